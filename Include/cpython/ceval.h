@@ -24,6 +24,13 @@ PyAPI_FUNC(PyObject *) _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameOb
 PyAPI_FUNC(void) _PyEval_SetSwitchInterval(unsigned long microseconds);
 PyAPI_FUNC(unsigned long) _PyEval_GetSwitchInterval(void);
 
+/* Thread switching policies, see sys.setswitchpolicy() */
+#define _PyEval_SWITCH_INTERVAL 0
+#define _PyEval_SWITCH_IO_PRIORITY 1
+
+PyAPI_FUNC(void) _PyEval_SetSwitchPolicy(int policy);
+PyAPI_FUNC(int) _PyEval_GetSwitchPolicy(void);
+
 PyAPI_FUNC(Py_ssize_t) _PyEval_RequestCodeExtraIndex(freefunc);
 
 PyAPI_FUNC(int) _PyEval_SliceIndex(PyObject *, Py_ssize_t *);
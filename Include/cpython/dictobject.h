@@ -41,6 +41,12 @@ PyAPI_FUNC(int) _PyDict_DelItem_KnownHash(PyObject *mp, PyObject *key,
 PyAPI_FUNC(int) _PyDict_DelItemIf(PyObject *mp, PyObject *key,
                                   int (*predicate)(PyObject *value));
 PyDictKeysObject *_PyDict_NewKeysForClass(void);
+PyAPI_FUNC(PyDictKeysObject *) _PyDict_MakeKeysShared(PyObject *mp);
+PyAPI_FUNC(int) _PyDictKeys_Match(PyDictKeysObject *keys,
+                                  PyObject *const *names, Py_ssize_t n);
+PyAPI_FUNC(PyObject *) _PyDict_FromSharedKeys(PyDictKeysObject *keys,
+                                              PyObject *const *values);
+PyAPI_FUNC(void) _PyDictKeys_DecRef(PyDictKeysObject *keys);
 PyAPI_FUNC(int) _PyDict_Next(
     PyObject *mp, Py_ssize_t *pos, PyObject **key, PyObject **value, Py_hash_t *hash);
 
@@ -72,6 +78,7 @@ PyAPI_FUNC(void) _PyDict_DebugMallocStats(FILE *out);
 int _PyObjectDict_SetItem(PyTypeObject *tp, PyObject **dictptr, PyObject *name, PyObject *value);
 PyObject *_PyDict_LoadGlobal(PyDictObject *, PyDictObject *, PyObject *);
 Py_ssize_t _PyDict_GetItemHint(PyDictObject *, PyObject *, Py_ssize_t, PyObject **);
+int _PyDict_SetItemHint(PyDictObject *, PyObject *, Py_ssize_t, PyObject *);
 
 /* _PyDictView */
 
@@ -119,6 +119,13 @@ typedef struct PyPreConfig {
     /* Memory allocator: PYTHONMALLOC env var.
        See PyMemAllocatorName for valid values. */
     int allocator;
+
+    /* If non-zero, use 2 MiB pymalloc arenas backed by huge pages.
+
+       Set to 1 by the -X hugepages command line option and by the
+       PYTHONHUGEPAGES environment variable. If set to -1 (default), it is
+       read from them. */
+    int use_hugepages;
 } PyPreConfig;
 
 PyAPI_FUNC(void) PyPreConfig_InitPythonConfig(PyPreConfig *config);
@@ -129,6 +129,24 @@ struct _ts {
     /* Unique thread state id. */
     uint64_t id;
 
+    /* Per-thread cache of free pymalloc blocks, see Objects/obmalloc.c */
+    struct _obmalloc_thread_cache *obmalloc_cache;
+
+    /* GIL hand-off statistics, see sys._getgilstats().  Times are
+       _PyTime_t values. */
+    struct {
+        int64_t wait_time;          /* total time spent in take_gil() */
+        int64_t max_wait_time;
+        int64_t hold_time;          /* total time between take and drop */
+        int64_t taken_at;           /* 0 if the GIL is not held */
+        unsigned long acquisitions;
+        unsigned long contended;    /* acquisitions which had to wait */
+        unsigned long forced_switches;  /* GIL dropped on request */
+        /* set while the thread drops the GIL on request, so that
+           take_gil() knows it is not returning from a blocking call */
+        int switch_requested;
+    } gil;
+
     /* XXX signal handlers should also be here */
 
 };
@@ -166,6 +184,11 @@ PyAPI_FUNC(PyInterpreterState *) _PyGILState_GetInterpreterStateUnsafe(void);
 */
 PyAPI_FUNC(PyObject *) _PyThread_CurrentFrames(void);
 
+/* The implementation of sys._getgilstats()  Returns a dict mapping
+   thread id to the GIL statistics of that thread.
+*/
+PyAPI_FUNC(PyObject *) _PyThread_GILStats(void);
+
 /* The implementation of sys._current_exceptions()  Returns a dict mapping
    thread id to that thread's current exception.
 */
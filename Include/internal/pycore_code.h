@@ -16,16 +16,79 @@ typedef struct {
     unsigned int tp_version_tag;
 } _PyOpCodeOpt_LoadAttr;
 
+/* LOAD_METHOD cache kinds */
+#define LM_KIND_METHOD 1    /* unbound method found on the type */
+#define LM_KIND_MODULE 2    /* attribute of a module object */
+
+typedef struct {
+    union {
+        PyTypeObject *type;     /* LM_KIND_METHOD: type of the owner */
+        PyObject *dict;         /* LM_KIND_MODULE: module __dict__ */
+    } owner;
+    PyObject *meth;  /* Cached method or module attribute (borrowed) */
+    union {
+        unsigned int tp_version_tag;  /* LM_KIND_METHOD */
+        uint64_t dict_ver;            /* LM_KIND_MODULE: ma_version_tag */
+    } ver;
+    char kind;
+} _PyOpcache_LoadMethod;
+
 struct _PyOpcache {
     union {
         _PyOpcache_LoadGlobal lg;
         _PyOpCodeOpt_LoadAttr la;
+        _PyOpCodeOpt_LoadAttr sa;  /* STORE_ATTR uses the LOAD_ATTR layout */
+        _PyOpcache_LoadMethod lm;
     } u;
     char optimized;
 };
 
+/* Opcode cache statistics */
+enum {
+    OPCACHE_KIND_LOAD_GLOBAL,
+    OPCACHE_KIND_LOAD_ATTR,
+    OPCACHE_KIND_LOAD_METHOD,
+    OPCACHE_KIND_STORE_ATTR,
+    OPCACHE_NKINDS
+};
+
+typedef struct {
+    size_t hits;      /* the cached value was used */
+    size_t misses;    /* a warm cache entry had to be refreshed */
+    size_t opts;      /* an entry was specialized for the first time */
+    size_t deopts;    /* an entry gave up and was disabled */
+    size_t entries;   /* cache entries currently allocated */
+} _PyOpcacheKindStats;
+
+typedef struct {
+    size_t code_objects;  /* code objects currently owning a cache */
+    size_t map_memory;    /* bytes used by their co_opcache_map and counters */
+    _PyOpcacheKindStats kinds[OPCACHE_NKINDS];
+} _PyOpcacheStats;
+
+extern _PyOpcacheStats _Py_opcache_stats;
+
+/* Counters of a single code object, per cache kind */
+typedef struct {
+    size_t hits;
+    size_t misses;
+    size_t opts;
+    size_t deopts;
+} _PyOpcacheCounters;
+
+/* The counters are allocated right after the co_opcache_size entries of
+   co_opcache, so they only exist while co_opcache is not NULL. */
+static inline _PyOpcacheCounters *
+_PyOpcache_CodeCounters(PyCodeObject *co)
+{
+    assert(co->co_opcache != NULL);
+    return (_PyOpcacheCounters *)&co->co_opcache[co->co_opcache_size];
+}
+
 /* Private API */
-int _PyCode_InitOpcache(PyCodeObject *co);
+PyAPI_FUNC(int) _PyCode_InitOpcache(PyCodeObject *co);
+PyObject *_PyCode_GetOpcacheStats(PyCodeObject *co);
+PyObject *_PyOpcache_GetStats(void);
 
 
 #ifdef __cplusplus
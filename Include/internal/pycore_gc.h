@@ -40,10 +40,17 @@ typedef struct {
 #define _PyGC_PREV_SHIFT           (2)
 #define _PyGC_PREV_MASK            (((uintptr_t) -1) << _PyGC_PREV_SHIFT)
 
-// Lowest bit of _gc_next is used for flags only in GC.
-// But it is always 0 for normal code.
-#define _PyGCHead_NEXT(g)        ((PyGC_Head*)(g)->_gc_next)
-#define _PyGCHead_SET_NEXT(g, p) ((g)->_gc_next = (uintptr_t)(p))
+/* Bit flags for _gc_next */
+/* Bit 0 is used only while collecting (NEXT_MASK_UNREACHABLE in gcmodule.c) */
+/* Bit 1 tells which half of the oldest generation the object belongs to
+   when it is collected incrementally. */
+#define _PyGC_NEXT_MASK_OLD_SPACE_1 (2)
+
+// Lowest two bits of _gc_next are used for flags.  Normal code must
+// preserve the _PyGC_NEXT_MASK_OLD_SPACE_1 flag.
+#define _PyGCHead_NEXT(g)        ((PyGC_Head*)((g)->_gc_next & _PyGC_PREV_MASK))
+#define _PyGCHead_SET_NEXT(g, p) ((g)->_gc_next = \
+    ((g)->_gc_next & _PyGC_NEXT_MASK_OLD_SPACE_1) | (uintptr_t)(p))
 
 // Lowest two bits of _gc_prev is used for _PyGC_PREV_MASK_* flags.
 #define _PyGCHead_PREV(g) ((PyGC_Head*)((g)->_gc_prev & _PyGC_PREV_MASK))
@@ -159,6 +166,21 @@ struct _gc_runtime_state {
        collections, and are awaiting to undergo a full collection for
        the first time. */
     Py_ssize_t long_lived_pending;
+    /* Maximum number of objects of the oldest generation examined by an
+       incremental collection, or 0 if the oldest generation is always
+       collected at once. */
+    Py_ssize_t incremental_budget;
+    /* Value of the _PyGC_NEXT_MASK_OLD_SPACE_1 bit for the objects of the
+       oldest generation already examined by the current incremental scan. */
+    int visited_space;
+    /* Number of objects examined by the current incremental scan. */
+    Py_ssize_t incremental_examined;
+    /* true if the oldest generation grew enough to require a full
+       collection rather than another incremental scan. */
+    int incremental_full_pending;
+    /* Number of threads searching the unreachable objects of large
+       collections. */
+    int threads;
 };
 
 extern void _PyGC_InitState(struct _gc_runtime_state *);
@@ -175,6 +197,11 @@ extern void _PyDict_ClearFreeList(PyInterpreterState *interp);
 extern void _PyAsyncGen_ClearFreeLists(PyInterpreterState *interp);
 extern void _PyContext_ClearFreeList(PyInterpreterState *interp);
 
+#ifdef Py_IMMORTAL_INSTANCES
+// Make the interned strings immortal, used by gc.immortalize()
+extern void _PyUnicode_ImmortalizeInterned(PyInterpreterState *interp);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
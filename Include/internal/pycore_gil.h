@@ -23,6 +23,8 @@ extern "C" {
 struct _gil_runtime_state {
     /* microseconds (the Python API uses seconds, though) */
     unsigned long interval;
+    /* _PyEval_SWITCH_INTERVAL or _PyEval_SWITCH_IO_PRIORITY */
+    int policy;
     /* Last PyThreadState holding / having held the GIL. This helps us
        know whether anyone else was scheduled after we dropped the GIL. */
     _Py_atomic_address last_holder;
@@ -31,6 +33,10 @@ struct _gil_runtime_state {
     _Py_atomic_int locked;
     /* Number of GIL switches since the beginning. */
     unsigned long switch_number;
+    /* Thread returning from a blocking call which asked for the GIL with
+       the "io_priority" policy: other threads don't take the GIL until it
+       got it. */
+    PyThreadState *priority_waiter;
     /* This condition variable allows one or several threads to wait
        until the GIL is released. In addition, the mutex also protects
        the above variables. */
@@ -86,6 +86,10 @@ struct _Py_unicode_state {
        count of a string is:  s->ob_refcnt + (s->state ? 2 : 0)
     */
     PyObject *interned;
+    /* Cache of the strings returned by _PyUnicode_InternFromUCS1(), indexed
+       by a hash of their characters, or NULL.  The references are borrowed:
+       unicode_dealloc() clears the entry of a string which dies. */
+    PyObject **intern_cache;
 
     // Unicode identifiers (_Py_Identifier): see _PyUnicode_FromId()
     struct _Py_unicode_ids ids;
@@ -69,6 +69,14 @@ PyAPI_FUNC(int) _PyMem_GetAllocatorName(
    PYMEM_ALLOCATOR_NOT_SET does nothing. */
 PyAPI_FUNC(int) _PyMem_SetupAllocators(PyMemAllocatorName allocator);
 
+/* Give the free blocks cached by a thread state back to pymalloc and
+   stop caching for it.  Called by PyThreadState_Clear(). */
+extern void _PyObject_ClearThreadCache(PyThreadState *tstate);
+
+/* Use 2 MiB pymalloc arenas backed by huge pages: -X hugepages.
+   Must be called before the first arena is allocated. */
+extern void _PyObject_EnableHugeArenas(void);
+
 struct _PyTraceMalloc_Config {
     /* Module initialized?
        Variable protected by the GIL */
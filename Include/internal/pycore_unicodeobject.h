@@ -0,0 +1,21 @@
+#ifndef Py_INTERNAL_UNICODEOBJECT_H
+#define Py_INTERNAL_UNICODEOBJECT_H
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef Py_BUILD_CORE
+#  error "this header requires Py_BUILD_CORE define"
+#endif
+
+/* Return an interned string for a buffer of Latin-1 characters.  A cache
+   of the strings interned by this function avoids creating a temporary
+   string and looking it up in the interned dictionary. */
+extern PyObject* _PyUnicode_InternFromUCS1(
+    const Py_UCS1 *buffer,
+    Py_ssize_t size);
+
+#ifdef __cplusplus
+}
+#endif
+#endif /* !Py_INTERNAL_UNICODEOBJECT_H */
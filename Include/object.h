@@ -146,6 +146,22 @@ static inline void _Py_SET_REFCNT(PyObject *ob, Py_ssize_t refcnt) {
 }
 #define Py_SET_REFCNT(ob, refcnt) _Py_SET_REFCNT(_PyObject_CAST(ob), refcnt)
 
+#ifdef Py_IMMORTAL_INSTANCES
+/* gc.immortalize() sets this bit in the reference count of objects which
+ * must never be deallocated.  Py_INCREF() and Py_DECREF() don't write to
+ * immortal objects, so that the memory pages holding them stay shared
+ * with forked processes. */
+#define _Py_IMMORTAL_BIT ((Py_ssize_t)1 << (8 * SIZEOF_SIZE_T - 4))
+
+static inline int _Py_IsImmortal(const PyObject *ob) {
+    return (ob->ob_refcnt & _Py_IMMORTAL_BIT) != 0;
+}
+
+static inline void _Py_SetImmortal(PyObject *ob) {
+    ob->ob_refcnt |= _Py_IMMORTAL_BIT;
+}
+#endif
+
 
 static inline void _Py_SET_TYPE(PyObject *ob, PyTypeObject *type) {
     ob->ob_type = type;
@@ -424,6 +440,11 @@ PyAPI_FUNC(void) _Py_Dealloc(PyObject *);
 
 static inline void _Py_INCREF(PyObject *op)
 {
+#ifdef Py_IMMORTAL_INSTANCES
+    if (_Py_IsImmortal(op)) {
+        return;
+    }
+#endif
 #ifdef Py_REF_DEBUG
     _Py_RefTotal++;
 #endif
@@ -437,6 +458,11 @@ static inline void _Py_DECREF(
 #endif
     PyObject *op)
 {
+#ifdef Py_IMMORTAL_INSTANCES
+    if (_Py_IsImmortal(op)) {
+        return;
+    }
+#endif
 #ifdef Py_REF_DEBUG
     _Py_RefTotal--;
 #endif
@@ -638,6 +638,41 @@ def _compile_bytecode(data, name=None, bytecode_path=None, source_path=None):
                           name=name, path=bytecode_path)
 
 
+# Code objects loaded ahead of their import by importlib.util.prewarm(), keyed
+# by bytecode path.  Each value is a (source_mtime, source_size, code) tuple.
+_prepared_code = {}
+
+
+def _prepare_code(name, source_path, bytecode_path):
+    """Load a timestamp-based pyc and keep its code object for SourceLoader.
+
+    Return True if the bytecode was up to date and could be loaded.  Errors
+    are left for the import itself to report.
+
+    """
+    try:
+        st = _path_stat(source_path)
+        with _io.open_code(bytecode_path) as file:
+            data = file.read()
+    except OSError:
+        return False
+    exc_details = {'name': name, 'path': bytecode_path}
+    try:
+        # Hash-based pycs are left for the import to validate.
+        if _classify_pyc(data, name, exc_details) != 0:
+            return False
+        source_mtime = int(st.st_mtime)
+        _validate_timestamp_pyc(data, source_mtime, st.st_size, name,
+                                exc_details)
+        code = _compile_bytecode(memoryview(data)[16:], name=name,
+                                 bytecode_path=bytecode_path,
+                                 source_path=source_path)
+    except (ImportError, EOFError, ValueError, TypeError):
+        return False
+    _prepared_code[bytecode_path] = (source_mtime, st.st_size, code)
+    return True
+
+
 def _code_to_timestamp_pyc(code, mtime=0, source_size=0):
     "Produce the data for a timestamp-based pyc."
     data = bytearray(MAGIC_NUMBER)
@@ -921,6 +956,12 @@ def get_code(self, fullname):
                 pass
             else:
                 source_mtime = int(st['mtime'])
+                prepared = _prepared_code.pop(bytecode_path, None)
+                if (prepared is not None and
+                        prepared[:2] == (source_mtime, st.get('size'))):
+                    _bootstrap._verbose_message('{} matches {}', bytecode_path,
+                                                source_path)
+                    return prepared[2]
                 try:
                     data = self.get_data(bytecode_path)
                 except OSError:
@@ -1269,6 +1310,7 @@ class PathFinder:
     def invalidate_caches():
         """Call the invalidate_caches() method on all path entry finders
         stored in sys.path_importer_caches (where implemented)."""
+        _prepared_code.clear()
         for name, finder in list(sys.path_importer_cache.items()):
             if finder is None:
                 del sys.path_importer_cache[name]
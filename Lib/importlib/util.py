@@ -5,9 +5,13 @@
 from ._bootstrap import spec_from_loader
 from ._bootstrap import _find_spec
 from ._bootstrap_external import MAGIC_NUMBER
+from ._bootstrap_external import PathFinder
+from ._bootstrap_external import SourceFileLoader
 from ._bootstrap_external import _RAW_MAGIC_NUMBER
 from ._bootstrap_external import cache_from_source
 from ._bootstrap_external import decode_source
+from ._bootstrap_external import _prepare_code
+from ._bootstrap_external import _prepared_code
 from ._bootstrap_external import source_from_cache
 from ._bootstrap_external import spec_from_file_location
 
@@ -115,6 +119,128 @@ def find_spec(name, package=None):
             return spec
 
 
+def _find_path_spec(name, specs):
+    """Find the spec of a module on sys.path without importing its parents."""
+    if name in sys.modules:
+        return getattr(sys.modules[name], '__spec__', None)
+    if name not in specs:
+        spec = None
+        parent_name = name.rpartition('.')[0]
+        if parent_name:
+            parent = _find_path_spec(parent_name, specs)
+            path = getattr(parent, 'submodule_search_locations', None)
+        else:
+            path = None
+        if not parent_name or path is not None:
+            try:
+                spec = PathFinder.find_spec(name, path)
+            except (ImportError, ValueError):
+                pass
+        specs[name] = spec
+    return specs[name]
+
+
+def prewarm(names, *, max_workers=None):
+    """Load the bytecode of the named modules ahead of their import.
+
+    The cached bytecode of the source modules found on sys.path is read,
+    validated and unmarshalled by max_workers threads, and the code objects
+    are used when the modules are imported.  Parent packages are not
+    imported, and modules which are already imported or not loaded from
+    source are skipped.  Return the list of names whose code was prepared.
+
+    """
+    if max_workers is None:
+        import os
+        max_workers = min(32, (os.cpu_count() or 1) + 4)
+    if max_workers <= 0:
+        raise ValueError("max_workers must be greater than 0")
+    specs = {}
+    todo = {}
+    for name in names:
+        spec = _find_path_spec(name, specs)
+        if (name not in sys.modules and spec is not None and
+                isinstance(spec.loader, SourceFileLoader) and spec.cached):
+            todo[name] = spec
+    if not todo:
+        return []
+
+    import threading
+    queue = list(reversed(todo.values()))
+    prepared = set()
+    def worker():
+        while True:
+            try:
+                spec = queue.pop()
+            except IndexError:
+                return
+            if _prepare_code(spec.name, spec.origin, spec.cached):
+                prepared.add(spec.name)
+
+    threads = [threading.Thread(target=worker)
+               for _ in range(min(max_workers, len(queue)))]
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    return [name for name in todo if name in prepared]
+
+
+def write_snapshot(path, names):
+    """Write the code objects of the named modules to a snapshot file.
+
+    The modules are found like with prewarm() and are not imported.  Return
+    the list of names whose code was written.
+
+    """
+    import marshal
+    import os
+    specs = {}
+    entries = {}
+    for name in names:
+        spec = _find_path_spec(name, specs)
+        if (name in entries or spec is None or not spec.cached or
+                not isinstance(spec.loader, SourceFileLoader)):
+            continue
+        try:
+            # Stat the source first so that the code is never newer than
+            # the recorded stats.
+            st = os.stat(spec.origin)
+            code = spec.loader.get_code(name)
+        except (ImportError, OSError, SyntaxError, ValueError):
+            continue
+        entries[name] = (name, spec.origin, spec.cached, int(st.st_mtime),
+                         st.st_size, code)
+    with open(path, 'wb') as file:
+        file.write(MAGIC_NUMBER)
+        marshal.dump(tuple(entries.values()), file)
+    return list(entries)
+
+
+def read_snapshot(path):
+    """Read a snapshot file written by write_snapshot().
+
+    The code objects are used when the modules are imported, as long as
+    their source files were not modified since the snapshot was written.
+    Return the list of names whose code was read.
+
+    """
+    import marshal
+    with open(path, 'rb') as file:
+        data = file.read()
+    if data[:4] != MAGIC_NUMBER:
+        raise ValueError(f'bad magic number in snapshot {path!r}')
+    names = []
+    for name, source_path, bytecode_path, mtime, size, code in (
+            marshal.loads(memoryview(data)[4:])):
+        # The bytecode path depends on the optimization level.
+        if (name not in sys.modules and
+                cache_from_source(source_path) == bytecode_path):
+            _prepared_code[bytecode_path] = (mtime, size, code)
+            names.append(name)
+    return names
+
+
 @contextmanager
 def _module_to_load(name):
     is_reload = name in sys.modules
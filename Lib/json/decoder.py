@@ -1,5 +1,6 @@
 """Implementation of JSONDecoder
 """
+import codecs
 import re
 
 from json import scanner
@@ -7,6 +8,10 @@
     from _json import scanstring as c_scanstring
 except ImportError:
     c_scanstring = None
+try:
+    from _json import make_stream_decoder as c_make_stream_decoder
+except ImportError:
+    c_make_stream_decoder = None
 
 __all__ = ['JSONDecoder', 'JSONDecodeError']
 
@@ -130,6 +135,7 @@ def py_scanstring(s, end, strict=True,
 scanstring = c_scanstring or py_scanstring
 
 WHITESPACE = re.compile(r'[ \t\n\r]*', FLAGS)
+WHITESPACE_BYTES = re.compile(br'[ \t\n\r]*', FLAGS)
 WHITESPACE_STR = ' \t\n\r'
 
 
@@ -251,6 +257,174 @@ def JSONArray(s_and_end, scan_once, _w=WHITESPACE.match, _ws=WHITESPACE_STR):
     return values, end
 
 
+STRING_CHUNK = re.compile(r'(?:[^"\\]|\\.)*', FLAGS)
+STRUCTURE = re.compile(r'["\[\]{}]', FLAGS)
+SCALAR_END = re.compile(r'[ \t\n\r,:\[\]{}"]', FLAGS)
+
+
+class PyStreamDecoder(object):
+    """Incremental JSON decoder
+
+    The input is accumulated in a buffer, which is scanned for the end of
+    the next top-level value: only the nesting depth and whether it is in
+    a string are tracked, so that scanning can resume when more data
+    arrives.  Complete values are parsed with the scanner of ``context``
+    and dropped from the buffer.
+    """
+
+    def __init__(self, context, items=False):
+        self.scanner = scanner.py_make_scanner(context)
+        self.items = bool(items)
+        self._utf8 = codecs.getincrementaldecoder('utf-8')('surrogatepass')
+        self._buf = ''
+        self._start = self._idx = 0
+        self._depth = 0
+        self._in_value = self._in_string = False
+        self._in_array = False
+        # in an array: 0 at the start, 1 after an item, 2 after a comma
+        self._expect_delimiter = 0
+        self._closed = False
+        # set while the hooks of the scanner may run
+        self._decoding = False
+
+    def feed(self, data):
+        """Add data (a str or a UTF-8 encoded bytes-like object) to the
+        input.  Iterate over the decoder to get the values it completes.
+        """
+        if self._closed:
+            raise ValueError('feed() after close()')
+        if self._decoding:
+            raise RuntimeError('feed() called while decoding a value')
+        if not isinstance(data, str):
+            data = self._utf8.decode(data)
+        # Drop the data of the values already produced
+        self._buf = self._buf[self._start:] + data
+        self._idx -= self._start
+        self._start = 0
+
+    def close(self):
+        """Signal the end of the input.  A trailing number or constant is
+        then complete, and an incomplete value raises JSONDecodeError when
+        the decoder is iterated.
+        """
+        if not self._closed:
+            self._closed = True
+            self._buf += self._utf8.decode(b'', True)
+
+    def __iter__(self):
+        return self
+
+    def __next__(self, _w=WHITESPACE.match):
+        if self._decoding:
+            raise RuntimeError('next() called while decoding a value')
+        buf = self._buf
+        idx = self._idx
+        while not self._in_value:
+            idx = _w(buf, idx).end()
+            self._start = self._idx = idx
+            if idx == len(buf):
+                if self._closed and self._in_array:
+                    self._in_array = False
+                    if self._expect_delimiter == 1:
+                        raise JSONDecodeError("Expecting ',' delimiter", '', 0)
+                    raise JSONDecodeError("Expecting value", '', 0)
+                raise StopIteration
+            c = buf[idx]
+            if self._in_array:
+                if c == ']':
+                    self._in_array = False
+                    self._idx = idx = idx + 1
+                    if self._expect_delimiter == 2:
+                        raise JSONDecodeError("Expecting value", c, 0)
+                    continue
+                if self._expect_delimiter == 1:
+                    if c != ',':
+                        self._in_array = False
+                        # the document is the unexpected character
+                        raise JSONDecodeError("Expecting ',' delimiter",
+                                              c if c < '\x80' else '', 0)
+                    self._expect_delimiter = 2
+                    self._idx = idx = idx + 1
+                    continue
+            elif c == '[' and self.items:
+                self._in_array = True
+                self._expect_delimiter = 0
+                self._idx = idx = idx + 1
+                continue
+            self._in_value = True
+            self._depth = 0
+            self._in_string = False
+
+        # Look for the end of the value
+        start = self._start
+        end = -1
+        if idx == start and buf[idx] in ',:]}':
+            # not a value: let the scanner report it
+            end = idx + 1
+        elif (not self._in_string and self._depth == 0 and
+                buf[start] not in '"[{'):
+            # number or constant
+            m = SCALAR_END.search(buf, idx)
+            if m is not None:
+                end = m.start()
+            else:
+                idx = len(buf)
+        else:
+            while True:
+                if self._in_string:
+                    idx = STRING_CHUNK.match(buf, idx).end()
+                    if idx == len(buf) or buf[idx] != '"':
+                        # incomplete string or escape sequence
+                        break
+                    idx += 1
+                    self._in_string = False
+                    if self._depth == 0:
+                        end = idx
+                        break
+                m = STRUCTURE.search(buf, idx)
+                if m is None:
+                    idx = len(buf)
+                    break
+                c = m.group()
+                idx = m.end()
+                if c == '"':
+                    self._in_string = True
+                elif c in '[{':
+                    self._depth += 1
+                else:
+                    self._depth -= 1
+                    if self._depth == 0:
+                        end = idx
+                        break
+        if end < 0:
+            if not self._closed:
+                # wait for more data
+                self._idx = idx
+                raise StopIteration
+            end = len(buf)
+
+        # Parse the value, and drop it even if it is invalid, so that the
+        # values that follow can still be decoded
+        s = buf[start:end]
+        self._in_value = False
+        self._start = self._idx = end
+        if self._in_array:
+            self._expect_delimiter = 1
+        self._decoding = True
+        try:
+            obj, end = self.scanner(s, 0)
+        except StopIteration as err:
+            raise JSONDecodeError("Expecting value", s, err.value) from None
+        finally:
+            self._decoding = False
+        if end != len(s):
+            raise JSONDecodeError("Extra data", s, end)
+        return obj
+
+
+make_stream_decoder = c_make_stream_decoder or PyStreamDecoder
+
+
 class JSONDecoder(object):
     """Simple JSON <http://json.org> decoder
 
@@ -354,3 +528,46 @@ def raw_decode(self, s, idx=0):
         except StopIteration as err:
             raise JSONDecodeError("Expecting value", s, err.value) from None
         return obj, end
+
+    def stream(self, *, items=False):
+        """Return an incremental decoder for a stream of JSON documents
+        using the settings of this decoder.
+
+        Pass data to its ``feed()`` method, as ``str`` or UTF-8 encoded
+        bytes-like objects, and iterate over it to get the values that are
+        complete so far: iteration stops when more data is needed, and can
+        be resumed after the next ``feed()``.  Call ``close()`` at the end
+        of the input to get a trailing number or constant.
+
+        Documents may be separated by whitespace, as in newline-delimited
+        JSON.  If ``items`` is true, the items of top-level arrays are
+        produced one at a time instead of the arrays themselves.
+
+        A ``JSONDecodeError`` raised during iteration is about a single
+        document (its ``doc`` attribute), which is skipped.
+        """
+        return make_stream_decoder(self, items=items)
+
+    def _decode_utf8(self, b, _w=WHITESPACE_BYTES.match):
+        """Return the Python representation of ``b`` (a bytes-like object
+        containing a UTF-8 encoded JSON document).
+
+        The C scanner parses the bytes directly and only decodes keys and
+        string values; errors are reported as if ``b`` had been decoded
+        first.
+        """
+        if (scanner.c_make_scanner is None or
+                not isinstance(self.scan_once, scanner.c_make_scanner)):
+            return self.decode(str(b, 'utf-8', 'surrogatepass'))
+        try:
+            obj, end = self.scan_once(b, _w(b, 0).end())
+        except StopIteration as err:
+            msg, end = "Expecting value", err.value
+        else:
+            end = _w(b, end).end()
+            if end == len(b):
+                return obj
+            msg = "Extra data"
+        # Byte offset to index in the decoded document
+        s = str(b, 'utf-8', 'surrogatepass')
+        raise JSONDecodeError(msg, s, len(str(b[:end], 'utf-8', 'surrogatepass')))
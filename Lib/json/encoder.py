@@ -1,5 +1,6 @@
 """Implementation of JSONEncoder
 """
+import io
 import re
 
 try:
@@ -256,6 +257,32 @@ def floatstr(o, allow_nan=self.allow_nan,
                 self.skipkeys, _one_shot)
         return _iterencode(o, 0)
 
+    def _dump(self, o, fp):
+        """Write the JSON representation of o to the file-like object fp.
+
+        UTF-8 encoded bytes are written to binary streams.  The C encoder
+        passes the output to fp.write() in large chunks as it goes, so the
+        whole text is never held in memory.
+        """
+        binary = isinstance(fp, (io.RawIOBase, io.BufferedIOBase))
+        if (c_make_encoder is not None and self.indent is None
+                and type(self).iterencode is JSONEncoder.iterencode):
+            if self.ensure_ascii:
+                _encoder = encode_basestring_ascii
+            else:
+                _encoder = encode_basestring
+            _dump = c_make_encoder(
+                {} if self.check_circular else None, self.default,
+                _encoder, self.indent, self.key_separator,
+                self.item_separator, self.sort_keys, self.skipkeys,
+                self.allow_nan).dump
+            _dump(o, fp.write, binary)
+        else:
+            for chunk in self.iterencode(o):
+                if binary:
+                    chunk = chunk.encode('utf-8')
+                fp.write(chunk)
+
 def _make_iterencode(markers, _default, _encoder, _indent, _floatstr,
         _key_separator, _item_separator, _sort_keys, _skipkeys, _one_shot,
         ## HACK: hand-optimized bytecode; turn globals into locals
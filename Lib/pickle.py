@@ -407,7 +407,7 @@ def decode_long(data):
 class _Pickler:
 
     def __init__(self, file, protocol=None, *, fix_imports=True,
-                 buffer_callback=None):
+                 buffer_callback=None, background_write=False):
         """This takes a binary file for writing a pickle data stream.
 
         The optional *protocol* argument tells the pickler to use the
@@ -440,6 +440,13 @@ def __init__(self, file, protocol=None, *, fix_imports=True,
 
         It is an error if *buffer_callback* is not None and *protocol*
         is None or smaller than 5.
+
+        If *background_write* is true, large payloads dumped to a regular
+        file opened with open() may be written out by a worker thread
+        while the rest of the object is pickled.  The file, and the
+        buffers being pickled, must then not be used by other code until
+        dump() returns.  This pure Python implementation always writes
+        synchronously.
         """
         if protocol is None:
             protocol = DEFAULT_PROTOCOL
@@ -1175,6 +1182,7 @@ def __init__(self, file, *, fix_imports=True,
         'bytes' to read theses 8-bit string instances as bytes objects.
         """
         self._buffers = iter(buffers) if buffers is not None else None
+        self._input = self._input_view = None
         self._file_readline = file.readline
         self._file_read = file.read
         self.memo = {}
@@ -1387,11 +1395,37 @@ def load_bytearray8(self):
         if len > maxsize:
             raise UnpicklingError("BYTEARRAY8 exceeds system's maximum size "
                                   "of %d bytes" % maxsize)
+        if self._input_view is not None:
+            self.append(self._read_view(len))
+            return
         b = bytearray(len)
         self.readinto(b)
         self.append(b)
     dispatch[BYTEARRAY8[0]] = load_bytearray8
 
+    def _read_view(self, n):
+        # loads() with copy=False: slice the payload from the input
+        view = self._input_view
+        frame = self._unframer.current_frame
+        if frame:
+            # The frame was read from the input just before its end
+            pos = frame.tell()
+            end = frame.seek(0, io.SEEK_END)
+            frame.seek(pos)
+            if pos < end or n == 0:
+                if n > end - pos:
+                    raise UnpicklingError(
+                        "pickle exhausted before end of frame")
+                frame.seek(pos + n)
+                pos += self._input.tell() - end
+                return view[pos:pos + n]
+            self._unframer.current_frame = None
+        pos = self._input.tell()
+        if n > len(view) - pos:
+            raise UnpicklingError("pickle data was truncated")
+        self._input.seek(pos + n)
+        return view[pos:pos + n]
+
     def load_next_buffer(self):
         if self._buffers is None:
             raise UnpicklingError("pickle stream refers to out-of-band data "
@@ -1764,12 +1798,16 @@ def _load(file, *, fix_imports=True, encoding="ASCII", errors="strict",
                      encoding=encoding, errors=errors).load()
 
 def _loads(s, /, *, fix_imports=True, encoding="ASCII", errors="strict",
-           buffers=None):
+           buffers=None, copy=True):
     if isinstance(s, str):
         raise TypeError("Can't load pickle from unicode string")
     file = io.BytesIO(s)
-    return _Unpickler(file, fix_imports=fix_imports, buffers=buffers,
-                      encoding=encoding, errors=errors).load()
+    unpickler = _Unpickler(file, fix_imports=fix_imports, buffers=buffers,
+                           encoding=encoding, errors=errors)
+    if not copy:
+        unpickler._input = file
+        unpickler._input_view = memoryview(s).cast('B')
+    return unpickler.load()
 
 # Use the faster _pickle if possible
 try:
@@ -3346,6 +3346,67 @@ def test_dump_text_file(self):
             f.close()
             os_helper.unlink(TESTFN)
 
+    def test_dump_large_payloads_to_file(self):
+        # With background_write, large payloads may be written out while
+        # pickling the rest
+        payload = bytes(range(256)) * 8192
+        data = [{'a': payload, 'b': bytearray(payload), 'c': [1, 2] * 1000},
+                'x' * 2**21, ('\xe9' * 2**20, payload), payload[1:]]
+        self.addCleanup(os_helper.unlink, TESTFN)
+        def dump(f, proto):
+            self.Pickler(f, proto, background_write=True).dump(data)
+        for proto in protocols:
+            if proto >= 5:
+                data.append(pickle.PickleBuffer(payload[2:]))
+            expected = self.dumps(data, proto)
+            for buffering in -1, 0:
+                with self.subTest(proto=proto, buffering=buffering):
+                    with open(TESTFN, 'wb', buffering=buffering) as f:
+                        f.write(b'spam')
+                        dump(f, proto)
+                        self.assertEqual(f.tell(), len(expected) + 4)
+                        self.Pickler(f, proto).dump(data)
+                        f.write(b'eggs')
+                    with open(TESTFN, 'ab', buffering=buffering) as f:
+                        dump(f, proto)
+                        self.assertEqual(f.tell(), 3 * len(expected) + 8)
+                    with open(TESTFN, 'rb') as f:
+                        self.assertEqual(f.read(),
+                                         b'spam' + expected * 2 + b'eggs' +
+                                         expected)
+
+    def test_loads_without_copy(self):
+        payload = bytearray(b'spam' * 100000)
+        obj = [payload, bytearray(b'eggs'), bytes(payload),
+               pickle.PickleBuffer(payload)]
+        data = self.dumps(obj, 5)
+        for source in data, bytearray(data), memoryview(data):
+            with self.subTest(type=type(source)):
+                a, b, c, d = self.loads(source, copy=False)
+                self.assertIsInstance(a, memoryview)
+                self.assertIsInstance(b, memoryview)
+                self.assertIs(type(c), bytes)
+                self.assertIsInstance(d, memoryview)
+                self.assertEqual([a, b, c, d], [payload, b'eggs', payload,
+                                                payload])
+                self.assertEqual(a.readonly, not isinstance(source, bytearray))
+                if isinstance(source, bytearray):
+                    # Payloads within frames are views too
+                    a[:4] = b'SPAM'
+                    b[:] = b'EGGS'
+                    self.assertIn(b'SPAM', source)
+                    self.assertIn(b'EGGS', source)
+                    a.release()
+                    b.release()
+                    d.release()
+                    source.clear()
+        self.assertEqual(self.loads(data), obj[:3] + [payload])
+        self.assertIs(type(self.loads(data, copy=False)[0]), memoryview)
+        self.assertIs(type(self.loads(self.dumps(payload, 4), copy=False)),
+                      bytearray)
+        self.assertRaises(pickle.UnpicklingError, self.loads,
+                          self.dumps(payload, 5)[:-10], copy=False)
+
     def test_incomplete_input(self):
         s = io.BytesIO(b"X''.")
         self.assertRaises((EOFError, struct.error, pickle.UnpicklingError), self.load, s)
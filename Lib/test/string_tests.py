@@ -213,6 +213,55 @@ def test_find(self):
                 if loc != -1:
                     self.assertEqual(i[loc:loc+len(j)], j)
 
+    def check_find_against_naive(self, haystack, needle):
+        haystack = self.fixtype(haystack)
+        needle = self.fixtype(needle)
+        m = len(needle)
+        matches = [i for i in range(len(haystack) - m + 1)
+                   if haystack[i:i+m] == needle]
+        count = 0
+        end = 0
+        for i in matches:
+            if i >= end:
+                count += 1
+                end = i + m
+        self.assertEqual(haystack.find(needle), matches[0] if matches else -1)
+        self.assertEqual(haystack.count(needle), count)
+        self.assertEqual(needle in haystack, bool(matches))
+
+    def test_find_periodic_pattern(self):
+        # Needles long enough for the two-way algorithm, which are
+        # periodic or almost periodic
+        for unit, m in [('a', 120), ('ab', 300), ('abc', 151), ('aab', 200)]:
+            needle = (unit * m)[:m]
+            for k in (0, m // 2, m - 1):
+                for c in 'abcx':
+                    pattern = needle[:k] + c + needle[k+1:]
+                    text = (unit * 3000)[:3000]
+                    self.check_find_against_naive(text, pattern)
+                    self.check_find_against_naive(
+                        text[:1000] + pattern + text[:1000] + pattern, pattern)
+
+    def test_find_long_needle(self):
+        import random
+        rng = random.Random(42)
+        for alphabet in ('ab', 'abcd', string.ascii_letters):
+            for m in (6, 100, 260):
+                text = ''.join(rng.choice(alphabet) for i in range(3000))
+                needle = text[1234:1234+m]
+                self.check_find_against_naive(text, needle)
+                self.check_find_against_naive(text, needle[:-1] + '!')
+                self.check_find_against_naive(text * 3, needle)
+
+    def test_find_short_needle(self):
+        # The word-at-a-time filter of short needles
+        text = 'xy z' * 50 + 'x' * 100 + 'x zy' * 50
+        for needle in ('xy', 'x z', 'zy', 'xx', 'yx', 'x zy', 'y zxy z',
+                       'xxxxxxxx', 'xxxxxxx ', 'xy!', 'x' * 9):
+            self.check_find_against_naive(text, needle)
+            self.check_find_against_naive(text[:70], needle)
+            self.check_find_against_naive(text[1:] + needle, needle)
+
     def test_rfind(self):
         self.checkequal(9,  'abcdefghiabc', 'rfind', 'abc')
         self.checkequal(12, 'abcdefghiabc', 'rfind', '')
@@ -314,6 +314,7 @@ class InitConfigTests(EmbeddingTestsMixin, unittest.TestCase):
     PRE_CONFIG_COMPAT = {
         '_config_init': API_COMPAT,
         'allocator': PYMEM_ALLOCATOR_NOT_SET,
+        'use_hugepages': 0,
         'parse_argv': 0,
         'configure_locale': 1,
         'coerce_c_locale': 0,
@@ -787,6 +787,44 @@ def test_freeze(self):
         gc.unfreeze()
         self.assertEqual(gc.get_freeze_count(), 0)
 
+    @unittest.skipUnless(hasattr(gc, 'immortalize'),
+                         'requires --with-immortal-instances')
+    def test_immortalize(self):
+        code = """if 1:
+            import gc, sys
+            class A:
+                pass
+            # compile f separately: the constants of the code being run
+            # are also referred to by the parser
+            ns = {}
+            exec("def f(): return ('abc def', (12.5,))", ns)
+            f = ns['f']
+            # untrack the constant tuples of f
+            gc.collect()
+            assert not gc.is_tracked(f()[1])
+            a = A()
+            refs = sys.getrefcount(a)
+            gc.immortalize()
+            assert gc.get_freeze_count() > 0
+            immortal = sys.getrefcount(a)
+            assert immortal > refs
+            l = [a] * 100
+            assert sys.getrefcount(a) == immortal
+            del l
+            assert sys.getrefcount(a) == immortal
+            refs = sys.getrefcount(A)
+            objs = [A() for i in range(100)]
+            assert sys.getrefcount(A) == refs
+            # Objects only reachable through untracked objects: the code
+            # object of f and its constants
+            assert not gc.is_tracked(f.__code__)
+            x = f()[1][0]
+            refs = sys.getrefcount(x)
+            l = [f()[1][0] for i in range(100)]
+            assert sys.getrefcount(x) == refs
+            """
+        assert_python_ok('-c', code)
+
     def test_get_objects(self):
         gc.collect()
         l = []
@@ -1361,6 +1399,218 @@ def __del__(self):
             # empty __dict__.
             self.assertEqual(x, None)
 
+class Node:
+    pass
+
+class IncrementalGCTests(unittest.TestCase):
+    budget = 100
+
+    def setUp(self):
+        self.enabled = gc.isenabled()
+        gc.disable()
+        self.threshold = gc.get_threshold()
+        gc.collect()
+        gc.set_incremental(self.budget)
+
+    def tearDown(self):
+        gc.set_incremental(0)
+        gc.set_threshold(*self.threshold)
+        if self.enabled:
+            gc.enable()
+
+    def collect_scan(self, wr):
+        # Run increments until the referent of wr is collected, giving up
+        # after two complete scans of the oldest generation.
+        old = len(gc.get_objects(generation=2))
+        for i in range(2 * (old // self.budget + 2)):
+            gc.collect_increment()
+            if wr() is None:
+                return True
+        return False
+
+    def test_set_incremental(self):
+        self.assertEqual(gc.get_incremental(), self.budget)
+        gc.set_incremental(0)
+        self.assertEqual(gc.get_incremental(), 0)
+        self.assertRaises(RuntimeError, gc.collect_increment)
+        self.assertRaises(ValueError, gc.set_incremental, -1)
+        self.assertEqual(gc.get_incremental(), 0)
+
+    def test_collect_old_cycle(self):
+        a = Node()
+        a.a = a
+        wr = weakref.ref(a)
+        gc.collect()
+        self.assertIn(a, gc.get_objects(generation=2))
+        del a
+        self.assertTrue(self.collect_scan(wr))
+
+    def test_cycle_between_generations(self):
+        old = Node()
+        gc.collect()
+        young = Node()
+        young.old = old
+        old.young = young
+        wr = weakref.ref(old)
+        del old, young
+        # The increment holds the young generation and the objects it
+        # refers to.
+        self.assertGreaterEqual(gc.collect_increment(), 2)
+        self.assertIsNone(wr())
+
+    def test_legacy_finalizer(self):
+        Uncollectable()
+        gc.collect_increment()
+        try:
+            self.assertEqual(len(gc.garbage), 2)
+        finally:
+            for obj in gc.garbage:
+                obj.partner = None
+            del gc.garbage[:]
+            gc.collect()
+
+    def test_frozen(self):
+        a = Node()
+        a.a = a
+        wr = weakref.ref(a)
+        gc.freeze()
+        try:
+            count = gc.get_freeze_count()
+            del a
+            self.assertFalse(self.collect_scan(wr))
+            self.assertEqual(gc.get_freeze_count(), count)
+        finally:
+            gc.unfreeze()
+        self.assertTrue(self.collect_scan(wr))
+
+    def test_callbacks(self):
+        visit = []
+        def cb(phase, info):
+            visit.append((phase, info["generation"], info["incremental"]))
+        gc.callbacks.append(cb)
+        try:
+            gc.collect_increment()
+            gc.collect()
+            self.assertEqual(visit, [("start", 2, True), ("stop", 2, True),
+                                     ("start", 2, False), ("stop", 2, False)])
+            # Reaching the threshold of the oldest generation collects an
+            # increment
+            del visit[:]
+            gc.set_threshold(10, 1, 1)
+            gc.enable()
+            for i in range(1000):
+                l = []
+                l.append(l)
+            gc.disable()
+            self.assertIn(("stop", 2, True), visit)
+            self.assertNotIn(("stop", 2, False), visit)
+        finally:
+            gc.callbacks.remove(cb)
+
+    def test_get_objects_during_increment(self):
+        # The survivors of an increment are found by gc.get_objects() while
+        # the finalizers and the callbacks run.
+        seen = []
+        def found(phase):
+            seen.append((phase, any(o is survivor for o in gc.get_objects())))
+        def cb(phase, info):
+            found(phase)
+        class Finalized(Node):
+            def __del__(self):
+                found('finalizer')
+        survivor = Node()
+        garbage = Finalized()
+        garbage.self = garbage
+        del garbage
+        gc.callbacks.append(cb)
+        try:
+            gc.collect_increment()
+        finally:
+            gc.callbacks.remove(cb)
+        self.assertEqual(seen, [('start', True), ('finalizer', True),
+                                ('stop', True)])
+        self.assertIn(survivor, gc.get_objects(generation=2))
+
+
+class ParallelGCTests(unittest.TestCase):
+    # Enough objects for the collection to be split between threads
+    size = 100_000
+
+    def setUp(self):
+        self.enabled = gc.isenabled()
+        gc.disable()
+        try:
+            gc.set_threads(4)
+        except NotImplementedError:
+            self.skipTest("parallel collection is not supported")
+
+    def tearDown(self):
+        gc.set_threads(1)
+        if self.enabled:
+            gc.enable()
+
+    def test_set_threads(self):
+        self.assertEqual(gc.get_threads(), 4)
+        gc.set_threads(1)
+        self.assertEqual(gc.get_threads(), 1)
+        self.assertRaises(ValueError, gc.set_threads, 0)
+        self.assertEqual(gc.get_threads(), 1)
+
+    def test_collect(self):
+        # A chain spanning all the segments of the list, reachable from its
+        # last link only, must survive.
+        head = None
+        for i in range(self.size):
+            node = Node()
+            node.next = head
+            head = node
+        head.cycle = head
+        # Garbage cycles interleaved with reachable ones
+        keep = []
+        wrs = []
+        for i in range(self.size // 10):
+            a = Node()
+            b = Node()
+            a.b = b
+            b.a = a
+            if i % 2:
+                keep.append(a)
+            else:
+                wrs.append(weakref.ref(a))
+        del a, b
+        gc.collect()
+        self.assertTrue(all(wr() is None for wr in wrs))
+        self.assertTrue(all(a.b.a is a for a in keep))
+        n = 0
+        node = head
+        while node is not None:
+            n += 1
+            node = node.next
+        self.assertEqual(n, self.size)
+
+        # The whole chain is garbage now
+        wr = weakref.ref(head)
+        del head, node
+        self.assertGreaterEqual(gc.collect(), self.size)
+        self.assertIsNone(wr())
+
+    def test_finalizers(self):
+        # Objects resurrected by finalizers are handled as in serial
+        # collections.
+        resurrected = []
+        class Lazarus:
+            def __del__(self):
+                resurrected.append(self)
+        for i in range(self.size // 2):
+            a = Lazarus()
+            a.cycle = a
+        del a
+        gc.collect()
+        self.assertEqual(len(resurrected), self.size // 2)
+        del resurrected[:]
+        self.assertGreaterEqual(gc.collect(), self.size // 2)
+
+
 def test_main():
     enabled = gc.isenabled()
     gc.disable()
@@ -1370,7 +1620,8 @@ def test_main():
 
     try:
         gc.collect() # Delete 2nd generation garbage
-        run_unittest(GCTests, GCTogglingTests, GCCallbackTests)
+        run_unittest(GCTests, GCTogglingTests, GCCallbackTests,
+                     IncrementalGCTests, ParallelGCTests)
     finally:
         gc.set_debug(debug)
         # test gc.enable() even if GC is disabled by default
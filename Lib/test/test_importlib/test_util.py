@@ -7,9 +7,11 @@
 import importlib.util
 import os
 import pathlib
+import py_compile
 import string
 import sys
 from test import support
+from test.support import os_helper
 import types
 import unittest
 import unittest.mock
@@ -836,6 +838,121 @@ def test_source_from_cache_outside_pycache_prefix(self):
  ) = util.test_both(PEP3147Tests, util=importlib_util)
 
 
+class PrewarmTests(unittest.TestCase):
+
+    def setUp(self):
+        self.state = {'meta_path': sys.meta_path[:],
+                      'path_hooks': sys.path_hooks[:]}
+        self.addCleanup(importlib.invalidate_caches)
+
+    def compile(self, path, mode=py_compile.PycInvalidationMode.TIMESTAMP):
+        py_compile.compile(path, doraise=True, invalidation_mode=mode)
+
+    def test_prewarm(self):
+        names = ('_pw_pkg.__init__', '_pw_pkg.sub', '_pw_mod', '_pw_hash',
+                 '_pw_stale', '_pw_nocache')
+        with util.create_modules(*names) as mapping, \
+             util.import_state(path=[mapping['.root']], **self.state):
+            for name in names[:-1]:
+                self.compile(mapping[name])
+            self.compile(mapping['_pw_hash'],
+                         py_compile.PycInvalidationMode.CHECKED_HASH)
+            st = os.stat(mapping['_pw_stale'])
+            os.utime(mapping['_pw_stale'], (st.st_atime, st.st_mtime + 10))
+            importlib.invalidate_caches()
+            prepared = importlib.util.prewarm(
+                ['_pw_mod', '_pw_pkg.sub', '_pw_hash', '_pw_stale',
+                 '_pw_nocache', '_pw_missing', '_pw_missing.sub', 'sys'])
+            self.assertEqual(prepared, ['_pw_mod', '_pw_pkg.sub'])
+            self.assertNotIn('_pw_pkg', sys.modules)
+            # The prepared code is used in place of the source and bytecode
+            # which are left untouched.
+            path = mapping['_pw_mod']
+            st = os.stat(path)
+            os.unlink(importlib.util.cache_from_source(path))
+            with open(path, 'w') as file:
+                file.write("attr = 'spam!!!'")
+            os.utime(path, ns=(st.st_atime_ns, st.st_mtime_ns))
+            import _pw_mod, _pw_pkg.sub
+            self.assertEqual(_pw_mod.attr, '_pw_mod')
+            self.assertEqual(_pw_pkg.sub.attr, '_pw_pkg.sub')
+            self.assertEqual(_pw_mod.__file__, path)
+
+    def test_invalidate_caches(self):
+        with util.create_modules('_pw_mod') as mapping, \
+             util.import_state(path=[mapping['.root']], **self.state):
+            self.compile(mapping['_pw_mod'])
+            importlib.invalidate_caches()
+            self.assertEqual(importlib.util.prewarm(['_pw_mod', '_pw_mod']),
+                             ['_pw_mod'])
+            importlib.invalidate_caches()
+            path = mapping['_pw_mod']
+            st = os.stat(path)
+            os.unlink(importlib.util.cache_from_source(path))
+            with open(path, 'w') as file:
+                file.write("attr = 'spam!!!'")
+            os.utime(path, ns=(st.st_atime_ns, st.st_mtime_ns))
+            import _pw_mod
+            self.assertEqual(_pw_mod.attr, 'spam!!!')
+
+    def test_max_workers(self):
+        self.assertRaises(ValueError, importlib.util.prewarm, [],
+                          max_workers=0)
+        self.assertEqual(importlib.util.prewarm(['sys', 'os'], max_workers=1),
+                         [])
+
+
+class SnapshotTests(unittest.TestCase):
+
+    def setUp(self):
+        self.state = {'meta_path': sys.meta_path[:],
+                      'path_hooks': sys.path_hooks[:]}
+        self.addCleanup(importlib.invalidate_caches)
+
+    def test_snapshot(self):
+        names = ('_snap_pkg.__init__', '_snap_pkg.sub', '_snap_mod',
+                 '_snap_stale')
+        with util.create_modules(*names) as mapping, \
+             util.import_state(path=[mapping['.root']], **self.state):
+            importlib.invalidate_caches()
+            snapshot = os.path.join(mapping['.root'], 'snapshot')
+            written = importlib.util.write_snapshot(
+                snapshot, ['_snap_pkg.sub', '_snap_mod', '_snap_stale',
+                           '_snap_mod', '_snap_missing', 'sys'])
+            self.assertEqual(written, ['_snap_pkg.sub', '_snap_mod',
+                                       '_snap_stale'])
+            self.assertNotIn('_snap_pkg', sys.modules)
+            # The snapshot entry of a modified source is rejected.
+            path = mapping['_snap_stale']
+            st = os.stat(path)
+            with open(path, 'w') as file:
+                file.write("attr = 'modified'")
+            os.utime(path, (st.st_atime, st.st_mtime + 10))
+            # The snapshot is used in place of the unchanged source.
+            path = mapping['_snap_mod']
+            st = os.stat(path)
+            with open(path, 'w') as file:
+                file.write("attr = 'spam!!!!!'")
+            os.utime(path, ns=(st.st_atime_ns, st.st_mtime_ns))
+            self.assertEqual(importlib.util.read_snapshot(snapshot), written)
+            import _snap_mod, _snap_pkg.sub, _snap_stale
+            self.assertEqual(_snap_mod.attr, '_snap_mod')
+            self.assertEqual(_snap_mod.__file__, path)
+            self.assertEqual(_snap_pkg.sub.attr, '_snap_pkg.sub')
+            self.assertEqual(_snap_stale.attr, 'modified')
+            # Imported modules are skipped.
+            self.assertEqual(importlib.util.read_snapshot(snapshot), [])
+
+    def test_bad_magic_number(self):
+        with os_helper.temp_dir() as tmpdir:
+            snapshot = os.path.join(tmpdir, 'snapshot')
+            importlib.util.write_snapshot(snapshot, [])
+            with open(snapshot, 'r+b') as file:
+                file.write(b'spam')
+            self.assertRaises(ValueError, importlib.util.read_snapshot,
+                              snapshot)
+
+
 class MagicNumberTests(unittest.TestCase):
     """
     Test release compatibility issues relating to importlib
@@ -62,6 +62,31 @@ def test_keys_reuse(self):
         self.check_keys_reuse(s, decoder.decode)
         self.assertFalse(decoder.memo)
 
+    def test_records(self):
+        # Objects with the same keys, in various orders and numbers
+        many = {'k%d' % i: i for i in range(40)}
+        docs = [{'a': 1, 'b': [2]}, {'a': 3, 'b': {}}, {'b': 4, 'a': 5},
+                {'a': 6}, {'a': 7, 'b': 8, 'c': 9}, {'a': 10, 'b': 11},
+                many, many, {}, {'a': None, 'b': None}]
+        s = self.dumps(docs * 3)
+        for _ in range(2):
+            rval = self.loads(s)
+            self.assertEqual(rval, docs * 3)
+            self.assertEqual([list(d) for d in rval],
+                             [list(d) for d in docs * 3])
+        self.assertEqual(self.loads('[{"a": 1, "a": 2}, {"a": 3, "a": 4}]'),
+                         [{'a': 2}, {'a': 4}])
+        # the decoded objects are independent
+        a, b, c = self.loads('[{"x": 1, "y": 2}, {"x": 3, "y": 4}, '
+                             '{"x": 5, "y": 6}]')
+        b['z'] = 7
+        del c['x']
+        a['x'] = 8
+        self.assertEqual([a, b, c], [{'x': 8, 'y': 2},
+                                     {'x': 3, 'y': 4, 'z': 7}, {'y': 6}])
+        self.assertEqual(self.loads('[{"x": 1, "y": 2}, {"x": 3, "y": 4}]'),
+                         [{'x': 1, 'y': 2}, {'x': 3, 'y': 4}])
+
     def test_extra_data(self):
         s = '[1, 2, 3]5'
         msg = 'Extra data'
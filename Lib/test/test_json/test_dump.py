@@ -1,4 +1,4 @@
-from io import StringIO
+from io import BytesIO, StringIO
 from test.test_json import PyTest, CTest
 
 from test.support import bigmemtest, _1G
@@ -12,6 +12,32 @@ def test_dump(self):
     def test_dumps(self):
         self.assertEqual(self.dumps({}), '{}')
 
+    def test_dump_binary(self):
+        obj = {'a': ['\xe9\u20ac\U0001f600"\\\n\x7f', 1, -2**63, 10**20, 0.5,
+                     -1e300, None, True, float('nan')], '\xe9': {}, 3: []}
+        for ensure_ascii in True, False:
+            bio = BytesIO()
+            self.json.dump(obj, bio, ensure_ascii=ensure_ascii)
+            self.assertEqual(bio.getvalue(),
+                             self.dumps(obj, ensure_ascii=ensure_ascii).encode())
+        bio = BytesIO()
+        with self.assertRaises(UnicodeEncodeError):
+            self.json.dump(['\ud800'], bio, ensure_ascii=False)
+
+    def test_dump_chunks(self):
+        # the output of a large object is written in several chunks
+        obj = [{'key': 'value %d' % i, 'n': [i, i / 2]} for i in range(10000)]
+        expected = self.dumps(obj)
+        for fp in StringIO(), BytesIO():
+            writes = []
+            write = fp.write
+            fp.write = lambda chunk: writes.append(len(chunk)) or write(chunk)
+            self.json.dump(obj, fp)
+            self.assertEqual(sum(writes), len(expected))
+            self.assertGreater(len(writes), 1)
+            self.assertEqual(fp.getvalue(), expected
+                             if isinstance(fp, StringIO) else expected.encode())
+
     def test_dump_skipkeys(self):
         v = {b'invalid_key': False, 'valid_key': True}
         with self.assertRaises(TypeError):
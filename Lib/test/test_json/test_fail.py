@@ -196,6 +196,23 @@ def test_extra_data(self):
                              '%s: line 1 column %d (char %d)' %
                              (msg, idx + 1, idx))
 
+    def test_bytes_error_position(self):
+        # Positions are character indices in the decoded document
+        test_cases = [
+            ('["\xe9t\xe9",]', 'Expecting value', 7),
+            ('{"\u65e5\u672c" 1}', "Expecting ':' delimiter", 6),
+            ('["\U0001d120", "spam', 'Unterminated string starting at', 6),
+            ('"\u20ac" "\u20ac"', 'Extra data', 4),
+            ('[\u20ac]', 'Expecting value', 1),
+        ]
+        for data, msg, idx in test_cases:
+            with self.assertRaises(self.JSONDecodeError) as cm:
+                self.loads(data.encode())
+            err = cm.exception
+            self.assertEqual(err.msg, msg)
+            self.assertEqual(err.pos, idx)
+            self.assertEqual(err.doc, data)
+
     def test_linecol(self):
         test_cases = [
             ('!', 1, 1, 0),
@@ -1,3 +1,4 @@
+import sys
 from test.test_json import CTest
 
 
@@ -22,6 +23,35 @@ class TestDecode(CTest):
     def test_make_scanner(self):
         self.assertRaises(AttributeError, self.json.scanner.c_make_scanner, 1)
 
+    def test_scan_bytes(self):
+        # The scanner also parses UTF-8 encoded bytes-like objects, with
+        # byte offsets as indices
+        scan_once = self.json.decoder.JSONDecoder().scan_once
+        doc = '[1, {"\u20ac": "\xe9\\n"}] 2'
+        self.assertEqual(scan_once(doc, 0), ([1, {'\u20ac': '\xe9\n'}], 17))
+        for conv in (bytes, bytearray, memoryview):
+            data = conv(doc.encode())
+            self.assertEqual(scan_once(data, 0),
+                             ([1, {'\u20ac': '\xe9\n'}], 20))
+            self.assertEqual(scan_once(data, 21), (2, 22))
+            with self.assertRaises(StopIteration) as cm:
+                scan_once(data, 22)
+            self.assertEqual(cm.exception.value, 22)
+        self.assertRaises(TypeError, scan_once, 1, 0)
+
+    def test_shared_keys(self):
+        # Objects with the same keys share them, like instance dicts
+        decoder = self.json.decoder.JSONDecoder()
+        decode = decoder.decode
+        rval = decode(self.dumps([{'a': i, 'b': [i]} for i in range(4)]))
+        size = sys.getsizeof(rval[-1])
+        self.assertLess(size, sys.getsizeof(rval[0]))
+        self.assertEqual([sys.getsizeof(d) for d in rval[1:]], [size] * 3)
+        # the keys are shared with the objects of the following documents
+        self.assertEqual(sys.getsizeof(decode('{"a": 5, "b": [5]}')), size)
+        rval, end = decoder.scan_once(b'{"a": 5, "b": [5]}', 0)
+        self.assertEqual(sys.getsizeof(rval), size)
+
     def test_bad_bool_args(self):
         def test(value):
             self.json.decoder.JSONDecoder(strict=BadBool()).decode(value)
@@ -68,6 +98,24 @@ def test(name):
         self.assertRaises(ZeroDivisionError, test, 'allow_nan')
         self.assertRaises(ZeroDivisionError, test, 'sort_keys')
 
+    def test_dump(self):
+        enc = self.json.encoder.c_make_encoder(
+            None, None, self.json.encoder.c_encode_basestring, None,
+            ': ', ', ', False, False, True)
+        obj = ['\xe9' * 5, 12345, [1.5]]
+        for binary in False, True:
+            chunks = []
+            self.assertIsNone(enc.dump(obj, chunks.append, binary, 4))
+            expected = '["\xe9\xe9\xe9\xe9\xe9", 12345, [1.5]]'
+            if binary:
+                expected = expected.encode()
+            # a chunk is written as soon as it reaches chunk_size
+            self.assertEqual(expected[:0].join(chunks), expected)
+            self.assertTrue(all(len(c) >= 4 for c in chunks[:-1]))
+            self.assertGreater(len(chunks), 3)
+        self.assertRaises(ValueError, enc.dump, obj, chunks.append, True, 0)
+        self.assertRaises(ZeroDivisionError, enc.dump, obj, lambda c: 1/0)
+
     def test_unsortable_keys(self):
         with self.assertRaises(TypeError):
             self.json.encoder.JSONEncoder(sort_keys=True).encode({'a': 1, 1: 'a'})
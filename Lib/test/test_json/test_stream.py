@@ -0,0 +1,175 @@
+from collections import OrderedDict
+from test.test_json import PyTest, CTest
+
+
+class TestStream:
+    def make(self, items=False, **kwargs):
+        return self.json.JSONDecoder(**kwargs).stream(items=items)
+
+    def decode_chunks(self, chunks, **kwargs):
+        dec = self.make(**kwargs)
+        result = []
+        for chunk in chunks:
+            dec.feed(chunk)
+            result.extend(dec)
+        dec.close()
+        result.extend(dec)
+        return result
+
+    def split(self, data, size):
+        return [data[i:i+size] for i in range(0, len(data), size)]
+
+    def test_values(self):
+        docs = [{'a': [1, 2.5, None]}, [], 'x"\\y', 42, -0.5, True, False,
+                None, {'\xe9€': ['\U0001d120', {}]}]
+        text = '\n'.join(self.dumps(doc) for doc in docs) + '\n'
+        for data in (text, text.encode()):
+            for size in (1, 2, 3, 7, len(data)):
+                with self.subTest(type=type(data), size=size):
+                    self.assertEqual(
+                        self.decode_chunks(self.split(data, size)), docs)
+        # non-ASCII characters
+        text = self.dumps(docs, ensure_ascii=False)
+        self.assertEqual(self.decode_chunks(self.split(text.encode(), 1)),
+                         [docs])
+
+    def test_separators(self):
+        self.assertEqual(self.decode_chunks(['{}{}[]"a""b"[1]{"c": 2}']),
+                         [{}, {}, [], 'a', 'b', [1], {'c': 2}])
+        self.assertEqual(self.decode_chunks([' \r\n1\t2\n  ', '\n3 ']),
+                         [1, 2, 3])
+        self.assertEqual(self.decode_chunks([]), [])
+        self.assertEqual(self.decode_chunks([' \n', '']), [])
+
+    def test_incremental(self):
+        dec = self.make()
+        dec.feed(b'{"a": [1, ')
+        self.assertEqual(list(dec), [])
+        dec.feed(b'2]} 12')
+        self.assertEqual(list(dec), [{'a': [1, 2]}])
+        # a number is complete at the next delimiter or at the end
+        dec.feed(b'3')
+        self.assertEqual(list(dec), [])
+        dec.feed(b' "\xc3')
+        self.assertEqual(list(dec), [123])
+        dec.feed(b'\xa9\\')
+        self.assertEqual(list(dec), [])
+        dec.feed(b'"" tru')
+        self.assertEqual(list(dec), ['\xe9"'])
+        dec.feed(b'e')
+        self.assertEqual(list(dec), [])
+        dec.close()
+        self.assertEqual(list(dec), [True])
+        self.assertEqual(list(dec), [])
+        self.assertRaises(ValueError, dec.feed, b'1')
+
+    def test_items(self):
+        data = '[1, {"a": [2, 3]}, "]", []] 4 [] [5,6]\n{"b": [7]}'
+        expected = [1, {'a': [2, 3]}, ']', [], 4, 5, 6, {'b': [7]}]
+        for size in (1, 5, len(data)):
+            self.assertEqual(
+                self.decode_chunks(self.split(data, size), items=True),
+                expected)
+
+    def test_hooks(self):
+        data = '{"a": 1.5, "b": NaN} {"c": 2}'
+        self.assertEqual(
+            self.decode_chunks([data], object_pairs_hook=OrderedDict,
+                               parse_float=str, parse_constant=str),
+            [OrderedDict([('a', '1.5'), ('b', 'NaN')]), OrderedDict(c=2)])
+        self.assertEqual(
+            self.decode_chunks([data], object_hook=len),
+            [2, 1])
+
+    def test_reentrant_hooks(self):
+        # A hook can neither feed the decoder whose input it is parsing
+        # nor iterate over it
+        seen = []
+        def hook(d):
+            for f in (lambda: dec.feed(b'[' + b'9,' * 100000 + b'9]'),
+                      lambda: next(dec)):
+                with self.assertRaises(RuntimeError):
+                    f()
+            seen.append(d)
+            return d
+        dec = self.json.JSONDecoder(object_hook=hook).stream(items=True)
+        dec.feed(b'[{"a": 1}, "' + b'x' * 100 + b'", {"b": 2}] [3]')
+        self.assertEqual(list(dec), [{'a': 1}, 'x' * 100, {'b': 2}, 3])
+        self.assertEqual(seen, [{'a': 1}, {'b': 2}])
+        # the decoder can be fed again after the hooks have returned
+        dec.feed('{"c": 4}')
+        self.assertEqual(list(dec), [{'c': 4}])
+
+    def test_invalid_value(self):
+        # an invalid value is skipped
+        dec = self.make()
+        dec.feed('[1, 2 {"a": 3}]\n"x\\q"\n4 {"b" 5}\n[6]\n')
+        with self.assertRaises(self.JSONDecodeError) as cm:
+            next(dec)
+        self.assertEqual(cm.exception.msg, "Expecting ',' delimiter")
+        self.assertEqual(cm.exception.pos, 6)
+        self.assertEqual(cm.exception.doc, '[1, 2 {"a": 3}]')
+        with self.assertRaises(self.JSONDecodeError) as cm:
+            next(dec)
+        self.assertEqual(cm.exception.doc, '"x\\q"')
+        self.assertEqual(next(dec), 4)
+        with self.assertRaises(self.JSONDecodeError) as cm:
+            next(dec)
+        self.assertEqual(cm.exception.msg, "Expecting ':' delimiter")
+        self.assertEqual(next(dec), [6])
+        self.assertEqual(list(dec), [])
+
+        for data, msg in [(']', 'Expecting value'),
+                          ('1x', 'Extra data'),
+                          ('nul', 'Expecting value'),
+                          ('[1, 2', "Expecting ',' delimiter"),
+                          ('"abc', 'Unterminated string starting at')]:
+            dec = self.make()
+            dec.feed(data)
+            dec.close()
+            with self.assertRaises(self.JSONDecodeError) as cm:
+                list(dec)
+            self.assertEqual(cm.exception.msg, msg)
+            self.assertEqual(cm.exception.doc, data)
+
+    def test_invalid_items(self):
+        dec = self.make(items=True)
+        dec.feed('[1 2] [3,] [4')
+        self.assertEqual(next(dec), 1)
+        with self.assertRaises(self.JSONDecodeError) as cm:
+            next(dec)
+        self.assertEqual(cm.exception.msg, "Expecting ',' delimiter")
+        self.assertEqual(next(dec), 2)
+        with self.assertRaises(self.JSONDecodeError) as cm:
+            next(dec)
+        self.assertEqual(cm.exception.msg, "Expecting value")
+        self.assertEqual(next(dec), 3)
+        with self.assertRaises(self.JSONDecodeError) as cm:
+            next(dec)
+        self.assertEqual(cm.exception.msg, "Expecting value")
+        self.assertEqual(list(dec), [])
+        dec.close()
+        self.assertEqual(next(dec), 4)
+        with self.assertRaises(self.JSONDecodeError) as cm:
+            next(dec)
+        self.assertEqual(cm.exception.msg, "Expecting ',' delimiter")
+        self.assertEqual(list(dec), [])
+
+    def test_invalid_utf8(self):
+        with self.assertRaises(UnicodeDecodeError):
+            self.decode_chunks([b'["\xff"]'])
+        with self.assertRaises(UnicodeDecodeError):
+            self.decode_chunks([b'1 "\xe6\x97'])
+
+    def test_stream_method(self):
+        dec = self.json.JSONDecoder().stream(items=True)
+        self.assertTrue(dec.items)
+        dec.feed('[1, 2]')
+        self.assertEqual(list(dec), [1, 2])
+
+
+class TestPyStream(TestStream, PyTest): pass
+class TestCStream(TestStream, CTest):
+    def test_c_stream_decoder(self):
+        dec = self.json.JSONDecoder().stream()
+        self.assertEqual(type(dec).__module__, '_json')
@@ -79,6 +79,31 @@ def test_bytes_decode(self):
         self.assertEqual(self.loads(b'\x007'), 7)
         self.assertEqual(self.loads(b'57'), 57)
 
+    def test_bytes_like_decode(self):
+        data = {"a\xb5": ["\u20ac", "x\n\U0001d120y", 1.5, None],
+                "\u65e5\u672c": {"\U0001d120": "\"\u00e9\\"}}
+        for ensure_ascii in (True, False):
+            encoded = self.dumps(data, ensure_ascii=ensure_ascii).encode()
+            for conv in (bytes, bytearray, memoryview):
+                self.assertEqual(self.loads(conv(encoded)), data)
+                self.assertEqual(self.loads(conv(encoded),
+                                            object_pairs_hook=list),
+                                 self.loads(encoded.decode(),
+                                            object_pairs_hook=list))
+        # multi-dimensional memoryview
+        self.assertEqual(self.loads(memoryview(b'[1, 2]').cast('B', (2, 3))),
+                         [1, 2])
+        self.assertRaises(TypeError, self.loads, memoryview(b'[1, 2]')[::2])
+        # encoded surrogates are accepted, as with the surrogatepass handler
+        self.assertEqual(self.loads(b'["\xed\xa0\xbd\\u0041"]'),
+                         ['\ud83dA'])
+        # invalid UTF-8 is reported against the whole document
+        for doc in (b'["\xe6\x97"]', b'["\xff"]', b'[1, \xff]',
+                    b'{"\xe6": 1}', b'[1, 2] \x80', b'["\\n\xc3"]'):
+            with self.assertRaises(UnicodeDecodeError) as cm:
+                self.loads(doc)
+            self.assertEqual(cm.exception.object, doc)
+
     def test_object_pairs_hook_with_unicode(self):
         s = '{"xkd":1, "kcw":2, "art":3, "hxm":4, "qrt":5, "pad":6, "hoy":7}'
         p = [("xkd", 1), ("kcw", 2), ("art", 3), ("hxm", 4),
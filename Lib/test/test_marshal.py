@@ -511,6 +511,20 @@ def testNoIntern(self):
         s2 = sys.intern(s)
         self.assertNotEqual(id(s2), id(s))
 
+    def testInternAfterRelease(self):
+        # The interned strings loaded are looked up in a cache, which must
+        # forget the strings which were released
+        for data in [marshal.dumps(sys.intern(''.join(['spam', 'eggs']))),
+                     marshal.dumps(sys.intern('spam' * 20))]:
+            for _ in range(3):
+                s = marshal.loads(data)
+                self.assertIs(sys.intern(''.join(s)), s)
+                del s
+                support.gc_collect()
+        s = marshal.loads(data)
+        self.assertIs(marshal.loads(data), s)
+        self.assertIs(marshal.loads(marshal.dumps(s)), s)
+
 @support.cpython_only
 @unittest.skipUnless(_testcapi, 'requires _testcapi')
 class CAPI_TestCase(unittest.TestCase, HelperMixin):
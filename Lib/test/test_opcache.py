@@ -1,5 +1,44 @@
+import sys
+import types
 import unittest
 
+try:
+    import _testinternalcapi
+except ImportError:
+    _testinternalcapi = None
+
+# The opcode cache is disabled in debug builds (bpo-37146)
+Py_DEBUG = hasattr(sys, 'gettotalrefcount')
+
+
+def fresh_code(func):
+    # Give func a copy of its code object without an opcode cache: the code
+    # of a nested function is shared by all its function objects, and keeps
+    # its cache when the tests are repeated.
+    func.__code__ = func.__code__.replace()
+    return func.__code__
+
+
+def enable_opcache(func):
+    # Create the opcode cache of func now rather than after 1024 calls,
+    # also in debug builds which never create it on their own.
+    if _testinternalcapi is None:
+        raise unittest.SkipTest('needs _testinternalcapi')
+    _testinternalcapi.init_opcache(fresh_code(func))
+
+
+class OpcacheTestCase(unittest.TestCase):
+
+    def assertHits(self, kind, func, *args):
+        # Check that calling func(*args) hits the cache of its instruction
+        # of the given kind.
+        stats = sys._getopcachestats(func.__code__)
+        self.assertEqual(stats['kinds'][kind]['optimized'], 1)
+        hits = sys._getopcachestats()['kinds'][kind]['hits']
+        func(*args)
+        self.assertGreater(sys._getopcachestats()['kinds'][kind]['hits'], hits)
+
+
 class TestLoadAttrCache(unittest.TestCase):
     def test_descriptor_added_after_optimization(self):
         class Descriptor:
@@ -21,3 +60,407 @@ def f(o):
         Descriptor.__set__ = lambda *args: None
 
         self.assertEqual(f(o), 2)
+
+
+class TestLoadMethodCache(OpcacheTestCase):
+
+    def test_method_redefined_on_class(self):
+        class C:
+            def f(self):
+                return 1
+
+        def call(o):
+            return o.f()
+
+        c = C()
+        enable_opcache(call)
+        for _ in range(1025):
+            self.assertEqual(call(c), 1)
+        self.assertHits('LOAD_METHOD', call, c)
+        C.f = lambda self: 2
+        self.assertEqual(call(c), 2)
+        del C.f
+        with self.assertRaises(AttributeError):
+            call(c)
+
+    def test_method_redefined_on_base_class(self):
+        class A:
+            def f(self):
+                return 1
+
+        class B(A):
+            pass
+
+        def call(o):
+            return o.f()
+
+        b = B()
+        enable_opcache(call)
+        for _ in range(1025):
+            self.assertEqual(call(b), 1)
+        self.assertHits('LOAD_METHOD', call, b)
+        A.f = lambda self: 2
+        self.assertEqual(call(b), 2)
+
+    def test_shadowed_by_instance_attribute(self):
+        class C:
+            def f(self):
+                return 1
+
+        def call(o):
+            return o.f()
+
+        c = C()
+        enable_opcache(call)
+        for _ in range(1025):
+            self.assertEqual(call(c), 1)
+        self.assertHits('LOAD_METHOD', call, c)
+        c.f = lambda: 2
+        self.assertEqual(call(c), 2)
+        del c.f
+        self.assertEqual(call(c), 1)
+
+    def test_polymorphic_receivers(self):
+        class A:
+            def f(self):
+                return 'A'
+
+        class B:
+            def f(self):
+                return 'B'
+
+        def call(o):
+            return o.f()
+
+        objs = [A(), B(), [], A()]
+        enable_opcache(call)
+        for _ in range(1025):
+            self.assertEqual(call(objs[0]), 'A')
+            self.assertEqual(call(objs[1]), 'B')
+        for _ in range(1025):
+            self.assertEqual([call(o) for o in objs[:2]], ['A', 'B'])
+
+    def test_class_assignment(self):
+        class A:
+            def f(self):
+                return 'A'
+
+        class B:
+            def f(self):
+                return 'B'
+
+        def call(o):
+            return o.f()
+
+        o = A()
+        enable_opcache(call)
+        for _ in range(1025):
+            self.assertEqual(call(o), 'A')
+        self.assertHits('LOAD_METHOD', call, o)
+        o.__class__ = B
+        self.assertEqual(call(o), 'B')
+
+    def test_module_attribute(self):
+        mod = types.ModuleType('mod')
+        mod.f = lambda: 1
+
+        def call():
+            return mod.f()
+
+        enable_opcache(call)
+        for _ in range(1025):
+            self.assertEqual(call(), 1)
+        self.assertHits('LOAD_METHOD', call)
+        mod.f = lambda: 2
+        self.assertEqual(call(), 2)
+        del mod.f
+        with self.assertRaises(AttributeError):
+            call()
+        mod.__getattr__ = lambda name: lambda: 3
+        self.assertEqual(call(), 3)
+
+    def test_different_modules(self):
+        mod1 = types.ModuleType('mod1')
+        mod1.f = lambda: 1
+        mod2 = types.ModuleType('mod2')
+        mod2.f = lambda: 2
+
+        def call(m):
+            return m.f()
+
+        enable_opcache(call)
+        for _ in range(1025):
+            self.assertEqual(call(mod1), 1)
+        self.assertHits('LOAD_METHOD', call, mod1)
+        self.assertEqual(call(mod2), 2)
+
+
+class TestStoreAttrCache(OpcacheTestCase):
+
+    def test_slots(self):
+        class C:
+            __slots__ = ('a', 'b')
+
+        def store(o, v):
+            o.a = v
+
+        c = C()
+        enable_opcache(store)
+        for i in range(1025):
+            store(c, i)
+            self.assertEqual(c.a, i)
+        self.assertHits('STORE_ATTR', store, c, -1)
+        C.a = property(lambda self: 'prop', lambda self, v: None)
+        store(c, 'x')
+        self.assertEqual(c.a, 'prop')
+
+    def test_other_members(self):
+        class C:
+            __slots__ = ('a',)
+
+        def store(o, v):
+            o.__doc__ = v
+
+        def store_func(o, v):
+            o.__module__ = v
+
+        f = lambda: None
+        enable_opcache(store_func)
+        enable_opcache(store)
+        for i in range(1025):
+            store_func(f, str(i))
+        self.assertEqual(f.__module__, str(1024))
+        for _ in range(1025):
+            with self.assertRaises(AttributeError):
+                store(C(), 'x')
+
+    def test_instance_dict(self):
+        class C:
+            pass
+
+        def store(o, v):
+            o.a = v
+
+        c = C()
+        enable_opcache(store)
+        for i in range(1025):
+            store(c, i)
+            self.assertEqual(c.a, i)
+        self.assertHits('STORE_ATTR', store, c, -1)
+        c.__dict__ = {'b': 1}
+        store(c, 'x')
+        self.assertEqual(c.__dict__, {'b': 1, 'a': 'x'})
+        d = C()
+        store(d, 'y')
+        self.assertEqual(d.a, 'y')
+        self.assertEqual(c.a, 'x')
+
+    def test_data_descriptor_added(self):
+        class C:
+            pass
+
+        def store(o, v):
+            o.a = v
+
+        c = C()
+        enable_opcache(store)
+        for i in range(1025):
+            store(c, i)
+        self.assertHits('STORE_ATTR', store, c, 1024)
+        stored = []
+        C.a = property(lambda self: 'prop', lambda self, v: stored.append(v))
+        store(c, 'x')
+        self.assertEqual(stored, ['x'])
+        self.assertEqual(c.__dict__['a'], 1024)
+
+    def test_old_value_released(self):
+        class C:
+            __slots__ = ('a',)
+
+        class D:
+            pass
+
+        class Tracked:
+            count = 0
+            def __init__(self):
+                Tracked.count += 1
+            def __del__(self):
+                Tracked.count -= 1
+
+        def store(o, v):
+            o.a = v
+
+        objs = [C(), D()]
+        enable_opcache(store)
+        for _ in range(1025):
+            for o in objs:
+                store(o, Tracked())
+        self.assertEqual(Tracked.count, 2)
+        del objs, o
+        self.assertEqual(Tracked.count, 0)
+
+
+class TestBinarySubscr(unittest.TestCase):
+
+    def test_list_and_tuple(self):
+        def get(seq, i):
+            return seq[i]
+
+        for seq in ([1, 2, 3], (1, 2, 3)):
+            for _ in range(1025):
+                self.assertEqual(get(seq, 0), 1)
+                self.assertEqual(get(seq, -1), 3)
+            for i in (3, -4, 2**70, -2**70):
+                with self.assertRaises(IndexError):
+                    get(seq, i)
+            self.assertEqual(get(seq, True), 2)
+            self.assertEqual(get(seq, slice(1, None)), seq[1:])
+
+    def test_dict(self):
+        def get(d, k):
+            return d[k]
+
+        d = {'a': 1, 2: 'b'}
+        for _ in range(1025):
+            self.assertEqual(get(d, 'a'), 1)
+            self.assertEqual(get(d, 2), 'b')
+        with self.assertRaises(KeyError) as cm:
+            get(d, (1,))
+        self.assertEqual(cm.exception.args, ((1,),))
+        with self.assertRaises(TypeError):
+            get(d, [])
+
+        class Missing(dict):
+            def __missing__(self, key):
+                return key * 2
+
+        self.assertEqual(get(Missing(), 'x'), 'xx')
+
+    def test_subclasses(self):
+        class L(list):
+            def __getitem__(self, i):
+                return 'L'
+
+        def get(seq, i):
+            return seq[i]
+
+        for _ in range(1025):
+            self.assertEqual(get([0], 0), 0)
+        self.assertEqual(get(L([0]), 0), 'L')
+
+
+class TestStats(unittest.TestCase):
+
+    def test_global_stats(self):
+        class C:
+            def __init__(self):
+                self.x = 0
+                self.y = 1
+            def m(self):
+                return self.x
+
+        def f(o):
+            o.x = len(o.__dict__) + o.y
+            return o.m()
+
+        enable_opcache(f)
+        before = sys._getopcachestats()
+        o = C()
+        for i in range(10):
+            f(o)
+        after = sys._getopcachestats()
+        self.assertGreaterEqual(after['code_objects'], 1)
+        self.assertGreater(after['memory'], 0)
+        for kind in ('LOAD_GLOBAL', 'LOAD_ATTR', 'LOAD_METHOD', 'STORE_ATTR'):
+            with self.subTest(kind=kind):
+                self.assertGreater(after['kinds'][kind]['hits'],
+                                   before['kinds'][kind]['hits'])
+                self.assertGreater(after['kinds'][kind]['entries'], 0)
+                self.assertGreater(after['kinds'][kind]['memory'], 0)
+
+    def test_code_stats(self):
+        class C:
+            def m(self):
+                pass
+
+        def f(o):
+            o.m()
+            return o.x
+
+        code = fresh_code(f)
+        stats = sys._getopcachestats(code)
+        self.assertFalse(stats['enabled'])
+        self.assertEqual(stats['memory'], 0)
+
+        o = C()
+        o.x = 1
+        enable_opcache(f)
+        code = f.__code__
+        for i in range(10):
+            f(o)
+        stats = sys._getopcachestats(code)
+        self.assertTrue(stats['enabled'])
+        self.assertGreater(stats['memory'], 0)
+        self.assertEqual(stats['kinds']['LOAD_METHOD']['optimized'], 1)
+        self.assertEqual(stats['kinds']['LOAD_ATTR']['optimized'], 1)
+        self.assertEqual(stats['kinds']['STORE_ATTR']['entries'], 0)
+        for kind in ('LOAD_METHOD', 'LOAD_ATTR'):
+            with self.subTest(kind=kind):
+                self.assertEqual(stats['kinds'][kind]['opts'], 1)
+                self.assertEqual(stats['kinds'][kind]['hits'], 9)
+                self.assertEqual(stats['kinds'][kind]['misses'], 0)
+                self.assertEqual(stats['kinds'][kind]['deopts'], 0)
+        self.assertEqual(stats['kinds']['STORE_ATTR']['hits'], 0)
+
+        # An attribute which keeps disappearing deoptimizes LOAD_ATTR
+        class D:
+            x = 2
+            def m(self):
+                pass
+        for i in range(30):
+            f(o if i % 2 else D())
+        stats = sys._getopcachestats(code)
+        self.assertEqual(stats['kinds']['LOAD_ATTR']['deoptimized'], 1)
+        self.assertEqual(stats['kinds']['LOAD_ATTR']['deopts'], 1)
+        self.assertGreater(stats['kinds']['LOAD_ATTR']['misses'], 0)
+
+        with self.assertRaises(TypeError):
+            sys._getopcachestats(f)
+
+    @unittest.skipIf(Py_DEBUG, 'the opcode cache is disabled in debug builds')
+    def test_enabled_after_runs(self):
+        def f():
+            return len
+
+        code = fresh_code(f)
+        for i in range(1023):
+            f()
+        stats = sys._getopcachestats(code)
+        self.assertEqual(stats['runs'], 1023)
+        self.assertFalse(stats['enabled'])
+        f()
+        stats = sys._getopcachestats(code)
+        self.assertEqual(stats['runs'], 1024)
+        self.assertTrue(stats['enabled'])
+        self.assertEqual(stats['kinds']['LOAD_GLOBAL']['entries'], 1)
+
+    def test_load_method_deopt_counted_once(self):
+        # An instruction which never gets cached is not counted as a deopt
+        def f(o):
+            return o.m()
+
+        class C:
+            def __getattribute__(self, name):
+                return lambda: 1
+
+        enable_opcache(f)
+        before = sys._getopcachestats()['kinds']['LOAD_METHOD']['deopts']
+        f(C())
+        stats = sys._getopcachestats(f.__code__)
+        self.assertEqual(stats['kinds']['LOAD_METHOD']['deoptimized'], 1)
+        self.assertEqual(sys._getopcachestats()['kinds']['LOAD_METHOD']['deopts'],
+                         before)
+
+
+if __name__ == "__main__":
+    unittest.main()
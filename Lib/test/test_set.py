@@ -481,6 +481,41 @@ def test_update(self):
                 self.assertEqual(s.update(C(p), C(q)), None)
                 self.assertEqual(s, set(s) | set(p) | set(q))
 
+    def test_update_from_sequence(self):
+        # The keys of lists and tuples are hashed and probed in batches.
+        # Keys with a __hash__ method must still be hashed after the keys
+        # before them were added.
+        sizes = []
+        class Key:
+            def __init__(self, fail=False):
+                self.fail = fail
+            def __hash__(self):
+                sizes.append(len(s))
+                if self.fail:
+                    raise PassThru
+                return 1
+        keys = [*range(40), Key(), *map(str, range(40)), Key(), 1.5, b'x']
+        for C in list, tuple:
+            s = self.thetype()
+            sizes.clear()
+            s.update(C(keys))
+            self.assertEqual(sizes, [40, 81])
+            self.assertEqual(s, set(keys))
+            s = self.thetype()
+            self.assertRaises(PassThru, s.update, C([*range(40), Key(True), 40]))
+            self.assertEqual(s, set(range(40)))
+        big = self.thetype(range(0, 1000, 2))
+        items = [*range(100), Key(), *map(float, range(100)), 'a', b'b']
+        expected = set(range(0, 100, 2))
+        for C in list, tuple:
+            self.assertEqual(big.intersection(C(items)), expected)
+            self.assertFalse(big.isdisjoint(C(items)))
+            self.assertTrue(big.isdisjoint(C(items[1:100:2])))
+            self.assertEqual(big.difference(C(items)), set(range(100, 1000, 2)))
+            self.assertRaises(PassThru, big.intersection, C([1, Key(True)]))
+            self.assertRaises(PassThru, big.isdisjoint, C([1, Key(True)]))
+            self.assertRaises(PassThru, big.difference, C([1, Key(True)]))
+
     def test_ior(self):
         self.s |= set(self.otherword)
         for c in (self.word + self.otherword):
@@ -362,6 +362,51 @@ def test_unsafe_float_compare(self):
         check_against_PyObject_RichCompareBool(self, [float(x) for
                                                       x in range(100)])
 
+    def test_radix_sort(self):
+        # Large lists of floats and small ints without long runs are sorted
+        # by radix, which must give the same results.
+        random.seed(0)
+        floats = [random.uniform(-1e6, 1e6) for _ in range(1000)]
+        floats += [0.0, -0.0, 5e-324, -5e-324, 1e308, float('inf'),
+                   float('-inf')] * 50
+        floats += [float(x) for x in range(-500, 500)] * 2
+        check_against_PyObject_RichCompareBool(self, floats)
+        check_against_PyObject_RichCompareBool(self, floats + [float('nan')])
+        ints = [random.randrange(-2**30 + 1, 2**30) for _ in range(1000)]
+        ints += [2**30 - 1, -2**30 + 1, 0] * 50
+        ints += [int(str(x)) for x in range(-1000, 1000)] * 2
+        check_against_PyObject_RichCompareBool(self, ints)
+
+        for keys in floats, ints:
+            data = [(random.choice(keys), i) for i in range(2000)]
+            for reverse in False, True:
+                result = sorted(data, key=lambda t: t[0], reverse=reverse)
+                self.assertEqual(result,
+                    sorted(data, key=lambda t: (-t[0] if reverse else t[0],
+                                                t[1])))
+        data = [(random.choice([0.0, -0.0, 1.0]), i) for i in range(2000)]
+        self.assertEqual(sorted(data, key=lambda t: t[0]), sorted(data))
+
+    def test_threads(self):
+        # Large lists of floats, small ints and Latin-1 strings are sorted by
+        # several threads, with the same result.
+        random.seed(0)
+        n = 150000
+        lists = [[random.random() for _ in range(n)],
+                 [random.randrange(-n, n) for _ in range(n)],
+                 [str(random.randrange(n)) for _ in range(n)],
+                 [random.random() for _ in range(n)] + [float('nan')],
+                 [(random.random(),) for _ in range(n)]]
+        for L in lists:
+            for threads, reverse in (2, False), (3, True), (100, False):
+                result = sorted(L, threads=threads, reverse=reverse)
+                for x, y in zip(result, sorted(L, reverse=reverse)):
+                    self.assertIs(x, y)
+        data = [(random.randrange(100), i) for i in range(n)]
+        self.assertEqual(sorted(data, key=lambda t: t[0], threads=4),
+                         sorted(data))
+        self.assertRaises(ValueError, [].sort, threads=0)
+
     def test_unsafe_tuple_compare(self):
         # This test was suggested by Tim Peters. It verifies that the tuple
         # comparison respects the current tuple compare semantics, which do not
@@ -204,6 +204,47 @@ def test_switchinterval(self):
         finally:
             sys.setswitchinterval(orig)
 
+    def test_switchpolicy(self):
+        self.assertRaises(TypeError, sys.setswitchpolicy)
+        self.assertRaises(TypeError, sys.setswitchpolicy, 1)
+        self.assertRaises(ValueError, sys.setswitchpolicy, "fifo")
+        orig = sys.getswitchpolicy()
+        self.assertEqual(orig, "interval")
+        try:
+            for policy in "io_priority", "interval":
+                sys.setswitchpolicy(policy)
+                self.assertEqual(sys.getswitchpolicy(), policy)
+        finally:
+            sys.setswitchpolicy(orig)
+
+    @threading_helper.reap_threads
+    def test_switchpolicy_io_priority(self):
+        # A thread returning from a blocking call gets the GIL back from a
+        # CPU-bound thread without waiting for the switch interval.
+        import threading
+        import time
+
+        orig_interval = sys.getswitchinterval()
+        orig_policy = sys.getswitchpolicy()
+        stop = False
+        def spin():
+            while not stop:
+                pass
+        t = threading.Thread(target=spin)
+        try:
+            sys.setswitchinterval(1.0)
+            sys.setswitchpolicy("io_priority")
+            t.start()
+            start = time.monotonic()
+            for i in range(5):
+                time.sleep(0.001)
+            self.assertLess(time.monotonic() - start, 1.0)
+        finally:
+            stop = True
+            t.join()
+            sys.setswitchinterval(orig_interval)
+            sys.setswitchpolicy(orig_policy)
+
     def test_recursionlimit(self):
         self.assertRaises(TypeError, sys.getrecursionlimit, 42)
         oldlimit = sys.getrecursionlimit()
@@ -334,6 +375,50 @@ def test_getframe(self):
             is sys._getframe().f_code
         )
 
+    @threading_helper.reap_threads
+    def test_getgilstats(self):
+        import threading
+        import time
+
+        stats = sys._getgilstats()
+        main_stats = stats[threading.get_ident()]
+        self.assertEqual(set(main_stats), {'acquisitions', 'contended',
+                                           'forced_switches', 'wait_time',
+                                           'max_wait_time', 'hold_time'})
+        self.assertGreaterEqual(main_stats['acquisitions'], 1)
+
+        # A thread spinning while another one sleeps is asked to release
+        # the GIL, and the sleeping thread waits for it.
+        stop = False
+        ready = threading.Event()
+        thread_stats = {}
+        def spin():
+            ready.set()
+            while not stop:
+                pass
+            thread_stats.update(sys._getgilstats()[threading.get_ident()])
+        orig = sys.getswitchinterval()
+        sys.setswitchinterval(0.0001)
+        try:
+            t = threading.Thread(target=spin)
+            t.start()
+            ready.wait()
+            for i in range(10):
+                time.sleep(0.001)
+            stop = True
+            t.join()
+        finally:
+            sys.setswitchinterval(orig)
+        self.assertNotIn(t.ident, sys._getgilstats())
+        self.assertGreater(thread_stats['forced_switches'], 0)
+        self.assertGreater(thread_stats['hold_time'], 0)
+
+        after = sys._getgilstats()[threading.get_ident()]
+        self.assertGreater(after['acquisitions'], main_stats['acquisitions'])
+        self.assertGreater(after['contended'], main_stats['contended'])
+        self.assertGreater(after['wait_time'], main_stats['wait_time'])
+        self.assertGreaterEqual(after['wait_time'], after['max_wait_time'])
+
     # sys._current_frames() is a CPython-only gimmick.
     @threading_helper.reap_threads
     def test_current_frames(self):
@@ -824,6 +909,17 @@ def test_debugmallocstats(self):
         # The function has no parameter
         self.assertRaises(TypeError, sys._debugmallocstats, True)
 
+    @unittest.skipUnless(support.with_pymalloc(), 'need pymalloc')
+    def test_debugmallocstats_hugepages(self):
+        from test.support.script_helper import assert_python_ok
+        code = 'import sys; sys._debugmallocstats()'
+        ret, out, err = assert_python_ok('-c', code)
+        self.assertIn(b" * 262144 bytes/arena", err)
+        ret, out, err = assert_python_ok('-X', 'hugepages', '-c', code)
+        self.assertIn(b" * 2097152 bytes/arena", err)
+        ret, out, err = assert_python_ok('-c', code, PYTHONHUGEPAGES='1')
+        self.assertIn(b" * 2097152 bytes/arena", err)
+
     @unittest.skipUnless(hasattr(sys, "getallocatedblocks"),
                          "sys.getallocatedblocks unavailable on this build")
     def test_getallocatedblocks(self):
@@ -865,6 +961,27 @@ def test_getallocatedblocks(self):
         c = sys.getallocatedblocks()
         self.assertIn(c, range(b - 50, b + 50))
 
+    @threading_helper.reap_threads
+    def test_getallocatedblocks_threads(self):
+        # Blocks freed by other threads (and possibly cached by them) must
+        # not be reported as allocated.
+        import threading
+
+        def work():
+            for i in range(1000):
+                objs = [(i, i), str(i), {i: i}, [i] * 10]
+                del objs
+
+        gc.collect()
+        a = sys.getallocatedblocks()
+        threads = [threading.Thread(target=work) for _ in range(5)]
+        with threading_helper.start_threads(threads):
+            pass
+        del threads
+        gc.collect()
+        b = sys.getallocatedblocks()
+        self.assertIn(b, range(a - 50, a + 50))
+
     def test_is_finalizing(self):
         self.assertIs(sys.is_finalizing(), False)
         # Don't use the atexit module because _Py_Finalizing is only set
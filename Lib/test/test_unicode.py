@@ -1769,6 +1769,37 @@ def test_utf8_decode_invalid_sequences(self):
             self.assertRaises(UnicodeDecodeError,
                               (b'\xF4'+cb+b'\xBF\xBF').decode, 'utf-8')
 
+    def test_utf8_decode_runs(self):
+        # Runs of 2- and 3-byte sequences are decoded by a fast path:
+        # check that it stops at invalid, out-of-range and truncated
+        # sequences at every position
+        for run in ('\xe9', '\u0434', '\u07ff', '\u0800', '\u65e5',
+                    '\ud7ff', '\ue000', '\uffff'):
+            width = len(run.encode('utf-8'))
+            for n in range(1, 10):
+                text = run * n
+                data = text.encode('utf-8')
+                self.assertEqual(data.decode('utf-8'), text)
+                self.assertEqual(('a' + text + 'b').encode('utf-8')
+                                 .decode('utf-8'), 'a' + text + 'b')
+                for bad in (b'\x80', b'\xc0\x80', b'\xe0\x80\x80',
+                            b'\xed\xa0\x80', b'\xff'):
+                    for i in range(n + 1):
+                        seq = data[:i*width] + bad + data[i*width:]
+                        with self.assertRaises(UnicodeDecodeError) as cm:
+                            seq.decode('utf-8')
+                        self.assertEqual(cm.exception.start, i*width)
+                        self.assertEqual(seq.decode('utf-8', 'replace'),
+                                         text[:i] + '\ufffd' * len(bad) +
+                                         text[i:])
+                # truncated sequence at the end
+                self.assertRaises(UnicodeDecodeError,
+                                  data[:-1].decode, 'utf-8')
+                # wider characters after the run
+                for wide in ('\u0100', '\u20ac', '\U0001f600'):
+                    self.assertEqual((text + wide + text).encode('utf-8')
+                                     .decode('utf-8'), text + wide + text)
+
     def test_issue8271(self):
         # Issue #8271: during the decoding of an invalid UTF-8 byte sequence,
         # only the start byte and the continuation byte(s) are now considered
@@ -14,6 +14,7 @@
 
 typedef struct {
     PyObject *PyScannerType;
+    PyObject *PyStreamDecoderType;
     PyObject *PyEncoderType;
 } _jsonmodulestate;
 
@@ -26,6 +27,12 @@ get_json_state(PyObject *module)
 }
 
 
+/* Objects with at most JSON_SHAPE_MAX_KEYS keys are built as key-sharing
+   dicts.  The shared keys of recently decoded objects are cached in the
+   scanner, indexed by a hash of their key sequence. */
+#define JSON_SHAPE_MAX_KEYS 16
+#define JSON_SHAPE_CACHE_SIZE 64
+
 typedef struct _PyScannerObject {
     PyObject_HEAD
     signed char strict;
@@ -35,6 +42,8 @@ typedef struct _PyScannerObject {
     PyObject *parse_int;
     PyObject *parse_constant;
     PyObject *memo;
+    Py_hash_t shape_hashes[JSON_SHAPE_CACHE_SIZE];
+    PyDictKeysObject *shapes[JSON_SHAPE_CACHE_SIZE];
 } PyScannerObject;
 
 static PyMemberDef scanner_members[] = {
@@ -61,6 +70,23 @@ typedef struct _PyEncoderObject {
     PyCFunction fast_encode;
 } PyEncoderObject;
 
+#define JSON_DUMP_CHUNK_SIZE 65536
+
+/* The output of the encoder: the list of str pieces returned by
+   encoder_call(), or the chunks passed to the write() method of a stream by
+   encoder_dump().  A binary stream gets UTF-8 encoded bytes, which are
+   produced directly in buf. */
+typedef struct {
+    _PyAccu acc;
+    PyObject *write;
+    int binary;
+    Py_ssize_t chunk_size;
+    _PyUnicodeWriter writer;
+    char *buf;
+    Py_ssize_t len;
+    Py_ssize_t allocated;
+} encoder_output;
+
 static PyMemberDef encoder_members[] = {
     {"markers", T_OBJECT, offsetof(PyEncoderObject, markers), READONLY, "markers"},
     {"default", T_OBJECT, offsetof(PyEncoderObject, defaultfn), READONLY, "default"},
@@ -82,6 +108,8 @@ py_encode_basestring_ascii(PyObject* Py_UNUSED(self), PyObject *pystr);
 static PyObject *
 scan_once_unicode(PyScannerObject *s, PyObject *pystr, Py_ssize_t idx, Py_ssize_t *next_idx_ptr);
 static PyObject *
+scan_once_bytes(PyScannerObject *s, const char *str, Py_ssize_t length, Py_ssize_t idx, Py_ssize_t *next_idx_ptr);
+static PyObject *
 _build_rval_index_tuple(PyObject *rval, Py_ssize_t idx);
 static PyObject *
 scanner_new(PyTypeObject *type, PyObject *args, PyObject *kwds);
@@ -96,11 +124,11 @@ encoder_dealloc(PyObject *self);
 static int
 encoder_clear(PyEncoderObject *self);
 static int
-encoder_listencode_list(PyEncoderObject *s, _PyAccu *acc, PyObject *seq, Py_ssize_t indent_level);
+encoder_listencode_list(PyEncoderObject *s, encoder_output *out, PyObject *seq, Py_ssize_t indent_level);
 static int
-encoder_listencode_obj(PyEncoderObject *s, _PyAccu *acc, PyObject *obj, Py_ssize_t indent_level);
+encoder_listencode_obj(PyEncoderObject *s, encoder_output *out, PyObject *obj, Py_ssize_t indent_level);
 static int
-encoder_listencode_dict(PyEncoderObject *s, _PyAccu *acc, PyObject *dct, Py_ssize_t indent_level);
+encoder_listencode_dict(PyEncoderObject *s, encoder_output *out, PyObject *dct, Py_ssize_t indent_level);
 static PyObject *
 _encoded_const(PyObject *obj);
 static void
@@ -669,9 +697,132 @@ scanner_clear(PyScannerObject *self)
     Py_CLEAR(self->parse_int);
     Py_CLEAR(self->parse_constant);
     Py_CLEAR(self->memo);
+    for (int i = 0; i < JSON_SHAPE_CACHE_SIZE; i++) {
+        if (self->shapes[i] != NULL) {
+            _PyDictKeys_DecRef(self->shapes[i]);
+            self->shapes[i] = NULL;
+        }
+    }
     return 0;
 }
 
+/* Collects the members of a JSON object.  The dict is only created once
+   the object is complete, so that it can share the keys of a previous
+   object with the same key sequence. */
+typedef struct {
+    Py_ssize_t len;
+    PyObject *dict;     /* set once there are too many keys to share */
+    PyObject *keys[JSON_SHAPE_MAX_KEYS];
+    PyObject *values[JSON_SHAPE_MAX_KEYS];
+} object_builder;
+
+static void
+object_builder_clear(object_builder *b)
+{
+    for (Py_ssize_t i = 0; i < b->len; i++) {
+        Py_DECREF(b->keys[i]);
+        Py_DECREF(b->values[i]);
+    }
+    b->len = 0;
+    Py_CLEAR(b->dict);
+}
+
+static PyObject *
+object_builder_to_dict(object_builder *b)
+{
+    PyObject *rval = _PyDict_NewPresized(b->len);
+    if (rval == NULL)
+        return NULL;
+    for (Py_ssize_t i = 0; i < b->len; i++) {
+        if (PyDict_SetItem(rval, b->keys[i], b->values[i]) < 0) {
+            Py_DECREF(rval);
+            return NULL;
+        }
+    }
+    object_builder_clear(b);
+    return rval;
+}
+
+static int
+object_builder_add(object_builder *b, PyObject *key, PyObject *val)
+{
+    if (b->dict == NULL) {
+        if (b->len < JSON_SHAPE_MAX_KEYS) {
+            Py_INCREF(key);
+            Py_INCREF(val);
+            b->keys[b->len] = key;
+            b->values[b->len] = val;
+            b->len++;
+            return 0;
+        }
+        b->dict = object_builder_to_dict(b);
+        if (b->dict == NULL)
+            return -1;
+    }
+    return PyDict_SetItem(b->dict, key, val);
+}
+
+static PyObject *
+object_builder_finish(PyScannerObject *s, object_builder *b)
+{
+    /* Return a new dict holding the members collected by b and clear b.
+
+    A key sequence is made shared the second time it hashes to an empty or
+    stale cache slot, so that objects with unique keys don't evict the
+    shapes of the records around them.
+    */
+    PyObject *rval;
+    PyDictKeysObject *shape;
+    Py_uhash_t hash;
+    Py_ssize_t i, n = b->len;
+
+    if (b->dict != NULL) {
+        rval = b->dict;
+        b->dict = NULL;
+        return rval;
+    }
+    if (n == 0)
+        return PyDict_New();
+
+    /* keys come from the memo, so their hash is already computed */
+    hash = (Py_uhash_t)n;
+    for (i = 0; i < n; i++) {
+        hash = (hash * 1000003) ^ (Py_uhash_t)((PyASCIIObject *)b->keys[i])->hash;
+    }
+    i = (Py_ssize_t)((hash ^ (hash >> 16)) & (JSON_SHAPE_CACHE_SIZE - 1));
+
+    shape = s->shapes[i];
+    if (shape != NULL && _PyDictKeys_Match(shape, b->keys, n)) {
+        rval = _PyDict_FromSharedKeys(shape, b->values);
+        object_builder_clear(b);
+        return rval;
+    }
+
+    rval = object_builder_to_dict(b);
+    if (rval == NULL)
+        return NULL;
+    if (s->shape_hashes[i] != (Py_hash_t)hash) {
+        s->shape_hashes[i] = (Py_hash_t)hash;
+        return rval;
+    }
+    if (PyDict_GET_SIZE(rval) != n) {
+        /* duplicate keys */
+        return rval;
+    }
+    shape = _PyDict_MakeKeysShared(rval);
+    if (shape == NULL) {
+        if (PyErr_Occurred()) {
+            Py_DECREF(rval);
+            return NULL;
+        }
+        return rval;
+    }
+    if (s->shapes[i] != NULL)
+        _PyDictKeys_DecRef(s->shapes[i]);
+    s->shapes[i] = shape;
+    return rval;
+}
+
 static PyObject *
 _parse_object_unicode(PyScannerObject *s, PyObject *pystr, Py_ssize_t idx, Py_ssize_t *next_idx_ptr)
 {
@@ -688,6 +839,7 @@ _parse_object_unicode(PyScannerObject *s, PyObject *pystr, Py_ssize_t idx, Py_ss
     PyObject *val = NULL;
     PyObject *rval = NULL;
     PyObject *key = NULL;
+    object_builder builder;
     int has_pairs_hook = (s->object_pairs_hook != Py_None);
     Py_ssize_t next_idx;
 
@@ -698,12 +850,13 @@ _parse_object_unicode(PyScannerObject *s, PyObject *pystr, Py_ssize_t idx, Py_ss
     kind = PyUnicode_KIND(pystr);
     end_idx = PyUnicode_GET_LENGTH(pystr) - 1;
 
-    if (has_pairs_hook)
+    builder.len = 0;
+    builder.dict = NULL;
+    if (has_pairs_hook) {
         rval = PyList_New(0);
-    else
-        rval = PyDict_New();
-    if (rval == NULL)
-        return NULL;
+        if (rval == NULL)
+            return NULL;
+    }
 
     /* skip whitespace after { */
     while (idx <= end_idx && IS_WHITESPACE(PyUnicode_READ(kind,str, idx))) idx++;
@@ -757,7 +910,7 @@ _parse_object_unicode(PyScannerObject *s, PyObject *pystr, Py_ssize_t idx, Py_ss
                 Py_DECREF(item);
             }
             else {
-                if (PyDict_SetItem(rval, key, val) < 0)
+                if (object_builder_add(&builder, key, val) < 0)
                     goto bail;
                 Py_CLEAR(key);
                 Py_CLEAR(val);
@@ -789,6 +942,10 @@ _parse_object_unicode(PyScannerObject *s, PyObject *pystr, Py_ssize_t idx, Py_ss
         return val;
     }
 
+    rval = object_builder_finish(s, &builder);
+    if (rval == NULL)
+        return NULL;
+
     /* if object_hook is not None: rval = object_hook(rval) */
     if (s->object_hook != Py_None) {
         val = PyObject_CallOneArg(s->object_hook, rval);
@@ -797,6 +954,7 @@ _parse_object_unicode(PyScannerObject *s, PyObject *pystr, Py_ssize_t idx, Py_ss
     }
     return rval;
 bail:
+    object_builder_clear(&builder);
     Py_XDECREF(key);
     Py_XDECREF(val);
     Py_XDECREF(rval);
@@ -1133,178 +1291,1224 @@ scan_once_unicode(PyScannerObject *s, PyObject *pystr, Py_ssize_t idx, Py_ssize_
     return _match_number_unicode(s, pystr, idx, next_idx_ptr);
 }
 
-static PyObject *
-scanner_call(PyScannerObject *self, PyObject *args, PyObject *kwds)
-{
-    /* Python callable interface to scan_once_{str,unicode} */
-    PyObject *pystr;
-    PyObject *rval;
-    Py_ssize_t idx;
-    Py_ssize_t next_idx = -1;
-    static char *kwlist[] = {"string", "idx", NULL};
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "On:scan_once", kwlist, &pystr, &idx))
-        return NULL;
+/* The functions below scan a UTF-8 encoded document from a bytes-like
+   object, so that json.loads() does not have to decode the whole document
+   before parsing it.  Only keys and string values are decoded, and indices
+   are byte offsets. */
 
-    if (PyUnicode_Check(pystr)) {
-        rval = scan_once_unicode(self, pystr, idx, &next_idx);
-    }
-    else {
-        PyErr_Format(PyExc_TypeError,
-                 "first argument must be a string, not %.80s",
-                 Py_TYPE(pystr)->tp_name);
-        return NULL;
+static void
+raise_errmsg_bytes(const char *msg, const char *str, Py_ssize_t len, Py_ssize_t end)
+{
+    /* Report an error as if the document had been decoded before being
+       parsed: raise UnicodeDecodeError if it is not valid UTF-8, else a
+       JSONDecodeError with the index of the character at byte offset end. */
+    PyObject *doc;
+    Py_ssize_t i, pos = 0;
+
+    doc = PyUnicode_DecodeUTF8(str, len, "surrogatepass");
+    if (doc == NULL)
+        return;
+    for (i = 0; i < end; i++) {
+        /* count all bytes but continuation bytes */
+        pos += (((unsigned char)str[i] & 0xC0) != 0x80);
     }
-    PyDict_Clear(self->memo);
-    if (rval == NULL)
-        return NULL;
-    return _build_rval_index_tuple(rval, next_idx);
+    raise_errmsg(msg, doc, pos);
+    Py_DECREF(doc);
 }
 
 static PyObject *
-scanner_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+decode_chunk_bytes(const char *str, Py_ssize_t len, Py_ssize_t start, Py_ssize_t end, int is_ascii)
 {
-    PyScannerObject *s;
-    PyObject *ctx;
-    PyObject *strict;
-    static char *kwlist[] = {"context", NULL};
-
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O:make_scanner", kwlist, &ctx))
-        return NULL;
+    /* Decode str[start:end], which contains no quote or backslash */
+    PyObject *rval;
 
-    s = (PyScannerObject *)type->tp_alloc(type, 0);
-    if (s == NULL) {
+    if (is_ascii)
+        return _PyUnicode_FromASCII(str + start, end - start);
+    rval = PyUnicode_DecodeUTF8(str + start, end - start, "surrogatepass");
+    if (rval == NULL && PyErr_ExceptionMatches(PyExc_UnicodeDecodeError)) {
+        /* Report the error against the whole document, as json.loads()
+           used to: it necessarily contains the same invalid sequence. */
+        PyErr_Clear();
+        rval = PyUnicode_DecodeUTF8(str, len, "surrogatepass");
+        assert(rval == NULL);
+        Py_XDECREF(rval);
         return NULL;
     }
-
-    s->memo = PyDict_New();
-    if (s->memo == NULL)
-        goto bail;
-
-    /* All of these will fail "gracefully" so we don't need to verify them */
-    strict = PyObject_GetAttrString(ctx, "strict");
-    if (strict == NULL)
-        goto bail;
-    s->strict = PyObject_IsTrue(strict);
-    Py_DECREF(strict);
-    if (s->strict < 0)
-        goto bail;
-    s->object_hook = PyObject_GetAttrString(ctx, "object_hook");
-    if (s->object_hook == NULL)
-        goto bail;
-    s->object_pairs_hook = PyObject_GetAttrString(ctx, "object_pairs_hook");
-    if (s->object_pairs_hook == NULL)
-        goto bail;
-    s->parse_float = PyObject_GetAttrString(ctx, "parse_float");
-    if (s->parse_float == NULL)
-        goto bail;
-    s->parse_int = PyObject_GetAttrString(ctx, "parse_int");
-    if (s->parse_int == NULL)
-        goto bail;
-    s->parse_constant = PyObject_GetAttrString(ctx, "parse_constant");
-    if (s->parse_constant == NULL)
-        goto bail;
-
-    return (PyObject *)s;
-
-bail:
-    Py_DECREF(s);
-    return NULL;
+    return rval;
 }
 
-PyDoc_STRVAR(scanner_doc, "JSON scanner object");
-
-static PyType_Slot PyScannerType_slots[] = {
-    {Py_tp_doc, (void *)scanner_doc},
-    {Py_tp_dealloc, scanner_dealloc},
-    {Py_tp_call, scanner_call},
-    {Py_tp_traverse, scanner_traverse},
-    {Py_tp_clear, scanner_clear},
-    {Py_tp_members, scanner_members},
-    {Py_tp_new, scanner_new},
-    {0, 0}
-};
-
-static PyType_Spec PyScannerType_spec = {
-    .name = "_json.Scanner",
-    .basicsize = sizeof(PyScannerObject),
-    .itemsize = 0,
-    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
-    .slots = PyScannerType_slots,
-};
-
 static PyObject *
-encoder_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+scanstring_bytes(const char *str, Py_ssize_t len, Py_ssize_t end, int strict, Py_ssize_t *next_end_ptr)
 {
-    static char *kwlist[] = {"markers", "default", "encoder", "indent", "key_separator", "item_separator", "sort_keys", "skipkeys", "allow_nan", NULL};
+    /* Read the JSON string from the UTF-8 encoded buffer str.
+    end is the index of the first byte after the quote.
+    if strict is zero then literal control characters are allowed
+    *next_end_ptr is a return-by-reference index of the byte
+        after the end quote
 
-    PyEncoderObject *s;
-    PyObject *markers, *defaultfn, *encoder, *indent, *key_separator;
-    PyObject *item_separator;
-    int sort_keys, skipkeys, allow_nan;
+    Return value is a new PyUnicode
+    */
+    PyObject *rval = NULL;
+    PyObject *chunk;
+    Py_ssize_t begin = end - 1;
+    Py_ssize_t next /* = begin */;
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOOOUUppp:make_encoder", kwlist,
-        &markers, &defaultfn, &encoder, &indent,
-        &key_separator, &item_separator,
-        &sort_keys, &skipkeys, &allow_nan))
-        return NULL;
+    _PyUnicodeWriter writer;
+    _PyUnicodeWriter_Init(&writer);
+    writer.overallocate = 1;
 
-    if (markers != Py_None && !PyDict_Check(markers)) {
-        PyErr_Format(PyExc_TypeError,
-                     "make_encoder() argument 1 must be dict or None, "
-                     "not %.200s", Py_TYPE(markers)->tp_name);
-        return NULL;
+    if (end < 0 || len < end) {
+        PyErr_SetString(PyExc_ValueError, "end is out of bounds");
+        goto bail;
     }
-
-    s = (PyEncoderObject *)type->tp_alloc(type, 0);
-    if (s == NULL)
-        return NULL;
-
-    s->markers = markers;
-    s->defaultfn = defaultfn;
-    s->encoder = encoder;
-    s->indent = indent;
-    s->key_separator = key_separator;
-    s->item_separator = item_separator;
-    s->sort_keys = sort_keys;
-    s->skipkeys = skipkeys;
-    s->allow_nan = allow_nan;
-    s->fast_encode = NULL;
-    if (PyCFunction_Check(s->encoder)) {
-        PyCFunction f = PyCFunction_GetFunction(s->encoder);
-        if (f == (PyCFunction)py_encode_basestring_ascii ||
-                f == (PyCFunction)py_encode_basestring) {
-            s->fast_encode = f;
+    while (1) {
+        /* Find the end of the string or the next escape */
+        Py_UCS4 c;
+        unsigned char high;
+        {
+            // Use tight scope variable to help register allocation.
+            unsigned char d = 0, h = 0;
+            for (next = end; next < len; next++) {
+                d = (unsigned char)str[next];
+                if (d == '"' || d == '\\') {
+                    break;
+                }
+                if (d <= 0x1f && strict) {
+                    raise_errmsg_bytes("Invalid control character at", str, len, next);
+                    goto bail;
+                }
+                h |= d;
+            }
+            c = d;
+            high = h;
         }
-    }
-
-    Py_INCREF(s->markers);
-    Py_INCREF(s->defaultfn);
-    Py_INCREF(s->encoder);
-    Py_INCREF(s->indent);
-    Py_INCREF(s->key_separator);
-    Py_INCREF(s->item_separator);
-    return (PyObject *)s;
-}
 
-static PyObject *
-encoder_call(PyEncoderObject *self, PyObject *args, PyObject *kwds)
-{
-    /* Python callable interface to encode_listencode_obj */
-    static char *kwlist[] = {"obj", "_current_indent_level", NULL};
-    PyObject *obj;
-    Py_ssize_t indent_level;
-    _PyAccu acc;
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "On:_iterencode", kwlist,
-        &obj, &indent_level))
-        return NULL;
-    if (_PyAccu_Init(&acc))
-        return NULL;
-    if (encoder_listencode_obj(self, &acc, obj, indent_level)) {
-        _PyAccu_Destroy(&acc);
-        return NULL;
-    }
-    return _PyAccu_FinishAsList(&acc);
-}
+        if (c == '"') {
+            // Fast path for simple case.
+            if (writer.buffer == NULL) {
+                PyObject *ret = decode_chunk_bytes(str, len, end, next,
+                                                   high < 0x80);
+                if (ret == NULL) {
+                    goto bail;
+                }
+                *next_end_ptr = next + 1;
+                return ret;
+            }
+        }
+        else if (c != '\\') {
+            raise_errmsg_bytes("Unterminated string starting at", str, len, begin);
+            goto bail;
+        }
+
+        /* Pick up this chunk if it's not zero length */
+        if (next != end) {
+            if (high < 0x80) {
+                if (_PyUnicodeWriter_WriteASCIIString(&writer, str + end,
+                                                      next - end) < 0) {
+                    goto bail;
+                }
+            }
+            else {
+                chunk = decode_chunk_bytes(str, len, end, next, 0);
+                if (chunk == NULL) {
+                    goto bail;
+                }
+                if (_PyUnicodeWriter_WriteStr(&writer, chunk) < 0) {
+                    Py_DECREF(chunk);
+                    goto bail;
+                }
+                Py_DECREF(chunk);
+            }
+        }
+        next++;
+        if (c == '"') {
+            end = next;
+            break;
+        }
+        if (next == len) {
+            raise_errmsg_bytes("Unterminated string starting at", str, len, begin);
+            goto bail;
+        }
+        c = (unsigned char)str[next];
+        if (c != 'u') {
+            /* Non-unicode backslash escapes */
+            end = next + 1;
+            switch (c) {
+                case '"': break;
+                case '\\': break;
+                case '/': break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'n': c = '\n'; break;
+                case 'r': c = '\r'; break;
+                case 't': c = '\t'; break;
+                default: c = 0;
+            }
+            if (c == 0) {
+                raise_errmsg_bytes("Invalid \\escape", str, len, end - 2);
+                goto bail;
+            }
+        }
+        else {
+            c = 0;
+            next++;
+            end = next + 4;
+            if (end >= len) {
+                raise_errmsg_bytes("Invalid \\uXXXX escape", str, len, next - 1);
+                goto bail;
+            }
+            /* Decode 4 hex digits */
+            for (; next < end; next++) {
+                Py_UCS4 digit = (unsigned char)str[next];
+                c <<= 4;
+                switch (digit) {
+                    case '0': case '1': case '2': case '3': case '4':
+                    case '5': case '6': case '7': case '8': case '9':
+                        c |= (digit - '0'); break;
+                    case 'a': case 'b': case 'c': case 'd': case 'e':
+                    case 'f':
+                        c |= (digit - 'a' + 10); break;
+                    case 'A': case 'B': case 'C': case 'D': case 'E':
+                    case 'F':
+                        c |= (digit - 'A' + 10); break;
+                    default:
+                        raise_errmsg_bytes("Invalid \\uXXXX escape", str, len, end - 5);
+                        goto bail;
+                }
+            }
+            /* Surrogate pair */
+            if (Py_UNICODE_IS_HIGH_SURROGATE(c) && end + 6 < len &&
+                str[next++] == '\\' &&
+                str[next++] == 'u') {
+                Py_UCS4 c2 = 0;
+                end += 6;
+                /* Decode 4 hex digits */
+                for (; next < end; next++) {
+                    Py_UCS4 digit = (unsigned char)str[next];
+                    c2 <<= 4;
+                    switch (digit) {
+                        case '0': case '1': case '2': case '3': case '4':
+                        case '5': case '6': case '7': case '8': case '9':
+                            c2 |= (digit - '0'); break;
+                        case 'a': case 'b': case 'c': case 'd': case 'e':
+                        case 'f':
+                            c2 |= (digit - 'a' + 10); break;
+                        case 'A': case 'B': case 'C': case 'D': case 'E':
+                        case 'F':
+                            c2 |= (digit - 'A' + 10); break;
+                        default:
+                            raise_errmsg_bytes("Invalid \\uXXXX escape", str, len, end - 5);
+                            goto bail;
+                    }
+                }
+                if (Py_UNICODE_IS_LOW_SURROGATE(c2))
+                    c = Py_UNICODE_JOIN_SURROGATES(c, c2);
+                else
+                    end -= 6;
+            }
+        }
+        if (_PyUnicodeWriter_WriteChar(&writer, c) < 0) {
+            goto bail;
+        }
+    }
+
+    rval = _PyUnicodeWriter_Finish(&writer);
+    *next_end_ptr = end;
+    return rval;
+
+bail:
+    *next_end_ptr = -1;
+    _PyUnicodeWriter_Dealloc(&writer);
+    return NULL;
+}
+
+static PyObject *
+_parse_object_bytes(PyScannerObject *s, const char *str, Py_ssize_t len, Py_ssize_t idx, Py_ssize_t *next_idx_ptr)
+{
+    /* Read a JSON object from the UTF-8 encoded buffer str.
+    idx is the index of the first byte after the opening curly brace.
+    *next_idx_ptr is a return-by-reference index to the first byte after
+        the closing curly brace.
+
+    Returns a new PyObject (usually a dict, but object_hook can change that)
+    */
+    Py_ssize_t end_idx = len - 1;
+    PyObject *val = NULL;
+    PyObject *rval = NULL;
+    PyObject *key = NULL;
+    object_builder builder;
+    int has_pairs_hook = (s->object_pairs_hook != Py_None);
+    Py_ssize_t next_idx;
+
+    builder.len = 0;
+    builder.dict = NULL;
+    if (has_pairs_hook) {
+        rval = PyList_New(0);
+        if (rval == NULL)
+            return NULL;
+    }
+
+    /* skip whitespace after { */
+    while (idx <= end_idx && IS_WHITESPACE(str[idx])) idx++;
+
+    /* only loop if the object is non-empty */
+    if (idx > end_idx || str[idx] != '}') {
+        while (1) {
+            PyObject *memokey;
+
+            /* read key */
+            if (idx > end_idx || str[idx] != '"') {
+                raise_errmsg_bytes("Expecting property name enclosed in double quotes", str, len, idx);
+                goto bail;
+            }
+            key = scanstring_bytes(str, len, idx + 1, s->strict, &next_idx);
+            if (key == NULL)
+                goto bail;
+            memokey = PyDict_SetDefault(s->memo, key, key);
+            if (memokey == NULL) {
+                goto bail;
+            }
+            Py_INCREF(memokey);
+            Py_DECREF(key);
+            key = memokey;
+            idx = next_idx;
+
+            /* skip whitespace between key and : delimiter, read :, skip whitespace */
+            while (idx <= end_idx && IS_WHITESPACE(str[idx])) idx++;
+            if (idx > end_idx || str[idx] != ':') {
+                raise_errmsg_bytes("Expecting ':' delimiter", str, len, idx);
+                goto bail;
+            }
+            idx++;
+            while (idx <= end_idx && IS_WHITESPACE(str[idx])) idx++;
+
+            /* read any JSON term */
+            val = scan_once_bytes(s, str, len, idx, &next_idx);
+            if (val == NULL)
+                goto bail;
+
+            if (has_pairs_hook) {
+                PyObject *item = PyTuple_Pack(2, key, val);
+                if (item == NULL)
+                    goto bail;
+                Py_CLEAR(key);
+                Py_CLEAR(val);
+                if (PyList_Append(rval, item) == -1) {
+                    Py_DECREF(item);
+                    goto bail;
+                }
+                Py_DECREF(item);
+            }
+            else {
+                if (object_builder_add(&builder, key, val) < 0)
+                    goto bail;
+                Py_CLEAR(key);
+                Py_CLEAR(val);
+            }
+            idx = next_idx;
+
+            /* skip whitespace before } or , */
+            while (idx <= end_idx && IS_WHITESPACE(str[idx])) idx++;
+
+            /* bail if the object is closed or we didn't get the , delimiter */
+            if (idx <= end_idx && str[idx] == '}')
+                break;
+            if (idx > end_idx || str[idx] != ',') {
+                raise_errmsg_bytes("Expecting ',' delimiter", str, len, idx);
+                goto bail;
+            }
+            idx++;
+
+            /* skip whitespace after , delimiter */
+            while (idx <= end_idx && IS_WHITESPACE(str[idx])) idx++;
+        }
+    }
+
+    *next_idx_ptr = idx + 1;
+
+    if (has_pairs_hook) {
+        val = PyObject_CallOneArg(s->object_pairs_hook, rval);
+        Py_DECREF(rval);
+        return val;
+    }
+
+    rval = object_builder_finish(s, &builder);
+    if (rval == NULL)
+        return NULL;
+
+    /* if object_hook is not None: rval = object_hook(rval) */
+    if (s->object_hook != Py_None) {
+        val = PyObject_CallOneArg(s->object_hook, rval);
+        Py_DECREF(rval);
+        return val;
+    }
+    return rval;
+bail:
+    object_builder_clear(&builder);
+    Py_XDECREF(key);
+    Py_XDECREF(val);
+    Py_XDECREF(rval);
+    return NULL;
+}
+
+static PyObject *
+_parse_array_bytes(PyScannerObject *s, const char *str, Py_ssize_t len, Py_ssize_t idx, Py_ssize_t *next_idx_ptr) {
+    /* Read a JSON array from the UTF-8 encoded buffer str.
+    idx is the index of the first byte after the opening brace.
+    *next_idx_ptr is a return-by-reference index to the first byte after
+        the closing brace.
+
+    Returns a new PyList
+    */
+    Py_ssize_t end_idx = len - 1;
+    PyObject *val = NULL;
+    PyObject *rval;
+    Py_ssize_t next_idx;
+
+    rval = PyList_New(0);
+    if (rval == NULL)
+        return NULL;
+
+    /* skip whitespace after [ */
+    while (idx <= end_idx && IS_WHITESPACE(str[idx])) idx++;
+
+    /* only loop if the array is non-empty */
+    if (idx > end_idx || str[idx] != ']') {
+        while (1) {
+
+            /* read any JSON term  */
+            val = scan_once_bytes(s, str, len, idx, &next_idx);
+            if (val == NULL)
+                goto bail;
+
+            if (PyList_Append(rval, val) == -1)
+                goto bail;
+
+            Py_CLEAR(val);
+            idx = next_idx;
+
+            /* skip whitespace between term and , */
+            while (idx <= end_idx && IS_WHITESPACE(str[idx])) idx++;
+
+            /* bail if the array is closed or we didn't get the , delimiter */
+            if (idx <= end_idx && str[idx] == ']')
+                break;
+            if (idx > end_idx || str[idx] != ',') {
+                raise_errmsg_bytes("Expecting ',' delimiter", str, len, idx);
+                goto bail;
+            }
+            idx++;
+
+            /* skip whitespace after , */
+            while (idx <= end_idx && IS_WHITESPACE(str[idx])) idx++;
+        }
+    }
+
+    /* verify that idx < end_idx, str[idx] should be ']' */
+    if (idx > end_idx || str[idx] != ']') {
+        raise_errmsg_bytes("Expecting value", str, len, end_idx);
+        goto bail;
+    }
+    *next_idx_ptr = idx + 1;
+    return rval;
+bail:
+    Py_XDECREF(val);
+    Py_DECREF(rval);
+    return NULL;
+}
+
+#define IS_DIGIT(c) ((c) >= '0' && (c) <= '9')
+
+static PyObject *
+_match_number_bytes(PyScannerObject *s, const char *str, Py_ssize_t len, Py_ssize_t start, Py_ssize_t *next_idx_ptr) {
+    /* Read a JSON number from the UTF-8 encoded buffer str.
+    idx is the index of the first byte of the number
+    *next_idx_ptr is a return-by-reference index to the first byte after
+        the number.
+
+    Returns a new PyObject representation of that number:
+        PyLong, or PyFloat.
+        May return other types if parse_int or parse_float are set
+    */
+    Py_ssize_t end_idx = len - 1;
+    Py_ssize_t idx = start;
+    int is_float = 0;
+    PyObject *rval;
+    PyObject *numstr = NULL;
+    PyObject *custom_func;
+
+    /* read a sign if it's there, make sure it's not the end of the string */
+    if (str[idx] == '-') {
+        idx++;
+        if (idx > end_idx) {
+            raise_stop_iteration(start);
+            return NULL;
+        }
+    }
+
+    /* read as many integer digits as we find as long as it doesn't start with 0 */
+    if (str[idx] >= '1' && str[idx] <= '9') {
+        idx++;
+        while (idx <= end_idx && IS_DIGIT(str[idx])) idx++;
+    }
+    /* if it starts with 0 we only expect one integer digit */
+    else if (str[idx] == '0') {
+        idx++;
+    }
+    /* no integer digits, error */
+    else {
+        raise_stop_iteration(start);
+        return NULL;
+    }
+
+    /* if the next char is '.' followed by a digit then read all float digits */
+    if (idx < end_idx && str[idx] == '.' && IS_DIGIT(str[idx + 1])) {
+        is_float = 1;
+        idx += 2;
+        while (idx <= end_idx && IS_DIGIT(str[idx])) idx++;
+    }
+
+    /* if the next char is 'e' or 'E' then maybe read the exponent (or backtrack) */
+    if (idx < end_idx && (str[idx] == 'e' || str[idx] == 'E')) {
+        Py_ssize_t e_start = idx;
+        idx++;
+
+        /* read an exponent sign if present */
+        if (idx < end_idx && (str[idx] == '-' || str[idx] == '+')) idx++;
+
+        /* read all digits */
+        while (idx <= end_idx && IS_DIGIT(str[idx])) idx++;
+
+        /* if we got a digit, then parse as float. if not, backtrack */
+        if (IS_DIGIT(str[idx - 1])) {
+            is_float = 1;
+        }
+        else {
+            idx = e_start;
+        }
+    }
+
+    if (is_float && s->parse_float != (PyObject *)&PyFloat_Type)
+        custom_func = s->parse_float;
+    else if (!is_float && s->parse_int != (PyObject *) &PyLong_Type)
+        custom_func = s->parse_int;
+    else
+        custom_func = NULL;
+
+    if (custom_func) {
+        /* copy the section we determined to be a number */
+        numstr = _PyUnicode_FromASCII(str + start, idx - start);
+        if (numstr == NULL)
+            return NULL;
+        rval = PyObject_CallOneArg(custom_func, numstr);
+    }
+    else {
+        /* Copy to get a NUL-terminated string */
+        numstr = PyBytes_FromStringAndSize(str + start, idx - start);
+        if (numstr == NULL)
+            return NULL;
+        if (is_float)
+            rval = PyFloat_FromString(numstr);
+        else
+            rval = PyLong_FromString(PyBytes_AS_STRING(numstr), NULL, 10);
+    }
+    Py_DECREF(numstr);
+    *next_idx_ptr = idx;
+    return rval;
+}
+
+#undef IS_DIGIT
+
+static PyObject *
+scan_once_bytes(PyScannerObject *s, const char *str, Py_ssize_t length, Py_ssize_t idx, Py_ssize_t *next_idx_ptr)
+{
+    /* Read one JSON term (of any kind) from the UTF-8 encoded buffer str.
+    idx is the index of the first byte of the term
+    *next_idx_ptr is a return-by-reference index to the first byte after
+        the term.
+
+    Returns a new PyObject representation of the term.
+    */
+    PyObject *res;
+
+    if (idx < 0) {
+        PyErr_SetString(PyExc_ValueError, "idx cannot be negative");
+        return NULL;
+    }
+    if (idx >= length) {
+        raise_stop_iteration(idx);
+        return NULL;
+    }
+
+    switch (str[idx]) {
+        case '"':
+            /* string */
+            return scanstring_bytes(str, length, idx + 1, s->strict, next_idx_ptr);
+        case '{':
+            /* object */
+            if (Py_EnterRecursiveCall(" while decoding a JSON object "
+                                      "from a bytes-like object"))
+                return NULL;
+            res = _parse_object_bytes(s, str, length, idx + 1, next_idx_ptr);
+            Py_LeaveRecursiveCall();
+            return res;
+        case '[':
+            /* array */
+            if (Py_EnterRecursiveCall(" while decoding a JSON array "
+                                      "from a bytes-like object"))
+                return NULL;
+            res = _parse_array_bytes(s, str, length, idx + 1, next_idx_ptr);
+            Py_LeaveRecursiveCall();
+            return res;
+        case 'n':
+            /* null */
+            if ((idx + 3 < length) && memcmp(str + idx, "null", 4) == 0) {
+                *next_idx_ptr = idx + 4;
+                Py_RETURN_NONE;
+            }
+            break;
+        case 't':
+            /* true */
+            if ((idx + 3 < length) && memcmp(str + idx, "true", 4) == 0) {
+                *next_idx_ptr = idx + 4;
+                Py_RETURN_TRUE;
+            }
+            break;
+        case 'f':
+            /* false */
+            if ((idx + 4 < length) && memcmp(str + idx, "false", 5) == 0) {
+                *next_idx_ptr = idx + 5;
+                Py_RETURN_FALSE;
+            }
+            break;
+        case 'N':
+            /* NaN */
+            if ((idx + 2 < length) && memcmp(str + idx, "NaN", 3) == 0) {
+                return _parse_constant(s, "NaN", idx, next_idx_ptr);
+            }
+            break;
+        case 'I':
+            /* Infinity */
+            if ((idx + 7 < length) && memcmp(str + idx, "Infinity", 8) == 0) {
+                return _parse_constant(s, "Infinity", idx, next_idx_ptr);
+            }
+            break;
+        case '-':
+            /* -Infinity */
+            if ((idx + 8 < length) && memcmp(str + idx, "-Infinity", 9) == 0) {
+                return _parse_constant(s, "-Infinity", idx, next_idx_ptr);
+            }
+            break;
+    }
+    /* Didn't find a string, object, array, or named constant. Look for a number. */
+    return _match_number_bytes(s, str, length, idx, next_idx_ptr);
+}
+
+static PyObject *
+scanner_call(PyScannerObject *self, PyObject *args, PyObject *kwds)
+{
+    /* Python callable interface to scan_once_{bytes,unicode} */
+    PyObject *pystr;
+    PyObject *rval;
+    Py_ssize_t idx;
+    Py_ssize_t next_idx = -1;
+    static char *kwlist[] = {"string", "idx", NULL};
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "On:scan_once", kwlist, &pystr, &idx))
+        return NULL;
+
+    if (PyUnicode_Check(pystr)) {
+        rval = scan_once_unicode(self, pystr, idx, &next_idx);
+    }
+    else if (PyObject_CheckBuffer(pystr)) {
+        /* UTF-8 encoded document, indices are byte offsets */
+        Py_buffer view;
+        if (PyObject_GetBuffer(pystr, &view, PyBUF_SIMPLE) < 0)
+            return NULL;
+        rval = scan_once_bytes(self, view.buf, view.len, idx, &next_idx);
+        PyBuffer_Release(&view);
+    }
+    else {
+        PyErr_Format(PyExc_TypeError,
+                 "first argument must be a string or a bytes-like object, "
+                 "not %.80s",
+                 Py_TYPE(pystr)->tp_name);
+        return NULL;
+    }
+    PyDict_Clear(self->memo);
+    if (rval == NULL)
+        return NULL;
+    return _build_rval_index_tuple(rval, next_idx);
+}
+
+static PyObject *
+scanner_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    PyScannerObject *s;
+    PyObject *ctx;
+    PyObject *strict;
+    static char *kwlist[] = {"context", NULL};
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O:make_scanner", kwlist, &ctx))
+        return NULL;
+
+    s = (PyScannerObject *)type->tp_alloc(type, 0);
+    if (s == NULL) {
+        return NULL;
+    }
+
+    s->memo = PyDict_New();
+    if (s->memo == NULL)
+        goto bail;
+
+    /* All of these will fail "gracefully" so we don't need to verify them */
+    strict = PyObject_GetAttrString(ctx, "strict");
+    if (strict == NULL)
+        goto bail;
+    s->strict = PyObject_IsTrue(strict);
+    Py_DECREF(strict);
+    if (s->strict < 0)
+        goto bail;
+    s->object_hook = PyObject_GetAttrString(ctx, "object_hook");
+    if (s->object_hook == NULL)
+        goto bail;
+    s->object_pairs_hook = PyObject_GetAttrString(ctx, "object_pairs_hook");
+    if (s->object_pairs_hook == NULL)
+        goto bail;
+    s->parse_float = PyObject_GetAttrString(ctx, "parse_float");
+    if (s->parse_float == NULL)
+        goto bail;
+    s->parse_int = PyObject_GetAttrString(ctx, "parse_int");
+    if (s->parse_int == NULL)
+        goto bail;
+    s->parse_constant = PyObject_GetAttrString(ctx, "parse_constant");
+    if (s->parse_constant == NULL)
+        goto bail;
+
+    return (PyObject *)s;
+
+bail:
+    Py_DECREF(s);
+    return NULL;
+}
+
+PyDoc_STRVAR(scanner_doc, "JSON scanner object");
+
+static PyType_Slot PyScannerType_slots[] = {
+    {Py_tp_doc, (void *)scanner_doc},
+    {Py_tp_dealloc, scanner_dealloc},
+    {Py_tp_call, scanner_call},
+    {Py_tp_traverse, scanner_traverse},
+    {Py_tp_clear, scanner_clear},
+    {Py_tp_members, scanner_members},
+    {Py_tp_new, scanner_new},
+    {0, 0}
+};
+
+static PyType_Spec PyScannerType_spec = {
+    .name = "_json.Scanner",
+    .basicsize = sizeof(PyScannerObject),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .slots = PyScannerType_slots,
+};
+
+/* Incremental decoder: the input is accumulated in a UTF-8 encoded buffer,
+   which is scanned for the end of the next top-level value.  Only nesting
+   depth and string state are tracked, so scanning can resume when more
+   data arrives; once a value is complete it is parsed in place by
+   scan_once_bytes() and dropped from the buffer. */
+
+typedef struct _PyStreamDecoderObject {
+    PyObject_HEAD
+    PyObject *scanner;
+    char *buf;
+    Py_ssize_t len;             /* number of bytes in buf */
+    Py_ssize_t allocated;
+    Py_ssize_t start;           /* start of the current value */
+    Py_ssize_t idx;             /* where scanning resumes */
+    Py_ssize_t depth;           /* nesting depth in the current value */
+    char in_value;
+    char in_string;
+    char escape;
+    char items;                 /* produce the items of top-level arrays */
+    char in_array;              /* inside such an array */
+    char expect_delimiter;      /* in_array: 0 at the start, 1 after an item,
+                                   2 after a comma */
+    char closed;
+    char decoding;              /* a value is being parsed in place: the
+                                   hooks must not feed or iterate */
+} PyStreamDecoderObject;
+
+static PyMemberDef stream_decoder_members[] = {
+    {"scanner", T_OBJECT, offsetof(PyStreamDecoderObject, scanner), READONLY, "scanner"},
+    {"items", T_BOOL, offsetof(PyStreamDecoderObject, items), READONLY, "items"},
+    {NULL}
+};
+
+/* Maximum number of keys memoized across values */
+#define STREAM_MEMO_SIZE 1024
+
+#define IS_SCALAR_END(c) (IS_WHITESPACE(c) || (c) == ',' || (c) == ':' || \
+                          (c) == '[' || (c) == ']' || (c) == '{' || \
+                          (c) == '}' || (c) == '"')
+
+static PyObject *
+stream_decoder_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    PyStreamDecoderObject *s;
+    PyObject *ctx;
+    int items = 0;
+    static char *kwlist[] = {"context", "items", NULL};
+    _jsonmodulestate *state = PyType_GetModuleState(type);
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O|p:make_stream_decoder",
+                                     kwlist, &ctx, &items))
+        return NULL;
+
+    s = (PyStreamDecoderObject *)type->tp_alloc(type, 0);
+    if (s == NULL) {
+        return NULL;
+    }
+    s->items = (char)items;
+    s->scanner = PyObject_CallOneArg(state->PyScannerType, ctx);
+    if (s->scanner == NULL) {
+        Py_DECREF(s);
+        return NULL;
+    }
+    return (PyObject *)s;
+}
+
+static void
+stream_decoder_dealloc(PyObject *self)
+{
+    PyTypeObject *tp = Py_TYPE(self);
+    PyObject_GC_UnTrack(self);
+    Py_CLEAR(((PyStreamDecoderObject *)self)->scanner);
+    PyMem_Free(((PyStreamDecoderObject *)self)->buf);
+    tp->tp_free(self);
+    Py_DECREF(tp);
+}
+
+static int
+stream_decoder_traverse(PyStreamDecoderObject *self, visitproc visit, void *arg)
+{
+    Py_VISIT(Py_TYPE(self));
+    Py_VISIT(self->scanner);
+    return 0;
+}
+
+static int
+stream_decoder_clear(PyStreamDecoderObject *self)
+{
+    Py_CLEAR(self->scanner);
+    return 0;
+}
+
+PyDoc_STRVAR(stream_decoder_feed_doc,
+    "feed(data)\n"
+    "\n"
+    "Add data (a str or a UTF-8 encoded bytes-like object) to the input.\n"
+    "Iterate over the decoder to get the values it completes."
+);
+
+static PyObject *
+stream_decoder_feed(PyStreamDecoderObject *self, PyObject *data)
+{
+    Py_buffer view;
+    PyObject *encoded = NULL;
+    Py_ssize_t kept;
+
+    if (self->closed) {
+        PyErr_SetString(PyExc_ValueError, "feed() after close()");
+        return NULL;
+    }
+    if (self->decoding) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "feed() called while decoding a value");
+        return NULL;
+    }
+    if (PyUnicode_Check(data)) {
+        encoded = PyUnicode_AsEncodedString(data, "utf-8", "surrogatepass");
+        if (encoded == NULL)
+            return NULL;
+        data = encoded;
+    }
+    if (PyObject_GetBuffer(data, &view, PyBUF_SIMPLE) < 0) {
+        Py_XDECREF(encoded);
+        return NULL;
+    }
+
+    /* Drop the data of the values already produced */
+    kept = self->len - self->start;
+    if (self->start > 0) {
+        memmove(self->buf, self->buf + self->start, kept);
+        self->idx -= self->start;
+        self->start = 0;
+        self->len = kept;
+    }
+    if (view.len > self->allocated - kept) {
+        Py_ssize_t allocated;
+        char *buf;
+        if (view.len > PY_SSIZE_T_MAX / 2 - kept) {
+            PyBuffer_Release(&view);
+            Py_XDECREF(encoded);
+            PyErr_NoMemory();
+            return NULL;
+        }
+        /* Overallocate to amortize the cost of values split across
+           many chunks */
+        allocated = Py_MAX(kept + view.len, 2 * self->allocated);
+        buf = PyMem_Realloc(self->buf, allocated);
+        if (buf == NULL) {
+            PyBuffer_Release(&view);
+            Py_XDECREF(encoded);
+            PyErr_NoMemory();
+            return NULL;
+        }
+        self->buf = buf;
+        self->allocated = allocated;
+    }
+    memcpy(self->buf + self->len, view.buf, view.len);
+    self->len += view.len;
+    PyBuffer_Release(&view);
+    Py_XDECREF(encoded);
+    Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(stream_decoder_close_doc,
+    "close()\n"
+    "\n"
+    "Signal the end of the input.  A trailing number or constant is then\n"
+    "complete, and an incomplete value raises JSONDecodeError when the\n"
+    "decoder is iterated."
+);
+
+static PyObject *
+stream_decoder_close(PyStreamDecoderObject *self, PyObject *Py_UNUSED(ignored))
+{
+    self->closed = 1;
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+stream_decoder_iternext(PyStreamDecoderObject *self)
+{
+    const char *buf = self->buf;
+    Py_ssize_t len = self->len;
+    Py_ssize_t idx = self->idx;
+    Py_ssize_t end, next_idx;
+    PyObject *rval, *scanner;
+
+    if (self->decoding) {
+        PyErr_SetString(PyExc_RuntimeError,
+                        "next() called while decoding a value");
+        return NULL;
+    }
+    if (self->scanner == NULL) {
+        /* cleared by the garbage collector */
+        PyErr_SetString(PyExc_ValueError,
+                        "next() called on a cleared stream decoder");
+        return NULL;
+    }
+    while (!self->in_value) {
+        char c;
+        while (idx < len && IS_WHITESPACE(buf[idx])) idx++;
+        self->start = self->idx = idx;
+        if (idx == len) {
+            if (self->closed && self->in_array) {
+                self->in_array = 0;
+                raise_errmsg_bytes(self->expect_delimiter == 1 ?
+                                   "Expecting ',' delimiter" : "Expecting value",
+                                   buf + idx, 0, 0);
+            }
+            return NULL;
+        }
+        c = buf[idx];
+        if (self->in_array) {
+            if (c == ']') {
+                self->in_array = 0;
+                self->idx = ++idx;
+                if (self->expect_delimiter == 2) {
+                    raise_errmsg_bytes("Expecting value", buf + idx - 1, 1, 0);
+                    return NULL;
+                }
+                continue;
+            }
+            if (self->expect_delimiter == 1) {
+                if (c != ',') {
+                    self->in_array = 0;
+                    /* the document is the unexpected character */
+                    raise_errmsg_bytes("Expecting ',' delimiter", buf + idx,
+                                       (unsigned char)c < 0x80, 0);
+                    return NULL;
+                }
+                self->expect_delimiter = 2;
+                self->idx = ++idx;
+                continue;
+            }
+        }
+        else if (c == '[' && self->items) {
+            self->in_array = 1;
+            self->expect_delimiter = 0;
+            self->idx = ++idx;
+            continue;
+        }
+        self->in_value = 1;
+        self->depth = 0;
+        self->in_string = 0;
+        self->escape = 0;
+    }
+
+    /* Look for the end of the value */
+    end = -1;
+    if (idx == self->start && (buf[idx] == ',' || buf[idx] == ':' ||
+                               buf[idx] == ']' || buf[idx] == '}')) {
+        /* not a value: let the scanner report it */
+        end = idx + 1;
+    }
+    else if (!self->in_string && self->depth == 0 &&
+             buf[self->start] != '"' && buf[self->start] != '[' &&
+             buf[self->start] != '{') {
+        /* number or constant */
+        while (idx < len && !IS_SCALAR_END(buf[idx])) idx++;
+        if (idx < len)
+            end = idx;
+    }
+    else {
+        // Use local variables to help register allocation.
+        Py_ssize_t depth = self->depth;
+        int in_string = self->in_string, escape = self->escape;
+        for (; idx < len; idx++) {
+            char c = buf[idx];
+            if (in_string) {
+                if (escape)
+                    escape = 0;
+                else if (c == '\\')
+                    escape = 1;
+                else if (c == '"') {
+                    in_string = 0;
+                    if (depth == 0) {
+                        end = idx + 1;
+                        break;
+                    }
+                }
+            }
+            else if (c == '"')
+                in_string = 1;
+            else if (c == '[' || c == '{')
+                depth++;
+            else if ((c == ']' || c == '}') && --depth == 0) {
+                end = idx + 1;
+                break;
+            }
+        }
+        self->depth = depth;
+        self->in_string = (char)in_string;
+        self->escape = (char)escape;
+    }
+    if (end < 0) {
+        if (!self->closed) {
+            /* wait for more data */
+            self->idx = idx;
+            return NULL;
+        }
+        end = len;
+    }
+
+    /* Parse the value, and drop it even if it is invalid, so that the
+       values that follow can still be decoded */
+    len = end - self->start;
+    buf += self->start;
+    self->in_value = 0;
+    self->start = self->idx = end;
+    if (self->in_array)
+        self->expect_delimiter = 1;
+
+    next_idx = -1;
+    /* the hooks may run arbitrary code, keep the scanner alive */
+    scanner = self->scanner;
+    Py_INCREF(scanner);
+    self->decoding = 1;
+    rval = scan_once_bytes((PyScannerObject *)scanner, buf, len, 0, &next_idx);
+    self->decoding = 0;
+    /* Keep the keys of the previous values, the values of a stream usually
+       have the same ones, but bound the memory used */
+    if (PyDict_GET_SIZE(((PyScannerObject *)scanner)->memo) > STREAM_MEMO_SIZE)
+        PyDict_Clear(((PyScannerObject *)scanner)->memo);
+    Py_DECREF(scanner);
+    if (rval == NULL) {
+        if (PyErr_ExceptionMatches(PyExc_StopIteration)) {
+            /* as in JSONDecoder.raw_decode() */
+            PyObject *type, *value, *tb;
+            Py_ssize_t pos;
+            PyErr_Fetch(&type, &value, &tb);
+            PyErr_NormalizeException(&type, &value, &tb);
+            if (!PyObject_TypeCheck(value, (PyTypeObject *)PyExc_StopIteration)) {
+                PyErr_Restore(type, value, tb);
+                return NULL;
+            }
+            pos = PyLong_AsSsize_t(((PyStopIterationObject *)value)->value);
+            Py_DECREF(type);
+            Py_DECREF(value);
+            Py_XDECREF(tb);
+            if (pos == -1 && PyErr_Occurred())
+                return NULL;
+            raise_errmsg_bytes("Expecting value", buf, len, pos);
+        }
+        return NULL;
+    }
+    if (next_idx != len) {
+        Py_DECREF(rval);
+        raise_errmsg_bytes("Extra data", buf, len, next_idx);
+        return NULL;
+    }
+    return rval;
+}
+
+#undef IS_SCALAR_END
+
+static PyMethodDef stream_decoder_methods[] = {
+    {"feed", (PyCFunction)stream_decoder_feed, METH_O, stream_decoder_feed_doc},
+    {"close", (PyCFunction)stream_decoder_close, METH_NOARGS, stream_decoder_close_doc},
+    {NULL, NULL}
+};
+
+PyDoc_STRVAR(stream_decoder_doc,
+    "make_stream_decoder(context, items=False)\n"
+    "--\n"
+    "\n"
+    "JSON incremental decoder object");
+
+static PyType_Slot PyStreamDecoderType_slots[] = {
+    {Py_tp_doc, (void *)stream_decoder_doc},
+    {Py_tp_dealloc, stream_decoder_dealloc},
+    {Py_tp_iter, PyObject_SelfIter},
+    {Py_tp_iternext, stream_decoder_iternext},
+    {Py_tp_traverse, stream_decoder_traverse},
+    {Py_tp_clear, stream_decoder_clear},
+    {Py_tp_members, stream_decoder_members},
+    {Py_tp_methods, stream_decoder_methods},
+    {Py_tp_new, stream_decoder_new},
+    {0, 0}
+};
+
+static PyType_Spec PyStreamDecoderType_spec = {
+    .name = "_json.StreamDecoder",
+    .basicsize = sizeof(PyStreamDecoderObject),
+    .itemsize = 0,
+    .flags = Py_TPFLAGS_DEFAULT | Py_TPFLAGS_HAVE_GC,
+    .slots = PyStreamDecoderType_slots,
+};
+
+static PyObject *
+encoder_new(PyTypeObject *type, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"markers", "default", "encoder", "indent", "key_separator", "item_separator", "sort_keys", "skipkeys", "allow_nan", NULL};
+
+    PyEncoderObject *s;
+    PyObject *markers, *defaultfn, *encoder, *indent, *key_separator;
+    PyObject *item_separator;
+    int sort_keys, skipkeys, allow_nan;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OOOOUUppp:make_encoder", kwlist,
+        &markers, &defaultfn, &encoder, &indent,
+        &key_separator, &item_separator,
+        &sort_keys, &skipkeys, &allow_nan))
+        return NULL;
+
+    if (markers != Py_None && !PyDict_Check(markers)) {
+        PyErr_Format(PyExc_TypeError,
+                     "make_encoder() argument 1 must be dict or None, "
+                     "not %.200s", Py_TYPE(markers)->tp_name);
+        return NULL;
+    }
+
+    s = (PyEncoderObject *)type->tp_alloc(type, 0);
+    if (s == NULL)
+        return NULL;
+
+    s->markers = markers;
+    s->defaultfn = defaultfn;
+    s->encoder = encoder;
+    s->indent = indent;
+    s->key_separator = key_separator;
+    s->item_separator = item_separator;
+    s->sort_keys = sort_keys;
+    s->skipkeys = skipkeys;
+    s->allow_nan = allow_nan;
+    s->fast_encode = NULL;
+    if (PyCFunction_Check(s->encoder)) {
+        PyCFunction f = PyCFunction_GetFunction(s->encoder);
+        if (f == (PyCFunction)py_encode_basestring_ascii ||
+                f == (PyCFunction)py_encode_basestring) {
+            s->fast_encode = f;
+        }
+    }
+
+    Py_INCREF(s->markers);
+    Py_INCREF(s->defaultfn);
+    Py_INCREF(s->encoder);
+    Py_INCREF(s->indent);
+    Py_INCREF(s->key_separator);
+    Py_INCREF(s->item_separator);
+    return (PyObject *)s;
+}
+
+static PyObject *
+encoder_call(PyEncoderObject *self, PyObject *args, PyObject *kwds)
+{
+    /* Python callable interface to encode_listencode_obj */
+    static char *kwlist[] = {"obj", "_current_indent_level", NULL};
+    PyObject *obj;
+    Py_ssize_t indent_level;
+    encoder_output out;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "On:_iterencode", kwlist,
+        &obj, &indent_level))
+        return NULL;
+    out.write = NULL;
+    if (_PyAccu_Init(&out.acc))
+        return NULL;
+    if (encoder_listencode_obj(self, &out, obj, indent_level)) {
+        _PyAccu_Destroy(&out.acc);
+        return NULL;
+    }
+    return _PyAccu_FinishAsList(&out.acc);
+}
+
+static int encoder_output_flush(encoder_output *out);
+
+static PyObject *
+encoder_dump(PyEncoderObject *self, PyObject *args, PyObject *kwds)
+{
+    /* Encode obj and pass the output to write() in chunks */
+    static char *kwlist[] = {"obj", "write", "binary", "chunk_size", NULL};
+    PyObject *obj;
+    encoder_output out;
+    int rv;
+
+    out.binary = 0;
+    out.chunk_size = JSON_DUMP_CHUNK_SIZE;
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|pn:dump", kwlist,
+        &obj, &out.write, &out.binary, &out.chunk_size))
+        return NULL;
+    if (out.chunk_size <= 0) {
+        PyErr_SetString(PyExc_ValueError, "chunk_size must be positive");
+        return NULL;
+    }
+    out.buf = NULL;
+    out.len = out.allocated = 0;
+    _PyUnicodeWriter_Init(&out.writer);
+    out.writer.overallocate = 1;
+
+    rv = encoder_listencode_obj(self, &out, obj, 0);
+    if (rv == 0)
+        rv = encoder_output_flush(&out);
+    _PyUnicodeWriter_Dealloc(&out.writer);
+    PyMem_Free(out.buf);
+    if (rv)
+        return NULL;
+    Py_RETURN_NONE;
+}
 
 static PyObject *
 _encoded_const(PyObject *obj)
@@ -1387,16 +2591,234 @@ encoder_encode_string(PyEncoderObject *s, PyObject *obj)
 }
 
 static int
-_steal_accumulate(_PyAccu *acc, PyObject *stolen)
+encoder_output_flush(encoder_output *out)
+{
+    /* Pass the pending output of encoder_dump() to write() */
+    PyObject *chunk, *res;
+
+    if (out->binary) {
+        if (out->len == 0)
+            return 0;
+        chunk = PyBytes_FromStringAndSize(out->buf, out->len);
+        out->len = 0;
+    }
+    else {
+        if (out->writer.pos == 0)
+            return 0;
+        chunk = _PyUnicodeWriter_Finish(&out->writer);
+        _PyUnicodeWriter_Init(&out->writer);
+        out->writer.overallocate = 1;
+    }
+    if (chunk == NULL)
+        return -1;
+    res = PyObject_CallOneArg(out->write, chunk);
+    Py_DECREF(chunk);
+    if (res == NULL)
+        return -1;
+    Py_DECREF(res);
+    return 0;
+}
+
+static char *
+encoder_output_reserve(encoder_output *out, Py_ssize_t size)
+{
+    /* Return a pointer to size free bytes at the end of the binary output */
+    if (out->allocated - out->len < size) {
+        Py_ssize_t allocated = Py_MAX(out->len + size, out->chunk_size);
+        char *buf;
+        if (allocated > PY_SSIZE_T_MAX / 2) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+        allocated *= 2;
+        buf = PyMem_Realloc(out->buf, allocated);
+        if (buf == NULL) {
+            PyErr_NoMemory();
+            return NULL;
+        }
+        out->buf = buf;
+        out->allocated = allocated;
+    }
+    return out->buf + out->len;
+}
+
+static int
+encoder_output_bytes(encoder_output *out, const char *str, Py_ssize_t len)
+{
+    /* Append UTF-8 encoded bytes to the binary output */
+    char *p = encoder_output_reserve(out, len);
+    if (p == NULL)
+        return -1;
+    memcpy(p, str, len);
+    out->len += len;
+    if (out->len >= out->chunk_size)
+        return encoder_output_flush(out);
+    return 0;
+}
+
+static int
+encoder_write(encoder_output *out, PyObject *unicode)
+{
+    /* Append unicode to the output */
+    if (out->write == NULL)
+        return _PyAccu_Accumulate(&out->acc, unicode);
+    if (out->binary) {
+        const char *str;
+        Py_ssize_t len;
+        if (PyUnicode_IS_ASCII(unicode)) {
+            str = (const char *)PyUnicode_1BYTE_DATA(unicode);
+            len = PyUnicode_GET_LENGTH(unicode);
+        }
+        else {
+            str = PyUnicode_AsUTF8AndSize(unicode, &len);
+            if (str == NULL)
+                return -1;
+        }
+        return encoder_output_bytes(out, str, len);
+    }
+    if (_PyUnicodeWriter_WriteStr(&out->writer, unicode) < 0)
+        return -1;
+    if (out->writer.pos >= out->chunk_size)
+        return encoder_output_flush(out);
+    return 0;
+}
+
+static int
+_steal_write(encoder_output *out, PyObject *stolen)
 {
     /* Append stolen and then decrement its reference count */
-    int rval = _PyAccu_Accumulate(acc, stolen);
+    int rval;
+    if (stolen == NULL)
+        return -1;
+    rval = encoder_write(out, stolen);
     Py_DECREF(stolen);
     return rval;
 }
 
 static int
-encoder_listencode_obj(PyEncoderObject *s, _PyAccu *acc,
+encoder_write_utf8_string(PyEncoderObject *s, encoder_output *out,
+                          PyObject *pystr)
+{
+    /* Write the JSON representation of a string to the binary output,
+    without creating the escaped string */
+    int ensure_ascii = (s->fast_encode == (PyCFunction)py_encode_basestring_ascii);
+    Py_ssize_t i = 0, n;
+    const void *input;
+    int kind;
+
+    if (PyUnicode_READY(pystr) == -1)
+        return -1;
+    n = PyUnicode_GET_LENGTH(pystr);
+    input = PyUnicode_DATA(pystr);
+    kind = PyUnicode_KIND(pystr);
+
+    if (encoder_output_bytes(out, "\"", 1))
+        return -1;
+    while (i < n) {
+        /* Escape the string in blocks, so that a long string does not need
+           12 times its length at once */
+        Py_ssize_t end = Py_MIN(n, i + 4096);
+        unsigned char *output;
+        Py_ssize_t chars = 0;
+
+        output = (unsigned char *)encoder_output_reserve(out, (end - i) * 12);
+        if (output == NULL)
+            return -1;
+        for (; i < end; i++) {
+            Py_UCS4 c = PyUnicode_READ(kind, input, i);
+            if (S_CHAR(c)) {
+                output[chars++] = c;
+            }
+            else if (ensure_ascii || c < ' ' || c == '\\' || c == '"') {
+                chars = ascii_escape_unichar(c, output, chars);
+            }
+            else if (c < 0x80) {
+                output[chars++] = c;
+            }
+            else if (c < 0x800) {
+                output[chars++] = 0xc0 | (c >> 6);
+                output[chars++] = 0x80 | (c & 0x3f);
+            }
+            else if (c < 0x10000) {
+                if (Py_UNICODE_IS_SURROGATE(c)) {
+                    /* let the UTF-8 codec raise the error */
+                    if (PyUnicode_AsUTF8AndSize(pystr, NULL) == NULL)
+                        return -1;
+                    PyErr_SetString(PyExc_SystemError,
+                                    "surrogate encoded to UTF-8");
+                    return -1;
+                }
+                output[chars++] = 0xe0 | (c >> 12);
+                output[chars++] = 0x80 | ((c >> 6) & 0x3f);
+                output[chars++] = 0x80 | (c & 0x3f);
+            }
+            else {
+                output[chars++] = 0xf0 | (c >> 18);
+                output[chars++] = 0x80 | ((c >> 12) & 0x3f);
+                output[chars++] = 0x80 | ((c >> 6) & 0x3f);
+                output[chars++] = 0x80 | (c & 0x3f);
+            }
+        }
+        out->len += chars;
+    }
+    return encoder_output_bytes(out, "\"", 1);
+}
+
+static int
+encoder_write_string(PyEncoderObject *s, encoder_output *out, PyObject *obj)
+{
+    /* Write the JSON representation of a string */
+    if (out->write != NULL && out->binary && s->fast_encode)
+        return encoder_write_utf8_string(s, out, obj);
+    return _steal_write(out, encoder_encode_string(s, obj));
+}
+
+static int
+encoder_write_long(encoder_output *out, PyObject *obj)
+{
+    /* Write the JSON representation of an int */
+    char buf[24], *p = buf + sizeof(buf);
+    long long value;
+    unsigned long long u;
+    int overflow;
+
+    if (out->write == NULL || !out->binary)
+        return _steal_write(out, PyLong_Type.tp_repr(obj));
+    value = PyLong_AsLongLongAndOverflow(obj, &overflow);
+    if (overflow)
+        return _steal_write(out, PyLong_Type.tp_repr(obj));
+    if (value == -1 && PyErr_Occurred())
+        return -1;
+    u = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    do {
+        *--p = '0' + (char)(u % 10);
+        u /= 10;
+    } while (u);
+    if (value < 0)
+        *--p = '-';
+    return encoder_output_bytes(out, p, buf + sizeof(buf) - p);
+}
+
+static int
+encoder_write_float(PyEncoderObject *s, encoder_output *out, PyObject *obj)
+{
+    /* Write the JSON representation of a float */
+    double d = PyFloat_AS_DOUBLE(obj);
+    char *repr;
+    int rv;
+
+    if (out->write == NULL || !out->binary || !Py_IS_FINITE(d))
+        return _steal_write(out, encoder_encode_float(s, obj));
+    repr = PyOS_double_to_string(d, 'r', 0, Py_DTSF_ADD_DOT_0, NULL);
+    if (repr == NULL)
+        return -1;
+    rv = encoder_output_bytes(out, repr, strlen(repr));
+    PyMem_Free(repr);
+    return rv;
+}
+
+static int
+encoder_listencode_obj(PyEncoderObject *s, encoder_output *out,
                        PyObject *obj, Py_ssize_t indent_level)
 {
     /* Encode Python object obj to a JSON term */
@@ -1407,38 +2829,29 @@ encoder_listencode_obj(PyEncoderObject *s, _PyAccu *acc,
         PyObject *cstr = _encoded_const(obj);
         if (cstr == NULL)
             return -1;
-        return _steal_accumulate(acc, cstr);
+        return _steal_write(out, cstr);
     }
     else if (PyUnicode_Check(obj))
     {
-        PyObject *encoded = encoder_encode_string(s, obj);
-        if (encoded == NULL)
-            return -1;
-        return _steal_accumulate(acc, encoded);
+        return encoder_write_string(s, out, obj);
     }
     else if (PyLong_Check(obj)) {
-        PyObject *encoded = PyLong_Type.tp_repr(obj);
-        if (encoded == NULL)
-            return -1;
-        return _steal_accumulate(acc, encoded);
+        return encoder_write_long(out, obj);
     }
     else if (PyFloat_Check(obj)) {
-        PyObject *encoded = encoder_encode_float(s, obj);
-        if (encoded == NULL)
-            return -1;
-        return _steal_accumulate(acc, encoded);
+        return encoder_write_float(s, out, obj);
     }
     else if (PyList_Check(obj) || PyTuple_Check(obj)) {
         if (Py_EnterRecursiveCall(" while encoding a JSON object"))
             return -1;
-        rv = encoder_listencode_list(s, acc, obj, indent_level);
+        rv = encoder_listencode_list(s, out, obj, indent_level);
         Py_LeaveRecursiveCall();
         return rv;
     }
     else if (PyDict_Check(obj)) {
         if (Py_EnterRecursiveCall(" while encoding a JSON object"))
             return -1;
-        rv = encoder_listencode_dict(s, acc, obj, indent_level);
+        rv = encoder_listencode_dict(s, out, obj, indent_level);
         Py_LeaveRecursiveCall();
         return rv;
     }
@@ -1472,7 +2885,7 @@ encoder_listencode_obj(PyEncoderObject *s, _PyAccu *acc,
             Py_XDECREF(ident);
             return -1;
         }
-        rv = encoder_listencode_obj(s, acc, newobj, indent_level);
+        rv = encoder_listencode_obj(s, out, newobj, indent_level);
         Py_LeaveRecursiveCall();
 
         Py_DECREF(newobj);
@@ -1492,7 +2905,7 @@ encoder_listencode_obj(PyEncoderObject *s, _PyAccu *acc,
 }
 
 static int
-encoder_listencode_dict(PyEncoderObject *s, _PyAccu *acc,
+encoder_listencode_dict(PyEncoderObject *s, encoder_output *out,
                         PyObject *dct, Py_ssize_t indent_level)
 {
     /* Encode Python dict dct a JSON term */
@@ -1513,7 +2926,7 @@ encoder_listencode_dict(PyEncoderObject *s, _PyAccu *acc,
         return -1;
     }
     if (PyDict_GET_SIZE(dct) == 0)  /* Fast path */
-        return _PyAccu_Accumulate(acc, empty_dict);
+        return encoder_write(out, empty_dict);
 
     if (s->markers != Py_None) {
         int has_key;
@@ -1531,7 +2944,7 @@ encoder_listencode_dict(PyEncoderObject *s, _PyAccu *acc,
         }
     }
 
-    if (_PyAccu_Accumulate(acc, open_dict))
+    if (encoder_write(out, open_dict))
         goto bail;
 
     if (s->indent != Py_None) {
@@ -1557,7 +2970,7 @@ encoder_listencode_dict(PyEncoderObject *s, _PyAccu *acc,
         goto bail;
     idx = 0;
     while ((item = PyIter_Next(it)) != NULL) {
-        PyObject *encoded, *key, *value;
+        PyObject *key, *value;
         if (!PyTuple_Check(item) || PyTuple_GET_SIZE(item) != 2) {
             PyErr_SetString(PyExc_ValueError, "items must return 2-tuples");
             goto bail;
@@ -1597,24 +3010,18 @@ encoder_listencode_dict(PyEncoderObject *s, _PyAccu *acc,
         }
 
         if (idx) {
-            if (_PyAccu_Accumulate(acc, s->item_separator))
+            if (encoder_write(out, s->item_separator))
                 goto bail;
         }
 
-        encoded = encoder_encode_string(s, kstr);
-        Py_CLEAR(kstr);
-        if (encoded == NULL)
+        if (encoder_write_string(s, out, kstr))
             goto bail;
-        if (_PyAccu_Accumulate(acc, encoded)) {
-            Py_DECREF(encoded);
-            goto bail;
-        }
-        Py_DECREF(encoded);
-        if (_PyAccu_Accumulate(acc, s->key_separator))
+        Py_CLEAR(kstr);
+        if (encoder_write(out, s->key_separator))
             goto bail;
 
         value = PyTuple_GET_ITEM(item, 1);
-        if (encoder_listencode_obj(s, acc, value, indent_level))
+        if (encoder_listencode_obj(s, out, value, indent_level))
             goto bail;
         idx += 1;
         Py_DECREF(item);
@@ -1634,7 +3041,7 @@ encoder_listencode_dict(PyEncoderObject *s, _PyAccu *acc,
 
         yield '\n' + (' ' * (_indent * _current_indent_level))
     }*/
-    if (_PyAccu_Accumulate(acc, close_dict))
+    if (encoder_write(out, close_dict))
         goto bail;
     return 0;
 
@@ -1648,7 +3055,7 @@ encoder_listencode_dict(PyEncoderObject *s, _PyAccu *acc,
 
 
 static int
-encoder_listencode_list(PyEncoderObject *s, _PyAccu *acc,
+encoder_listencode_list(PyEncoderObject *s, encoder_output *out,
                         PyObject *seq, Py_ssize_t indent_level)
 {
     /* Encode Python list seq to a JSON term */
@@ -1671,7 +3078,7 @@ encoder_listencode_list(PyEncoderObject *s, _PyAccu *acc,
         return -1;
     if (PySequence_Fast_GET_SIZE(s_fast) == 0) {
         Py_DECREF(s_fast);
-        return _PyAccu_Accumulate(acc, empty_array);
+        return encoder_write(out, empty_array);
     }
 
     if (s->markers != Py_None) {
@@ -1690,7 +3097,7 @@ encoder_listencode_list(PyEncoderObject *s, _PyAccu *acc,
         }
     }
 
-    if (_PyAccu_Accumulate(acc, open_array))
+    if (encoder_write(out, open_array))
         goto bail;
     if (s->indent != Py_None) {
         /* TODO: DOES NOT RUN */
@@ -1704,10 +3111,10 @@ encoder_listencode_list(PyEncoderObject *s, _PyAccu *acc,
     for (i = 0; i < PySequence_Fast_GET_SIZE(s_fast); i++) {
         PyObject *obj = PySequence_Fast_GET_ITEM(s_fast, i);
         if (i) {
-            if (_PyAccu_Accumulate(acc, s->item_separator))
+            if (encoder_write(out, s->item_separator))
                 goto bail;
         }
-        if (encoder_listencode_obj(s, acc, obj, indent_level))
+        if (encoder_listencode_obj(s, out, obj, indent_level))
             goto bail;
     }
     if (ident != NULL) {
@@ -1722,7 +3129,7 @@ encoder_listencode_list(PyEncoderObject *s, _PyAccu *acc,
 
         yield '\n' + (' ' * (_indent * _current_indent_level))
     }*/
-    if (_PyAccu_Accumulate(acc, close_array))
+    if (encoder_write(out, close_array))
         goto bail;
     Py_DECREF(s_fast);
     return 0;
@@ -1772,6 +3179,18 @@ encoder_clear(PyEncoderObject *self)
 
 PyDoc_STRVAR(encoder_doc, "_iterencode(obj, _current_indent_level) -> iterable");
 
+PyDoc_STRVAR(encoder_dump_doc,
+"dump(obj, write, binary=False, chunk_size=65536)\n\
+\n\
+Encode obj and pass the output to write() in chunks of about chunk_size\n\
+characters.  If binary is true, the chunks are UTF-8 encoded bytes.");
+
+static PyMethodDef encoder_methods[] = {
+    {"dump", (PyCFunction)(void(*)(void))encoder_dump,
+        METH_VARARGS | METH_KEYWORDS, encoder_dump_doc},
+    {NULL, NULL}
+};
+
 static PyType_Slot PyEncoderType_slots[] = {
     {Py_tp_doc, (void *)encoder_doc},
     {Py_tp_dealloc, encoder_dealloc},
@@ -1779,6 +3198,7 @@ static PyType_Slot PyEncoderType_slots[] = {
     {Py_tp_traverse, encoder_traverse},
     {Py_tp_clear, encoder_clear},
     {Py_tp_members, encoder_members},
+    {Py_tp_methods, encoder_methods},
     {Py_tp_new, encoder_new},
     {0, 0}
 };
@@ -1825,6 +3245,18 @@ _json_exec(PyObject *module)
         return -1;
     }
 
+    state->PyStreamDecoderType = PyType_FromModuleAndSpec(
+        module, &PyStreamDecoderType_spec, NULL);
+    if (state->PyStreamDecoderType == NULL) {
+        return -1;
+    }
+    Py_INCREF(state->PyStreamDecoderType);
+    if (PyModule_AddObject(module, "make_stream_decoder",
+                           state->PyStreamDecoderType) < 0) {
+        Py_DECREF(state->PyStreamDecoderType);
+        return -1;
+    }
+
     state->PyEncoderType = PyType_FromSpec(&PyEncoderType_spec);
     if (state->PyEncoderType == NULL) {
         return -1;
@@ -1843,6 +3275,7 @@ _jsonmodule_traverse(PyObject *module, visitproc visit, void *arg)
 {
     _jsonmodulestate *state = get_json_state(module);
     Py_VISIT(state->PyScannerType);
+    Py_VISIT(state->PyStreamDecoderType);
     Py_VISIT(state->PyEncoderType);
     return 0;
 }
@@ -1852,6 +3285,7 @@ _jsonmodule_clear(PyObject *module)
 {
     _jsonmodulestate *state = get_json_state(module);
     Py_CLEAR(state->PyScannerType);
+    Py_CLEAR(state->PyStreamDecoderType);
     Py_CLEAR(state->PyEncoderType);
     return 0;
 }
@@ -9,6 +9,7 @@
 #endif
 
 #include "Python.h"
+#include "pycore_atomic.h"        // _Py_atomic_int
 #include "structmember.h"         // PyMemberDef
 
 PyDoc_STRVAR(pickle_module_doc,
@@ -131,7 +132,12 @@ enum {
 
     FRAME_SIZE_MIN = 4,
     FRAME_SIZE_TARGET = 64 * 1024,
-    FRAME_HEADER_SIZE = 9
+    FRAME_HEADER_SIZE = 9,
+
+    /* Size of the first payload which hands the writes to a regular file
+       over to a worker thread, and number of writes it can have pending. */
+    ASYNC_WRITE_MIN_SIZE = 1024 * 1024,
+    ASYNC_WRITE_QUEUE_SIZE = 64
 };
 
 /*************************************************************************/
@@ -614,6 +620,8 @@ typedef struct {
     PyMemoEntry *mt_table;
 } PyMemoTable;
 
+typedef struct AsyncWriter AsyncWriter;
+
 typedef struct PicklerObject {
     PyObject_HEAD
     PyMemoTable *memo;          /* Memo table, keep track of the seen
@@ -651,6 +659,10 @@ typedef struct PicklerObject {
                                    the name of globals for Python 2.x. */
     PyObject *fast_memo;
     PyObject *buffer_callback;  /* Callback for out-of-band buffers, or NULL */
+    AsyncWriter *async_writer;  /* Worker thread writing to the file, or NULL */
+    int async_checked;          /* True once the output stream was checked
+                                   for asynchronous writes in this dump. */
+    int background_write;       /* Allow writing from a worker thread. */
 } PicklerObject;
 
 typedef struct UnpicklerObject {
@@ -679,6 +691,8 @@ typedef struct UnpicklerObject {
     PyObject *readline;         /* readline() method of the input stream. */
     PyObject *peek;             /* peek() method of the input stream, or NULL */
     PyObject *buffers;          /* iterable of out-of-band buffers, or NULL */
+    PyObject *input_view;       /* memoryview of the input of loads() to
+                                   slice BYTEARRAY8 payloads from, or NULL */
 
     char *encoding;             /* Name of the encoding to be used for
                                    decoding strings pickled using Python
@@ -720,7 +734,11 @@ static PyTypeObject Unpickler_Type;
  difference. */
 
 #define MT_MINSIZE 8
-#define PERTURB_SHIFT 5
+#if SIZEOF_SIZE_T > 4
+#  define MT_HASH_MULTIPLIER 0x9E3779B97F4A7C15
+#else
+#  define MT_HASH_MULTIPLIER 0x9E3779B9
+#endif
 
 
 static PyMemoTable *
@@ -805,27 +823,23 @@ PyMemoTable_Del(PyMemoTable *self)
 }
 
 /* Since entries cannot be deleted from this hashtable, _PyMemoTable_Lookup()
-   can be considerably simpler than dictobject.c's lookdict(). */
+   can be considerably simpler than dictobject.c's lookdict().  The keys are
+   addresses, which are scrambled by a multiplicative hash so that linear
+   probing, which stays within a few cache lines, works well. */
 static PyMemoEntry *
 _PyMemoTable_Lookup(PyMemoTable *self, PyObject *key)
 {
-    size_t i;
-    size_t perturb;
     size_t mask = self->mt_mask;
     PyMemoEntry *table = self->mt_table;
     PyMemoEntry *entry;
-    Py_hash_t hash = (Py_hash_t)key >> 3;
-
-    i = hash & mask;
-    entry = &table[i];
-    if (entry->me_key == NULL || entry->me_key == key)
-        return entry;
+    size_t i = (uintptr_t)key * MT_HASH_MULTIPLIER;
 
-    for (perturb = hash; ; perturb >>= PERTURB_SHIFT) {
-        i = (i << 2) + i + perturb + 1;
+    i ^= i >> (4 * SIZEOF_SIZE_T);
+    for (;;) {
         entry = &table[i & mask];
-        if (entry->me_key == NULL || entry->me_key == key)
+        if (entry->me_key == key || entry->me_key == NULL)
             return entry;
+        i++;
     }
     Py_UNREACHABLE();
 }
@@ -931,7 +945,7 @@ PyMemoTable_Set(PyMemoTable *self, PyObject *key, Py_ssize_t value)
 }
 
 #undef MT_MINSIZE
-#undef PERTURB_SHIFT
+#undef MT_HASH_MULTIPLIER
 
 /*************************************************************************/
 
@@ -1002,6 +1016,384 @@ _Pickler_GetString(PicklerObject *self)
     return output_buffer;
 }
 
+/* Writer thread for dumping to a regular file.
+
+   If the pickler was created with background_write=True and a payload of at
+   least ASYNC_WRITE_MIN_SIZE bytes is dumped to a plain io.FileIO, or to an
+   io.BufferedWriter over one, the following output chunks and payloads are
+   handed over to a thread which writes them to the file descriptor without
+   holding the GIL.  Writing out a large payload thus overlaps with pickling
+   the rest of the object.  The pickler keeps the written objects alive (and
+   bytearrays locked against resizing) until the thread is done with them.
+   The file must not be used by anything else until the dump returns. */
+
+typedef struct {
+    PyObject *obj;          /* Owner of the data, or NULL if view is used */
+    Py_buffer view;         /* Buffer exported by the owner of the data */
+    const char *data;
+    Py_ssize_t size;
+} AsyncWriteItem;
+
+struct AsyncWriter {
+    PyObject *file;
+    int fd;
+    PyThread_type_lock mutex;           /* Protects the fields below */
+    PyThread_type_lock worker_wakeup;
+    PyThread_type_lock pickler_wakeup;
+    PyThread_type_lock exit_lock;       /* Held until the thread exits */
+    int worker_waiting;
+    int pickler_waiting;
+    int closing;
+    int error;                          /* errno of the first failed write */
+    size_t queued;                      /* Number of items pushed */
+    size_t written;                     /* Number of items processed */
+    size_t released;                    /* Not protected: pickler only */
+    AsyncWriteItem items[ASYNC_WRITE_QUEUE_SIZE];
+};
+
+static void
+_AsyncWriter_Run(void *arg)
+{
+    AsyncWriter *w = (AsyncWriter *)arg;
+
+    PyThread_acquire_lock(w->mutex, WAIT_LOCK);
+    for (;;) {
+        AsyncWriteItem *item;
+        const char *data;
+        Py_ssize_t size, n;
+        int error;
+
+        if (w->written == w->queued) {
+            if (w->closing)
+                break;
+            w->worker_waiting = 1;
+            PyThread_release_lock(w->mutex);
+            PyThread_acquire_lock(w->worker_wakeup, WAIT_LOCK);
+            PyThread_acquire_lock(w->mutex, WAIT_LOCK);
+            continue;
+        }
+        item = &w->items[w->written % ASYNC_WRITE_QUEUE_SIZE];
+        data = item->data;
+        size = item->size;
+        error = w->error;
+        PyThread_release_lock(w->mutex);
+
+        /* Skip the remaining items after an error. */
+        while (!error && size > 0) {
+            n = _Py_write_noraise(w->fd, data, (size_t)size);
+            if (n < 0) {
+                error = errno;
+                break;
+            }
+            data += n;
+            size -= n;
+        }
+
+        PyThread_acquire_lock(w->mutex, WAIT_LOCK);
+        w->error = error;
+        w->written++;
+        if (w->pickler_waiting) {
+            w->pickler_waiting = 0;
+            PyThread_release_lock(w->pickler_wakeup);
+        }
+    }
+    PyThread_release_lock(w->mutex);
+    /* This must be the last use of w: the pickler frees it as soon as it
+       acquires the lock. */
+    PyThread_release_lock(w->exit_lock);
+}
+
+/* Waits for the writer thread to make progress.  The mutex must be held. */
+static void
+_AsyncWriter_Wait(AsyncWriter *w)
+{
+    w->pickler_waiting = 1;
+    PyThread_release_lock(w->mutex);
+    Py_BEGIN_ALLOW_THREADS
+    PyThread_acquire_lock(w->pickler_wakeup, WAIT_LOCK);
+    Py_END_ALLOW_THREADS
+    PyThread_acquire_lock(w->mutex, WAIT_LOCK);
+}
+
+static void
+_AsyncWriter_Signal(AsyncWriter *w)
+{
+    if (w->worker_waiting) {
+        w->worker_waiting = 0;
+        PyThread_release_lock(w->worker_wakeup);
+    }
+}
+
+/* Releases the items which were written. */
+static void
+_AsyncWriter_Release(AsyncWriter *w, size_t written)
+{
+    while (w->released < written) {
+        AsyncWriteItem *item = &w->items[w->released % ASYNC_WRITE_QUEUE_SIZE];
+        if (item->obj != NULL)
+            Py_CLEAR(item->obj);
+        else
+            PyBuffer_Release(&item->view);
+        w->released++;
+    }
+}
+
+static int
+_AsyncWriter_SetError(int error)
+{
+    errno = error;
+    PyErr_SetFromErrno(PyExc_OSError);
+    return -1;
+}
+
+/* Queues size bytes at data for writing.  The data is owned either by obj,
+   whose reference is stolen, or by the buffer view, which is released once
+   the data is written. */
+static int
+_AsyncWriter_Push(AsyncWriter *w, PyObject *obj, Py_buffer *view,
+                  const char *data, Py_ssize_t size)
+{
+    AsyncWriteItem *item;
+    size_t written;
+    int error;
+
+    PyThread_acquire_lock(w->mutex, WAIT_LOCK);
+    while (w->queued - w->written == ASYNC_WRITE_QUEUE_SIZE && !w->error)
+        _AsyncWriter_Wait(w);
+    written = w->written;
+    error = w->error;
+    PyThread_release_lock(w->mutex);
+
+    _AsyncWriter_Release(w, written);
+    if (error || size == 0) {
+        if (obj != NULL)
+            Py_DECREF(obj);
+        else
+            PyBuffer_Release(view);
+        return error ? _AsyncWriter_SetError(error) : 0;
+    }
+
+    item = &w->items[w->queued % ASYNC_WRITE_QUEUE_SIZE];
+    item->obj = obj;
+    if (obj == NULL)
+        item->view = *view;
+    item->data = data;
+    item->size = size;
+
+    PyThread_acquire_lock(w->mutex, WAIT_LOCK);
+    w->queued++;
+    _AsyncWriter_Signal(w);
+    PyThread_release_lock(w->mutex);
+    return 0;
+}
+
+static void
+_AsyncWriter_Free(AsyncWriter *w)
+{
+    if (w->mutex != NULL)
+        PyThread_free_lock(w->mutex);
+    if (w->worker_wakeup != NULL)
+        PyThread_free_lock(w->worker_wakeup);
+    if (w->pickler_wakeup != NULL)
+        PyThread_free_lock(w->pickler_wakeup);
+    if (w->exit_lock != NULL)
+        PyThread_free_lock(w->exit_lock);
+    Py_XDECREF(w->file);
+    PyMem_Free(w);
+}
+
+/* Starts the writer thread if self->write is the write() method of a plain
+   file object over a regular file, and thus writing to its file descriptor
+   has the same effect as calling it.  Returns -1 on error, 0 otherwise,
+   whether the thread was started or not. */
+static int
+_Pickler_StartAsyncWriter(PicklerObject *self)
+{
+    _Py_IDENTIFIER(FileIO);
+    _Py_IDENTIFIER(BufferedWriter);
+    _Py_IDENTIFIER(raw);
+    _Py_IDENTIFIER(writable);
+    _Py_IDENTIFIER(flush);
+    PyObject *file, *io, *fileio_type = NULL, *writer_type = NULL;
+    PyObject *raw = NULL, *tmp;
+    struct _Py_stat_struct st;
+    AsyncWriter *w;
+    int fd, writable, status = -1;
+
+    self->async_checked = 1;
+    if (!PyCFunction_Check(self->write))
+        return 0;
+    file = PyCFunction_GET_SELF(self->write);
+    if (file == NULL ||
+        strcmp(((PyCFunctionObject *)self->write)->m_ml->ml_name, "write"))
+        return 0;
+
+    io = PyImport_ImportModule("_io");
+    if (io == NULL)
+        return -1;
+    fileio_type = _PyObject_GetAttrId(io, &PyId_FileIO);
+    writer_type = _PyObject_GetAttrId(io, &PyId_BufferedWriter);
+    Py_DECREF(io);
+    if (fileio_type == NULL || writer_type == NULL)
+        goto done;
+
+    if (Py_IS_TYPE(file, (PyTypeObject *)writer_type)) {
+        raw = _PyObject_GetAttrId(file, &PyId_raw);
+        if (raw == NULL)
+            goto done;
+    }
+    else {
+        Py_INCREF(file);
+        raw = file;
+    }
+    status = 0;
+    if (!Py_IS_TYPE(raw, (PyTypeObject *)fileio_type))
+        goto done;
+
+    /* Leave the errors of closed or read-only files to write(). */
+    fd = PyObject_AsFileDescriptor(raw);
+    if (fd < 0) {
+        PyErr_Clear();
+        goto done;
+    }
+    tmp = _PyObject_CallMethodIdNoArgs(raw, &PyId_writable);
+    writable = (tmp != NULL) ? PyObject_IsTrue(tmp) : -1;
+    Py_XDECREF(tmp);
+    if (writable <= 0) {
+        PyErr_Clear();
+        goto done;
+    }
+    if (_Py_fstat_noraise(fd, &st) != 0 || !S_ISREG(st.st_mode))
+        goto done;
+
+    /* The data buffered by the file object goes first. */
+    tmp = _PyObject_CallMethodIdNoArgs(file, &PyId_flush);
+    if (tmp == NULL) {
+        status = -1;
+        goto done;
+    }
+    Py_DECREF(tmp);
+
+    w = PyMem_Calloc(1, sizeof(AsyncWriter));
+    if (w == NULL) {
+        PyErr_NoMemory();
+        status = -1;
+        goto done;
+    }
+    Py_INCREF(file);
+    w->file = file;
+    w->fd = fd;
+    w->mutex = PyThread_allocate_lock();
+    w->worker_wakeup = PyThread_allocate_lock();
+    w->pickler_wakeup = PyThread_allocate_lock();
+    w->exit_lock = PyThread_allocate_lock();
+    if (w->mutex == NULL || w->worker_wakeup == NULL ||
+        w->pickler_wakeup == NULL || w->exit_lock == NULL) {
+        _AsyncWriter_Free(w);
+        PyErr_NoMemory();
+        status = -1;
+        goto done;
+    }
+    PyThread_acquire_lock(w->worker_wakeup, WAIT_LOCK);
+    PyThread_acquire_lock(w->pickler_wakeup, WAIT_LOCK);
+    PyThread_acquire_lock(w->exit_lock, WAIT_LOCK);
+    /* Keep writing synchronously if no thread can be started. */
+    if (PyThread_start_new_thread(_AsyncWriter_Run, w) ==
+        PYTHREAD_INVALID_THREAD_ID) {
+        _AsyncWriter_Free(w);
+        goto done;
+    }
+    self->async_writer = w;
+
+  done:
+    Py_XDECREF(raw);
+    Py_XDECREF(fileio_type);
+    Py_XDECREF(writer_type);
+    return status;
+}
+
+/* Waits until the writer thread has written all the queued data and stops
+   it.  Returns -1 with an exception set if a write failed. */
+static int
+_Pickler_FinishAsyncWrites(PicklerObject *self)
+{
+    _Py_IDENTIFIER(seek);
+    AsyncWriter *w = self->async_writer;
+    PyObject *file, *result;
+    int error;
+
+    if (w == NULL)
+        return 0;
+    self->async_writer = NULL;
+
+    PyThread_acquire_lock(w->mutex, WAIT_LOCK);
+    w->closing = 1;
+    _AsyncWriter_Signal(w);
+    PyThread_release_lock(w->mutex);
+    /* Join the thread: it releases exit_lock once it no longer uses w. */
+    Py_BEGIN_ALLOW_THREADS
+    PyThread_acquire_lock(w->exit_lock, WAIT_LOCK);
+    Py_END_ALLOW_THREADS
+    error = w->error;
+
+    _AsyncWriter_Release(w, w->queued);
+    file = w->file;
+    Py_INCREF(file);
+    _AsyncWriter_Free(w);
+
+    if (error) {
+        Py_DECREF(file);
+        return _AsyncWriter_SetError(error);
+    }
+    /* Update the position cached by io.BufferedWriter. */
+    result = _PyObject_CallMethodId(file, &PyId_seek, "ii", 0, SEEK_CUR);
+    Py_DECREF(file);
+    if (result == NULL)
+        return -1;
+    Py_DECREF(result);
+    return 0;
+}
+
+/* Like _Pickler_FinishAsyncWrites(), for when an error occurred already. */
+static void
+_Pickler_AbortAsyncWrites(PicklerObject *self)
+{
+    PyObject *exc, *val, *tb;
+
+    if (self->async_writer == NULL)
+        return;
+    PyErr_Fetch(&exc, &val, &tb);
+    if (_Pickler_FinishAsyncWrites(self) < 0)
+        PyErr_Clear();
+    PyErr_Restore(exc, val, tb);
+}
+
+/* Queues the payload of _Pickler_write_bytes() for the writer thread. */
+static int
+_Pickler_PushPayload(PicklerObject *self, const char *data,
+                     Py_ssize_t data_size, PyObject *payload)
+{
+    Py_buffer view;
+
+    if (payload != NULL && PyBytes_CheckExact(payload)) {
+        Py_INCREF(payload);
+        return _AsyncWriter_Push(self->async_writer, payload, NULL,
+                                 data, data_size);
+    }
+    if (payload != NULL) {
+        if (PyObject_GetBuffer(payload, &view, PyBUF_SIMPLE) == 0) {
+            return _AsyncWriter_Push(self->async_writer, NULL, &view,
+                                     data, data_size);
+        }
+        PyErr_Clear();
+    }
+    payload = PyBytes_FromStringAndSize(data, data_size);
+    if (payload == NULL)
+        return -1;
+    return _AsyncWriter_Push(self->async_writer, payload, NULL,
+                             PyBytes_AS_STRING(payload), data_size);
+}
+
 static int
 _Pickler_FlushToFile(PicklerObject *self)
 {
@@ -1014,6 +1406,12 @@ _Pickler_FlushToFile(PicklerObject *self)
     if (output == NULL)
         return -1;
 
+    if (self->async_writer != NULL) {
+        return _AsyncWriter_Push(self->async_writer, output, NULL,
+                                 PyBytes_AS_STRING(output),
+                                 PyBytes_GET_SIZE(output));
+    }
+
     result = _Pickle_FastCall(self->write, output);
     Py_XDECREF(result);
     return (result == NULL) ? -1 : 0;
@@ -1125,6 +1523,9 @@ _Pickler_New(void)
     self->max_output_len = WRITE_BUF_SIZE;
     self->output_len = 0;
     self->reducer_override = NULL;
+    self->async_writer = NULL;
+    self->async_checked = 0;
+    self->background_write = 0;
 
     self->memo = PyMemoTable_New();
     self->output_buffer = PyBytes_FromStringAndSize(NULL,
@@ -1218,6 +1619,23 @@ _Unpickler_SetStringInput(UnpicklerObject *self, PyObject *input)
     return self->input_len;
 }
 
+/* Makes load_counted_bytearray() return slices of the input set by
+   _Unpickler_SetStringInput() instead of copies. */
+static int
+_Unpickler_SetInputView(UnpicklerObject *self, PyObject *input)
+{
+    _Py_IDENTIFIER(cast);
+    PyObject *view;
+
+    view = PyMemoryView_FromObject(input);
+    if (view == NULL)
+        return -1;
+    Py_XSETREF(self->input_view,
+               _PyObject_CallMethodId(view, &PyId_cast, "s", "B"));
+    Py_DECREF(view);
+    return (self->input_view == NULL) ? -1 : 0;
+}
+
 static int
 bad_readline(void)
 {
@@ -1605,6 +2023,7 @@ _Unpickler_New(void)
     self->readline = NULL;
     self->peek = NULL;
     self->buffers = NULL;
+    self->input_view = NULL;
     self->encoding = NULL;
     self->errors = NULL;
     self->marks = NULL;
@@ -2309,6 +2728,12 @@ _Pickler_write_bytes(PicklerObject *self,
         /* Bypass the in-memory buffer to directly stream large data
            into the underlying file object. */
         PyObject *result, *mem = NULL;
+        if (self->background_write && self->async_writer == NULL &&
+            !self->async_checked && data_size >= ASYNC_WRITE_MIN_SIZE) {
+            if (_Pickler_StartAsyncWriter(self) < 0) {
+                return -1;
+            }
+        }
         /* Dump the output buffer to the file. */
         if (_Pickler_FlushToFile(self) < 0) {
             return -1;
@@ -2316,20 +2741,27 @@ _Pickler_write_bytes(PicklerObject *self,
 
         /* Stream write the payload into the file without going through the
            output buffer. */
-        if (payload == NULL) {
-            /* TODO: It would be better to use a memoryview with a linked
-               original string if this is possible. */
-            payload = mem = PyBytes_FromStringAndSize(data, data_size);
-            if (payload == NULL) {
+        if (self->async_writer != NULL) {
+            if (_Pickler_PushPayload(self, data, data_size, payload) < 0) {
                 return -1;
             }
         }
-        result = PyObject_CallOneArg(self->write, payload);
-        Py_XDECREF(mem);
-        if (result == NULL) {
-            return -1;
+        else {
+            if (payload == NULL) {
+                /* TODO: It would be better to use a memoryview with a linked
+                   original string if this is possible. */
+                payload = mem = PyBytes_FromStringAndSize(data, data_size);
+                if (payload == NULL) {
+                    return -1;
+                }
+            }
+            result = PyObject_CallOneArg(self->write, payload);
+            Py_XDECREF(mem);
+            if (result == NULL) {
+                return -1;
+            }
+            Py_DECREF(result);
         }
-        Py_DECREF(result);
 
         /* Reinitialize the buffer for subsequent calls to _Pickler_Write. */
         if (_Pickler_ClearBuffer(self) < 0) {
@@ -4297,7 +4729,9 @@ save(PicklerObject *self, PyObject *obj, int pers_save)
 
     /* Check the memo to see if it has the object. If so, generate
        a GET (or BINGET) opcode, instead of pickling the object
-       once again. */
+       once again.  Short strings go through the memo too: a BINGET of
+       a repeated 1-character string is shorter and quicker to write
+       than the string itself. */
     if (PyMemoTable_Get(self->memo, obj)) {
         return memo_get(self, obj);
     }
@@ -4582,10 +5016,13 @@ _pickle_Pickler_dump(PicklerObject *self, PyObject *obj)
     if (_Pickler_ClearBuffer(self) < 0)
         return NULL;
 
-    if (dump(self, obj) < 0)
+    self->async_checked = 0;
+    if (dump(self, obj) < 0 || _Pickler_FlushToFile(self) < 0) {
+        _Pickler_AbortAsyncWrites(self);
         return NULL;
+    }
 
-    if (_Pickler_FlushToFile(self) < 0)
+    if (_Pickler_FinishAsyncWrites(self) < 0)
         return NULL;
 
     Py_RETURN_NONE;
@@ -4683,6 +5120,7 @@ _pickle.Pickler.__init__
   protocol: object = None
   fix_imports: bool = True
   buffer_callback: object = None
+  background_write: bool = False
 
 This takes a binary file for writing a pickle data stream.
 
@@ -4715,13 +5153,19 @@ buffer is serialized in-band, i.e. inside the pickle stream.
 It is an error if *buffer_callback* is not None and *protocol*
 is None or smaller than 5.
 
+If *background_write* is true, large payloads dumped to a regular
+file opened with open() may be written out by a worker thread while
+the rest of the object is pickled.  The file, and the buffers being
+pickled, must then not be used by other code until dump() returns.
+
 [clinic start generated code]*/
 
 static int
 _pickle_Pickler___init___impl(PicklerObject *self, PyObject *file,
                               PyObject *protocol, int fix_imports,
-                              PyObject *buffer_callback)
-/*[clinic end generated code: output=0abedc50590d259b input=a7c969699bf5dad3]*/
+                              PyObject *buffer_callback,
+                              int background_write)
+/*[clinic end generated code: output=9e5396401dd1d29f input=a75492af797929d4]*/
 {
     _Py_IDENTIFIER(persistent_id);
     _Py_IDENTIFIER(dispatch_table);
@@ -4738,6 +5182,7 @@ _pickle_Pickler___init___impl(PicklerObject *self, PyObject *file,
 
     if (_Pickler_SetBufferCallback(self, buffer_callback) < 0)
         return -1;
+    self->background_write = background_write;
 
     /* memo and output_buffer may have already been created in _Pickler_New */
     if (self->memo == NULL) {
@@ -5558,6 +6003,21 @@ load_counted_bytearray(UnpicklerObject *self)
         return -1;
     }
 
+    if (self->input_view != NULL) {
+        /* The payload is in the input buffer, no need to copy it. */
+        if (size > self->input_len - self->next_read_idx) {
+            return bad_readline();
+        }
+        bytearray = PySequence_GetSlice(self->input_view, self->next_read_idx,
+                                        self->next_read_idx + size);
+        if (bytearray == NULL) {
+            return -1;
+        }
+        self->next_read_idx += size;
+        PDATA_PUSH(self->stack, bytearray, -1);
+        return 0;
+    }
+
     bytearray = PyByteArray_FromStringAndSize(NULL, size);
     if (bytearray == NULL) {
         return -1;
@@ -7153,6 +7613,7 @@ Unpickler_dealloc(UnpicklerObject *self)
     Py_XDECREF(self->stack);
     Py_XDECREF(self->pers_func);
     Py_XDECREF(self->buffers);
+    Py_XDECREF(self->input_view);
     if (self->buffer.buf != NULL) {
         PyBuffer_Release(&self->buffer);
         self->buffer.buf = NULL;
@@ -7177,6 +7638,7 @@ Unpickler_traverse(UnpicklerObject *self, visitproc visit, void *arg)
     Py_VISIT(self->stack);
     Py_VISIT(self->pers_func);
     Py_VISIT(self->buffers);
+    Py_VISIT(self->input_view);
     return 0;
 }
 
@@ -7190,6 +7652,7 @@ Unpickler_clear(UnpicklerObject *self)
     Py_CLEAR(self->stack);
     Py_CLEAR(self->pers_func);
     Py_CLEAR(self->buffers);
+    Py_CLEAR(self->input_view);
     if (self->buffer.buf != NULL) {
         PyBuffer_Release(&self->buffer);
         self->buffer.buf = NULL;
@@ -7691,10 +8154,12 @@ _pickle_dump_impl(PyObject *module, PyObject *obj, PyObject *file,
     if (_Pickler_SetBufferCallback(pickler, buffer_callback) < 0)
         goto error;
 
-    if (dump(pickler, obj) < 0)
+    if (dump(pickler, obj) < 0 || _Pickler_FlushToFile(pickler) < 0) {
+        _Pickler_AbortAsyncWrites(pickler);
         goto error;
+    }
 
-    if (_Pickler_FlushToFile(pickler) < 0)
+    if (_Pickler_FinishAsyncWrites(pickler) < 0)
         goto error;
 
     Py_DECREF(pickler);
@@ -7844,6 +8309,7 @@ _pickle.loads
   encoding: str = 'ASCII'
   errors: str = 'strict'
   buffers: object(c_default="NULL") = ()
+  copy: bool = True
 
 Read and return an object from the given pickle data.
 
@@ -7859,13 +8325,16 @@ map the old Python 2 names to the new names used in Python 3.  The
 instances pickled by Python 2; these default to 'ASCII' and 'strict',
 respectively.  The *encoding* can be 'bytes' to read these 8-bit
 string instances as bytes objects.
+
+If *copy* is false, bytearrays pickled in-band with protocol 5 are
+loaded as memoryview slices of *data* rather than copies.
 [clinic start generated code]*/
 
 static PyObject *
 _pickle_loads_impl(PyObject *module, PyObject *data, int fix_imports,
                    const char *encoding, const char *errors,
-                   PyObject *buffers)
-/*[clinic end generated code: output=82ac1e6b588e6d02 input=b3615540d0535087]*/
+                   PyObject *buffers, int copy)
+/*[clinic end generated code: output=e690307607c12ffa input=c0c9109dada9eaf9]*/
 {
     PyObject *result;
     UnpicklerObject *unpickler = _Unpickler_New();
@@ -7876,6 +8345,9 @@ _pickle_loads_impl(PyObject *module, PyObject *data, int fix_imports,
     if (_Unpickler_SetStringInput(unpickler, data) < 0)
         goto error;
 
+    if (!copy && _Unpickler_SetInputView(unpickler, data) < 0)
+        goto error;
+
     if (_Unpickler_SetInputEncoding(unpickler, encoding, errors) < 0)
         goto error;
 
@@ -117,6 +117,40 @@ gc_collect(PyObject *module, PyObject *const *args, Py_ssize_t nargs, PyObject *
     return return_value;
 }
 
+PyDoc_STRVAR(gc_collect_increment__doc__,
+"collect_increment($module, /)\n"
+"--\n"
+"\n"
+"Collect an increment of the oldest generation.\n"
+"\n"
+"The increment holds the young generations and at most as many objects\n"
+"of the oldest generation as the budget set by set_incremental().  A\n"
+"RuntimeError is raised if incremental collection is disabled.\n"
+"\n"
+"The number of unreachable objects is returned.");
+
+#define GC_COLLECT_INCREMENT_METHODDEF    \
+    {"collect_increment", (PyCFunction)gc_collect_increment, METH_NOARGS, gc_collect_increment__doc__},
+
+static Py_ssize_t
+gc_collect_increment_impl(PyObject *module);
+
+static PyObject *
+gc_collect_increment(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    Py_ssize_t _return_value;
+
+    _return_value = gc_collect_increment_impl(module);
+    if ((_return_value == -1) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyLong_FromSsize_t(_return_value);
+
+exit:
+    return return_value;
+}
+
 PyDoc_STRVAR(gc_set_debug__doc__,
 "set_debug($module, flags, /)\n"
 "--\n"
@@ -220,6 +254,136 @@ gc_get_count(PyObject *module, PyObject *Py_UNUSED(ignored))
     return gc_get_count_impl(module);
 }
 
+PyDoc_STRVAR(gc_set_incremental__doc__,
+"set_incremental($module, budget, /)\n"
+"--\n"
+"\n"
+"Set the budget of incremental collections of the oldest generation.\n"
+"\n"
+"When the threshold of the oldest generation is reached, only an\n"
+"increment made of the young generations and at most budget objects\n"
+"of the oldest generation is collected, which bounds the duration of\n"
+"the collection.  A budget of zero disables incremental collection.");
+
+#define GC_SET_INCREMENTAL_METHODDEF    \
+    {"set_incremental", (PyCFunction)gc_set_incremental, METH_O, gc_set_incremental__doc__},
+
+static PyObject *
+gc_set_incremental_impl(PyObject *module, Py_ssize_t budget);
+
+static PyObject *
+gc_set_incremental(PyObject *module, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    Py_ssize_t budget;
+
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(arg);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        budget = ival;
+    }
+    return_value = gc_set_incremental_impl(module, budget);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_get_incremental__doc__,
+"get_incremental($module, /)\n"
+"--\n"
+"\n"
+"Return the budget of incremental collections, or 0 if disabled.");
+
+#define GC_GET_INCREMENTAL_METHODDEF    \
+    {"get_incremental", (PyCFunction)gc_get_incremental, METH_NOARGS, gc_get_incremental__doc__},
+
+static Py_ssize_t
+gc_get_incremental_impl(PyObject *module);
+
+static PyObject *
+gc_get_incremental(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    Py_ssize_t _return_value;
+
+    _return_value = gc_get_incremental_impl(module);
+    if ((_return_value == -1) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyLong_FromSsize_t(_return_value);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_set_threads__doc__,
+"set_threads($module, threads, /)\n"
+"--\n"
+"\n"
+"Set the number of threads used by large collections.\n"
+"\n"
+"Collections of many objects split the search for unreachable objects\n"
+"between the calling thread and threads-1 helper threads.  The\n"
+"tp_traverse slots of all tracked objects must be safe to call\n"
+"concurrently.");
+
+#define GC_SET_THREADS_METHODDEF    \
+    {"set_threads", (PyCFunction)gc_set_threads, METH_O, gc_set_threads__doc__},
+
+static PyObject *
+gc_set_threads_impl(PyObject *module, int threads);
+
+static PyObject *
+gc_set_threads(PyObject *module, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    int threads;
+
+    threads = _PyLong_AsInt(arg);
+    if (threads == -1 && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = gc_set_threads_impl(module, threads);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(gc_get_threads__doc__,
+"get_threads($module, /)\n"
+"--\n"
+"\n"
+"Return the number of threads used by large collections.");
+
+#define GC_GET_THREADS_METHODDEF    \
+    {"get_threads", (PyCFunction)gc_get_threads, METH_NOARGS, gc_get_threads__doc__},
+
+static int
+gc_get_threads_impl(PyObject *module);
+
+static PyObject *
+gc_get_threads(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    PyObject *return_value = NULL;
+    int _return_value;
+
+    _return_value = gc_get_threads_impl(module);
+    if ((_return_value == -1) && PyErr_Occurred()) {
+        goto exit;
+    }
+    return_value = PyLong_FromLong((long)_return_value);
+
+exit:
+    return return_value;
+}
+
 PyDoc_STRVAR(gc_get_objects__doc__,
 "get_objects($module, /, generation=None)\n"
 "--\n"
@@ -325,6 +489,33 @@ gc_freeze(PyObject *module, PyObject *Py_UNUSED(ignored))
     return gc_freeze_impl(module);
 }
 
+#if defined(Py_IMMORTAL_INSTANCES)
+
+PyDoc_STRVAR(gc_immortalize__doc__,
+"immortalize($module, /)\n"
+"--\n"
+"\n"
+"Freeze all tracked objects and make them immortal.\n"
+"\n"
+"The objects in the permanent generation, all the objects reachable from\n"
+"them and the interned strings are never deallocated and their reference\n"
+"count is no longer updated.  This keeps the memory pages holding them\n"
+"shared with the processes forked afterwards.");
+
+#define GC_IMMORTALIZE_METHODDEF    \
+    {"immortalize", (PyCFunction)gc_immortalize, METH_NOARGS, gc_immortalize__doc__},
+
+static PyObject *
+gc_immortalize_impl(PyObject *module);
+
+static PyObject *
+gc_immortalize(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return gc_immortalize_impl(module);
+}
+
+#endif /* defined(Py_IMMORTAL_INSTANCES) */
+
 PyDoc_STRVAR(gc_unfreeze__doc__,
 "unfreeze($module, /)\n"
 "--\n"
@@ -372,4 +563,8 @@ gc_get_freeze_count(PyObject *module, PyObject *Py_UNUSED(ignored))
 exit:
     return return_value;
 }
-/*[clinic end generated code: output=61e15f3a549f3ab5 input=a9049054013a1b77]*/
+
+#ifndef GC_IMMORTALIZE_METHODDEF
+    #define GC_IMMORTALIZE_METHODDEF
+#endif /* !defined(GC_IMMORTALIZE_METHODDEF) */
+/*[clinic end generated code: output=68deac24b81b7b0b input=a9049054013a1b77]*/
@@ -44,6 +44,14 @@ module gc
 #  define GC_DEBUG
 #endif
 
+/* Large collections can split subtract_refs() and the reachability
+   analysis across helper threads, see gc.set_threads().  The helpers
+   update the gc headers with the GCC atomic builtins.  The top bit of
+   _gc_prev is only free above gc_refs on 64-bit platforms. */
+#if defined(HAVE_BUILTIN_ATOMIC) && SIZEOF_VOID_P == 8
+#  define GC_PARALLEL
+#endif
+
 #define GC_NEXT _PyGCHead_NEXT
 #define GC_PREV _PyGCHead_PREV
 
@@ -68,6 +76,11 @@ module gc
 // most gc_list_* functions for it.
 #define NEXT_MASK_UNREACHABLE  (1)
 
+// Second lowest bit of _gc_next tells whether an object of the oldest
+// generation was examined by the current incremental scan, see
+// gc_collect_increment().  update_refs() clears it.
+#define NEXT_MASK_OLD_SPACE_1  _PyGC_NEXT_MASK_OLD_SPACE_1
+
 /* Get an object's GC head */
 #define AS_GC(o) ((PyGC_Head *)(o)-1)
 
@@ -116,6 +129,23 @@ gc_decref(PyGC_Head *g)
     g->_gc_prev -= 1 << _PyGC_PREV_SHIFT;
 }
 
+static inline int
+gc_old_space(PyGC_Head *g)
+{
+    return (g->_gc_next & NEXT_MASK_OLD_SPACE_1) != 0;
+}
+
+static inline void
+gc_set_old_space(PyGC_Head *g, int space)
+{
+    if (space) {
+        g->_gc_next |= NEXT_MASK_OLD_SPACE_1;
+    }
+    else {
+        g->_gc_next &= ~NEXT_MASK_OLD_SPACE_1;
+    }
+}
+
 /* set for debugging information */
 #define DEBUG_STATS             (1<<0) /* print collection statistics */
 #define DEBUG_COLLECTABLE       (1<<1) /* print collectable objects */
@@ -140,6 +170,7 @@ void
 _PyGC_InitState(GCState *gcstate)
 {
     gcstate->enabled = 1; /* automatic collection enabled? */
+    gcstate->threads = 1;
 
 #define _GEN_HEAD(n) GEN_HEAD(gcstate, n)
     struct gc_generation generations[NUM_GENERATIONS] = {
@@ -228,6 +259,12 @@ NEXT_MASK_UNREACHABLE
     The flag is unset and the object is moved back to "reachable" set.
 
     move_legacy_finalizers() will remove this flag from "unreachable" set.
+
+NEXT_MASK_OLD_SPACE_1
+    When the oldest generation is collected incrementally, this flag tells
+    whether its objects were already examined by the current scan.  It is
+    kept between collections (list functions preserve it) and cleared by
+    update_refs() for the objects being collected.
 */
 
 /*** list functions ***/
@@ -339,6 +376,17 @@ gc_list_clear_collecting(PyGC_Head *collectable)
     }
 }
 
+/* Walk the list and set the NEXT_MASK_OLD_SPACE_1 flag of all objects
+ * to `space` */
+static void
+gc_list_set_space(PyGC_Head *list, int space)
+{
+    PyGC_Head *gc;
+    for (gc = GC_NEXT(list); gc != list; gc = GC_NEXT(gc)) {
+        gc_set_old_space(gc, space);
+    }
+}
+
 /* Append objects in a GC list to a Python list.
  * Return 0 if all OK, < 0 if error (out of memory for list)
  */
@@ -399,7 +447,7 @@ validate_list(PyGC_Head *head, enum flagstates flags)
     PyGC_Head *gc = GC_NEXT(head);
     while (gc != head) {
         PyGC_Head *trueprev = GC_PREV(gc);
-        PyGC_Head *truenext = (PyGC_Head *)(gc->_gc_next  & ~NEXT_MASK_UNREACHABLE);
+        PyGC_Head *truenext = GC_NEXT(gc);
         assert(truenext != NULL);
         assert(trueprev == prev);
         assert((gc->_gc_prev & PREV_MASK_COLLECTING) == prev_value);
@@ -415,15 +463,58 @@ validate_list(PyGC_Head *head, enum flagstates flags)
 
 /*** end of list stuff ***/
 
+/* Number of consecutive objects of a collected list handled as a unit of
+   work by the helper threads. */
+#define GC_SEGMENT_SIZE 2048
+
+/* Collections of fewer segments than this are not worth starting helper
+   threads for. */
+#define GC_PARALLEL_MIN_SEGMENTS 32
+
+/* The first object of each segment of a list, filled by update_refs(). */
+struct gc_segments {
+    PyGC_Head **starts;
+    Py_ssize_t size;
+    Py_ssize_t allocated;
+    int nomemory;
+};
+
+static void
+gc_segments_append(struct gc_segments *segments, PyGC_Head *gc)
+{
+    if (segments->nomemory) {
+        return;
+    }
+    if (segments->size == segments->allocated) {
+        Py_ssize_t allocated = segments->allocated ? 2 * segments->allocated : 64;
+        PyGC_Head **starts = PyMem_RawRealloc(segments->starts,
+                                              allocated * sizeof(PyGC_Head *));
+        if (starts == NULL) {
+            segments->nomemory = 1;
+            return;
+        }
+        segments->starts = starts;
+        segments->allocated = allocated;
+    }
+    segments->starts[segments->size++] = gc;
+}
+
 
 /* Set all gc_refs = ob_refcnt.  After this, gc_refs is > 0 and
  * PREV_MASK_COLLECTING bit is set for all objects in containers.
+ * NEXT_MASK_OLD_SPACE_1 is cleared so that _gc_next only holds a pointer
+ * while collecting.
  */
 static void
-update_refs(PyGC_Head *containers)
+update_refs(PyGC_Head *containers, struct gc_segments *segments)
 {
     PyGC_Head *gc = GC_NEXT(containers);
+    Py_ssize_t n = 0;
     for (; gc != containers; gc = GC_NEXT(gc)) {
+        if (segments != NULL && n++ % GC_SEGMENT_SIZE == 0) {
+            gc_segments_append(segments, gc);
+        }
+        gc_set_old_space(gc, 0);
         gc_reset_refs(gc, Py_REFCNT(FROM_GC(gc)));
         /* Python's cyclic gc should never see an incoming refcount
          * of 0:  if something decref'ed to 0, it should have been
@@ -632,6 +723,385 @@ move_unreachable(PyGC_Head *young, PyGC_Head *unreachable)
     unreachable->_gc_next &= ~NEXT_MASK_UNREACHABLE;
 }
 
+#ifdef GC_PARALLEL
+/* Parallel reachability analysis
+ * -------------------------------
+ *
+ * After gc.set_threads(n), the collections of lists of at least
+ * GC_PARALLEL_MIN_SEGMENTS segments run subtract_refs() and the
+ * reachability analysis on n threads: the thread running the collection,
+ * which holds the GIL so that no other thread touches the objects, and n-1
+ * helper threads started for the collection and reused by all its phases.
+ * Each thread keeps claiming the next unprocessed segment of the list from
+ * a shared counter, so that the threads which are done with cheap segments
+ * take over the remaining work.
+ *
+ * The helper threads only call tp_traverse and update the gc headers, with
+ * atomic operations since several threads may visit the same object.
+ * They don't need a thread state and only allocate with PyMem_RawMalloc().
+ *
+ * move_unreachable() can't be split since it relies on the order of the
+ * list.  Instead, the threads mark with PREV_MASK_REACHABLE every object
+ * reachable from an object with gc_refs > 0, using a stack each.  Then
+ * move_unmarked() moves the objects left unmarked to the unreachable list
+ * in a single pass.
+ */
+
+/* Set in _gc_prev, above gc_refs, for the objects found reachable.  A
+   reference count can't exceed the number of pointers that fit in memory,
+   so on 64-bit platforms gc_refs never reaches this bit, see the
+   Py_BUILD_ASSERT() in deduce_unreachable_parallel(). */
+#define PREV_MASK_REACHABLE  ((uintptr_t)1 << (8 * SIZEOF_VOID_P - 1))
+
+struct gc_parallel {
+    PyGC_Head *containers;
+    struct gc_segments *segments;
+    /* index of the next segment to process, updated atomically */
+    Py_ssize_t next_segment;
+    /* set if a mark stack could not grow, see mark_reachable_serial() */
+    int overflow;
+};
+
+struct gc_mark_stack {
+    PyGC_Head **items;
+    Py_ssize_t size;
+    Py_ssize_t allocated;
+    int *overflow;
+};
+
+static inline uintptr_t
+gc_load_prev(PyGC_Head *gc)
+{
+    return __atomic_load_n(&gc->_gc_prev, __ATOMIC_RELAXED);
+}
+
+/* Claim the next segment [*start, *end) of the list.  Return 0 if all
+   segments were already claimed. */
+static int
+gc_claim_segment(struct gc_parallel *par, PyGC_Head **start, PyGC_Head **end)
+{
+    struct gc_segments *segments = par->segments;
+    Py_ssize_t i = __atomic_fetch_add(&par->next_segment, 1, __ATOMIC_RELAXED);
+    if (i >= segments->size) {
+        return 0;
+    }
+    *start = segments->starts[i];
+    *end = i + 1 < segments->size ? segments->starts[i + 1] : par->containers;
+    return 1;
+}
+
+/* A traversal callback for subtract_refs_worker(). */
+static int
+visit_decref_atomic(PyObject *op, void *parent)
+{
+    _PyObject_ASSERT(_PyObject_CAST(parent), !_PyObject_IsFreed(op));
+
+    if (_PyObject_IS_GC(op)) {
+        PyGC_Head *gc = AS_GC(op);
+        if (gc_load_prev(gc) & PREV_MASK_COLLECTING) {
+            uintptr_t prev = __atomic_fetch_sub(&gc->_gc_prev,
+                                                1 << _PyGC_PREV_SHIFT,
+                                                __ATOMIC_RELAXED);
+            _PyObject_ASSERT_WITH_MSG(op, (prev >> _PyGC_PREV_SHIFT) > 0,
+                                      "refcount is too small");
+            (void)prev;
+        }
+    }
+    return 0;
+}
+
+/* Same as subtract_refs(), for the segments claimed by this thread. */
+static void
+subtract_refs_worker(struct gc_parallel *par)
+{
+    PyGC_Head *gc, *end;
+    while (gc_claim_segment(par, &gc, &end)) {
+        for (; gc != end; gc = GC_NEXT(gc)) {
+            PyObject *op = FROM_GC(gc);
+            (void) Py_TYPE(op)->tp_traverse(op, (visitproc)visit_decref_atomic,
+                                            op);
+        }
+    }
+}
+
+static void
+gc_mark_push(struct gc_mark_stack *stack, PyGC_Head *gc)
+{
+    if (stack->size == stack->allocated) {
+        Py_ssize_t allocated = stack->allocated ? 2 * stack->allocated : 256;
+        PyGC_Head **items = PyMem_RawRealloc(stack->items,
+                                             allocated * sizeof(PyGC_Head *));
+        if (items == NULL) {
+            /* gc stays marked but its referents are not traversed */
+            __atomic_store_n(stack->overflow, 1, __ATOMIC_RELAXED);
+            return;
+        }
+        stack->items = items;
+        stack->allocated = allocated;
+    }
+    stack->items[stack->size++] = gc;
+}
+
+/* Mark gc reachable.  Return 1 if it was not marked yet. */
+static inline int
+gc_mark(PyGC_Head *gc)
+{
+    uintptr_t prev = __atomic_fetch_or(&gc->_gc_prev, PREV_MASK_REACHABLE,
+                                       __ATOMIC_RELAXED);
+    return (prev & PREV_MASK_REACHABLE) == 0;
+}
+
+/* A traversal callback for mark_reachable_worker(). */
+static int
+visit_mark(PyObject *op, struct gc_mark_stack *stack)
+{
+    if (!_PyObject_IS_GC(op)) {
+        return 0;
+    }
+    PyGC_Head *gc = AS_GC(op);
+    uintptr_t flags = gc_load_prev(gc) & (PREV_MASK_COLLECTING |
+                                          PREV_MASK_REACHABLE);
+    if (flags == PREV_MASK_COLLECTING && gc_mark(gc)) {
+        gc_mark_push(stack, gc);
+    }
+    return 0;
+}
+
+/* Mark the objects reachable from the objects with gc_refs > 0 of the
+   segments claimed by this thread. */
+static void
+mark_reachable_worker(struct gc_parallel *par)
+{
+    struct gc_mark_stack stack = {NULL, 0, 0, &par->overflow};
+    PyGC_Head *gc, *end;
+    while (gc_claim_segment(par, &gc, &end)) {
+        for (; gc != end; gc = GC_NEXT(gc)) {
+            uintptr_t prev = gc_load_prev(gc);
+            if ((prev & PREV_MASK_REACHABLE)
+                || (prev & ~PREV_MASK_REACHABLE) >> _PyGC_PREV_SHIFT == 0
+                || !gc_mark(gc))
+            {
+                continue;
+            }
+            gc_mark_push(&stack, gc);
+            while (stack.size > 0) {
+                PyObject *op = FROM_GC(stack.items[--stack.size]);
+                (void) Py_TYPE(op)->tp_traverse(op, (visitproc)visit_mark,
+                                                &stack);
+            }
+        }
+    }
+    PyMem_RawFree(stack.items);
+}
+
+/* A traversal callback for mark_reachable_serial(). */
+static int
+visit_mark_serial(PyObject *op, int *changed)
+{
+    if (_PyObject_IS_GC(op)) {
+        PyGC_Head *gc = AS_GC(op);
+        if ((gc->_gc_prev & (PREV_MASK_COLLECTING | PREV_MASK_REACHABLE))
+            == PREV_MASK_COLLECTING)
+        {
+            gc->_gc_prev |= PREV_MASK_REACHABLE;
+            *changed = 1;
+        }
+    }
+    return 0;
+}
+
+/* Complete the marking when a mark stack could not grow, by traversing
+   the marked objects until no new object gets marked.  Slow, but it
+   doesn't need memory. */
+static void
+mark_reachable_serial(PyGC_Head *containers)
+{
+    int changed;
+    do {
+        changed = 0;
+        PyGC_Head *gc = GC_NEXT(containers);
+        for (; gc != containers; gc = GC_NEXT(gc)) {
+            if (!(gc->_gc_prev & PREV_MASK_REACHABLE)) {
+                if (gc_get_refs(gc) == 0) {
+                    continue;
+                }
+                gc->_gc_prev |= PREV_MASK_REACHABLE;
+                changed = 1;
+            }
+            PyObject *op = FROM_GC(gc);
+            (void) Py_TYPE(op)->tp_traverse(op, (visitproc)visit_mark_serial,
+                                            &changed);
+        }
+    } while (changed);
+}
+
+/* Move the objects of young which are not marked PREV_MASK_REACHABLE to
+ * unreachable.  This leaves both lists in the same state as
+ * move_unreachable() does.
+ */
+static void
+move_unmarked(PyGC_Head *young, PyGC_Head *unreachable)
+{
+    PyGC_Head *prev = young;
+    PyGC_Head *gc = GC_NEXT(young);
+    while (gc != young) {
+        PyGC_Head *next = GC_NEXT(gc);
+        if (gc->_gc_prev & PREV_MASK_REACHABLE) {
+            prev->_gc_next = (uintptr_t)gc;
+            // This also clears PREV_MASK_REACHABLE.
+            _PyGCHead_SET_PREV(gc, prev);
+            gc_clear_collecting(gc);
+            prev = gc;
+        }
+        else {
+            // See move_unreachable().
+            PyGC_Head *last = GC_PREV(unreachable);
+            last->_gc_next = (NEXT_MASK_UNREACHABLE | (uintptr_t)gc);
+            _PyGCHead_SET_PREV(gc, last);
+            gc->_gc_next = (NEXT_MASK_UNREACHABLE | (uintptr_t)unreachable);
+            unreachable->_gc_prev = (uintptr_t)gc;
+        }
+        gc = next;
+    }
+    prev->_gc_next = (uintptr_t)young;
+    young->_gc_prev = (uintptr_t)prev;
+    unreachable->_gc_next &= ~NEXT_MASK_UNREACHABLE;
+}
+
+/* The helper threads of a parallel analysis.  They are started once and
+   given each phase in turn. */
+struct gc_pool;
+
+struct gc_helper {
+    struct gc_pool *pool;
+    /* released to hand the next phase to the helper */
+    PyThread_type_lock start;
+    /* released by the helper once it is done with the phase */
+    PyThread_type_lock done;
+};
+
+struct gc_pool {
+    struct gc_parallel *par;
+    /* the phase to run, NULL tells the helpers to exit */
+    void (*func)(struct gc_parallel *);
+    struct gc_helper *helpers;
+    Py_ssize_t started;
+};
+
+static void
+gc_helper_main(void *arg)
+{
+    struct gc_helper *helper = (struct gc_helper *)arg;
+    struct gc_pool *pool = helper->pool;
+    for (;;) {
+        PyThread_acquire_lock(helper->start, WAIT_LOCK);
+        if (pool->func == NULL) {
+            break;
+        }
+        pool->func(pool->par);
+        PyThread_release_lock(helper->done);
+    }
+    PyThread_release_lock(helper->done);
+}
+
+/* Start up to nhelpers helper threads.  If they can't all be started, the
+   current thread simply processes more segments. */
+static void
+gc_pool_start(struct gc_pool *pool, Py_ssize_t nhelpers)
+{
+    pool->func = NULL;
+    pool->started = 0;
+    pool->helpers = PyMem_RawMalloc(Py_MAX(nhelpers, 1) *
+                                    sizeof(struct gc_helper));
+    if (pool->helpers == NULL) {
+        return;
+    }
+    for (; pool->started < nhelpers; pool->started++) {
+        struct gc_helper *helper = &pool->helpers[pool->started];
+        helper->pool = pool;
+        helper->start = PyThread_allocate_lock();
+        helper->done = PyThread_allocate_lock();
+        if (helper->start == NULL || helper->done == NULL) {
+            if (helper->start != NULL) {
+                PyThread_free_lock(helper->start);
+            }
+            if (helper->done != NULL) {
+                PyThread_free_lock(helper->done);
+            }
+            break;
+        }
+        PyThread_acquire_lock(helper->start, WAIT_LOCK);
+        PyThread_acquire_lock(helper->done, WAIT_LOCK);
+        if (PyThread_start_new_thread(gc_helper_main, helper)
+            == PYTHREAD_INVALID_THREAD_ID)
+        {
+            PyThread_release_lock(helper->start);
+            PyThread_release_lock(helper->done);
+            PyThread_free_lock(helper->start);
+            PyThread_free_lock(helper->done);
+            break;
+        }
+    }
+}
+
+/* Run func on the current thread and the helpers, and wait for all of
+   them to return. */
+static void
+gc_pool_run(struct gc_pool *pool, void (*func)(struct gc_parallel *))
+{
+    pool->par->next_segment = 0;
+    pool->func = func;
+    for (Py_ssize_t i = 0; i < pool->started; i++) {
+        PyThread_release_lock(pool->helpers[i].start);
+    }
+    func(pool->par);
+    for (Py_ssize_t i = 0; i < pool->started; i++) {
+        PyThread_acquire_lock(pool->helpers[i].done, WAIT_LOCK);
+    }
+}
+
+/* Tell the helpers to exit and wait for them. */
+static void
+gc_pool_stop(struct gc_pool *pool)
+{
+    pool->func = NULL;
+    for (Py_ssize_t i = 0; i < pool->started; i++) {
+        PyThread_release_lock(pool->helpers[i].start);
+    }
+    for (Py_ssize_t i = 0; i < pool->started; i++) {
+        struct gc_helper *helper = &pool->helpers[i];
+        PyThread_acquire_lock(helper->done, WAIT_LOCK);
+        PyThread_release_lock(helper->done);
+        PyThread_free_lock(helper->done);
+        PyThread_free_lock(helper->start);
+    }
+    PyMem_RawFree(pool->helpers);
+}
+
+/* Same as subtract_refs() followed by move_unreachable(), using nthreads
+   threads.  segments was filled by update_refs(). */
+static void
+deduce_unreachable_parallel(PyGC_Head *base, PyGC_Head *unreachable,
+                            struct gc_segments *segments, int nthreads)
+{
+    /* gc_refs must stay below PREV_MASK_REACHABLE */
+    Py_BUILD_ASSERT(SIZE_MAX / sizeof(PyObject *)
+                    < PREV_MASK_REACHABLE >> _PyGC_PREV_SHIFT);
+
+    struct gc_parallel par = {base, segments, 0, 0};
+    struct gc_pool pool = {&par, NULL, NULL, 0};
+    gc_pool_start(&pool, Py_MIN(nthreads, segments->size) - 1);
+    gc_pool_run(&pool, subtract_refs_worker);
+    gc_pool_run(&pool, mark_reachable_worker);
+    gc_pool_stop(&pool);
+    if (par.overflow) {
+        mark_reachable_serial(base);
+    }
+    gc_list_init(unreachable);
+    move_unmarked(base, unreachable);
+}
+#endif  /* GC_PARALLEL */
+
 static void
 untrack_tuples(PyGC_Head *head)
 {
@@ -1094,14 +1564,27 @@ flag is cleared (for example, by using 'clear_unreachable_mask' function or
 by a call to 'move_legacy_finalizers'), the 'unreachable' list is not a normal
 list and we can not use most gc_list_* functions for it. */
 static inline void
-deduce_unreachable(PyGC_Head *base, PyGC_Head *unreachable) {
+deduce_unreachable(PyGC_Head *base, PyGC_Head *unreachable, int nthreads) {
+    struct gc_segments segments = {NULL, 0, 0, 0};
+
     validate_list(base, collecting_clear_unreachable_clear);
     /* Using ob_refcnt and gc_refs, calculate which objects in the
      * container set are reachable from outside the set (i.e., have a
      * refcount greater than 0 when all the references within the
      * set are taken into account).
      */
-    update_refs(base);  // gc_prev is used for gc_refs
+    // gc_prev is used for gc_refs
+    update_refs(base, nthreads > 1 ? &segments : NULL);
+#ifdef GC_PARALLEL
+    if (!segments.nomemory && segments.size >= GC_PARALLEL_MIN_SEGMENTS) {
+        deduce_unreachable_parallel(base, unreachable, &segments, nthreads);
+        PyMem_RawFree(segments.starts);
+        validate_list(base, collecting_clear_unreachable_clear);
+        validate_list(unreachable, collecting_set_unreachable_set);
+        return;
+    }
+#endif
+    PyMem_RawFree(segments.starts);
     subtract_refs(base);
 
     /* Leave everything reachable from outside base in base, and move
@@ -1170,17 +1653,171 @@ handle_resurrected_objects(PyGC_Head *unreachable, PyGC_Head* still_unreachable,
     // have the PREV_MARK_COLLECTING set, but the objects are going to be
     // removed so we can skip the expense of clearing the flag.
     PyGC_Head* resurrected = unreachable;
-    deduce_unreachable(resurrected, still_unreachable);
+    deduce_unreachable(resurrected, still_unreachable, 1);
     clear_unreachable_mask(still_unreachable);
 
     // Move the resurrected objects to the old generation for future collection.
     gc_list_merge(resurrected, old_generation);
 }
 
+/* Incremental collection of the oldest generation
+ * ------------------------------------------------
+ *
+ * A full collection examines every tracked object at once, so its pause is
+ * proportional to the size of the heap.  When gc.set_incremental() sets a
+ * budget, reaching the threshold of the oldest generation collects an
+ * "increment" instead: the young generations plus at most `budget` objects
+ * of the oldest generation.  Successive increments form a scan of the
+ * oldest generation.
+ *
+ * An increment is collected like any generation: update_refs(),
+ * subtract_refs() and move_unreachable() only consider the references from
+ * outside the increment as external roots, so no reachable object is ever
+ * collected.  To find garbage cycles spanning objects of the oldest
+ * generation, the increment is grown with the objects they refer to
+ * (until the budget is used up), rather than simply taking the next
+ * objects in the list.
+ *
+ * The NEXT_MASK_OLD_SPACE_1 flag tells the objects of the oldest generation
+ * already examined by the current scan ("visited", the flag equals
+ * gcstate->visited_space) from the others ("pending").  Objects joining the
+ * oldest generation during a scan are marked visited and appended, so
+ * pending objects stay at the head of the list.  The objects of the
+ * permanent generation are always marked visited so that increments never
+ * pull them in.  Once no pending object is left, flipping visited_space
+ * starts a new scan without walking the list, unless the permanent
+ * generation is not empty.
+ *
+ * Garbage cycles larger than an increment can only be found by a full
+ * collection.  A full collection is performed instead of a scan once the
+ * oldest generation has grown to twice its size after the last full
+ * collection.
+ */
+
+struct gc_increment {
+    PyGC_Head *head;
+    Py_ssize_t size;      /* # objects of the oldest generation added */
+    Py_ssize_t budget;
+    int visited_space;
+};
+
+/* A traversal callback for expand_increment().  Stop the traversal once
+ * the budget is used up, large containers would make the pause unbounded
+ * otherwise. */
+static int
+visit_add_to_increment(PyObject *op, struct gc_increment *inc)
+{
+    if (inc->size >= inc->budget) {
+        return 1;
+    }
+    if (_PyObject_IS_GC(op) && _PyObject_GC_IS_TRACKED(op)) {
+        PyGC_Head *gc = AS_GC(op);
+        /* The young generations are already in the increment and marked
+         * visited, as well as the permanent generation, so this is a pending
+         * object of the oldest generation.
+         */
+        if (gc_old_space(gc) != inc->visited_space) {
+            gc_list_move(gc, inc->head);
+            gc_set_old_space(gc, inc->visited_space);
+            inc->size++;
+        }
+    }
+    return 0;
+}
+
+/* Add the pending objects referred to by the objects of the increment,
+ * from `gc` to its end, and so on transitively until the budget is used up.
+ */
+static void
+expand_increment(struct gc_increment *inc, PyGC_Head *gc)
+{
+    for (; gc != inc->head && inc->size < inc->budget; gc = GC_NEXT(gc)) {
+        PyObject *op = FROM_GC(gc);
+        (void) Py_TYPE(op)->tp_traverse(op,
+                                        (visitproc)visit_add_to_increment,
+                                        inc);
+    }
+}
+
+/* Move the young generations and up to incremental_budget pending objects
+ * of the oldest generation to `increment`.  Return 1 if no pending object
+ * is left afterwards.
+ */
+static int
+gc_build_increment(GCState *gcstate, PyGC_Head *increment)
+{
+    PyGC_Head *old = GEN_HEAD(gcstate, NUM_GENERATIONS-1);
+    struct gc_increment inc = {increment, 0, gcstate->incremental_budget,
+                               gcstate->visited_space};
+    int completed = 0;
+
+    gc_list_init(increment);
+    for (int i = 0; i < NUM_GENERATIONS-1; i++) {
+        gc_list_merge(GEN_HEAD(gcstate, i), increment);
+    }
+    gc_list_set_space(increment, inc.visited_space);
+    expand_increment(&inc, GC_NEXT(increment));
+
+    while (inc.size < inc.budget) {
+        PyGC_Head *gc = GC_NEXT(old);
+        if (gc == old || gc_old_space(gc) == inc.visited_space) {
+            completed = 1;
+            break;
+        }
+        gc_list_move(gc, increment);
+        gc_set_old_space(gc, inc.visited_space);
+        inc.size++;
+        expand_increment(&inc, gc);
+    }
+    gcstate->incremental_examined += inc.size;
+    return completed;
+}
+
+/* Mark all the objects of the oldest generation pending: the next
+ * increment starts a new scan. */
+static void
+gc_restart_scan(GCState *gcstate)
+{
+    gc_list_set_space(GEN_HEAD(gcstate, NUM_GENERATIONS-1),
+                      !gcstate->visited_space);
+    gcstate->incremental_examined = 0;
+    gcstate->incremental_full_pending = 0;
+}
+
+/* Called when all the objects of the oldest generation are visited. */
+static void
+gc_complete_scan(GCState *gcstate)
+{
+    if (gcstate->incremental_examined / 2 > gcstate->long_lived_total) {
+        gcstate->incremental_full_pending = 1;
+    }
+    gcstate->incremental_examined = 0;
+    if (gc_list_is_empty(&gcstate->permanent_generation.head)) {
+        gcstate->visited_space = !gcstate->visited_space;
+    }
+    else {
+        /* The permanent generation must stay visited */
+        gc_list_set_space(GEN_HEAD(gcstate, NUM_GENERATIONS-1),
+                          !gcstate->visited_space);
+    }
+}
+
+/* Move the survivors of an incremental collection to the oldest
+ * generation, marked visited.  This is done after every step which may
+ * add to them, so that gc.get_objects() and gc.get_referrers() find them
+ * while finalizers and callbacks run. */
+static void
+gc_merge_survivors(GCState *gcstate, PyGC_Head *survivors)
+{
+    gc_list_set_space(survivors, gcstate->visited_space);
+    gc_list_merge(survivors, GEN_HEAD(gcstate, NUM_GENERATIONS-1));
+}
+
 /* This is the main function.  Read this to understand how the
- * collection process works. */
+ * collection process works.  If `incremental` is true, collect an
+ * increment of the oldest generation rather than all of it. */
 static Py_ssize_t
-gc_collect_main(PyThreadState *tstate, int generation,
+gc_collect_main(PyThreadState *tstate, int generation, int incremental,
                 Py_ssize_t *n_collected, Py_ssize_t *n_uncollectable,
                 int nofail)
 {
@@ -1189,6 +1826,9 @@ gc_collect_main(PyThreadState *tstate, int generation,
     Py_ssize_t n = 0; /* # unreachable objects that couldn't be collected */
     PyGC_Head *young; /* the generation we are examining */
     PyGC_Head *old; /* next older generation */
+    PyGC_Head increment; /* the increment we are examining */
+    PyGC_Head survivors; /* objects about to join the oldest generation */
+    int completed = 0; /* true if the increment completes a scan */
     PyGC_Head unreachable; /* non-problematic unreachable trash */
     PyGC_Head finalizers;  /* objects with, & reachable from, __del__ */
     PyGC_Head *gc;
@@ -1209,7 +1849,8 @@ gc_collect_main(PyThreadState *tstate, int generation,
 #endif
 
     if (gcstate->debug & DEBUG_STATS) {
-        PySys_WriteStderr("gc: collecting generation %d...\n", generation);
+        PySys_WriteStderr("gc: collecting generation %d%s...\n", generation,
+                          incremental ? " (increment)" : "");
         show_stats_each_generations(gcstate);
         t1 = _PyTime_GetMonotonicClock();
     }
@@ -1223,20 +1864,36 @@ gc_collect_main(PyThreadState *tstate, int generation,
     for (i = 0; i <= generation; i++)
         gcstate->generations[i].count = 0;
 
-    /* merge younger generations with one we are currently collecting */
-    for (i = 0; i < generation; i++) {
-        gc_list_merge(GEN_HEAD(gcstate, i), GEN_HEAD(gcstate, generation));
+    if (incremental) {
+        assert(generation == NUM_GENERATIONS-1);
+        assert(gcstate->incremental_budget > 0);
+        completed = gc_build_increment(gcstate, &increment);
+        young = &increment;
+        gc_list_init(&survivors);
+        old = &survivors;
     }
+    else {
+        /* merge younger generations with one we are currently collecting */
+        for (i = 0; i < generation; i++) {
+            gc_list_merge(GEN_HEAD(gcstate, i), GEN_HEAD(gcstate, generation));
+        }
 
-    /* handy references */
-    young = GEN_HEAD(gcstate, generation);
-    if (generation < NUM_GENERATIONS-1)
-        old = GEN_HEAD(gcstate, generation+1);
-    else
-        old = young;
+        /* handy references */
+        young = GEN_HEAD(gcstate, generation);
+        if (generation < NUM_GENERATIONS-1)
+            old = GEN_HEAD(gcstate, generation+1);
+        else
+            old = young;
+        if (generation == NUM_GENERATIONS-2 && gcstate->incremental_budget) {
+            /* Survivors must be marked visited before joining the oldest
+               generation. */
+            gc_list_init(&survivors);
+            old = &survivors;
+        }
+    }
     validate_list(old, collecting_clear_unreachable_clear);
 
-    deduce_unreachable(young, &unreachable);
+    deduce_unreachable(young, &unreachable, gcstate->threads);
 
     untrack_tuples(young);
     /* Move reachable objects to next generation. */
@@ -1244,7 +1901,13 @@ gc_collect_main(PyThreadState *tstate, int generation,
         if (generation == NUM_GENERATIONS - 2) {
             gcstate->long_lived_pending += gc_list_size(young);
         }
+        else if (incremental) {
+            untrack_dicts(young);
+        }
         gc_list_merge(young, old);
+        if (old == &survivors) {
+            gc_merge_survivors(gcstate, &survivors);
+        }
     }
     else {
         /* We only un-track dicts in full collections, to avoid quadratic
@@ -1279,6 +1942,9 @@ gc_collect_main(PyThreadState *tstate, int generation,
 
     /* Clear weakrefs and invoke callbacks as necessary. */
     m += handle_weakrefs(&unreachable, old);
+    if (old == &survivors) {
+        gc_merge_survivors(gcstate, &survivors);
+    }
 
     validate_list(old, collecting_clear_unreachable_clear);
     validate_list(&unreachable, collecting_set_unreachable_clear);
@@ -1291,6 +1957,9 @@ gc_collect_main(PyThreadState *tstate, int generation,
      * objects that are still unreachable */
     PyGC_Head final_unreachable;
     handle_resurrected_objects(&unreachable, &final_unreachable, old);
+    if (old == &survivors) {
+        gc_merge_survivors(gcstate, &survivors);
+    }
 
     /* Call tp_clear on objects in the final_unreachable set.  This will cause
     * the reference cycles to be broken.  It may also cause some objects
@@ -1320,6 +1989,16 @@ gc_collect_main(PyThreadState *tstate, int generation,
     handle_legacy_finalizers(tstate, gcstate, &finalizers, old);
     validate_list(old, collecting_clear_unreachable_clear);
 
+    if (old == &survivors) {
+        gc_merge_survivors(gcstate, &survivors);
+        if (completed) {
+            gc_complete_scan(gcstate);
+        }
+    }
+    else if (young == old && gcstate->incremental_budget) {
+        gc_restart_scan(gcstate);
+    }
+
     /* Clear free list only during the collection of the highest
      * generation */
     if (generation == NUM_GENERATIONS-1) {
@@ -1361,7 +2040,7 @@ gc_collect_main(PyThreadState *tstate, int generation,
  */
 static void
 invoke_gc_callback(PyThreadState *tstate, const char *phase,
-                   int generation, Py_ssize_t collected,
+                   int generation, int incremental, Py_ssize_t collected,
                    Py_ssize_t uncollectable)
 {
     assert(!_PyErr_Occurred(tstate));
@@ -1376,10 +2055,11 @@ invoke_gc_callback(PyThreadState *tstate, const char *phase,
     assert(PyList_CheckExact(gcstate->callbacks));
     PyObject *info = NULL;
     if (PyList_GET_SIZE(gcstate->callbacks) != 0) {
-        info = Py_BuildValue("{sisnsn}",
+        info = Py_BuildValue("{sisnsnsO}",
             "generation", generation,
             "collected", collected,
-            "uncollectable", uncollectable);
+            "uncollectable", uncollectable,
+            "incremental", incremental ? Py_True : Py_False);
         if (info == NULL) {
             PyErr_WriteUnraisable(NULL);
             return;
@@ -1401,17 +2081,20 @@ invoke_gc_callback(PyThreadState *tstate, const char *phase,
     assert(!_PyErr_Occurred(tstate));
 }
 
-/* Perform garbage collection of a generation and invoke
- * progress callbacks.
+/* Perform garbage collection of a generation (or of an increment of the
+ * oldest generation) and invoke progress callbacks.
  */
 static Py_ssize_t
-gc_collect_with_callback(PyThreadState *tstate, int generation)
+gc_collect_with_callback(PyThreadState *tstate, int generation,
+                         int incremental)
 {
     assert(!_PyErr_Occurred(tstate));
     Py_ssize_t result, collected, uncollectable;
-    invoke_gc_callback(tstate, "start", generation, 0, 0);
-    result = gc_collect_main(tstate, generation, &collected, &uncollectable, 0);
-    invoke_gc_callback(tstate, "stop", generation, collected, uncollectable);
+    invoke_gc_callback(tstate, "start", generation, incremental, 0, 0);
+    result = gc_collect_main(tstate, generation, incremental,
+                             &collected, &uncollectable, 0);
+    invoke_gc_callback(tstate, "stop", generation, incremental,
+                       collected, uncollectable);
     assert(!_PyErr_Occurred(tstate));
     return result;
 }
@@ -1462,10 +2145,16 @@ gc_collect_generations(PyThreadState *tstate)
                June 2008. His original analysis and proposal can be found at:
                http://mail.python.org/pipermail/python-dev/2008-June/080579.html
             */
+            if (i == NUM_GENERATIONS - 1
+                && gcstate->incremental_budget
+                && !gcstate->incremental_full_pending) {
+                n = gc_collect_with_callback(tstate, i, 1);
+                break;
+            }
             if (i == NUM_GENERATIONS - 1
                 && gcstate->long_lived_pending < gcstate->long_lived_total / 4)
                 continue;
-            n = gc_collect_with_callback(tstate, i);
+            n = gc_collect_with_callback(tstate, i, 0);
             break;
         }
     }
@@ -1551,7 +2240,45 @@ gc_collect_impl(PyObject *module, int generation)
     }
     else {
         gcstate->collecting = 1;
-        n = gc_collect_with_callback(tstate, generation);
+        n = gc_collect_with_callback(tstate, generation, 0);
+        gcstate->collecting = 0;
+    }
+    return n;
+}
+
+/*[clinic input]
+gc.collect_increment -> Py_ssize_t
+
+Collect an increment of the oldest generation.
+
+The increment holds the young generations and at most as many objects
+of the oldest generation as the budget set by set_incremental().  A
+RuntimeError is raised if incremental collection is disabled.
+
+The number of unreachable objects is returned.
+[clinic start generated code]*/
+
+static Py_ssize_t
+gc_collect_increment_impl(PyObject *module)
+/*[clinic end generated code: output=99f29c7719d14647 input=42877dd72eadced1]*/
+{
+    PyThreadState *tstate = _PyThreadState_GET();
+    GCState *gcstate = &tstate->interp->gc;
+
+    if (!gcstate->incremental_budget) {
+        _PyErr_SetString(tstate, PyExc_RuntimeError,
+                         "incremental collection is disabled");
+        return -1;
+    }
+
+    Py_ssize_t n;
+    if (gcstate->collecting) {
+        /* already collecting, don't do anything */
+        n = 0;
+    }
+    else {
+        gcstate->collecting = 1;
+        n = gc_collect_with_callback(tstate, NUM_GENERATIONS - 1, 1);
         gcstate->collecting = 0;
     }
     return n;
@@ -1654,6 +2381,102 @@ gc_get_count_impl(PyObject *module)
                          gcstate->generations[2].count);
 }
 
+/*[clinic input]
+gc.set_incremental
+
+    budget: Py_ssize_t
+    /
+
+Set the budget of incremental collections of the oldest generation.
+
+When the threshold of the oldest generation is reached, only an
+increment made of the young generations and at most budget objects
+of the oldest generation is collected, which bounds the duration of
+the collection.  A budget of zero disables incremental collection.
+[clinic start generated code]*/
+
+static PyObject *
+gc_set_incremental_impl(PyObject *module, Py_ssize_t budget)
+/*[clinic end generated code: output=eb3596ce342d7b32 input=4eb1cb0c77a1b698]*/
+{
+    GCState *gcstate = get_gc_state();
+    if (budget < 0) {
+        PyErr_SetString(PyExc_ValueError, "budget must be >= 0");
+        return NULL;
+    }
+    if (budget && !gcstate->incremental_budget) {
+        /* The flags were not maintained while incremental collection was
+           disabled */
+        gc_list_set_space(&gcstate->permanent_generation.head,
+                          gcstate->visited_space);
+        gc_restart_scan(gcstate);
+    }
+    gcstate->incremental_budget = budget;
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+gc.get_incremental -> Py_ssize_t
+
+Return the budget of incremental collections, or 0 if disabled.
+[clinic start generated code]*/
+
+static Py_ssize_t
+gc_get_incremental_impl(PyObject *module)
+/*[clinic end generated code: output=5028249752fdc310 input=8733ad14cb69f61e]*/
+{
+    GCState *gcstate = get_gc_state();
+    return gcstate->incremental_budget;
+}
+
+/*[clinic input]
+gc.set_threads
+
+    threads: int
+    /
+
+Set the number of threads used by large collections.
+
+Collections of many objects split the search for unreachable objects
+between the calling thread and threads-1 helper threads.  The
+tp_traverse slots of all tracked objects must be safe to call
+concurrently.
+[clinic start generated code]*/
+
+static PyObject *
+gc_set_threads_impl(PyObject *module, int threads)
+/*[clinic end generated code: output=49ddc63397250cc3 input=4d0b16de7e051051]*/
+{
+    GCState *gcstate = get_gc_state();
+    if (threads < 1) {
+        PyErr_SetString(PyExc_ValueError, "threads must be >= 1");
+        return NULL;
+    }
+#ifndef GC_PARALLEL
+    if (threads > 1) {
+        PyErr_SetString(PyExc_NotImplementedError,
+                        "parallel collection is not supported on this platform");
+        return NULL;
+    }
+#endif
+    gcstate->threads = threads;
+    Py_RETURN_NONE;
+}
+
+/*[clinic input]
+gc.get_threads -> int
+
+Return the number of threads used by large collections.
+[clinic start generated code]*/
+
+static int
+gc_get_threads_impl(PyObject *module)
+/*[clinic end generated code: output=4bf304713f6da228 input=6bf15062e7da9ef8]*/
+{
+    GCState *gcstate = get_gc_state();
+    return gcstate->threads;
+}
+
 static int
 referrersvisit(PyObject* obj, PyObject *objs)
 {
@@ -1895,6 +2718,21 @@ gc_is_finalized(PyObject *module, PyObject *obj)
     Py_RETURN_FALSE;
 }
 
+/* Move all tracked objects to the permanent generation. */
+static void
+gc_freeze_all(GCState *gcstate)
+{
+    for (int i = 0; i < NUM_GENERATIONS; ++i) {
+        gc_list_merge(GEN_HEAD(gcstate, i), &gcstate->permanent_generation.head);
+        gcstate->generations[i].count = 0;
+    }
+    if (gcstate->incremental_budget) {
+        /* Increments must not pull frozen objects in */
+        gc_list_set_space(&gcstate->permanent_generation.head,
+                          gcstate->visited_space);
+    }
+}
+
 /*[clinic input]
 gc.freeze
 
@@ -1910,12 +2748,126 @@ gc_freeze_impl(PyObject *module)
 /*[clinic end generated code: output=502159d9cdc4c139 input=b602b16ac5febbe5]*/
 {
     GCState *gcstate = get_gc_state();
-    for (int i = 0; i < NUM_GENERATIONS; ++i) {
-        gc_list_merge(GEN_HEAD(gcstate, i), &gcstate->permanent_generation.head);
-        gcstate->generations[i].count = 0;
+    gc_freeze_all(gcstate);
+    Py_RETURN_NONE;
+}
+
+#ifdef Py_IMMORTAL_INSTANCES
+/* The objects made immortal by gc.immortalize() whose referents still have
+ * to be visited. */
+typedef struct {
+    PyObject **items;
+    Py_ssize_t size;
+    Py_ssize_t allocated;
+} immortalize_stack;
+
+/* Make op immortal and push it on the stack, unless it already was
+ * immortal: the immortal bit doubles as the "visited" mark of the walk. */
+static int
+visit_immortalize(PyObject *op, immortalize_stack *stack)
+{
+    if (_Py_IsImmortal(op)) {
+        return 0;
+    }
+    if (stack->size == stack->allocated) {
+        Py_ssize_t allocated = stack->allocated * 2 + 256;
+        PyObject **items = PyMem_Realloc(stack->items,
+                                         allocated * sizeof(PyObject *));
+        if (items == NULL) {
+            return -1;
+        }
+        stack->items = items;
+        stack->allocated = allocated;
+    }
+    _Py_SetImmortal(op);
+    stack->items[stack->size++] = op;
+    return 0;
+}
+
+/* Make the objects on the stack and everything they refer to immortal.
+ * Untracked objects are followed too: code objects, their constants and
+ * names, untracked tuples and dicts, etc. would otherwise still have their
+ * reference count updated.  Return -1 on memory error. */
+static int
+immortalize_referents(immortalize_stack *stack)
+{
+    while (stack->size > 0) {
+        PyObject *op = stack->items[--stack->size];
+        if (PyCode_Check(op)) {
+            /* Code objects are not tracked and have no tp_traverse */
+            PyCodeObject *co = (PyCodeObject *)op;
+            PyObject *fields[] = {
+                co->co_code, co->co_consts, co->co_names, co->co_varnames,
+                co->co_freevars, co->co_cellvars, co->co_filename,
+                co->co_name, co->co_linetable,
+            };
+            for (size_t i = 0; i < Py_ARRAY_LENGTH(fields); i++) {
+                if (fields[i] != NULL &&
+                    visit_immortalize(fields[i], stack) < 0) {
+                    return -1;
+                }
+            }
+            continue;
+        }
+        if (!_PyObject_IS_GC(op)) {
+            continue;
+        }
+        if (Py_TYPE(op)->tp_traverse(op, (visitproc)visit_immortalize,
+                                     stack) < 0) {
+            return -1;
+        }
+        if (PyDict_Check(op)) {
+            /* dict_traverse() skips the keys of unicode-only tables */
+            Py_ssize_t pos = 0;
+            PyObject *key;
+            while (PyDict_Next(op, &pos, &key, NULL)) {
+                if (visit_immortalize(key, stack) < 0) {
+                    return -1;
+                }
+            }
+        }
+    }
+    return 0;
+}
+
+/*[clinic input]
+gc.immortalize
+
+Freeze all tracked objects and make them immortal.
+
+The objects in the permanent generation, all the objects reachable from
+them and the interned strings are never deallocated and their reference
+count is no longer updated.  This keeps the memory pages holding them
+shared with the processes forked afterwards.
+[clinic start generated code]*/
+
+static PyObject *
+gc_immortalize_impl(PyObject *module)
+/*[clinic end generated code: output=b9df9414abd28e46 input=ef98ae90b890523f]*/
+{
+    PyInterpreterState *interp = _PyInterpreterState_GET();
+    GCState *gcstate = &interp->gc;
+    PyGC_Head *permanent = &gcstate->permanent_generation.head;
+    immortalize_stack stack = {NULL, 0, 0};
+    int err = 0;
+
+    gc_freeze_all(gcstate);
+    for (PyGC_Head *gc = GC_NEXT(permanent); gc != permanent && err == 0;
+         gc = GC_NEXT(gc))
+    {
+        err = visit_immortalize(FROM_GC(gc), &stack);
+        if (err == 0) {
+            err = immortalize_referents(&stack);
+        }
+    }
+    PyMem_Free(stack.items);
+    if (err < 0) {
+        return PyErr_NoMemory();
     }
+    _PyUnicode_ImmortalizeInterned(interp);
     Py_RETURN_NONE;
 }
+#endif  /* Py_IMMORTAL_INSTANCES */
 
 /*[clinic input]
 gc.unfreeze
@@ -1957,12 +2909,17 @@ PyDoc_STRVAR(gc__doc__,
 "disable() -- Disable automatic garbage collection.\n"
 "isenabled() -- Returns true if automatic collection is enabled.\n"
 "collect() -- Do a full collection right now.\n"
+"collect_increment() -- Collect an increment of the oldest generation.\n"
 "get_count() -- Return the current collection counts.\n"
 "get_stats() -- Return list of dictionaries containing per-generation stats.\n"
 "set_debug() -- Set debugging flags.\n"
 "get_debug() -- Get debugging flags.\n"
 "set_threshold() -- Set the collection thresholds.\n"
 "get_threshold() -- Return the current the collection thresholds.\n"
+"set_incremental() -- Set the budget of incremental collections.\n"
+"get_incremental() -- Return the budget of incremental collections.\n"
+"set_threads() -- Set the number of threads used by large collections.\n"
+"get_threads() -- Return the number of threads used by large collections.\n"
 "get_objects() -- Return a list of all objects tracked by the collector.\n"
 "is_tracked() -- Returns true if a given object is tracked.\n"
 "is_finalized() -- Returns true if a given object has been already finalized.\n"
@@ -1970,7 +2927,11 @@ PyDoc_STRVAR(gc__doc__,
 "get_referents() -- Return the list of objects that an object refers to.\n"
 "freeze() -- Freeze all tracked objects and ignore them for future collections.\n"
 "unfreeze() -- Unfreeze all objects in the permanent generation.\n"
-"get_freeze_count() -- Return the number of objects in the permanent generation.\n");
+"get_freeze_count() -- Return the number of objects in the permanent generation.\n"
+#ifdef Py_IMMORTAL_INSTANCES
+"immortalize() -- Freeze all tracked objects and make them immortal.\n"
+#endif
+);
 
 static PyMethodDef GcMethods[] = {
     GC_ENABLE_METHODDEF
@@ -1981,7 +2942,12 @@ static PyMethodDef GcMethods[] = {
     GC_GET_COUNT_METHODDEF
     {"set_threshold",  gc_set_threshold, METH_VARARGS, gc_set_thresh__doc__},
     GC_GET_THRESHOLD_METHODDEF
+    GC_SET_INCREMENTAL_METHODDEF
+    GC_GET_INCREMENTAL_METHODDEF
+    GC_SET_THREADS_METHODDEF
+    GC_GET_THREADS_METHODDEF
     GC_COLLECT_METHODDEF
+    GC_COLLECT_INCREMENT_METHODDEF
     GC_GET_OBJECTS_METHODDEF
     GC_GET_STATS_METHODDEF
     GC_IS_TRACKED_METHODDEF
@@ -1993,6 +2959,7 @@ static PyMethodDef GcMethods[] = {
     GC_FREEZE_METHODDEF
     GC_UNFREEZE_METHODDEF
     GC_GET_FREEZE_COUNT_METHODDEF
+    GC_IMMORTALIZE_METHODDEF
     {NULL,      NULL}           /* Sentinel */
 };
 
@@ -2062,7 +3029,7 @@ PyGC_Collect(void)
         PyObject *exc, *value, *tb;
         gcstate->collecting = 1;
         _PyErr_Fetch(tstate, &exc, &value, &tb);
-        n = gc_collect_with_callback(tstate, NUM_GENERATIONS - 1);
+        n = gc_collect_with_callback(tstate, NUM_GENERATIONS - 1, 0);
         _PyErr_Restore(tstate, exc, value, tb);
         gcstate->collecting = 0;
     }
@@ -2086,7 +3053,7 @@ _PyGC_CollectNoFail(PyThreadState *tstate)
 
     Py_ssize_t n;
     gcstate->collecting = 1;
-    n = gc_collect_main(tstate, NUM_GENERATIONS - 1, NULL, NULL, 1);
+    n = gc_collect_main(tstate, NUM_GENERATIONS - 1, 0, NULL, NULL, 1);
     gcstate->collecting = 0;
     return n;
 }
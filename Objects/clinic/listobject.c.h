@@ -143,7 +143,7 @@ list_pop(PyListObject *self, PyObject *const *args, Py_ssize_t nargs)
 }
 
 PyDoc_STRVAR(list_sort__doc__,
-"sort($self, /, *, key=None, reverse=False)\n"
+"sort($self, /, *, key=None, reverse=False, threads=1)\n"
 "--\n"
 "\n"
 "Sort the list in ascending order and return None.\n"
@@ -154,24 +154,29 @@ PyDoc_STRVAR(list_sort__doc__,
 "If a key function is given, apply it once to each list item and sort them,\n"
 "ascending or descending, according to their function values.\n"
 "\n"
-"The reverse flag can be set to sort in descending order.");
+"The reverse flag can be set to sort in descending order.\n"
+"\n"
+"Large lists of floats, small ints or Latin-1 strings can be sorted by up to\n"
+"the given number of threads, with the same result.");
 
 #define LIST_SORT_METHODDEF    \
     {"sort", (PyCFunction)(void(*)(void))list_sort, METH_FASTCALL|METH_KEYWORDS, list_sort__doc__},
 
 static PyObject *
-list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse);
+list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse,
+               Py_ssize_t threads);
 
 static PyObject *
 list_sort(PyListObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject *kwnames)
 {
     PyObject *return_value = NULL;
-    static const char * const _keywords[] = {"key", "reverse", NULL};
+    static const char * const _keywords[] = {"key", "reverse", "threads", NULL};
     static _PyArg_Parser _parser = {NULL, _keywords, "sort", 0};
-    PyObject *argsbuf[2];
+    PyObject *argsbuf[3];
     Py_ssize_t noptargs = nargs + (kwnames ? PyTuple_GET_SIZE(kwnames) : 0) - 0;
     PyObject *keyfunc = Py_None;
     int reverse = 0;
+    Py_ssize_t threads = 1;
 
     args = _PyArg_UnpackKeywords(args, nargs, NULL, kwnames, &_parser, 0, 0, 0, argsbuf);
     if (!args) {
@@ -186,12 +191,29 @@ list_sort(PyListObject *self, PyObject *const *args, Py_ssize_t nargs, PyObject
             goto skip_optional_kwonly;
         }
     }
-    reverse = _PyLong_AsInt(args[1]);
-    if (reverse == -1 && PyErr_Occurred()) {
-        goto exit;
+    if (args[1]) {
+        reverse = _PyLong_AsInt(args[1]);
+        if (reverse == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        if (!--noptargs) {
+            goto skip_optional_kwonly;
+        }
+    }
+    {
+        Py_ssize_t ival = -1;
+        PyObject *iobj = _PyNumber_Index(args[2]);
+        if (iobj != NULL) {
+            ival = PyLong_AsSsize_t(iobj);
+            Py_DECREF(iobj);
+        }
+        if (ival == -1 && PyErr_Occurred()) {
+            goto exit;
+        }
+        threads = ival;
     }
 skip_optional_kwonly:
-    return_value = list_sort_impl(self, keyfunc, reverse);
+    return_value = list_sort_impl(self, keyfunc, reverse, threads);
 
 exit:
     return return_value;
@@ -352,4 +374,4 @@ list___reversed__(PyListObject *self, PyObject *Py_UNUSED(ignored))
 {
     return list___reversed___impl(self);
 }
-/*[clinic end generated code: output=0063aad535edf62d input=a9049054013a1b77]*/
+/*[clinic end generated code: output=8b47c4f5be3ec9e3 input=a9049054013a1b77]*/
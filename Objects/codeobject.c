@@ -67,7 +67,7 @@ intern_string_constants(PyObject *tuple, int *modified)
                 return -1;
             }
 
-            if (all_name_chars(v)) {
+            if (!PyUnicode_CHECK_INTERNED(v) && all_name_chars(v)) {
                 PyObject *w = v;
                 PyUnicode_InternInPlace(&v);
                 if (w != v) {
@@ -285,9 +285,82 @@ PyCode_New(int argcount, int kwonlyargcount,
                                      name, firstlineno, linetable);
 }
 
+/* Return the opcode cache kind used by opcode, or -1 if it isn't cached. */
+static int
+opcache_kind(unsigned char opcode)
+{
+    switch (opcode) {
+    case LOAD_GLOBAL:
+        return OPCACHE_KIND_LOAD_GLOBAL;
+    case LOAD_ATTR:
+        return OPCACHE_KIND_LOAD_ATTR;
+    case LOAD_METHOD:
+        return OPCACHE_KIND_LOAD_METHOD;
+    case STORE_ATTR:
+        return OPCACHE_KIND_STORE_ATTR;
+    default:
+        return -1;
+    }
+}
+
+/* Call func(co, kind, cache, arg) for every cache entry of co, in order.
+   Entries are assigned to instructions in code order, which lets us find
+   the instruction of an entry even after co_opcache_map dropped it on
+   deoptimization. */
+static void
+opcache_foreach(PyCodeObject *co,
+                void (*func)(PyCodeObject *, int, _PyOpcache *, void *),
+                void *arg)
+{
+    Py_ssize_t co_size = PyBytes_GET_SIZE(co->co_code) / sizeof(_Py_CODEUNIT);
+    _Py_CODEUNIT *opcodes = (_Py_CODEUNIT*)PyBytes_AS_STRING(co->co_code);
+    Py_ssize_t opts = 0;
+
+    for (Py_ssize_t i = 0; i < co_size && opts < co->co_opcache_size; i++) {
+        int kind = opcache_kind(_Py_OPCODE(opcodes[i]));
+        if (kind >= 0) {
+            func(co, kind, &co->co_opcache[opts], arg);
+            opts++;
+        }
+    }
+}
+
+static void
+opcache_count_entry(PyCodeObject *co, int kind, _PyOpcache *cache, void *arg)
+{
+    if (*(int *)arg > 0) {
+        _Py_opcache_stats.kinds[kind].entries++;
+    }
+    else {
+        _Py_opcache_stats.kinds[kind].entries--;
+    }
+}
+
+static void
+opcache_update_stats(PyCodeObject *co, int sign)
+{
+    if (co->co_opcache == NULL) {
+        return;
+    }
+    size_t map_size = PyBytes_GET_SIZE(co->co_code) / sizeof(_Py_CODEUNIT)
+                      + OPCACHE_NKINDS * sizeof(_PyOpcacheCounters);
+    if (sign > 0) {
+        _Py_opcache_stats.code_objects++;
+        _Py_opcache_stats.map_memory += map_size;
+    }
+    else {
+        _Py_opcache_stats.code_objects--;
+        _Py_opcache_stats.map_memory -= map_size;
+    }
+    opcache_foreach(co, opcache_count_entry, &sign);
+}
+
 int
 _PyCode_InitOpcache(PyCodeObject *co)
 {
+    if (co->co_opcache_map != NULL) {
+        return 0;  // already initialized
+    }
     Py_ssize_t co_size = PyBytes_Size(co->co_code) / sizeof(_Py_CODEUNIT);
     co->co_opcache_map = (unsigned char *)PyMem_Calloc(co_size, 1);
     if (co->co_opcache_map == NULL) {
@@ -301,8 +374,7 @@ _PyCode_InitOpcache(PyCodeObject *co)
         unsigned char opcode = _Py_OPCODE(opcodes[i]);
         i++;  // 'i' is now aligned to (next_instr - first_instr)
 
-        // TODO: LOAD_METHOD
-        if (opcode == LOAD_GLOBAL || opcode == LOAD_ATTR) {
+        if (opcache_kind(opcode) >= 0) {
             opts++;
             co->co_opcache_map[i] = (unsigned char)opts;
             if (opts > 254) {
@@ -312,7 +384,9 @@ _PyCode_InitOpcache(PyCodeObject *co)
     }
 
     if (opts) {
-        co->co_opcache = (_PyOpcache *)PyMem_Calloc(opts, sizeof(_PyOpcache));
+        co->co_opcache = (_PyOpcache *)PyMem_Calloc(
+            1, opts * sizeof(_PyOpcache)
+               + OPCACHE_NKINDS * sizeof(_PyOpcacheCounters));
         if (co->co_opcache == NULL) {
             PyMem_Free(co->co_opcache_map);
             return -1;
@@ -325,9 +399,123 @@ _PyCode_InitOpcache(PyCodeObject *co)
     }
 
     co->co_opcache_size = (unsigned char)opts;
+    opcache_update_stats(co, 1);
     return 0;
 }
 
+typedef struct {
+    Py_ssize_t optimized[OPCACHE_NKINDS];
+    Py_ssize_t deoptimized[OPCACHE_NKINDS];
+    Py_ssize_t unused[OPCACHE_NKINDS];
+} opcache_code_stats;
+
+static void
+opcache_code_stats_entry(PyCodeObject *co, int kind, _PyOpcache *cache,
+                         void *arg)
+{
+    opcache_code_stats *stats = (opcache_code_stats *)arg;
+    if (cache->optimized > 0) {
+        stats->optimized[kind]++;
+    }
+    else if (cache->optimized < 0) {
+        stats->deoptimized[kind]++;
+    }
+    else {
+        stats->unused[kind]++;
+    }
+}
+
+static const char * const opcache_kind_names[OPCACHE_NKINDS] = {
+    "LOAD_GLOBAL", "LOAD_ATTR", "LOAD_METHOD", "STORE_ATTR",
+};
+
+/* Build the dict returned by sys._getopcachestats(code). */
+PyObject *
+_PyCode_GetOpcacheStats(PyCodeObject *co)
+{
+    opcache_code_stats stats;
+    memset(&stats, 0, sizeof(stats));
+    _PyOpcacheCounters counters[OPCACHE_NKINDS];
+    memset(counters, 0, sizeof(counters));
+    Py_ssize_t memory = 0;
+    if (co->co_opcache != NULL) {
+        opcache_foreach(co, opcache_code_stats_entry, &stats);
+        memcpy(counters, _PyOpcache_CodeCounters(co), sizeof(counters));
+        memory = PyBytes_GET_SIZE(co->co_code) / sizeof(_Py_CODEUNIT) +
+                 co->co_opcache_size * sizeof(_PyOpcache) +
+                 sizeof(counters);
+    }
+
+    PyObject *kinds = PyDict_New();
+    if (kinds == NULL) {
+        return NULL;
+    }
+    for (int kind = 0; kind < OPCACHE_NKINDS; kind++) {
+        Py_ssize_t entries = (stats.optimized[kind] + stats.deoptimized[kind]
+                              + stats.unused[kind]);
+        PyObject *item = Py_BuildValue(
+            "{snsnsnsnsnsnsnsnsn}",
+            "hits", (Py_ssize_t)counters[kind].hits,
+            "misses", (Py_ssize_t)counters[kind].misses,
+            "opts", (Py_ssize_t)counters[kind].opts,
+            "deopts", (Py_ssize_t)counters[kind].deopts,
+            "entries", entries,
+            "optimized", stats.optimized[kind],
+            "deoptimized", stats.deoptimized[kind],
+            "unused", stats.unused[kind],
+            "memory", (Py_ssize_t)(entries * sizeof(_PyOpcache)));
+        if (item == NULL ||
+            PyDict_SetItemString(kinds, opcache_kind_names[kind], item) < 0)
+        {
+            Py_XDECREF(item);
+            Py_DECREF(kinds);
+            return NULL;
+        }
+        Py_DECREF(item);
+    }
+    return Py_BuildValue("{sisOsnsN}",
+                         "runs", co->co_opcache_flag,
+                         "enabled", co->co_opcache != NULL ? Py_True : Py_False,
+                         "memory", memory,
+                         "kinds", kinds);
+}
+
+/* Build the dict returned by sys._getopcachestats(). */
+PyObject *
+_PyOpcache_GetStats(void)
+{
+    PyObject *kinds = PyDict_New();
+    if (kinds == NULL) {
+        return NULL;
+    }
+    size_t memory = _Py_opcache_stats.map_memory;
+    for (int kind = 0; kind < OPCACHE_NKINDS; kind++) {
+        _PyOpcacheKindStats *ks = &_Py_opcache_stats.kinds[kind];
+        PyObject *item = Py_BuildValue(
+            "{snsnsnsnsnsn}",
+            "hits", (Py_ssize_t)ks->hits,
+            "misses", (Py_ssize_t)ks->misses,
+            "opts", (Py_ssize_t)ks->opts,
+            "deopts", (Py_ssize_t)ks->deopts,
+            "entries", (Py_ssize_t)ks->entries,
+            "memory", (Py_ssize_t)(ks->entries * sizeof(_PyOpcache)));
+        if (item == NULL ||
+            PyDict_SetItemString(kinds, opcache_kind_names[kind], item) < 0)
+        {
+            Py_XDECREF(item);
+            Py_DECREF(kinds);
+            return NULL;
+        }
+        Py_DECREF(item);
+        memory += ks->entries * sizeof(_PyOpcache);
+    }
+    return Py_BuildValue("{snsnsN}",
+                         "code_objects",
+                         (Py_ssize_t)_Py_opcache_stats.code_objects,
+                         "memory", (Py_ssize_t)memory,
+                         "kinds", kinds);
+}
+
 PyCodeObject *
 PyCode_NewEmpty(const char *filename, const char *funcname, int firstlineno)
 {
@@ -630,6 +818,7 @@ code_new_impl(PyTypeObject *type, int argcount, int posonlyargcount,
 static void
 code_dealloc(PyCodeObject *co)
 {
+    opcache_update_stats(co, -1);
     if (co->co_opcache != NULL) {
         PyMem_Free(co->co_opcache);
     }
@@ -689,8 +878,9 @@ code_sizeof(PyCodeObject *co, PyObject *Py_UNUSED(args))
         assert(co->co_opcache_map != NULL);
         // co_opcache_map
         res += PyBytes_GET_SIZE(co->co_code) / sizeof(_Py_CODEUNIT);
-        // co_opcache
-        res += co->co_opcache_size * sizeof(_PyOpcache);
+        // co_opcache and the counters after it
+        res += co->co_opcache_size * sizeof(_PyOpcache) +
+               OPCACHE_NKINDS * sizeof(_PyOpcacheCounters);
     }
     return PyLong_FromSsize_t(res);
 }
@@ -1475,6 +1475,49 @@ _PyDict_GetItemHint(PyDictObject *mp, PyObject *key,
     return (mp->ma_keys->dk_lookup)(mp, key, hash, value);
 }
 
+/* Replace the value of an existing key using an index hint, as returned by
+   _PyDict_GetItemHint().  Return 1 if the value was stored, or 0 if the hint
+   doesn't point to a live entry for key; in that case the dict is left
+   unchanged and the caller must fall back to a regular store.  Never raises.
+*/
+int
+_PyDict_SetItemHint(PyDictObject *mp, PyObject *key,
+                    Py_ssize_t hint, PyObject *value)
+{
+    assert(PyDict_CheckExact((PyObject*)mp));
+    assert(PyUnicode_CheckExact(key));
+    assert(value != NULL);
+
+    if (hint < 0 || hint >= mp->ma_keys->dk_nentries) {
+        return 0;
+    }
+    PyDictKeyEntry *ep = DK_ENTRIES(mp->ma_keys) + (size_t)hint;
+    if (ep->me_key != key) {
+        return 0;
+    }
+
+    PyObject **slot;
+    if (mp->ma_keys->dk_lookup == lookdict_split) {
+        assert(mp->ma_values != NULL);
+        slot = &mp->ma_values[(size_t)hint];
+    }
+    else {
+        slot = &ep->me_value;
+    }
+    PyObject *old_value = *slot;
+    if (old_value == NULL) {
+        return 0;
+    }
+
+    MAINTAIN_TRACKING(mp, key, value);
+    Py_INCREF(value);
+    *slot = value;
+    mp->ma_version_tag = DICT_NEXT_VERSION();
+    Py_DECREF(old_value); /* which **CAN** re-enter (see issue #22653) */
+    ASSERT_CONSISTENT(mp);
+    return 1;
+}
+
 /* Same as PyDict_GetItemWithError() but with hash supplied by caller.
    This returns NULL *with* an exception set if an exception occurred.
    It returns NULL *without* an exception set if the key wasn't present.
@@ -4978,6 +5021,73 @@ _PyDict_NewKeysForClass(void)
     return keys;
 }
 
+/* Key-sharing dicts outside of instance dicts.  A decoder which builds many
+   dicts with the same keys (e.g. the records of a JSON document) can convert
+   the first one with _PyDict_MakeKeysShared() and build the following ones
+   with _PyDict_FromSharedKeys(): they only allocate their values array. */
+
+/* Convert the exact dict op with str keys into a split table and return a
+   new reference to its shared keys.  Returns NULL if the table cannot be
+   split; an error is set only if the conversion failed. */
+PyDictKeysObject *
+_PyDict_MakeKeysShared(PyObject *op)
+{
+    return make_keys_shared(op);
+}
+
+/* Return 1 if the shared keys hold exactly the n str keys of names, in the
+   same order, else 0. */
+int
+_PyDictKeys_Match(PyDictKeysObject *keys,
+                  PyObject *const *names, Py_ssize_t n)
+{
+    assert(keys->dk_lookup == lookdict_split);
+    if (keys->dk_nentries != n) {
+        return 0;
+    }
+    PyDictKeyEntry *ep = DK_ENTRIES(keys);
+    for (Py_ssize_t i = 0; i < n; i++, ep++) {
+        PyObject *name = names[i];
+        if (ep->me_key == name) {
+            continue;
+        }
+        if (!PyUnicode_CheckExact(name) ||
+            ep->me_hash != ((PyASCIIObject *)name)->hash ||
+            !unicode_eq(ep->me_key, name))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Return a new dict sharing keys, with values as its values.  The number of
+   values must be the number of entries of keys. */
+PyObject *
+_PyDict_FromSharedKeys(PyDictKeysObject *keys, PyObject *const *values)
+{
+    Py_ssize_t n = keys->dk_nentries;
+    PyDictObject *mp;
+
+    assert(keys->dk_lookup == lookdict_split);
+    dictkeys_incref(keys);
+    mp = (PyDictObject *)new_dict_with_shared_keys(keys);
+    if (mp == NULL) {
+        return NULL;
+    }
+    for (Py_ssize_t i = 0; i < n; i++) {
+        PyObject *value = values[i];
+        Py_INCREF(value);
+        mp->ma_values[i] = value;
+        if (!_PyObject_GC_IS_TRACKED(mp) && _PyObject_GC_MAY_BE_TRACKED(value)) {
+            _PyObject_GC_TRACK(mp);
+        }
+    }
+    mp->ma_used = n;
+    ASSERT_CONSISTENT(mp);
+    return (PyObject *)mp;
+}
+
 #define CACHED_KEYS(tp) (((PyHeapTypeObject*)tp)->ht_cached_keys)
 
 PyObject *
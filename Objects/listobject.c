@@ -1198,6 +1198,10 @@ struct s_MergeState {
      * of tuples. It may be set to safe_object_compare, but the idea is that hopefully
      * we can assume more, and use one of the special-case compares. */
     int (*tuple_elem_compare)(PyObject *, PyObject *, MergeState *);
+
+    /* Set in the threads of a parallel sort, which don't hold the GIL and
+     * can't check the special-case compares with PyObject_RichCompareBool. */
+    int nogil;
 };
 
 /* binarysort is the best method for sorting small arrays: it does
@@ -1531,6 +1535,7 @@ merge_init(MergeState *ms, Py_ssize_t list_size, int has_keyfunc)
     ms->a.keys = ms->temparray;
     ms->n = 0;
     ms->min_gallop = MIN_GALLOP;
+    ms->nogil = 0;
 }
 
 /* Free all the temp memory owned by the MergeState.  This must be called
@@ -2076,7 +2081,7 @@ unsafe_latin_compare(PyObject *v, PyObject *w, MergeState *ms)
            res < 0 :
            PyUnicode_GET_LENGTH(v) < PyUnicode_GET_LENGTH(w));
 
-    assert(res == PyObject_RichCompareBool(v, w, Py_LT));;
+    assert(ms->nogil || res == PyObject_RichCompareBool(v, w, Py_LT));
     return res;
 }
 
@@ -2104,7 +2109,7 @@ unsafe_long_compare(PyObject *v, PyObject *w, MergeState *ms)
         w0 = -w0;
 
     res = v0 < w0;
-    assert(res == PyObject_RichCompareBool(v, w, Py_LT));
+    assert(ms->nogil || res == PyObject_RichCompareBool(v, w, Py_LT));
     return res;
 }
 
@@ -2119,7 +2124,7 @@ unsafe_float_compare(PyObject *v, PyObject *w, MergeState *ms)
     assert(Py_IS_TYPE(w, &PyFloat_Type));
 
     res = PyFloat_AS_DOUBLE(v) < PyFloat_AS_DOUBLE(w);
-    assert(res == PyObject_RichCompareBool(v, w, Py_LT));
+    assert(ms->nogil || res == PyObject_RichCompareBool(v, w, Py_LT));
     return res;
 }
 
@@ -2165,6 +2170,447 @@ unsafe_tuple_compare(PyObject *v, PyObject *w, MergeState *ms)
         return PyObject_RichCompareBool(vt->ob_item[i], wt->ob_item[i], Py_LT);
 }
 
+/* Sort the n keys of lo with the mergesort, moving the values along.
+ * Return 0 on success, -1 on error.
+ */
+static int
+timsort_slice(MergeState *ms, sortslice lo, Py_ssize_t nremaining)
+{
+    Py_ssize_t minrun;
+
+    /* March over the array once, left to right, finding natural runs,
+     * and extending short natural runs to minrun elements.
+     */
+    minrun = merge_compute_minrun(nremaining);
+    do {
+        int descending;
+        Py_ssize_t n;
+
+        /* Identify next run. */
+        n = count_run(ms, lo.keys, lo.keys + nremaining, &descending);
+        if (n < 0)
+            return -1;
+        if (descending)
+            reverse_sortslice(&lo, n);
+        /* If short, extend to min(minrun, nremaining). */
+        if (n < minrun) {
+            const Py_ssize_t force = nremaining <= minrun ?
+                              nremaining : minrun;
+            if (binarysort(ms, lo, lo.keys + force, lo.keys + n) < 0)
+                return -1;
+            n = force;
+        }
+        /* Push run onto pending-runs stack, and maybe merge. */
+        assert(ms->n < MAX_MERGE_PENDING);
+        ms->pending[ms->n].base = lo;
+        ms->pending[ms->n].len = n;
+        ++ms->n;
+        if (merge_collapse(ms) < 0)
+            return -1;
+        /* Advance to find next run. */
+        sortslice_advance(&lo, n);
+        nremaining -= n;
+    } while (nremaining);
+
+    if (merge_force_collapse(ms) < 0)
+        return -1;
+    assert(ms->n == 1);
+    return 0;
+}
+
+/* Radix sort of floats and small ints.
+ *
+ * When the pre-sort check finds that all keys are floats or small ints,
+ * large lists without much order are sorted by copying the keys into an
+ * array of unsigned 64-bit integers which compare like the keys, sorting
+ * this array with an LSD radix sort, and permuting the keys and values
+ * back.  The radix sort is stable like the mergesort, and gives the same
+ * result:  -0.0 gets the key of 0.0 since they compare equal, and lists
+ * with NaNs are left to the mergesort since NaNs don't compare.
+ *
+ * Lists with long runs are left to the mergesort, which is linear on them.
+ * See listsort.txt.
+ */
+
+#define RADIX_SORT_MIN_SIZE 512
+#define RADIX_BITS 8
+#define RADIX_PASSES (64 / RADIX_BITS)
+
+typedef struct {
+    uint64_t key;
+    Py_ssize_t index;
+} radix_item;
+
+static inline uint64_t
+radix_long_key(PyObject *v)
+{
+    PyLongObject *vl = (PyLongObject *)v;
+    int64_t v0;
+
+    assert(Py_ABS(Py_SIZE(v)) <= 1);
+    v0 = Py_SIZE(vl) == 0 ? 0 : (sdigit)vl->ob_digit[0];
+    if (Py_SIZE(vl) < 0)
+        v0 = -v0;
+    /* Single digits fit in 32 bits, so only the 4 low bytes are sorted. */
+    return (uint64_t)(v0 + ((int64_t)1 << 31));
+}
+
+/* Return the key of a float, or 0 for a NaN.  No other key is 0. */
+static inline uint64_t
+radix_float_key(PyObject *v)
+{
+    double x = PyFloat_AS_DOUBLE(v);
+    uint64_t u;
+
+    if (x == 0.0)
+        x = 0.0;
+    else if (Py_IS_NAN(x))
+        return 0;
+    memcpy(&u, &x, sizeof(u));
+    if (u >> 63)
+        return ~u;
+    return u | ((uint64_t)1 << 63);
+}
+
+/* Sort the n keys of the slice, which are all floats if is_float is true,
+ * or ints accepted by unsafe_long_compare, using a buffer of 2*n items.
+ * Return 1 if the slice was sorted, or 0 if it should be sorted by the
+ * mergesort instead.  The GIL doesn't need to be held.
+ */
+static int
+radix_sort_buffer(sortslice *slice, Py_ssize_t n, int is_float,
+                  radix_item *buffer)
+{
+    radix_item *src = buffer, *dst = buffer + n, *tmp;
+    PyObject **objects;
+    Py_ssize_t counts[RADIX_PASSES][1 << RADIX_BITS];
+    Py_ssize_t i, ascents = 0, descents = 0;
+    int pass;
+
+    for (i = 0; i < n; i++) {
+        uint64_t key = (is_float ? radix_float_key(slice->keys[i])
+                                 : radix_long_key(slice->keys[i]));
+        if (key == 0)
+            return 0;
+        if (i > 0) {
+            ascents += key > src[i - 1].key;
+            descents += key < src[i - 1].key;
+        }
+        src[i].key = key;
+        src[i].index = i;
+    }
+    if (ascents < n / 16 || descents < n / 16)
+        return 0;
+
+    memset(counts, 0, sizeof(counts));
+    for (i = 0; i < n; i++) {
+        uint64_t key = src[i].key;
+        for (pass = 0; pass < RADIX_PASSES; pass++) {
+            counts[pass][key & ((1 << RADIX_BITS) - 1)]++;
+            key >>= RADIX_BITS;
+        }
+    }
+    for (pass = 0; pass < RADIX_PASSES; pass++) {
+        Py_ssize_t *count = counts[pass];
+        int shift = pass * RADIX_BITS;
+        Py_ssize_t total = 0;
+        int digit;
+
+        /* Skip the digits which are the same for all keys. */
+        digit = (src[0].key >> shift) & ((1 << RADIX_BITS) - 1);
+        if (count[digit] == n)
+            continue;
+        for (digit = 0; digit < (1 << RADIX_BITS); digit++) {
+            Py_ssize_t c = count[digit];
+            count[digit] = total;
+            total += c;
+        }
+        for (i = 0; i < n; i++) {
+            digit = (src[i].key >> shift) & ((1 << RADIX_BITS) - 1);
+            dst[count[digit]++] = src[i];
+        }
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    /* Permute the keys and values, using dst as a temporary array. */
+    objects = (PyObject **)dst;
+    for (i = 0; i < n; i++)
+        objects[i] = slice->keys[src[i].index];
+    memcpy(slice->keys, objects, n * sizeof(PyObject *));
+    if (slice->values != NULL) {
+        for (i = 0; i < n; i++)
+            objects[i] = slice->values[src[i].index];
+        memcpy(slice->values, objects, n * sizeof(PyObject *));
+    }
+    return 1;
+}
+
+static int
+radix_sort(sortslice *slice, Py_ssize_t n, int is_float)
+{
+    radix_item *buffer;
+    int res;
+
+    assert(n >= RADIX_SORT_MIN_SIZE);
+    if ((size_t)n > PY_SSIZE_T_MAX / (2 * sizeof(radix_item)))
+        return 0;
+    /* Not enough memory is no error: the mergesort needs less. */
+    buffer = PyMem_Malloc(2 * n * sizeof(radix_item));
+    if (buffer == NULL)
+        return 0;
+    res = radix_sort_buffer(slice, n, is_float, buffer);
+    PyMem_Free(buffer);
+    return res;
+}
+
+/* Parallel sort of floats, small ints and Latin-1 strings.
+ *
+ * These keys are compared without running Python code or touching reference
+ * counts, so list.sort(threads=n) sorts large lists of them without the GIL:
+ * the list is split in up to n chunks of at least PARALLEL_SORT_MIN_SIZE
+ * keys which are sorted by as many threads, then the sorted chunks are merged
+ * pairwise until one run is left, each merge being split between the threads.
+ * The chunks are sorted stably and the merges take the left key on ties, so
+ * the result is the same as the one of the sequential sort, provided that
+ * the keys are totally ordered: floats are only sorted in parallel if there
+ * is no NaN.
+ */
+
+#define PARALLEL_SORT_MIN_SIZE (1 << 16)
+#define PARALLEL_SORT_MAX_CHUNKS 64
+
+typedef struct s_sort_task sort_task;
+struct s_sort_task {
+    void (*func)(sort_task *);
+    PyThread_type_lock done;    /* held unless a thread runs the task */
+    int started;
+    /* Sort the n keys of a, or merge them with the n2 keys of b into dest. */
+    sortslice a, b, dest;
+    Py_ssize_t n, n2;
+    void *buffer;               /* temporary space for sorting a */
+    MergeState ms;
+};
+
+static void
+sort_chunk(sort_task *t)
+{
+    MergeState *ms = &t->ms;
+
+    if (ms->key_compare != unsafe_latin_compare &&
+        radix_sort_buffer(&t->a, t->n, ms->key_compare == unsafe_float_compare,
+                          (radix_item *)t->buffer))
+    {
+        return;
+    }
+    ms->a.keys = (PyObject **)t->buffer;
+    ms->alloced = (t->n + 1) / 2;
+    if (t->a.values != NULL)
+        ms->a.values = ms->a.keys + ms->alloced;
+    /* The compares can't fail and the temporary space is large enough. */
+    (void)timsort_slice(ms, t->a, t->n);
+}
+
+static void
+merge_chunks(sort_task *t)
+{
+    MergeState *ms = &t->ms;
+    sortslice a = t->a, b = t->b, dest = t->dest;
+    Py_ssize_t na = t->n, nb = t->n2;
+
+    while (na > 0 && nb > 0) {
+        if (ms->key_compare(*b.keys, *a.keys, ms)) {
+            sortslice_copy_incr(&dest, &b);
+            --nb;
+        }
+        else {
+            sortslice_copy_incr(&dest, &a);
+            --na;
+        }
+    }
+    sortslice_memcpy(&dest, 0, &a, 0, na);
+    sortslice_memcpy(&dest, na, &b, 0, nb);
+}
+
+/* Return how many of the first k keys of the merge of a and b come from a. */
+static Py_ssize_t
+merge_split(MergeState *ms, PyObject **a, Py_ssize_t na,
+            PyObject **b, Py_ssize_t nb, Py_ssize_t k)
+{
+    Py_ssize_t lo = k > nb ? k - nb : 0;
+    Py_ssize_t hi = k < na ? k : na;
+
+    while (lo < hi) {
+        Py_ssize_t i = lo + (hi - lo) / 2;
+        /* Does a[i] come before b[k-i-1]? */
+        if (!ms->key_compare(b[k - i - 1], a[i], ms))
+            lo = i + 1;
+        else
+            hi = i;
+    }
+    return lo;
+}
+
+static void
+sort_task_thread(void *arg)
+{
+    sort_task *t = (sort_task *)arg;
+
+    t->func(t);
+    PyThread_release_lock(t->done);
+}
+
+/* Run the tasks in as many threads, including the current one.  The tasks
+ * of the threads which can't be started are run by the current thread.
+ */
+static void
+run_sort_tasks(sort_task *tasks, Py_ssize_t ntasks)
+{
+    Py_ssize_t i;
+
+    for (i = 1; i < ntasks; i++) {
+        tasks[i].started = (PyThread_start_new_thread(sort_task_thread,
+                                                      &tasks[i])
+                            != PYTHREAD_INVALID_THREAD_ID);
+    }
+    tasks[0].func(&tasks[0]);
+    for (i = 1; i < ntasks; i++) {
+        if (tasks[i].started)
+            PyThread_acquire_lock(tasks[i].done, WAIT_LOCK);
+        else
+            tasks[i].func(&tasks[i]);
+    }
+}
+
+/* Sort the n keys of lo with up to nthreads threads, if they are compared
+ * by key_compare without the GIL.  Return 1 if the slice was sorted, or 0
+ * if it should be sorted sequentially.
+ */
+static int
+parallel_sort(sortslice *lo, Py_ssize_t n, MergeState *base,
+              Py_ssize_t nthreads)
+{
+    sort_task *tasks;
+    sortslice src, dst, tmp;
+    Py_ssize_t offsets[PARALLEL_SORT_MAX_CHUNKS + 1];
+    Py_ssize_t nchunks, i, k;
+    size_t itemsize;
+    char *buffer;
+    int res = 0;
+
+    if (base->key_compare == unsafe_float_compare) {
+        for (i = 0; i < n; i++) {
+            if (Py_IS_NAN(PyFloat_AS_DOUBLE(lo->keys[i])))
+                return 0;
+        }
+    }
+    else if (base->key_compare != unsafe_long_compare &&
+             base->key_compare != unsafe_latin_compare) {
+        return 0;
+    }
+    nthreads = Py_MIN(nthreads, PARALLEL_SORT_MAX_CHUNKS);
+    nchunks = Py_MIN(nthreads, n / PARALLEL_SORT_MIN_SIZE);
+    if (nchunks < 2)
+        return 0;
+
+    /* The buffer is used for sorting the chunks, then for the merges. */
+    itemsize = (base->key_compare == unsafe_latin_compare ?
+                2 * sizeof(PyObject *) : 2 * sizeof(radix_item));
+    if ((size_t)n > PY_SSIZE_T_MAX / itemsize)
+        return 0;
+    buffer = PyMem_Malloc(n * itemsize);
+    tasks = PyMem_Calloc(nthreads, sizeof(sort_task));
+    if (buffer == NULL || tasks == NULL)
+        goto done;
+    for (i = 0; i < nthreads; i++) {
+        tasks[i].ms = *base;
+        tasks[i].ms.nogil = 1;
+        tasks[i].done = PyThread_allocate_lock();
+        if (tasks[i].done == NULL)
+            goto done;
+        PyThread_acquire_lock(tasks[i].done, WAIT_LOCK);
+    }
+
+    for (i = 0; i <= nchunks; i++)
+        offsets[i] = n / nchunks * i + Py_MIN(i, n % nchunks);
+    for (i = 0; i < nchunks; i++) {
+        tasks[i].func = sort_chunk;
+        tasks[i].a = *lo;
+        sortslice_advance(&tasks[i].a, offsets[i]);
+        tasks[i].n = offsets[i + 1] - offsets[i];
+        tasks[i].buffer = buffer + offsets[i] * itemsize;
+    }
+    Py_BEGIN_ALLOW_THREADS
+    run_sort_tasks(tasks, nchunks);
+    Py_END_ALLOW_THREADS
+
+    src = *lo;
+    dst.keys = (PyObject **)buffer;
+    dst.values = lo->values != NULL ? dst.keys + n : NULL;
+    while (nchunks > 1) {
+        /* Merge the pairs of runs, splitting each merge in parts. */
+        Py_ssize_t npairs = (nchunks + 1) / 2;
+        Py_ssize_t nparts = Py_MAX(nthreads / npairs, 1);
+        Py_ssize_t ntasks = 0;
+
+        for (i = 0; i < npairs; i++) {
+            Py_ssize_t start = offsets[2 * i];
+            Py_ssize_t mid = offsets[Py_MIN(2 * i + 1, nchunks)];
+            Py_ssize_t end = offsets[Py_MIN(2 * i + 2, nchunks)];
+            Py_ssize_t ia = 0, ib = 0;
+
+            for (k = 1; k <= nparts; k++) {
+                sort_task *t = &tasks[ntasks++];
+                Py_ssize_t nk = (end - start) / nparts * k;
+                Py_ssize_t ja, jb;
+
+                if (k == nparts)
+                    nk = end - start;
+                ja = merge_split(&t->ms, src.keys + start, mid - start,
+                                 src.keys + mid, end - mid, nk);
+                jb = nk - ja;
+                t->func = merge_chunks;
+                t->a = src;
+                sortslice_advance(&t->a, start + ia);
+                t->b = src;
+                sortslice_advance(&t->b, mid + ib);
+                t->dest = dst;
+                sortslice_advance(&t->dest, start + ia + ib);
+                t->n = ja - ia;
+                t->n2 = jb - ib;
+                ia = ja;
+                ib = jb;
+            }
+            offsets[i] = start;
+        }
+        offsets[npairs] = n;
+        Py_BEGIN_ALLOW_THREADS
+        run_sort_tasks(tasks, ntasks);
+        Py_END_ALLOW_THREADS
+        nchunks = npairs;
+        tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+    if (src.keys != lo->keys)
+        sortslice_memcpy(lo, 0, &src, 0, n);
+    res = 1;
+
+done:
+    if (tasks != NULL) {
+        for (i = 0; i < nthreads; i++) {
+            if (tasks[i].done != NULL) {
+                PyThread_release_lock(tasks[i].done);
+                PyThread_free_lock(tasks[i].done);
+            }
+        }
+        PyMem_Free(tasks);
+    }
+    PyMem_Free(buffer);
+    return res;
+}
+
 /* An adaptive, stable, natural mergesort.  See listsort.txt.
  * Returns Py_None on success, NULL on error.  Even in case of error, the
  * list will be some permutation of its input state (nothing is lost or
@@ -2176,6 +2622,7 @@ list.sort
     *
     key as keyfunc: object = None
     reverse: bool(accept={int}) = False
+    threads: Py_ssize_t = 1
 
 Sort the list in ascending order and return None.
 
@@ -2186,15 +2633,18 @@ If a key function is given, apply it once to each list item and sort them,
 ascending or descending, according to their function values.
 
 The reverse flag can be set to sort in descending order.
+
+Large lists of floats, small ints or Latin-1 strings can be sorted by up to
+the given number of threads, with the same result.
 [clinic start generated code]*/
 
 static PyObject *
-list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse)
-/*[clinic end generated code: output=57b9f9c5e23fbe42 input=cb56cd179a713060]*/
+list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse,
+               Py_ssize_t threads)
+/*[clinic end generated code: output=d5f2ddf33404f34a input=8ee9a0f3e079c300]*/
 {
     MergeState ms;
     Py_ssize_t nremaining;
-    Py_ssize_t minrun;
     sortslice lo;
     Py_ssize_t saved_ob_size, saved_allocated;
     PyObject **saved_ob_item;
@@ -2207,6 +2657,10 @@ list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse)
     assert(PyList_Check(self));
     if (keyfunc == Py_None)
         keyfunc = NULL;
+    if (threads < 1) {
+        PyErr_SetString(PyExc_ValueError, "threads must be at least 1");
+        return NULL;
+    }
 
     /* The list is temporarily made empty, so that mutations performed
      * by comparison functions can't affect the slice of memory we're
@@ -2364,48 +2818,23 @@ list_sort_impl(PyListObject *self, PyObject *keyfunc, int reverse)
         reverse_slice(&saved_ob_item[0], &saved_ob_item[saved_ob_size]);
     }
 
-    /* March over the array once, left to right, finding natural runs,
-     * and extending short natural runs to minrun elements.
-     */
-    minrun = merge_compute_minrun(nremaining);
-    do {
-        int descending;
-        Py_ssize_t n;
-
-        /* Identify next run. */
-        n = count_run(&ms, lo.keys, lo.keys + nremaining, &descending);
-        if (n < 0)
-            goto fail;
-        if (descending)
-            reverse_sortslice(&lo, n);
-        /* If short, extend to min(minrun, nremaining). */
-        if (n < minrun) {
-            const Py_ssize_t force = nremaining <= minrun ?
-                              nremaining : minrun;
-            if (binarysort(&ms, lo, lo.keys + force, lo.keys + n) < 0)
-                goto fail;
-            n = force;
-        }
-        /* Push run onto pending-runs stack, and maybe merge. */
-        assert(ms.n < MAX_MERGE_PENDING);
-        ms.pending[ms.n].base = lo;
-        ms.pending[ms.n].len = n;
-        ++ms.n;
-        if (merge_collapse(&ms) < 0)
-            goto fail;
-        /* Advance to find next run. */
-        sortslice_advance(&lo, n);
-        nremaining -= n;
-    } while (nremaining);
+    if (threads > 1 && parallel_sort(&lo, nremaining, &ms, threads))
+        goto succeed;
+    if (nremaining >= RADIX_SORT_MIN_SIZE &&
+        (ms.key_compare == unsafe_float_compare ||
+         ms.key_compare == unsafe_long_compare) &&
+        radix_sort(&lo, nremaining, ms.key_compare == unsafe_float_compare))
+    {
+        goto succeed;
+    }
 
-    if (merge_force_collapse(&ms) < 0)
+    if (timsort_slice(&ms, lo, nremaining) < 0)
         goto fail;
     assert(ms.n == 1);
     assert(keys == NULL
            ? ms.pending[0].base.keys == saved_ob_item
            : ms.pending[0].base.keys == &keys[0]);
     assert(ms.pending[0].len == saved_ob_size);
-    lo = ms.pending[0].base;
 
 succeed:
     result = Py_None;
@@ -2457,7 +2886,7 @@ PyList_Sort(PyObject *v)
         PyErr_BadInternalCall();
         return -1;
     }
-    v = list_sort_impl((PyListObject *)v, NULL, 0);
+    v = list_sort_impl((PyListObject *)v, NULL, 0, 1);
     if (v == NULL)
         return -1;
     Py_DECREF(v);
@@ -1,5 +1,6 @@
 #include "Python.h"
 #include "pycore_pymem.h"         // _PyTraceMalloc_Config
+#include "pycore_pystate.h"       // _PyThreadState_GET()
 
 #include <stdbool.h>
 
@@ -143,10 +144,56 @@ _PyObject_ArenaVirtualFree(void *ctx, void *ptr, size_t size)
 }
 
 #elif defined(ARENAS_USE_MMAP)
+#ifdef WITH_PYMALLOC
+static int arena_use_hugepages = 0;
+#define HUGE_PAGE_SIZE          (2 << 20)       /* 2MB */
+
+/* Map size bytes aligned on a huge page boundary, so that the kernel can
+   back the mapping with transparent huge pages.  Explicit huge pages
+   (MAP_HUGETLB) are used if the system administrator reserved some. */
+static void *
+arena_mmap_huge(size_t size)
+{
+    void *ptr;
+#ifdef MAP_HUGETLB
+    ptr = mmap(NULL, size, PROT_READ|PROT_WRITE,
+               MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB, -1, 0);
+    if (ptr != MAP_FAILED) {
+        return ptr;
+    }
+#endif
+    /* Over-allocate, then trim the unaligned head and tail */
+    size_t mapsize = size + HUGE_PAGE_SIZE;
+    ptr = mmap(NULL, mapsize, PROT_READ|PROT_WRITE,
+               MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+    if (ptr == MAP_FAILED) {
+        return NULL;
+    }
+    uintptr_t start = (uintptr_t)ptr;
+    uintptr_t aligned = _Py_SIZE_ROUND_UP(start, HUGE_PAGE_SIZE);
+    if (aligned != start) {
+        munmap(ptr, aligned - start);
+    }
+    if (aligned + size != start + mapsize) {
+        munmap((void *)(aligned + size), start + mapsize - (aligned + size));
+    }
+    ptr = (void *)aligned;
+#ifdef MADV_HUGEPAGE
+    (void)madvise(ptr, size, MADV_HUGEPAGE);
+#endif
+    return ptr;
+}
+#endif   /* WITH_PYMALLOC */
+
 static void *
 _PyObject_ArenaMmap(void *ctx, size_t size)
 {
     void *ptr;
+#ifdef WITH_PYMALLOC
+    if (arena_use_hugepages && size % HUGE_PAGE_SIZE == 0) {
+        return arena_mmap_huge(size);
+    }
+#endif
     ptr = mmap(NULL, size, PROT_READ|PROT_WRITE,
                MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
     if (ptr == MAP_FAILED)
@@ -909,8 +956,21 @@ static int running_on_valgrind = -1;
  */
 #define ARENA_SIZE              (256 << 10)     /* 256KB */
 
+/*
+ * With -X hugepages (PyPreConfig.use_hugepages), arenas are 2MB instead,
+ * aligned on a 2MB boundary and backed by a huge page where the platform
+ * supports it.  A process with a large heap of small objects then needs one
+ * TLB entry per arena rather than 512.  The arena size is picked before the
+ * first arena is allocated and never changes afterwards, since
+ * address_in_range() relies on all arenas having the same size.
+ */
+#define HUGE_ARENA_SIZE         (2 << 20)       /* 2MB */
+#define MAX_ARENA_SIZE          HUGE_ARENA_SIZE
+
+static size_t arena_size = ARENA_SIZE;
+
 #ifdef WITH_MEMORY_LIMITS
-#define MAX_ARENAS              (SMALL_MEMORY_LIMIT / ARENA_SIZE)
+#define MAX_ARENAS              (SMALL_MEMORY_LIMIT / arena_size)
 #endif
 
 /*
@@ -920,10 +980,13 @@ static int running_on_valgrind = -1;
 #define POOL_SIZE               SYSTEM_PAGE_SIZE        /* must be 2^N */
 #define POOL_SIZE_MASK          SYSTEM_PAGE_SIZE_MASK
 
-#define MAX_POOLS_IN_ARENA  (ARENA_SIZE / POOL_SIZE)
-#if MAX_POOLS_IN_ARENA * POOL_SIZE != ARENA_SIZE
+#define MAX_POOLS_IN_ARENA  (MAX_ARENA_SIZE / POOL_SIZE)
+#if (ARENA_SIZE / POOL_SIZE) * POOL_SIZE != ARENA_SIZE
 #   error "arena size not an exact multiple of pool size"
 #endif
+#if MAX_POOLS_IN_ARENA * POOL_SIZE != MAX_ARENA_SIZE
+#   error "huge arena size not an exact multiple of pool size"
+#endif
 
 /*
  * -- End of tunable settings section --
@@ -1196,7 +1259,7 @@ static struct arena_object* nfp2lasta[MAX_POOLS_IN_ARENA + 1] = { NULL };
 
 /* How many arena_objects do we initially allocate?
  * 16 = can allocate 16 arenas = 16 * ARENA_SIZE = 4MB before growing the
- * `arenas` vector.
+ * `arenas` vector (32MB with huge arenas).
  */
 #define INITIAL_ARENA_OBJECTS 16
 
@@ -1209,11 +1272,15 @@ static size_t ntimes_arena_allocated = 0;
 static size_t narenas_highwater = 0;
 
 static Py_ssize_t raw_allocated_blocks;
+/* Total number of blocks held by thread caches. */
+static Py_ssize_t cached_blocks = 0;
 
 Py_ssize_t
 _Py_GetAllocatedBlocks(void)
 {
-    Py_ssize_t n = raw_allocated_blocks;
+    /* Blocks sitting in thread caches are free from the user's point of
+       view, even though their pools count them as allocated. */
+    Py_ssize_t n = raw_allocated_blocks - cached_blocks;
     /* add up allocated blocks for used pools */
     for (uint i = 0; i < maxarenas; ++i) {
         /* Skip arenas which are not allocated. */
@@ -1234,6 +1301,22 @@ _Py_GetAllocatedBlocks(void)
 }
 
 
+/* Switch to huge arenas (see HUGE_ARENA_SIZE).  Called for -X hugepages
+   while the pre-configuration is written.  Nothing is done if an arena has
+   already been allocated: all arenas must have the same size. */
+void
+_PyObject_EnableHugeArenas(void)
+{
+    if (ntimes_arena_allocated != 0) {
+        return;
+    }
+    arena_size = HUGE_ARENA_SIZE;
+#ifdef ARENAS_USE_MMAP
+    arena_use_hugepages = 1;
+#endif
+}
+
+
 /* Allocate a new arena.  If we run out of memory, return NULL.  Else
  * allocate a new arena, and return the address of an arena_object
  * describing the new arena.  It's expected that the caller will set
@@ -1301,7 +1384,7 @@ new_arena(void)
     arenaobj = unused_arena_objects;
     unused_arena_objects = arenaobj->nextarena;
     assert(arenaobj->address == 0);
-    address = _PyObject_Arena.alloc(_PyObject_Arena.ctx, ARENA_SIZE);
+    address = _PyObject_Arena.alloc(_PyObject_Arena.ctx, arena_size);
     if (address == NULL) {
         /* The allocation failed: return NULL after putting the
          * arenaobj back.
@@ -1320,7 +1403,7 @@ new_arena(void)
     /* pool_address <- first pool-aligned address in the arena
        nfreepools <- number of whole pools that fit after alignment */
     arenaobj->pool_address = (block*)arenaobj->address;
-    arenaobj->nfreepools = MAX_POOLS_IN_ARENA;
+    arenaobj->nfreepools = (uint)(arena_size / POOL_SIZE);
     excess = (uint)(arenaobj->address & POOL_SIZE_MASK);
     if (excess != 0) {
         --arenaobj->nfreepools;
@@ -1419,7 +1502,7 @@ address_in_range(void *p, poolp pool)
     // only once.
     uint arenaindex = *((volatile uint *)&pool->arenaindex);
     return arenaindex < maxarenas &&
-        (uintptr_t)p - arenas[arenaindex].address < ARENA_SIZE &&
+        (uintptr_t)p - arenas[arenaindex].address < arena_size &&
         arenas[arenaindex].address != 0;
 }
 
@@ -1516,7 +1599,7 @@ allocate_from_new_pool(uint size)
             assert(usable_arenas->freepools != NULL ||
                    usable_arenas->pool_address <=
                    (block*)usable_arenas->address +
-                       ARENA_SIZE - POOL_SIZE);
+                       arena_size - POOL_SIZE);
         }
     }
     else {
@@ -1525,7 +1608,7 @@ allocate_from_new_pool(uint size)
         assert(usable_arenas->freepools == NULL);
         pool = (poolp)usable_arenas->pool_address;
         assert((block*)pool <= (block*)usable_arenas->address +
-                                 ARENA_SIZE - POOL_SIZE);
+                                 arena_size - POOL_SIZE);
         pool->arenaindex = (uint)(usable_arenas - arenas);
         assert(&arenas[pool->arenaindex] == usable_arenas);
         pool->szidx = DUMMY_SIZE_IDX;
@@ -1578,6 +1661,93 @@ allocate_from_new_pool(uint size)
     return bp;
 }
 
+/* Per-thread block caches.
+
+   Every thread state owns a small cache of free blocks per size class.
+   pymalloc_free() pushes blocks to the cache of the current thread instead
+   of linking them back into their pool, and pymalloc_alloc() pops them
+   again.  Threads allocating and freeing objects of the same size classes
+   thus mostly work on memory they touched recently, rather than on the
+   pool headers and free lists shared by all threads.
+
+   Blocks sitting in a cache are still counted as allocated by their pool
+   (pool->ref.count), so a pool holding cached blocks is never released.
+   To bound the memory held that way, a cache keeps at most
+   THREAD_CACHE_MAX_BLOCKS blocks and THREAD_CACHE_MAX_BYTES bytes per size
+   class; when that limit is exceeded half of the cached blocks are given
+   back to their pools at once.  When a cache is empty, it is refilled with
+   a batch of blocks from the current used pool of the size class (never
+   from a fresh pool).
+
+   The cache is created lazily on the first free, and flushed by
+   PyThreadState_Clear() through _PyObject_ClearThreadCache().  After that,
+   the thread state gets the thread_cache_disabled sentinel: blocks freed
+   while the thread state is being torn down go straight to their pools.
+
+   Like the rest of pymalloc, the caches rely on the GIL.
+*/
+
+#define THREAD_CACHE_MAX_BLOCKS 64
+#define THREAD_CACHE_MAX_BYTES  4096
+#define THREAD_CACHE_LIMIT(I) \
+    Py_MIN(THREAD_CACHE_MAX_BLOCKS, THREAD_CACHE_MAX_BYTES / INDEX2SIZE(I))
+/* Number of blocks moved from a pool into an empty cache at once. */
+#define THREAD_CACHE_REFILL(I) (THREAD_CACHE_LIMIT(I) / 4)
+
+struct _obmalloc_thread_cache {
+    block *freeblocks[NB_SMALL_SIZE_CLASSES];
+    uint nfree[NB_SMALL_SIZE_CLASSES];
+};
+
+/* Used by thread states which must not cache blocks anymore: all its
+   freeblocks lists are empty. */
+static struct _obmalloc_thread_cache thread_cache_disabled;
+
+/* Return the block cache of the current thread, or NULL if the thread
+   doesn't have one (yet). */
+static inline struct _obmalloc_thread_cache *
+get_thread_cache(void)
+{
+    PyThreadState *tstate = _PyThreadState_GET();
+    if (UNLIKELY(tstate == NULL)) {
+        return NULL;
+    }
+    return tstate->obmalloc_cache;
+}
+
+/* Pick up the head block of the free list of a used pool. */
+static inline block *
+pool_alloc_block(poolp pool, uint size)
+{
+    ++pool->ref.count;
+    block *bp = pool->freeblock;
+    assert(bp != NULL);
+
+    if (UNLIKELY((pool->freeblock = *(block **)bp) == NULL)) {
+        // Reached the end of the free list, try to extend it.
+        pymalloc_pool_extend(pool, size);
+    }
+    return bp;
+}
+
+static void
+thread_cache_refill(struct _obmalloc_thread_cache *cache, uint size)
+{
+    uint n = THREAD_CACHE_REFILL(size);
+    for (uint i = 0; i < n; i++) {
+        poolp pool = usedpools[size + size];
+        if (pool == pool->nextpool) {
+            /* Don't grab a fresh pool just to fill the cache */
+            break;
+        }
+        block *bp = pool_alloc_block(pool, size);
+        *(block **)bp = cache->freeblocks[size];
+        cache->freeblocks[size] = bp;
+        cache->nfree[size]++;
+        cached_blocks++;
+    }
+}
+
 /* pymalloc allocator
 
    Return a pointer to newly allocated memory if pymalloc allocated memory.
@@ -1606,21 +1776,24 @@ pymalloc_alloc(void *ctx, size_t nbytes)
     }
 
     uint size = (uint)(nbytes - 1) >> ALIGNMENT_SHIFT;
-    poolp pool = usedpools[size + size];
+    struct _obmalloc_thread_cache *cache = get_thread_cache();
     block *bp;
 
-    if (LIKELY(pool != pool->nextpool)) {
-        /*
-         * There is a used pool for this size class.
-         * Pick up the head block of its free list.
-         */
-        ++pool->ref.count;
-        bp = pool->freeblock;
-        assert(bp != NULL);
+    if (cache != NULL) {
+        bp = cache->freeblocks[size];
+        if (LIKELY(bp != NULL)) {
+            cache->freeblocks[size] = *(block **)bp;
+            cache->nfree[size]--;
+            cached_blocks--;
+            return (void *)bp;
+        }
+    }
 
-        if (UNLIKELY((pool->freeblock = *(block **)bp) == NULL)) {
-            // Reached the end of the free list, try to extend it.
-            pymalloc_pool_extend(pool, size);
+    poolp pool = usedpools[size + size];
+    if (LIKELY(pool != pool->nextpool)) {
+        bp = pool_alloc_block(pool, size);
+        if (cache != NULL && cache != &thread_cache_disabled) {
+            thread_cache_refill(cache, size);
         }
     }
     else {
@@ -1770,7 +1943,7 @@ insert_to_freepool(poolp pool)
 
         /* Free the entire arena. */
         _PyObject_Arena.free(_PyObject_Arena.ctx,
-                             (void *)ao->address, ARENA_SIZE);
+                             (void *)ao->address, arena_size);
         ao->address = 0;                        /* mark unassociated */
         --narenas_currently_allocated;
 
@@ -1848,6 +2021,10 @@ insert_to_freepool(poolp pool)
            || ao->prevarena->nextarena == ao);
 }
 
+static void pool_free_block(poolp pool, block *p);
+static struct _obmalloc_thread_cache *thread_cache_new(PyThreadState *tstate);
+static void thread_cache_trim(struct _obmalloc_thread_cache *cache, uint size);
+
 /* Free a memory block allocated by pymalloc_alloc().
    Return 1 if it was freed.
    Return 0 if the block was not allocated by pymalloc_alloc(). */
@@ -1868,6 +2045,33 @@ pymalloc_free(void *ctx, void *p)
     }
     /* We allocated this address. */
 
+    PyThreadState *tstate = _PyThreadState_GET();
+    if (LIKELY(tstate != NULL)) {
+        struct _obmalloc_thread_cache *cache = tstate->obmalloc_cache;
+        if (UNLIKELY(cache == NULL)) {
+            cache = thread_cache_new(tstate);
+        }
+        if (LIKELY(cache != &thread_cache_disabled)) {
+            uint size = pool->szidx;
+            *(block **)p = cache->freeblocks[size];
+            cache->freeblocks[size] = (block *)p;
+            cached_blocks++;
+            if (UNLIKELY(++cache->nfree[size] > THREAD_CACHE_LIMIT(size))) {
+                thread_cache_trim(cache, size);
+            }
+            return 1;
+        }
+    }
+
+    pool_free_block(pool, (block *)p);
+    return 1;
+}
+
+
+/* Link p back into its pool. */
+static void
+pool_free_block(poolp pool, block *p)
+{
     /* Link p to the start of the pool's freeblock list.  Since
      * the pool had at least the p block outstanding, the pool
      * wasn't empty (so it's already in a usedpools[] list, or
@@ -1888,7 +2092,7 @@ pymalloc_free(void *ctx, void *p)
          * blocks of the same size class.
          */
         insert_to_usedpool(pool);
-        return 1;
+        return;
     }
 
     /* freeblock wasn't NULL, so the pool wasn't full,
@@ -1896,7 +2100,7 @@ pymalloc_free(void *ctx, void *p)
      */
     if (LIKELY(pool->ref.count != 0)) {
         /* pool isn't empty:  leave it in usedpools */
-        return 1;
+        return;
     }
 
     /* Pool is now empty:  unlink from usedpools, and
@@ -1905,7 +2109,70 @@ pymalloc_free(void *ctx, void *p)
      * (being not referenced, they are perhaps paged out).
      */
     insert_to_freepool(pool);
-    return 1;
+}
+
+static struct _obmalloc_thread_cache *
+thread_cache_new(PyThreadState *tstate)
+{
+    struct _obmalloc_thread_cache *cache;
+    cache = PyMem_RawCalloc(1, sizeof(struct _obmalloc_thread_cache));
+    if (cache == NULL) {
+        /* Not a big deal: this thread just won't use a cache */
+        cache = &thread_cache_disabled;
+    }
+    tstate->obmalloc_cache = cache;
+    return cache;
+}
+
+/* Give the older half of the cached blocks of a size class back to their
+   pools. */
+static void
+thread_cache_trim(struct _obmalloc_thread_cache *cache, uint size)
+{
+    uint keep = THREAD_CACHE_LIMIT(size) / 2;
+    block **link = &cache->freeblocks[size];
+    for (uint i = 0; i < keep; i++) {
+        link = (block **)*link;
+    }
+    block *bp = *link;
+    *link = NULL;
+    while (bp != NULL) {
+        block *next = *(block **)bp;
+        pool_free_block(POOL_ADDR(bp), bp);
+        cache->nfree[size]--;
+        cached_blocks--;
+        bp = next;
+    }
+    assert(cache->nfree[size] == keep);
+}
+
+static void
+thread_cache_clear(PyThreadState *tstate)
+{
+    struct _obmalloc_thread_cache *cache = tstate->obmalloc_cache;
+    tstate->obmalloc_cache = &thread_cache_disabled;
+    if (cache == NULL || cache == &thread_cache_disabled) {
+        return;
+    }
+    for (uint size = 0; size < NB_SMALL_SIZE_CLASSES; size++) {
+        block *bp = cache->freeblocks[size];
+        while (bp != NULL) {
+            block *next = *(block **)bp;
+            pool_free_block(POOL_ADDR(bp), bp);
+            cached_blocks--;
+            bp = next;
+        }
+    }
+    PyMem_RawFree(cache);
+}
+
+
+/* Give the blocks cached by tstate back to their pools, and stop caching
+   blocks freed by this thread state.  The GIL must be held. */
+void
+_PyObject_ClearThreadCache(PyThreadState *tstate)
+{
+    thread_cache_clear(tstate);
 }
 
 
@@ -2023,6 +2290,16 @@ _Py_GetAllocatedBlocks(void)
     return 0;
 }
 
+void
+_PyObject_ClearThreadCache(PyThreadState *tstate)
+{
+}
+
+void
+_PyObject_EnableHugeArenas(void)
+{
+}
+
 #endif /* WITH_PYMALLOC */
 
 
@@ -2621,7 +2898,7 @@ _PyObject_DebugMallocStats(FILE *out)
     size_t quantization = 0;
     /* # of arenas actually allocated. */
     size_t narenas = 0;
-    /* running total -- should equal narenas * ARENA_SIZE */
+    /* running total -- should equal narenas * arena_size */
     size_t total;
     char buf[128];
 
@@ -2713,9 +2990,10 @@ _PyObject_DebugMallocStats(FILE *out)
     (void)printone(out, "# arenas allocated current", narenas);
 
     PyOS_snprintf(buf, sizeof(buf),
-                  "%zu arenas * %d bytes/arena",
-                  narenas, ARENA_SIZE);
-    (void)printone(out, buf, narenas * ARENA_SIZE);
+                  "%zu arenas * %zu bytes/arena",
+                  narenas, arena_size);
+    (void)printone(out, buf, narenas * arena_size);
+    (void)printone(out, "# blocks in thread caches", (size_t)cached_blocks);
 
     fputc('\n', out);
 
@@ -465,6 +465,120 @@ set_next(PySetObject *so, Py_ssize_t *pos_ptr, setentry **entry_ptr)
     return 1;
 }
 
+/*
+ * Bulk operations (update, intersection, difference, ...) probe the table
+ * once for each key of the other operand.  On tables much larger than the
+ * CPU caches, nearly every probe is a cache miss.  Rather than taking the
+ * misses one at a time, when the keys come from a list, a tuple or a dict,
+ * these operations gather a batch of keys with their hashes, prefetch the
+ * home bucket of each of them, and only then do the probes, so that the
+ * memory accesses of a whole batch overlap.  The keys of another set need
+ * no batching: they come in hash order, so the probes walk the table
+ * forward and the hardware prefetcher already keeps up with them.
+ *
+ * Only keys whose hash runs no Python code are batched, so __hash__ and
+ * __eq__ methods are still called in the same order as before.  A batch
+ * owns references to its keys since the comparisons made by the probes
+ * may mutate the operand the keys come from.
+ */
+
+#define SET_BATCH_SIZE 16
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SET_PREFETCH(so, hash) \
+    __builtin_prefetch(&(so)->table[(size_t)(hash) & (so)->mask])
+#else
+#define SET_PREFETCH(so, hash)
+#endif
+
+typedef struct {
+    Py_ssize_t len;
+    PyObject *keys[SET_BATCH_SIZE];
+    Py_hash_t hashes[SET_BATCH_SIZE];
+} setbatch;
+
+static void
+setbatch_clear(setbatch *batch)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < batch->len; i++)
+        Py_DECREF(batch->keys[i]);
+    batch->len = 0;
+}
+
+/* Fill the batch with the next keys of the dict other, and prefetch their
+   buckets in so.  Returns the number of keys, 0 at the end of other. */
+static Py_ssize_t
+setbatch_fill_from_dict(setbatch *batch, PySetObject *so,
+                        PyObject *other, Py_ssize_t *pos_ptr)
+{
+    Py_ssize_t n = 0;
+    PyObject *key, *value;
+    Py_hash_t hash;
+
+    while (n < SET_BATCH_SIZE && _PyDict_Next(other, pos_ptr, &key, &value, &hash)) {
+        Py_INCREF(key);
+        batch->keys[n] = key;
+        batch->hashes[n] = hash;
+        SET_PREFETCH(so, hash);
+        n++;
+    }
+    return batch->len = n;
+}
+
+/* Same as above for the items of the list or tuple seq.  Stops before the
+   first item whose hash could run Python code, unless it is the first one:
+   the batch then only holds that item, so that its hash is computed after
+   the probes for the previous items.  Returns -1 if that hash fails. */
+static Py_ssize_t
+setbatch_fill_from_sequence(setbatch *batch, PySetObject *so,
+                            PyObject *seq, Py_ssize_t *pos_ptr)
+{
+    Py_ssize_t n = 0;
+    Py_ssize_t i = *pos_ptr;
+    PyObject *key;
+    Py_hash_t hash;
+
+    assert(PyList_CheckExact(seq) || PyTuple_CheckExact(seq));
+    while (n < SET_BATCH_SIZE && i < PySequence_Fast_GET_SIZE(seq)) {
+        key = PySequence_Fast_GET_ITEM(seq, i);
+        if (PyUnicode_CheckExact(key)) {
+            hash = ((PyASCIIObject *) key)->hash;
+            if (hash == -1)
+                hash = PyObject_Hash(key);
+        }
+        else if (PyLong_CheckExact(key) || PyFloat_CheckExact(key) ||
+                 PyBytes_CheckExact(key)) {
+            hash = PyObject_Hash(key);
+        }
+        else if (n == 0) {
+            Py_INCREF(key);
+            hash = PyObject_Hash(key);
+            if (hash == -1) {
+                Py_DECREF(key);
+                batch->len = 0;
+                return -1;
+            }
+            batch->keys[0] = key;
+            batch->hashes[0] = hash;
+            *pos_ptr = i + 1;
+            return batch->len = 1;
+        }
+        else
+            break;
+        assert(hash != -1);
+        Py_INCREF(key);
+        batch->keys[n] = key;
+        batch->hashes[n] = hash;
+        SET_PREFETCH(so, hash);
+        n++;
+        i++;
+    }
+    *pos_ptr = i;
+    return batch->len = n;
+}
+
 static void
 set_dealloc(PySetObject *so)
 {
@@ -868,14 +982,13 @@ static int
 set_update_internal(PySetObject *so, PyObject *other)
 {
     PyObject *key, *it;
+    setbatch batch;
+    Py_ssize_t pos = 0, i, n;
 
     if (PyAnySet_Check(other))
         return set_merge(so, other);
 
     if (PyDict_CheckExact(other)) {
-        PyObject *value;
-        Py_ssize_t pos = 0;
-        Py_hash_t hash;
         Py_ssize_t dictsize = PyDict_GET_SIZE(other);
 
         /* Do one big resize at the start, rather than
@@ -888,13 +1001,31 @@ set_update_internal(PySetObject *so, PyObject *other)
             if (set_table_resize(so, (so->used + dictsize)*2) != 0)
                 return -1;
         }
-        while (_PyDict_Next(other, &pos, &key, &value, &hash)) {
-            if (set_add_entry(so, key, hash))
-                return -1;
+        while (setbatch_fill_from_dict(&batch, so, other, &pos)) {
+            for (i = 0; i < batch.len; i++) {
+                if (set_add_entry(so, batch.keys[i], batch.hashes[i])) {
+                    setbatch_clear(&batch);
+                    return -1;
+                }
+            }
+            setbatch_clear(&batch);
         }
         return 0;
     }
 
+    if (PyList_CheckExact(other) || PyTuple_CheckExact(other)) {
+        while ((n = setbatch_fill_from_sequence(&batch, so, other, &pos)) > 0) {
+            for (i = 0; i < n; i++) {
+                if (set_add_entry(so, batch.keys[i], batch.hashes[i])) {
+                    setbatch_clear(&batch);
+                    return -1;
+                }
+            }
+            setbatch_clear(&batch);
+        }
+        return n;
+    }
+
     it = PyObject_GetIter(other);
     if (it == NULL)
         return -1;
@@ -1168,6 +1299,8 @@ set_intersection(PySetObject *so, PyObject *other)
     PySetObject *result;
     PyObject *key, *it, *tmp;
     Py_hash_t hash;
+    setbatch batch;
+    Py_ssize_t pos = 0, i, n;
     int rv;
 
     if ((PyObject *)so == other)
@@ -1178,7 +1311,6 @@ set_intersection(PySetObject *so, PyObject *other)
         return NULL;
 
     if (PyAnySet_Check(other)) {
-        Py_ssize_t pos = 0;
         setentry *entry;
 
         if (PySet_GET_SIZE(other) > PySet_GET_SIZE(so)) {
@@ -1205,6 +1337,26 @@ set_intersection(PySetObject *so, PyObject *other)
         return (PyObject *)result;
     }
 
+    if (PyList_CheckExact(other) || PyTuple_CheckExact(other)) {
+        while ((n = setbatch_fill_from_sequence(&batch, so, other, &pos)) > 0) {
+            for (i = 0; i < n; i++) {
+                rv = set_contains_entry(so, batch.keys[i], batch.hashes[i]);
+                if (rv < 0)
+                    goto batch_error;
+                if (rv) {
+                    if (set_add_entry(result, batch.keys[i], batch.hashes[i]))
+                        goto batch_error;
+                }
+            }
+            setbatch_clear(&batch);
+        }
+        if (n < 0) {
+            Py_DECREF(result);
+            return NULL;
+        }
+        return (PyObject *)result;
+    }
+
     it = PyObject_GetIter(other);
     if (it == NULL) {
         Py_DECREF(result);
@@ -1235,6 +1387,10 @@ set_intersection(PySetObject *so, PyObject *other)
     Py_DECREF(result);
     Py_DECREF(key);
     return NULL;
+  batch_error:
+    setbatch_clear(&batch);
+    Py_DECREF(result);
+    return NULL;
 }
 
 static PyObject *
@@ -1321,6 +1477,8 @@ static PyObject *
 set_isdisjoint(PySetObject *so, PyObject *other)
 {
     PyObject *key, *it, *tmp;
+    setbatch batch;
+    Py_ssize_t pos = 0, i, n;
     int rv;
 
     if ((PyObject *)so == other) {
@@ -1331,7 +1489,6 @@ set_isdisjoint(PySetObject *so, PyObject *other)
     }
 
     if (PyAnySet_CheckExact(other)) {
-        Py_ssize_t pos = 0;
         setentry *entry;
 
         if (PySet_GET_SIZE(other) > PySet_GET_SIZE(so)) {
@@ -1349,6 +1506,22 @@ set_isdisjoint(PySetObject *so, PyObject *other)
         Py_RETURN_TRUE;
     }
 
+    if (PyList_CheckExact(other) || PyTuple_CheckExact(other)) {
+        while ((n = setbatch_fill_from_sequence(&batch, so, other, &pos)) > 0) {
+            rv = 0;
+            for (i = 0; i < n && rv == 0; i++)
+                rv = set_contains_entry(so, batch.keys[i], batch.hashes[i]);
+            setbatch_clear(&batch);
+            if (rv < 0)
+                return NULL;
+            if (rv)
+                Py_RETURN_FALSE;
+        }
+        if (n < 0)
+            return NULL;
+        Py_RETURN_TRUE;
+    }
+
     it = PyObject_GetIter(other);
     if (it == NULL)
         return NULL;
@@ -1410,6 +1583,21 @@ set_difference_update_internal(PySetObject *so, PyObject *other)
             }
 
         Py_DECREF(other);
+    } else if (PyList_CheckExact(other) || PyTuple_CheckExact(other)) {
+        setbatch batch;
+        Py_ssize_t pos = 0, i, n;
+
+        while ((n = setbatch_fill_from_sequence(&batch, so, other, &pos)) > 0) {
+            for (i = 0; i < n; i++) {
+                if (set_discard_entry(so, batch.keys[i], batch.hashes[i]) < 0) {
+                    setbatch_clear(&batch);
+                    return -1;
+                }
+            }
+            setbatch_clear(&batch);
+        }
+        if (n < 0)
+            return -1;
     } else {
         PyObject *key, *it;
         it = PyObject_GetIter(other);
@@ -122,6 +122,23 @@ STRINGLIB(utf8_decode)(const char **inptr, const char *end,
                 /* Out-of-range */
                 goto Return;
             *p++ = ch;
+            /* Fast path for runs of 2-byte sequences (Cyrillic, Greek...) */
+            while (end - s >= 2) {
+                uint16_t value;
+                memcpy(&value, s, 2);
+#if !PY_LITTLE_ENDIAN
+                value = _Py_bswap16(value);
+#endif
+                /* 110xxxxx 10xxxxxx */
+                if ((value & 0xC0E0u) != 0x80C0u)
+                    break;
+                ch = ((value & 0x1Fu) << 6) | ((value >> 8) & 0x3Fu);
+                if (ch < 0x80 ||
+                    (STRINGLIB_MAX_CHAR < 0x07FF && ch > STRINGLIB_MAX_CHAR))
+                    break;
+                *p++ = ch;
+                s += 2;
+            }
             continue;
         }
 
@@ -172,6 +189,25 @@ STRINGLIB(utf8_decode)(const char **inptr, const char *end,
                 /* Out-of-range */
                 goto Return;
             *p++ = ch;
+            /* Fast path for runs of 3-byte sequences (CJK): check a whole
+               sequence with a single mask. */
+            while (end - s >= 4) {
+                uint32_t value;
+                memcpy(&value, s, 4);
+#if !PY_LITTLE_ENDIAN
+                value = _Py_bswap32(value);
+#endif
+                /* 1110xxxx 10xxxxxx 10xxxxxx */
+                if ((value & 0xC0C0F0u) != 0x8080E0u)
+                    break;
+                ch = ((value & 0x0Fu) << 12) | ((value >> 2) & 0xFC0u) |
+                     ((value >> 16) & 0x3Fu);
+                if (ch < 0x800 || Py_UNICODE_IS_SURROGATE(ch) ||
+                    (STRINGLIB_MAX_CHAR < 0xFFFF && ch > STRINGLIB_MAX_CHAR))
+                    break;
+                *p++ = ch;
+                s += 3;
+            }
             continue;
         }
 
@@ -4,7 +4,11 @@
 
 /* fast search/count implementation, based on a mix between boyer-
    moore and horspool, with a few more bells and whistles on the top.
-   for some more background, see: http://effbot.org/zone/stringlib.htm */
+   for some more background, see: http://effbot.org/zone/stringlib.htm
+
+   long needles in long haystacks use the two-way algorithm instead,
+   which bounds the worst case, and short needles in 1-byte strings a
+   filter testing a word of candidate positions at once. */
 
 /* note: fastsearch may access s[n], which isn't a problem when using
    Python's ordinary string types, but may cause problems if you're
@@ -161,123 +165,480 @@ STRINGLIB(rfind_char)(const STRINGLIB_CHAR* s, Py_ssize_t n, STRINGLIB_CHAR ch)
 #undef MEMCHR_CUT_OFF
 
 Py_LOCAL_INLINE(Py_ssize_t)
-FASTSEARCH(const STRINGLIB_CHAR* s, Py_ssize_t n,
-           const STRINGLIB_CHAR* p, Py_ssize_t m,
-           Py_ssize_t maxcount, int mode)
+STRINGLIB(count_char)(const STRINGLIB_CHAR *s, Py_ssize_t n,
+                      const STRINGLIB_CHAR p0, Py_ssize_t maxcount)
 {
-    unsigned long mask;
-    Py_ssize_t skip, count = 0;
-    Py_ssize_t i, j, mlast, w;
+    Py_ssize_t i, count = 0;
+    for (i = 0; i < n; i++) {
+        if (s[i] == p0) {
+            count++;
+            if (count == maxcount) {
+                return maxcount;
+            }
+        }
+    }
+    return count;
+}
 
-    w = n - m;
+/* The two-way algorithm of Crochemore and Perrin (1991), used for long
+   needles, whose worst case is linear where the loops below can be
+   quadratic ("aaa...ab" searched in "aaa...a").
 
-    if (w < 0 || (mode == FAST_COUNT && maxcount == 0))
-        return -1;
+   The needle is cut in two halves, needle[:cut] and needle[cut:], such
+   that no shorter period than the local period at the cut can explain
+   both of them (a "critical factorization").  The right half is then
+   matched from left to right and the left half from right to left: a
+   mismatch in the right half shifts the window past the mismatched
+   character, and a mismatch in the left half shifts it by the period of
+   the needle.  When the whole needle is periodic, the part of the right
+   half which is known to match after such a shift is remembered, so that
+   it is not compared again.
 
-    /* look for special cases */
-    if (m <= 1) {
-        if (m <= 0)
-            return -1;
-        /* use special case for 1-character strings */
-        if (mode == FAST_SEARCH)
-            return STRINGLIB(find_char)(s, n, p[0]);
-        else if (mode == FAST_RSEARCH)
-            return STRINGLIB(rfind_char)(s, n, p[0]);
-        else {  /* FAST_COUNT */
-            for (i = 0; i < n; i++)
-                if (s[i] == p[0]) {
-                    count++;
-                    if (count == maxcount)
-                        return maxcount;
-                }
-            return count;
+   A Boyer-Moore bad character table on the last character of the window
+   is added on top of that, which skips most of the windows in practice.
+   Characters are stored in the table modulo 256: the shifts stay
+   conservative, but the last character of the needle must still be
+   compared when its entry is 0. */
+
+#define SHIFT_TYPE uint8_t
+#define MAX_SHIFT UINT8_MAX
+#define TABLE_SIZE 256U
+#define TABLE_MASK (TABLE_SIZE - 1U)
+
+typedef struct STRINGLIB(_pre) {
+    const STRINGLIB_CHAR *needle;
+    Py_ssize_t len_needle;
+    Py_ssize_t cut;
+    Py_ssize_t period;
+    int is_periodic;
+    SHIFT_TYPE table[TABLE_SIZE];
+} STRINGLIB(prework);
+
+
+static Py_ssize_t
+STRINGLIB(_lex_search)(const STRINGLIB_CHAR *needle, Py_ssize_t len_needle,
+                       Py_ssize_t *return_period, int invert_alphabet)
+{
+    /* Find the maximal suffix of the needle, essentially this:
+           >>> max(needle[i:] for i in range(len(needle)))
+       and the period of that suffix.  The start of the suffix is
+       returned minus one, the index of the last character of the left
+       half. */
+    Py_ssize_t max_suffix = -1;
+    Py_ssize_t candidate = 0;
+    Py_ssize_t k = 1;
+    Py_ssize_t period = 1;
+
+    while (candidate + k < len_needle) {
+        STRINGLIB_CHAR a = needle[candidate + k];
+        STRINGLIB_CHAR b = needle[max_suffix + k];
+        if (invert_alphabet ? (b < a) : (a < b)) {
+            /* The suffix at candidate is smaller: the period is the
+               whole prefix scanned so far. */
+            candidate += k;
+            k = 1;
+            period = candidate - max_suffix;
+        }
+        else if (a == b) {
+            /* Advance through a repetition of the current period. */
+            if (k != period) {
+                k++;
+            }
+            else {
+                candidate += period;
+                k = 1;
+            }
         }
+        else {
+            /* The suffix at candidate is larger: start over from it. */
+            max_suffix = candidate++;
+            k = 1;
+            period = 1;
+        }
+    }
+    *return_period = period;
+    return max_suffix;
+}
+
+static Py_ssize_t
+STRINGLIB(_factorize)(const STRINGLIB_CHAR *needle,
+                      Py_ssize_t len_needle,
+                      Py_ssize_t *return_period)
+{
+    /* The later of the maximal suffixes for the two orderings of the
+       alphabet gives a critical factorization. */
+    Py_ssize_t suffix1, period1, suffix2, period2;
+    suffix1 = STRINGLIB(_lex_search)(needle, len_needle, &period1, 0);
+    suffix2 = STRINGLIB(_lex_search)(needle, len_needle, &period2, 1);
+
+    if (suffix1 > suffix2) {
+        *return_period = period1;
+        return suffix1 + 1;
     }
+    *return_period = period2;
+    return suffix2 + 1;
+}
 
-    mlast = m - 1;
-    skip = mlast - 1;
-    mask = 0;
+static void
+STRINGLIB(_preprocess)(const STRINGLIB_CHAR *needle, Py_ssize_t len_needle,
+                       STRINGLIB(prework) *p)
+{
+    Py_ssize_t i, not_found_shift;
+
+    p->needle = needle;
+    p->len_needle = len_needle;
+    p->cut = STRINGLIB(_factorize)(needle, len_needle, &(p->period));
+    assert(p->cut + p->period <= len_needle);
+    p->is_periodic = (0 == memcmp(needle,
+                                  needle + p->period,
+                                  p->cut * STRINGLIB_SIZEOF_CHAR));
+    if (!p->is_periodic) {
+        /* A lower bound on the period of the needle, as both halves are
+           distinct. */
+        p->period = Py_MAX(p->cut, len_needle - p->cut) + 1;
+    }
 
-    if (mode != FAST_RSEARCH) {
-        const STRINGLIB_CHAR *ss = s + m - 1;
-        const STRINGLIB_CHAR *pp = p + m - 1;
+    /* Fill up the compressed bad character table. */
+    not_found_shift = Py_MIN(len_needle, MAX_SHIFT);
+    memset(p->table, (int)not_found_shift, sizeof(p->table));
+    for (i = len_needle - not_found_shift; i < len_needle; i++) {
+        SHIFT_TYPE shift = Py_SAFE_DOWNCAST(len_needle - 1 - i,
+                                            Py_ssize_t, SHIFT_TYPE);
+        p->table[needle[i] & TABLE_MASK] = shift;
+    }
+}
 
-        /* create compressed boyer-moore delta 1 table */
+static Py_ssize_t
+STRINGLIB(_two_way)(const STRINGLIB_CHAR *haystack, Py_ssize_t len_haystack,
+                    STRINGLIB(prework) *p, Py_ssize_t maxcount, int mode)
+{
+    /* Return the index of the first match in FAST_SEARCH mode, or the
+       number of non-overlapping matches in FAST_COUNT mode. */
+    const STRINGLIB_CHAR *const needle = p->needle;
+    const Py_ssize_t m = p->len_needle;
+    const Py_ssize_t cut = p->cut;
+    const Py_ssize_t period = p->period;
+    const Py_ssize_t w = len_haystack - m;
+    Py_ssize_t i, j = 0, count = 0;
+    /* The number of characters at the start of the window which are
+       known to match the needle. */
+    Py_ssize_t memory = 0;
 
-        /* process pattern[:-1] */
-        for (i = 0; i < mlast; i++) {
-            STRINGLIB_BLOOM_ADD(mask, p[i]);
-            if (p[i] == p[mlast])
-                skip = mlast - i - 1;
+    while (j <= w) {
+        Py_ssize_t shift = p->table[haystack[j + m - 1] & TABLE_MASK];
+        if (shift > 0) {
+            j += shift;
+            memory = 0;
+            continue;
         }
-        /* process pattern[-1] outside the loop */
-        STRINGLIB_BLOOM_ADD(mask, p[mlast]);
-
-        for (i = 0; i <= w; i++) {
-            /* note: using mlast in the skip path slows things down on x86 */
-            if (ss[i] == pp[0]) {
-                /* candidate match */
-                for (j = 0; j < mlast; j++)
-                    if (s[i+j] != p[j])
-                        break;
-                if (j == mlast) {
-                    /* got a match! */
-                    if (mode != FAST_COUNT)
-                        return i;
-                    count++;
-                    if (count == maxcount)
-                        return maxcount;
-                    i = i + mlast;
-                    continue;
+        /* Match the right half, from left to right. */
+        i = Py_MAX(cut, memory);
+        while (i < m && needle[i] == haystack[j + i]) {
+            i++;
+        }
+        if (i < m) {
+            j += i - cut + 1;
+            memory = 0;
+            continue;
+        }
+        /* Match the left half, from right to left. */
+        i = cut - 1;
+        while (i >= memory && needle[i] == haystack[j + i]) {
+            i--;
+        }
+        if (i < memory) {
+            if (mode != FAST_COUNT) {
+                return j;
+            }
+            count++;
+            if (count == maxcount) {
+                return maxcount;
+            }
+            j += m;
+            memory = 0;
+            continue;
+        }
+        j += period;
+        if (p->is_periodic) {
+            /* The part of the right half which was matched before the
+               shift still matches after it. */
+            memory = m - period;
+        }
+    }
+    return mode == FAST_COUNT ? count : -1;
+}
+
+static Py_ssize_t
+STRINGLIB(_two_way_find)(const STRINGLIB_CHAR *haystack,
+                         Py_ssize_t len_haystack,
+                         const STRINGLIB_CHAR *needle,
+                         Py_ssize_t len_needle)
+{
+    STRINGLIB(prework) p;
+    STRINGLIB(_preprocess)(needle, len_needle, &p);
+    return STRINGLIB(_two_way)(haystack, len_haystack, &p, 0, FAST_SEARCH);
+}
+
+static Py_ssize_t
+STRINGLIB(_two_way_count)(const STRINGLIB_CHAR *haystack,
+                          Py_ssize_t len_haystack,
+                          const STRINGLIB_CHAR *needle,
+                          Py_ssize_t len_needle,
+                          Py_ssize_t maxcount)
+{
+    STRINGLIB(prework) p;
+    STRINGLIB(_preprocess)(needle, len_needle, &p);
+    return STRINGLIB(_two_way)(haystack, len_haystack, &p,
+                               maxcount, FAST_COUNT);
+}
+
+#undef SHIFT_TYPE
+#undef MAX_SHIFT
+#undef TABLE_SIZE
+#undef TABLE_MASK
+
+Py_LOCAL_INLINE(Py_ssize_t)
+STRINGLIB(default_find)(const STRINGLIB_CHAR* s, Py_ssize_t n,
+                        const STRINGLIB_CHAR* p, Py_ssize_t m,
+                        Py_ssize_t maxcount, int mode, int adaptive)
+{
+    /* If adaptive is true, switch to the two-way algorithm once the
+       candidate matches have cost too many comparisons. */
+    const Py_ssize_t w = n - m;
+    const Py_ssize_t mlast = m - 1;
+    const STRINGLIB_CHAR *ss = s + m - 1;
+    const STRINGLIB_CHAR *pp = p + m - 1;
+    unsigned long mask = 0;
+    Py_ssize_t i, j, skip = mlast - 1, count = 0, hits = 0, res;
+
+    /* create compressed boyer-moore delta 1 table */
+
+    /* process pattern[:-1] */
+    for (i = 0; i < mlast; i++) {
+        STRINGLIB_BLOOM_ADD(mask, p[i]);
+        if (p[i] == p[mlast])
+            skip = mlast - i - 1;
+    }
+    /* process pattern[-1] outside the loop */
+    STRINGLIB_BLOOM_ADD(mask, p[mlast]);
+
+    for (i = 0; i <= w; i++) {
+        /* note: using mlast in the skip path slows things down on x86 */
+        if (ss[i] == pp[0]) {
+            /* candidate match */
+            for (j = 0; j < mlast; j++)
+                if (s[i+j] != p[j])
+                    break;
+            if (j == mlast) {
+                /* got a match! */
+                if (mode != FAST_COUNT)
+                    return i;
+                count++;
+                if (count == maxcount)
+                    return maxcount;
+                i = i + mlast;
+                continue;
+            }
+            if (adaptive) {
+                hits += j + 1;
+                if (hits > m / 4 && w - i > 2000) {
+                    if (mode == FAST_SEARCH) {
+                        res = STRINGLIB(_two_way_find)(s + i, n - i, p, m);
+                        return res == -1 ? -1 : res + i;
+                    }
+                    res = STRINGLIB(_two_way_count)(s + i, n - i, p, m,
+                                                    maxcount - count);
+                    return res + count;
                 }
-                /* miss: check if next character is part of pattern */
-                if (!STRINGLIB_BLOOM(mask, ss[i+1]))
-                    i = i + m;
-                else
-                    i = i + skip;
-            } else {
-                /* skip: check if next character is part of pattern */
-                if (!STRINGLIB_BLOOM(mask, ss[i+1]))
-                    i = i + m;
             }
+            /* miss: check if next character is part of pattern */
+            if (!STRINGLIB_BLOOM(mask, ss[i+1]))
+                i = i + m;
+            else
+                i = i + skip;
+        } else {
+            /* skip: check if next character is part of pattern */
+            if (!STRINGLIB_BLOOM(mask, ss[i+1]))
+                i = i + m;
         }
-    } else {    /* FAST_RSEARCH */
+    }
+    return mode == FAST_COUNT ? count : -1;
+}
 
-        /* create compressed boyer-moore delta 1 table */
+Py_LOCAL_INLINE(Py_ssize_t)
+STRINGLIB(default_rfind)(const STRINGLIB_CHAR* s, Py_ssize_t n,
+                         const STRINGLIB_CHAR* p, Py_ssize_t m)
+{
+    /* create compressed boyer-moore delta 1 table */
+    const Py_ssize_t w = n - m;
+    const Py_ssize_t mlast = m - 1;
+    unsigned long mask = 0;
+    Py_ssize_t i, j, skip = mlast - 1;
+
+    /* process pattern[0] outside the loop */
+    STRINGLIB_BLOOM_ADD(mask, p[0]);
+    /* process pattern[:0:-1] */
+    for (i = mlast; i > 0; i--) {
+        STRINGLIB_BLOOM_ADD(mask, p[i]);
+        if (p[i] == p[0])
+            skip = i - 1;
+    }
 
-        /* process pattern[0] outside the loop */
-        STRINGLIB_BLOOM_ADD(mask, p[0]);
-        /* process pattern[:0:-1] */
-        for (i = mlast; i > 0; i--) {
-            STRINGLIB_BLOOM_ADD(mask, p[i]);
-            if (p[i] == p[0])
-                skip = i - 1;
+    for (i = w; i >= 0; i--) {
+        if (s[i] == p[0]) {
+            /* candidate match */
+            for (j = mlast; j > 0; j--)
+                if (s[i+j] != p[j])
+                    break;
+            if (j == 0)
+                /* got a match! */
+                return i;
+            /* miss: check if previous character is part of pattern */
+            if (i > 0 && !STRINGLIB_BLOOM(mask, s[i-1]))
+                i = i - m;
+            else
+                i = i - skip;
+        } else {
+            /* skip: check if previous character is part of pattern */
+            if (i > 0 && !STRINGLIB_BLOOM(mask, s[i-1]))
+                i = i - m;
         }
+    }
+    return -1;
+}
 
-        for (i = w; i >= 0; i--) {
-            if (s[i] == p[0]) {
-                /* candidate match */
-                for (j = mlast; j > 0; j--)
-                    if (s[i+j] != p[j])
-                        break;
-                if (j == 0)
-                    /* got a match! */
+#if STRINGLIB_SIZEOF_CHAR == 1
+/* Filter for short needles in 1-byte strings: compare the first and the
+   last characters of the needle against SIZEOF_SIZE_T windows at once,
+   the comparisons of a C 'size_t' word being a zero byte test, and only
+   look at the windows of a word in turn when one of them may match.
+   This does not depend on the characters of the haystack being absent
+   from the needle, unlike the skips of default_find(). */
+
+#define PAIR_ONES ((size_t)-1 / 0xFF)
+#define PAIR_HIGHS (PAIR_ONES << 7)
+/* Nonzero if a byte of x is zero (with false positives above a zero
+   byte only). */
+#define PAIR_HAS_ZERO(x) (((x) - PAIR_ONES) & ~(x) & PAIR_HIGHS)
+
+Py_LOCAL_INLINE(Py_ssize_t)
+STRINGLIB(pair_find)(const STRINGLIB_CHAR *s, Py_ssize_t n,
+                     const STRINGLIB_CHAR *p, Py_ssize_t m,
+                     Py_ssize_t maxcount, int mode)
+{
+    const Py_ssize_t w = n - m;
+    const STRINGLIB_CHAR first = p[0];
+    const STRINGLIB_CHAR last = p[m - 1];
+    const size_t first_word = PAIR_ONES * (unsigned char)first;
+    const size_t last_word = PAIR_ONES * (unsigned char)last;
+    Py_ssize_t i = 0, j, end, res, count = 0, hits = 0;
+
+    while (i <= w) {
+        end = Py_MIN(i + SIZEOF_SIZE_T, w + 1);
+        if (end - i == SIZEOF_SIZE_T) {
+            size_t a, b, x;
+            memcpy(&a, s + i, SIZEOF_SIZE_T);
+            memcpy(&b, s + i + m - 1, SIZEOF_SIZE_T);
+            x = (a ^ first_word) | (b ^ last_word);
+            if (!PAIR_HAS_ZERO(x)) {
+                i = end;
+                continue;
+            }
+            /* Too many words hold candidates: the haystack is made of the
+               characters of the needle, let default_find() skip them. */
+            hits++;
+            if (hits > 32 && hits > (i >> 2) / SIZEOF_SIZE_T) {
+                res = STRINGLIB(default_find)(s + i, n - i, p, m,
+                                              maxcount - count, mode, 0);
+                if (mode == FAST_COUNT) {
+                    return res + count;
+                }
+                return res == -1 ? -1 : res + i;
+            }
+        }
+        for (; i < end; i++) {
+            if (s[i] != first || s[i + m - 1] != last) {
+                continue;
+            }
+            for (j = 1; j < m - 1; j++) {
+                if (s[i + j] != p[j]) {
+                    break;
+                }
+            }
+            if (j == m - 1) {
+                if (mode != FAST_COUNT) {
                     return i;
-                /* miss: check if previous character is part of pattern */
-                if (i > 0 && !STRINGLIB_BLOOM(mask, s[i-1]))
-                    i = i - m;
-                else
-                    i = i - skip;
-            } else {
-                /* skip: check if previous character is part of pattern */
-                if (i > 0 && !STRINGLIB_BLOOM(mask, s[i-1]))
-                    i = i - m;
+                }
+                count++;
+                if (count == maxcount) {
+                    return maxcount;
+                }
+                i = i + m - 1;
             }
         }
     }
+    return mode == FAST_COUNT ? count : -1;
+}
 
-    if (mode != FAST_COUNT)
+#undef PAIR_ONES
+#undef PAIR_HIGHS
+#undef PAIR_HAS_ZERO
+#endif  /* STRINGLIB_SIZEOF_CHAR == 1 */
+
+Py_LOCAL_INLINE(Py_ssize_t)
+FASTSEARCH(const STRINGLIB_CHAR* s, Py_ssize_t n,
+           const STRINGLIB_CHAR* p, Py_ssize_t m,
+           Py_ssize_t maxcount, int mode)
+{
+    if (n < m || (mode == FAST_COUNT && maxcount == 0)) {
         return -1;
-    return count;
+    }
+
+    /* look for special cases */
+    if (m <= 1) {
+        if (m <= 0) {
+            return -1;
+        }
+        /* use special case for 1-character strings */
+        if (mode == FAST_SEARCH)
+            return STRINGLIB(find_char)(s, n, p[0]);
+        else if (mode == FAST_RSEARCH)
+            return STRINGLIB(rfind_char)(s, n, p[0]);
+        else {
+            return STRINGLIB(count_char)(s, n, p[0], maxcount);
+        }
+    }
+
+    if (mode == FAST_RSEARCH) {
+        return STRINGLIB(default_rfind)(s, n, p, m);
+    }
+#if STRINGLIB_SIZEOF_CHAR == 1
+    /* The skips of default_find() are at most m characters long, which
+       the word filter beats for short needles. */
+    if (m <= 8 && n >= 64) {
+        return STRINGLIB(pair_find)(s, n, p, m, maxcount, mode);
+    }
+#endif
+    if (n < 2500 || (m < 100 && n < 30000) || m < 6) {
+        /* On short problems, the preprocessing of the two-way algorithm
+           does not pay off. */
+        return STRINGLIB(default_find)(s, n, p, m, maxcount, mode, 0);
+    }
+    if ((m >> 2) * 3 < (n >> 2)) {
+        /* 33% threshold, but don't overflow.  For larger problems where
+           the needle isn't a huge percentage of the size of the haystack,
+           the linear worst case of the two-way algorithm matters more
+           than its preprocessing. */
+        if (mode == FAST_SEARCH) {
+            return STRINGLIB(_two_way_find)(s, n, p, m);
+        }
+        return STRINGLIB(_two_way_count)(s, n, p, m, maxcount);
+    }
+    /* To ensure that we have good worst-case behavior, here's an
+       adaptive version of the algorithm, where if we match O(m)
+       characters without any matches of the entire needle, then we
+       predict that the startup cost of the two-way algorithm will
+       probably be worth it. */
+    return STRINGLIB(default_find)(s, n, p, m, maxcount, mode, 1);
 }
 
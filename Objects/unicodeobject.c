@@ -51,6 +51,7 @@ OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
 #include "pycore_pylifecycle.h"   // _Py_SetFileSystemEncoding()
 #include "pycore_pystate.h"       // _PyInterpreterState_GET()
 #include "pycore_ucnhash.h"       // _PyUnicode_Name_CAPI
+#include "pycore_unicodeobject.h" // _PyUnicode_InternFromUCS1()
 #include "stringlib/eq.h"         // unicode_eq()
 
 #ifdef MS_WINDOWS
@@ -1922,6 +1923,23 @@ _PyUnicode_Ready(PyObject *unicode)
     return 0;
 }
 
+/* Size of the cache of _PyUnicode_InternFromUCS1(), and maximum length of
+   the strings stored in it. */
+#define INTERN_CACHE_SIZE 2048
+#define INTERN_CACHE_MAX_LENGTH 64
+
+static PyObject **
+intern_cache_entry(struct _Py_unicode_state *state,
+                   const Py_UCS1 *s, Py_ssize_t size)
+{
+    /* FNV-1a: the entry is only a hint, checked by comparing the strings */
+    size_t h = 2166136261U;
+    for (Py_ssize_t i = 0; i < size; i++) {
+        h = (h ^ s[i]) * 16777619U;
+    }
+    return &state->intern_cache[(h ^ (h >> 16)) & (INTERN_CACHE_SIZE - 1)];
+}
+
 static void
 unicode_dealloc(PyObject *unicode)
 {
@@ -1932,6 +1950,17 @@ unicode_dealloc(PyObject *unicode)
     case SSTATE_INTERNED_MORTAL:
     {
         struct _Py_unicode_state *state = get_unicode_state();
+        if (state->intern_cache != NULL &&
+            PyUnicode_KIND(unicode) == PyUnicode_1BYTE_KIND &&
+            PyUnicode_GET_LENGTH(unicode) <= INTERN_CACHE_MAX_LENGTH)
+        {
+            PyObject **entry = intern_cache_entry(
+                state, PyUnicode_1BYTE_DATA(unicode),
+                PyUnicode_GET_LENGTH(unicode));
+            if (*entry == unicode) {
+                *entry = NULL;
+            }
+        }
         /* Revive the dead object temporarily. PyDict_DelItem() removes two
            references (key and value) which were ignored by
            PyUnicode_InternInPlace(). Use refcnt=3 rather than refcnt=2
@@ -15782,6 +15811,41 @@ PyUnicode_InternInPlace(PyObject **p)
 }
 
 
+PyObject *
+_PyUnicode_InternFromUCS1(const Py_UCS1 *s, Py_ssize_t size)
+{
+    struct _Py_unicode_state *state = get_unicode_state();
+    PyObject *unicode, **entry = NULL;
+
+    if (size <= INTERN_CACHE_MAX_LENGTH) {
+        if (state->intern_cache == NULL) {
+            state->intern_cache = PyMem_Calloc(INTERN_CACHE_SIZE,
+                                               sizeof(PyObject *));
+        }
+        if (state->intern_cache != NULL) {
+            entry = intern_cache_entry(state, s, size);
+            unicode = *entry;
+            if (unicode != NULL && PyUnicode_GET_LENGTH(unicode) == size &&
+                memcmp(PyUnicode_1BYTE_DATA(unicode), s, size) == 0)
+            {
+                Py_INCREF(unicode);
+                return unicode;
+            }
+        }
+    }
+
+    unicode = _PyUnicode_FromUCS1(s, size);
+    if (unicode == NULL) {
+        return NULL;
+    }
+    PyUnicode_InternInPlace(&unicode);
+    if (entry != NULL && PyUnicode_CHECK_INTERNED(unicode)) {
+        *entry = unicode;
+    }
+    return unicode;
+}
+
+
 void
 PyUnicode_InternImmortal(PyObject **p)
 {
@@ -15812,10 +15876,31 @@ PyUnicode_InternFromString(const char *cp)
 }
 
 
+#ifdef Py_IMMORTAL_INSTANCES
+void
+_PyUnicode_ImmortalizeInterned(PyInterpreterState *interp)
+{
+    struct _Py_unicode_state *state = &interp->unicode;
+    if (state->interned == NULL) {
+        return;
+    }
+    _Py_SetImmortal(state->interned);
+
+    Py_ssize_t pos = 0;
+    PyObject *s;
+    while (PyDict_Next(state->interned, &pos, &s, NULL)) {
+        _Py_SetImmortal(s);
+    }
+}
+#endif
+
+
 void
 _PyUnicode_ClearInterned(PyInterpreterState *interp)
 {
     struct _Py_unicode_state *state = &interp->unicode;
+    PyMem_Free(state->intern_cache);
+    state->intern_cache = NULL;
     if (state->interned == NULL) {
         return;
     }
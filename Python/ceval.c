@@ -116,22 +116,11 @@ static long dxp[256];
 #define OPCACHE_MIN_RUNS 1024  /* create opcache when code executed this time */
 #endif
 #define OPCODE_CACHE_MAX_TRIES 20
-#define OPCACHE_STATS 0  /* Enable stats */
 
-#if OPCACHE_STATS
-static size_t opcache_code_objects = 0;
-static size_t opcache_code_objects_extra_mem = 0;
-
-static size_t opcache_global_opts = 0;
-static size_t opcache_global_hits = 0;
-static size_t opcache_global_misses = 0;
-
-static size_t opcache_attr_opts = 0;
-static size_t opcache_attr_hits = 0;
-static size_t opcache_attr_misses = 0;
-static size_t opcache_attr_deopts = 0;
-static size_t opcache_attr_total = 0;
-#endif
+/* Opcode cache statistics, see sys._getopcachestats().  The counters are
+   always compiled in: they cost a single increment on paths that are
+   already doing a cache lookup. */
+_PyOpcacheStats _Py_opcache_stats;
 
 
 #ifndef NDEBUG
@@ -358,49 +347,6 @@ PyEval_InitThreads(void)
 void
 _PyEval_Fini(void)
 {
-#if OPCACHE_STATS
-    fprintf(stderr, "-- Opcode cache number of objects  = %zd\n",
-            opcache_code_objects);
-
-    fprintf(stderr, "-- Opcode cache total extra mem    = %zd\n",
-            opcache_code_objects_extra_mem);
-
-    fprintf(stderr, "\n");
-
-    fprintf(stderr, "-- Opcode cache LOAD_GLOBAL hits   = %zd (%d%%)\n",
-            opcache_global_hits,
-            (int) (100.0 * opcache_global_hits /
-                (opcache_global_hits + opcache_global_misses)));
-
-    fprintf(stderr, "-- Opcode cache LOAD_GLOBAL misses = %zd (%d%%)\n",
-            opcache_global_misses,
-            (int) (100.0 * opcache_global_misses /
-                (opcache_global_hits + opcache_global_misses)));
-
-    fprintf(stderr, "-- Opcode cache LOAD_GLOBAL opts   = %zd\n",
-            opcache_global_opts);
-
-    fprintf(stderr, "\n");
-
-    fprintf(stderr, "-- Opcode cache LOAD_ATTR hits     = %zd (%d%%)\n",
-            opcache_attr_hits,
-            (int) (100.0 * opcache_attr_hits /
-                opcache_attr_total));
-
-    fprintf(stderr, "-- Opcode cache LOAD_ATTR misses   = %zd (%d%%)\n",
-            opcache_attr_misses,
-            (int) (100.0 * opcache_attr_misses /
-                opcache_attr_total));
-
-    fprintf(stderr, "-- Opcode cache LOAD_ATTR opts     = %zd\n",
-            opcache_attr_opts);
-
-    fprintf(stderr, "-- Opcode cache LOAD_ATTR deopts   = %zd\n",
-            opcache_attr_deopts);
-
-    fprintf(stderr, "-- Opcode cache LOAD_ATTR total    = %zd\n",
-            opcache_attr_total);
-#endif
 }
 
 void
@@ -958,6 +904,8 @@ eval_frame_handle_pending(PyThreadState *tstate)
         if (_PyThreadState_Swap(&runtime->gilstate, NULL) != tstate) {
             Py_FatalError("tstate mix-up");
         }
+        tstate->gil.forced_switches++;
+        tstate->gil.switch_requested = 1;
         drop_gil(ceval, ceval2, tstate);
 
         /* Other threads may run now */
@@ -1309,10 +1257,9 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
     do { \
         if (co_opcache != NULL) { \
             co_opcache->optimized = -1; \
-            unsigned char co_opcache_offset = \
-                co->co_opcache_map[next_instr - first_instr]; \
-            assert(co_opcache_offset <= co->co_opcache_size); \
-            co->co_opcache_map[co_opcache_offset] = 0; \
+            assert(co->co_opcache_map[next_instr - first_instr] <= \
+                   co->co_opcache_size); \
+            co->co_opcache_map[next_instr - first_instr] = 0; \
             co_opcache = NULL; \
         } \
     } while (0)
@@ -1332,61 +1279,46 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
         } \
     } while (0)
 
-#if OPCACHE_STATS
-
-#define OPCACHE_STAT_GLOBAL_HIT() \
-    do { \
-        if (co->co_opcache != NULL) opcache_global_hits++; \
-    } while (0)
-
-#define OPCACHE_STAT_GLOBAL_MISS() \
-    do { \
-        if (co->co_opcache != NULL) opcache_global_misses++; \
-    } while (0)
-
-#define OPCACHE_STAT_GLOBAL_OPT() \
-    do { \
-        if (co->co_opcache != NULL) opcache_global_opts++; \
-    } while (0)
-
-#define OPCACHE_STAT_ATTR_HIT() \
-    do { \
-        if (co->co_opcache != NULL) opcache_attr_hits++; \
-    } while (0)
-
-#define OPCACHE_STAT_ATTR_MISS() \
+#define OPCACHE_MAYBE_DEOPT_LOAD_METHOD() \
     do { \
-        if (co->co_opcache != NULL) opcache_attr_misses++; \
-    } while (0)
-
-#define OPCACHE_STAT_ATTR_OPT() \
-    do { \
-        if (co->co_opcache!= NULL) opcache_attr_opts++; \
+        if (co_opcache != NULL && --co_opcache->optimized <= 0) { \
+            OPCACHE_STAT_METHOD_DEOPT(); \
+            OPCACHE_DEOPT(); \
+        } \
     } while (0)
 
-#define OPCACHE_STAT_ATTR_DEOPT() \
+#define OPCACHE_MAYBE_DEOPT_STORE_ATTR() \
     do { \
-        if (co->co_opcache != NULL) opcache_attr_deopts++; \
+        if (co_opcache != NULL && --co_opcache->optimized <= 0) { \
+            OPCACHE_STAT_STORE_ATTR_DEOPT(); \
+            OPCACHE_DEOPT(); \
+        } \
     } while (0)
 
-#define OPCACHE_STAT_ATTR_TOTAL() \
+#define OPCACHE_STAT_INC(kind, counter) \
     do { \
-        if (co->co_opcache != NULL) opcache_attr_total++; \
+        _Py_opcache_stats.kinds[OPCACHE_KIND_ ## kind].counter++; \
+        _PyOpcache_CodeCounters(co)[OPCACHE_KIND_ ## kind].counter++; \
     } while (0)
 
-#else /* OPCACHE_STATS */
+#define OPCACHE_STAT_GLOBAL_HIT() OPCACHE_STAT_INC(LOAD_GLOBAL, hits)
+#define OPCACHE_STAT_GLOBAL_MISS() OPCACHE_STAT_INC(LOAD_GLOBAL, misses)
+#define OPCACHE_STAT_GLOBAL_OPT() OPCACHE_STAT_INC(LOAD_GLOBAL, opts)
 
-#define OPCACHE_STAT_GLOBAL_HIT()
-#define OPCACHE_STAT_GLOBAL_MISS()
-#define OPCACHE_STAT_GLOBAL_OPT()
+#define OPCACHE_STAT_ATTR_HIT() OPCACHE_STAT_INC(LOAD_ATTR, hits)
+#define OPCACHE_STAT_ATTR_MISS() OPCACHE_STAT_INC(LOAD_ATTR, misses)
+#define OPCACHE_STAT_ATTR_OPT() OPCACHE_STAT_INC(LOAD_ATTR, opts)
+#define OPCACHE_STAT_ATTR_DEOPT() OPCACHE_STAT_INC(LOAD_ATTR, deopts)
 
-#define OPCACHE_STAT_ATTR_HIT()
-#define OPCACHE_STAT_ATTR_MISS()
-#define OPCACHE_STAT_ATTR_OPT()
-#define OPCACHE_STAT_ATTR_DEOPT()
-#define OPCACHE_STAT_ATTR_TOTAL()
+#define OPCACHE_STAT_METHOD_HIT() OPCACHE_STAT_INC(LOAD_METHOD, hits)
+#define OPCACHE_STAT_METHOD_MISS() OPCACHE_STAT_INC(LOAD_METHOD, misses)
+#define OPCACHE_STAT_METHOD_OPT() OPCACHE_STAT_INC(LOAD_METHOD, opts)
+#define OPCACHE_STAT_METHOD_DEOPT() OPCACHE_STAT_INC(LOAD_METHOD, deopts)
 
-#endif
+#define OPCACHE_STAT_STORE_ATTR_HIT() OPCACHE_STAT_INC(STORE_ATTR, hits)
+#define OPCACHE_STAT_STORE_ATTR_MISS() OPCACHE_STAT_INC(STORE_ATTR, misses)
+#define OPCACHE_STAT_STORE_ATTR_OPT() OPCACHE_STAT_INC(STORE_ATTR, opts)
+#define OPCACHE_STAT_STORE_ATTR_DEOPT() OPCACHE_STAT_INC(STORE_ATTR, deopts)
 
 /* Start of code */
 
@@ -1487,12 +1419,6 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
             if (_PyCode_InitOpcache(co) < 0) {
                 goto exit_eval_frame;
             }
-#if OPCACHE_STATS
-            opcache_code_objects_extra_mem +=
-                PyBytes_Size(co->co_code) / sizeof(_Py_CODEUNIT) +
-                sizeof(_PyOpcache) * co->co_opcache_size;
-            opcache_code_objects++;
-#endif
         }
     }
 
@@ -1877,7 +1803,61 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
         case TARGET(BINARY_SUBSCR): {
             PyObject *sub = POP();
             PyObject *container = TOP();
-            PyObject *res = PyObject_GetItem(container, sub);
+            PyObject *res;
+            /* Fast paths for the most common container types.  The type
+               checks act as guards: anything else, including out of range
+               indices, goes through PyObject_GetItem(). */
+            if (PyLong_CheckExact(sub) &&
+                (PyList_CheckExact(container) || PyTuple_CheckExact(container)))
+            {
+                Py_ssize_t i = PyLong_AsSsize_t(sub);
+                if (i == -1 && _PyErr_Occurred(tstate)) {
+                    _PyErr_Clear(tstate);
+                    i = PY_SSIZE_T_MAX;
+                }
+                Py_ssize_t size = Py_SIZE(container);
+                if (i < 0) {
+                    i += size;
+                }
+                if ((size_t)i < (size_t)size) {
+                    if (PyList_CheckExact(container)) {
+                        res = PyList_GET_ITEM(container, i);
+                    }
+                    else {
+                        res = PyTuple_GET_ITEM(container, i);
+                    }
+                    Py_INCREF(res);
+                    Py_DECREF(container);
+                    Py_DECREF(sub);
+                    SET_TOP(res);
+                    DISPATCH();
+                }
+            }
+            else if (PyDict_CheckExact(container)) {
+                /* An exact dict has no __missing__(): a missing key raises
+                   KeyError right here, without hashing it a second time. */
+                Py_hash_t hash;
+                if (!PyUnicode_CheckExact(sub) ||
+                    (hash = ((PyASCIIObject *)sub)->hash) == -1)
+                {
+                    hash = PyObject_Hash(sub);
+                }
+                res = NULL;
+                if (hash != -1) {
+                    res = _PyDict_GetItem_KnownHash(container, sub, hash);
+                    if (res == NULL && !_PyErr_Occurred(tstate)) {
+                        _PyErr_SetKeyError(sub);
+                    }
+                }
+                Py_XINCREF(res);
+                Py_DECREF(container);
+                Py_DECREF(sub);
+                SET_TOP(res);
+                if (res == NULL)
+                    goto error;
+                DISPATCH();
+            }
+            res = PyObject_GetItem(container, sub);
             Py_DECREF(container);
             Py_DECREF(sub);
             SET_TOP(res);
@@ -2608,9 +2588,99 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
             PyObject *name = GETITEM(names, oparg);
             PyObject *owner = TOP();
             PyObject *v = SECOND();
+            PyTypeObject *type = Py_TYPE(owner);
+            _PyOpCodeOpt_LoadAttr *sa;
             int err;
+
+            OPCACHE_CHECK();
+            if (co_opcache != NULL && co_opcache->optimized > 0) {
+                sa = &co_opcache->u.sa;
+                if (sa->type == type
+                    && sa->tp_version_tag == type->tp_version_tag
+                    && PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG))
+                {
+                    // Same hint encoding as LOAD_ATTR: hint < -1 is an
+                    // inverted slot offset, hint >= 0 is a dict index.
+                    if (sa->hint < -1) {
+                        PyObject **addr = (PyObject **)((char *)owner + ~sa->hint);
+                        PyObject *old = *addr;
+                        OPCACHE_STAT_STORE_ATTR_HIT();
+                        STACK_SHRINK(2);
+                        *addr = v;  /* steal the reference from the stack */
+                        Py_XDECREF(old);
+                        Py_DECREF(owner);
+                        DISPATCH();
+                    }
+                    assert(type->tp_dictoffset > 0);
+                    PyObject *dict = *(PyObject **)((char *)owner + type->tp_dictoffset);
+                    if (dict != NULL && PyDict_CheckExact(dict) &&
+                        _PyDict_SetItemHint((PyDictObject *)dict, name,
+                                            sa->hint, v))
+                    {
+                        OPCACHE_STAT_STORE_ATTR_HIT();
+                        STACK_SHRINK(2);
+                        Py_DECREF(v);
+                        Py_DECREF(owner);
+                        DISPATCH();
+                    }
+                }
+                // The type has changed or the attribute is not where it
+                // used to be.  Maybe it will stabilize?
+                OPCACHE_STAT_STORE_ATTR_MISS();
+                OPCACHE_MAYBE_DEOPT_STORE_ATTR();
+            }
+
             STACK_SHRINK(2);
             err = PyObject_SetAttr(owner, name, v);
+            // Py_TYPE(owner) can change if __class__ was assigned.
+            if (err == 0 && co_opcache != NULL && Py_TYPE(owner) == type &&
+                type->tp_setattro == PyObject_GenericSetAttr &&
+                PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG))
+            {
+                Py_ssize_t hint = -1;
+                PyObject *descr = _PyType_Lookup(type, name);
+                if (descr != NULL && Py_TYPE(descr) == &PyMemberDescr_Type) {
+                    // A writable slot of this exact layout.
+                    PyMemberDescrObject *member = (PyMemberDescrObject *)descr;
+                    struct PyMemberDef *dmem = member->d_member;
+                    if (dmem->type == T_OBJECT_EX && dmem->flags == 0 &&
+                        PyType_IsSubtype(type, PyDescr_TYPE(member)))
+                    {
+                        assert(dmem->offset > 0);
+                        hint = ~dmem->offset;
+                    }
+                }
+                else if ((descr == NULL || Py_TYPE(descr)->tp_descr_set == NULL)
+                         && type->tp_dictoffset > 0)
+                {
+                    PyObject *dict = *(PyObject **)((char *)owner + type->tp_dictoffset);
+                    if (dict != NULL && PyDict_CheckExact(dict)) {
+                        PyObject *res = NULL;
+                        hint = _PyDict_GetItemHint((PyDictObject *)dict, name,
+                                                   -1, &res);
+                        if (res == NULL) {
+                            // Can only fail if a __del__ removed the
+                            // attribute again; don't optimize.
+                            _PyErr_Clear(tstate);
+                            hint = -1;
+                        }
+                    }
+                }
+                if (hint != -1) {
+                    if (co_opcache->optimized == 0) {
+                        // First time we optimize this opcode.
+                        OPCACHE_STAT_STORE_ATTR_OPT();
+                        co_opcache->optimized = OPCODE_CACHE_MAX_TRIES;
+                    }
+                    sa = &co_opcache->u.sa;
+                    sa->type = type;
+                    sa->tp_version_tag = type->tp_version_tag;
+                    sa->hint = hint;
+                }
+                else {
+                    OPCACHE_DEOPT();
+                }
+            }
             Py_DECREF(v);
             Py_DECREF(owner);
             if (err != 0)
@@ -3176,8 +3246,6 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
             PyObject *dict;
             _PyOpCodeOpt_LoadAttr *la;
 
-            OPCACHE_STAT_ATTR_TOTAL();
-
             OPCACHE_CHECK();
             if (co_opcache != NULL && PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG))
             {
@@ -3196,6 +3264,7 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
                             char *addr = (char *)owner + offset;
                             res = *(PyObject **)addr;
                             if (res != NULL) {
+                                OPCACHE_STAT_ATTR_HIT();
                                 Py_INCREF(res);
                                 SET_TOP(res);
                                 Py_DECREF(owner);
@@ -3790,6 +3859,67 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
             PyObject *name = GETITEM(names, oparg);
             PyObject *obj = TOP();
             PyObject *meth = NULL;
+            PyTypeObject *type = Py_TYPE(obj);
+            _PyOpcache_LoadMethod *lm;
+
+            OPCACHE_CHECK();
+            if (co_opcache != NULL && co_opcache->optimized > 0) {
+                lm = &co_opcache->u.lm;
+                if (lm->kind == LM_KIND_METHOD
+                    && lm->owner.type == type
+                    && lm->ver.tp_version_tag == type->tp_version_tag
+                    && PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG))
+                {
+                    // The method is kept alive by the type dict for as long
+                    // as the version tag is unchanged.  Take a reference
+                    // before looking at the instance dict, which may run
+                    // arbitrary code.
+                    meth = lm->meth;
+                    Py_INCREF(meth);
+                    PyObject **dictptr = NULL;
+                    if (type->tp_dictoffset != 0) {
+                        dictptr = _PyObject_GetDictPtr(obj);
+                    }
+                    PyObject *dict = dictptr != NULL ? *dictptr : NULL;
+                    if (dict != NULL) {
+                        Py_INCREF(dict);
+                        PyObject *attr = PyDict_GetItemWithError(dict, name);
+                        Py_DECREF(dict);
+                        if (attr != NULL || _PyErr_Occurred(tstate)) {
+                            // Shadowed by an instance attribute: let the
+                            // slow path sort it out.
+                            Py_CLEAR(meth);
+                            if (_PyErr_Occurred(tstate)) {
+                                goto error;
+                            }
+                        }
+                    }
+                    if (meth != NULL) {
+                        OPCACHE_STAT_METHOD_HIT();
+                        SET_TOP(meth);
+                        PUSH(obj);  // self
+                        DISPATCH();
+                    }
+                }
+                else if (lm->kind == LM_KIND_MODULE
+                         && PyModule_CheckExact(obj)
+                         && PyModule_GetDict(obj) == lm->owner.dict
+                         && ((PyDictObject *)lm->owner.dict)->ma_version_tag ==
+                            lm->ver.dict_ver)
+                {
+                    // The module dict hasn't changed: the attribute is
+                    // still there.
+                    meth = lm->meth;
+                    OPCACHE_STAT_METHOD_HIT();
+                    Py_INCREF(meth);
+                    SET_TOP(NULL);
+                    Py_DECREF(obj);
+                    PUSH(meth);
+                    DISPATCH();
+                }
+                OPCACHE_STAT_METHOD_MISS();
+                OPCACHE_MAYBE_DEOPT_LOAD_METHOD();
+            }
 
             int meth_found = _PyObject_GetMethod(obj, name, &meth);
 
@@ -3798,6 +3928,59 @@ _PyEval_EvalFrameDefault(PyThreadState *tstate, PyFrameObject *f, int throwflag)
                 goto error;
             }
 
+            if (co_opcache != NULL) {
+                lm = &co_opcache->u.lm;
+                char kind = 0;
+                if (meth_found) {
+                    // _PyObject_GetMethod() only reports an unbound method
+                    // for types using the generic attribute lookup, and
+                    // the method comes straight from the type dict.
+                    if (Py_TYPE(obj) == type &&
+                        PyType_HasFeature(type, Py_TPFLAGS_VALID_VERSION_TAG) &&
+                        _PyType_Lookup(type, name) == meth)
+                    {
+                        kind = LM_KIND_METHOD;
+                        lm->owner.type = type;
+                        lm->ver.tp_version_tag = type->tp_version_tag;
+                    }
+                }
+                else if (PyModule_CheckExact(obj) &&
+                         _PyType_Lookup(&PyModule_Type, name) == NULL)
+                {
+                    // Only cache plain module globals, not module
+                    // __getattr__() results.
+                    PyObject *dict = PyModule_GetDict(obj);
+                    if (PyDict_CheckExact(dict) &&
+                        PyDict_GetItemWithError(dict, name) == meth)
+                    {
+                        kind = LM_KIND_MODULE;
+                        lm->owner.dict = dict;
+                        lm->ver.dict_ver =
+                            ((PyDictObject *)dict)->ma_version_tag;
+                    }
+                    else if (_PyErr_Occurred(tstate)) {
+                        Py_DECREF(meth);
+                        goto error;
+                    }
+                }
+                if (kind) {
+                    if (co_opcache->optimized == 0) {
+                        // First time we optimize this opcode.
+                        OPCACHE_STAT_METHOD_OPT();
+                        co_opcache->optimized = OPCODE_CACHE_MAX_TRIES;
+                    }
+                    lm->kind = kind;
+                    lm->meth = meth; /* borrowed */
+                }
+                else {
+                    // Only count a deopt if the cache had been in use.
+                    if (co_opcache->optimized > 0) {
+                        OPCACHE_STAT_METHOD_DEOPT();
+                    }
+                    OPCACHE_DEOPT();
+                }
+            }
+
             if (meth_found) {
                 /* We can bypass temporary bound method object.
                    meth is unbound method and obj is self.
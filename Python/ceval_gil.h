@@ -35,6 +35,19 @@
      The `interval` value is available for the user to read and modify
      using the Python API `sys.{get,set}switchinterval()`.
 
+   - With the "io_priority" switching policy (`sys.setswitchpolicy()`), a
+     thread returning from a blocking call (one that released the GIL on its
+     own rather than on request) sets gil_drop_request as soon as it finds
+     the GIL taken, instead of waiting for `interval` microseconds.  It is
+     recorded as priority_waiter so that the GIL is handed to it rather than
+     to another waiting thread, and drop_gil() wakes all waiting threads to
+     make sure it gets scheduled.  This cuts the latency of I/O-bound threads
+     competing with CPU-bound ones, at the cost of more switches.
+
+   - Each thread state records how long the thread waited for and held the
+     GIL, and how many times it had to drop it on request, see
+     `sys._getgilstats()`.
+
    - When a thread releases the GIL and gil_drop_request is set, that thread
      ensures that another GIL-awaiting thread gets scheduled.
      It does so by waiting on a condition variable (switch_cond) until
@@ -73,6 +86,9 @@
 #define COND_SIGNAL(cond) \
     if (PyCOND_SIGNAL(&(cond))) { \
         Py_FatalError("PyCOND_SIGNAL(" #cond ") failed"); };
+#define COND_BROADCAST(cond) \
+    if (PyCOND_BROADCAST(&(cond))) { \
+        Py_FatalError("PyCOND_BROADCAST(" #cond ") failed"); };
 #define COND_WAIT(cond, mut) \
     if (PyCOND_WAIT(&(cond), &(mut))) { \
         Py_FatalError("PyCOND_WAIT(" #cond ") failed"); };
@@ -95,6 +111,7 @@ static void _gil_initialize(struct _gil_runtime_state *gil)
     _Py_atomic_int uninitialized = {-1};
     gil->locked = uninitialized;
     gil->interval = DEFAULT_INTERVAL;
+    gil->policy = _PyEval_SWITCH_INTERVAL;
 }
 
 static int gil_created(struct _gil_runtime_state *gil)
@@ -113,6 +130,7 @@ static void create_gil(struct _gil_runtime_state *gil)
     COND_INIT(gil->switch_cond);
 #endif
     _Py_atomic_store_relaxed(&gil->last_holder, 0);
+    gil->priority_waiter = NULL;
     _Py_ANNOTATE_RWLOCK_CREATE(&gil->locked);
     _Py_atomic_store_explicit(&gil->locked, 0, _Py_memory_order_release);
 }
@@ -159,12 +177,23 @@ drop_gil(struct _ceval_runtime_state *ceval, struct _ceval_state *ceval2,
            under our feet using PyThreadState_Swap(). Fix the GIL last
            holder variable so that our heuristics work. */
         _Py_atomic_store_relaxed(&gil->last_holder, (uintptr_t)tstate);
+
+        if (tstate->gil.taken_at != 0) {
+            tstate->gil.hold_time += _PyTime_GetPerfCounter()
+                                     - tstate->gil.taken_at;
+            tstate->gil.taken_at = 0;
+        }
     }
 
     MUTEX_LOCK(gil->mutex);
     _Py_ANNOTATE_RWLOCK_RELEASED(&gil->locked, /*is_write=*/1);
     _Py_atomic_store_relaxed(&gil->locked, 0);
-    COND_SIGNAL(gil->cond);
+    if (gil->priority_waiter != NULL) {
+        COND_BROADCAST(gil->cond);
+    }
+    else {
+        COND_SIGNAL(gil->cond);
+    }
     MUTEX_UNLOCK(gil->mutex);
 
 #ifdef FORCE_SWITCHING
@@ -241,13 +270,31 @@ take_gil(PyThreadState *tstate)
     /* Check that _PyEval_InitThreads() was called to create the lock */
     assert(gil_created(gil));
 
+    /* Whether the GIL was dropped on request rather than around a
+       blocking call */
+    int switch_requested = tstate->gil.switch_requested;
+    tstate->gil.switch_requested = 0;
+    _PyTime_t wait_start = 0;
+
     MUTEX_LOCK(gil->mutex);
 
-    if (!_Py_atomic_load_relaxed(&gil->locked)) {
+#define GIL_BUSY() (_Py_atomic_load_relaxed(&gil->locked) \
+                    || (gil->priority_waiter != NULL \
+                        && gil->priority_waiter != tstate))
+
+    if (!GIL_BUSY()) {
         goto _ready;
     }
 
-    while (_Py_atomic_load_relaxed(&gil->locked)) {
+    wait_start = _PyTime_GetPerfCounter();
+    if (gil->policy == _PyEval_SWITCH_IO_PRIORITY && !switch_requested
+        && gil->priority_waiter == NULL)
+    {
+        gil->priority_waiter = tstate;
+        SET_GIL_DROP_REQUEST(interp);
+    }
+
+    while (GIL_BUSY()) {
         unsigned long saved_switchnum = gil->switch_number;
 
         unsigned long interval = (gil->interval >= 1 ? gil->interval : 1);
@@ -261,6 +308,9 @@ take_gil(PyThreadState *tstate)
             gil->switch_number == saved_switchnum)
         {
             if (tstate_must_exit(tstate)) {
+                if (gil->priority_waiter == tstate) {
+                    gil->priority_waiter = NULL;
+                }
                 MUTEX_UNLOCK(gil->mutex);
                 PyThread_exit_thread();
             }
@@ -269,8 +319,12 @@ take_gil(PyThreadState *tstate)
             SET_GIL_DROP_REQUEST(interp);
         }
     }
+#undef GIL_BUSY
 
 _ready:
+    if (gil->priority_waiter == tstate) {
+        gil->priority_waiter = NULL;
+    }
 #ifdef FORCE_SWITCHING
     /* This mutex must be taken before modifying gil->last_holder:
        see drop_gil(). */
@@ -316,6 +370,18 @@ take_gil(PyThreadState *tstate)
         COMPUTE_EVAL_BREAKER(interp, ceval, ceval2);
     }
 
+    _PyTime_t now = _PyTime_GetPerfCounter();
+    tstate->gil.acquisitions++;
+    if (wait_start != 0) {
+        _PyTime_t wait = now - wait_start;
+        tstate->gil.contended++;
+        tstate->gil.wait_time += wait;
+        if (wait > tstate->gil.max_wait_time) {
+            tstate->gil.max_wait_time = wait;
+        }
+    }
+    tstate->gil.taken_at = now;
+
     /* Don't access tstate if the thread must exit */
     if (tstate->async_exc != NULL) {
         _PyEval_SignalAsyncExc(tstate->interp);
@@ -347,3 +413,25 @@ unsigned long _PyEval_GetSwitchInterval()
 #endif
     return gil->interval;
 }
+
+void _PyEval_SetSwitchPolicy(int policy)
+{
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    PyInterpreterState *interp = PyInterpreterState_Get();
+    struct _gil_runtime_state *gil = &interp->ceval.gil;
+#else
+    struct _gil_runtime_state *gil = &_PyRuntime.ceval.gil;
+#endif
+    gil->policy = policy;
+}
+
+int _PyEval_GetSwitchPolicy()
+{
+#ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
+    PyInterpreterState *interp = PyInterpreterState_Get();
+    struct _gil_runtime_state *gil = &interp->ceval.gil;
+#else
+    struct _gil_runtime_state *gil = &_PyRuntime.ceval.gil;
+#endif
+    return gil->policy;
+}
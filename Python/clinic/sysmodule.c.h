@@ -350,6 +350,65 @@ sys_getswitchinterval(PyObject *module, PyObject *Py_UNUSED(ignored))
     return return_value;
 }
 
+PyDoc_STRVAR(sys_setswitchpolicy__doc__,
+"setswitchpolicy($module, policy, /)\n"
+"--\n"
+"\n"
+"Set the policy deciding when a thread waiting for the GIL gets it.\n"
+"\n"
+"With \"interval\" (the default), a waiting thread asks the running thread\n"
+"to release the GIL after the switch interval.  With \"io_priority\", a\n"
+"thread returning from a blocking call asks for it immediately.");
+
+#define SYS_SETSWITCHPOLICY_METHODDEF    \
+    {"setswitchpolicy", (PyCFunction)sys_setswitchpolicy, METH_O, sys_setswitchpolicy__doc__},
+
+static PyObject *
+sys_setswitchpolicy_impl(PyObject *module, const char *policy);
+
+static PyObject *
+sys_setswitchpolicy(PyObject *module, PyObject *arg)
+{
+    PyObject *return_value = NULL;
+    const char *policy;
+
+    if (!PyUnicode_Check(arg)) {
+        _PyArg_BadArgument("setswitchpolicy", "argument", "str", arg);
+        goto exit;
+    }
+    Py_ssize_t policy_length;
+    policy = PyUnicode_AsUTF8AndSize(arg, &policy_length);
+    if (policy == NULL) {
+        goto exit;
+    }
+    if (strlen(policy) != (size_t)policy_length) {
+        PyErr_SetString(PyExc_ValueError, "embedded null character");
+        goto exit;
+    }
+    return_value = sys_setswitchpolicy_impl(module, policy);
+
+exit:
+    return return_value;
+}
+
+PyDoc_STRVAR(sys_getswitchpolicy__doc__,
+"getswitchpolicy($module, /)\n"
+"--\n"
+"\n"
+"Return the current thread switch policy; see sys.setswitchpolicy().");
+
+#define SYS_GETSWITCHPOLICY_METHODDEF    \
+    {"getswitchpolicy", (PyCFunction)sys_getswitchpolicy, METH_NOARGS, sys_getswitchpolicy__doc__},
+
+static PyObject *
+sys_getswitchpolicy_impl(PyObject *module);
+
+static PyObject *
+sys_getswitchpolicy(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys_getswitchpolicy_impl(module);
+}
+
 PyDoc_STRVAR(sys_setrecursionlimit__doc__,
 "setrecursionlimit($module, limit, /)\n"
 "--\n"
@@ -801,6 +860,31 @@ sys__current_frames(PyObject *module, PyObject *Py_UNUSED(ignored))
     return sys__current_frames_impl(module);
 }
 
+PyDoc_STRVAR(sys__getgilstats__doc__,
+"_getgilstats($module, /)\n"
+"--\n"
+"\n"
+"Return a dict mapping each thread\'s identifier to its GIL statistics.\n"
+"\n"
+"The statistics count the acquisitions of the GIL, the ones which had to\n"
+"wait for another thread to release it, the releases requested by other\n"
+"threads, and the total and maximum time spent waiting for the GIL and\n"
+"the total time spent holding it, in seconds.\n"
+"\n"
+"This function should be used for specialized purposes only.");
+
+#define SYS__GETGILSTATS_METHODDEF    \
+    {"_getgilstats", (PyCFunction)sys__getgilstats, METH_NOARGS, sys__getgilstats__doc__},
+
+static PyObject *
+sys__getgilstats_impl(PyObject *module);
+
+static PyObject *
+sys__getgilstats(PyObject *module, PyObject *Py_UNUSED(ignored))
+{
+    return sys__getgilstats_impl(module);
+}
+
 PyDoc_STRVAR(sys__current_exceptions__doc__,
 "_current_exceptions($module, /)\n"
 "--\n"
@@ -880,6 +964,42 @@ sys__debugmallocstats(PyObject *module, PyObject *Py_UNUSED(ignored))
     return sys__debugmallocstats_impl(module);
 }
 
+PyDoc_STRVAR(sys__getopcachestats__doc__,
+"_getopcachestats($module, code=None, /)\n"
+"--\n"
+"\n"
+"Return statistics about the per opcode cache as a dict.\n"
+"\n"
+"Without argument, report the hits, misses, optimizations,\n"
+"deoptimizations and memory use of each kind of cache since startup.\n"
+"If a code object is given, report the state of its own cache entries.");
+
+#define SYS__GETOPCACHESTATS_METHODDEF    \
+    {"_getopcachestats", (PyCFunction)(void(*)(void))sys__getopcachestats, METH_FASTCALL, sys__getopcachestats__doc__},
+
+static PyObject *
+sys__getopcachestats_impl(PyObject *module, PyObject *code);
+
+static PyObject *
+sys__getopcachestats(PyObject *module, PyObject *const *args, Py_ssize_t nargs)
+{
+    PyObject *return_value = NULL;
+    PyObject *code = Py_None;
+
+    if (!_PyArg_CheckPositional("_getopcachestats", nargs, 0, 1)) {
+        goto exit;
+    }
+    if (nargs < 1) {
+        goto skip_optional;
+    }
+    code = args[0];
+skip_optional:
+    return_value = sys__getopcachestats_impl(module, code);
+
+exit:
+    return return_value;
+}
+
 PyDoc_STRVAR(sys__clear_type_cache__doc__,
 "_clear_type_cache($module, /)\n"
 "--\n"
@@ -965,4 +1085,4 @@ sys_getandroidapilevel(PyObject *module, PyObject *Py_UNUSED(ignored))
 #ifndef SYS_GETANDROIDAPILEVEL_METHODDEF
     #define SYS_GETANDROIDAPILEVEL_METHODDEF
 #endif /* !defined(SYS_GETANDROIDAPILEVEL_METHODDEF) */
-/*[clinic end generated code: output=bbc4963fe86a29d9 input=a9049054013a1b77]*/
+/*[clinic end generated code: output=6dcd1e58b1bea84a input=a9049054013a1b77]*/
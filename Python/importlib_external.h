@@ -1,7 +1,7 @@
 /* Auto-generated by Programs/_freeze_importlib.c */
 const unsigned char _Py_M__importlib_bootstrap_external[] = {
     99,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-    0,5,0,0,0,64,0,0,0,115,216,2,0,0,100,0,
+    0,5,0,0,0,64,0,0,0,115,228,2,0,0,100,0,
     90,0,100,1,97,1,100,2,100,1,108,2,90,2,100,2,
     100,1,108,3,90,3,100,2,100,1,108,4,90,4,100,2,
     100,1,108,5,90,5,100,2,100,1,108,6,90,6,101,4,
@@ -18,849 +18,897 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     100,20,132,0,90,25,100,21,100,22,132,0,90,26,100,23,
     100,24,132,0,90,27,100,25,100,26,132,0,90,28,100,27,
     100,28,132,0,90,29,100,29,100,30,132,0,90,30,100,31,
-    100,32,132,0,90,31,100,33,100,34,132,0,90,32,100,110,
+    100,32,132,0,90,31,100,33,100,34,132,0,90,32,100,112,
     100,36,100,37,132,1,90,33,101,34,101,33,106,35,131,1,
     90,36,100,38,160,37,100,39,100,40,161,2,100,41,23,0,
     90,38,101,39,160,40,101,38,100,40,161,2,90,41,100,42,
     90,42,100,43,90,43,100,44,103,1,90,44,101,8,144,1,
     114,94,101,44,160,45,100,45,161,1,1,0,101,2,160,46,
     161,0,90,47,100,46,103,1,90,48,101,48,4,0,90,49,
-    90,50,100,111,100,1,100,47,156,1,100,48,100,49,132,3,
+    90,50,100,113,100,1,100,47,156,1,100,48,100,49,132,3,
     90,51,100,50,100,51,132,0,90,52,100,52,100,53,132,0,
     90,53,100,54,100,55,132,0,90,54,100,56,100,57,132,0,
     90,55,100,58,100,59,132,0,90,56,100,60,100,61,132,0,
     90,57,100,62,100,63,132,0,90,58,100,64,100,65,132,0,
-    90,59,100,66,100,67,132,0,90,60,100,112,100,68,100,69,
-    132,1,90,61,100,113,100,70,100,71,132,1,90,62,100,114,
-    100,73,100,74,132,1,90,63,100,75,100,76,132,0,90,64,
-    101,65,131,0,90,66,100,115,100,1,101,66,100,77,156,2,
-    100,78,100,79,132,3,90,67,71,0,100,80,100,81,132,0,
-    100,81,131,2,90,68,71,0,100,82,100,83,132,0,100,83,
-    131,2,90,69,71,0,100,84,100,85,132,0,100,85,101,69,
-    131,3,90,70,71,0,100,86,100,87,132,0,100,87,131,2,
-    90,71,71,0,100,88,100,89,132,0,100,89,101,71,101,70,
-    131,4,90,72,71,0,100,90,100,91,132,0,100,91,101,71,
-    101,69,131,4,90,73,71,0,100,92,100,93,132,0,100,93,
-    101,71,101,69,131,4,90,74,71,0,100,94,100,95,132,0,
-    100,95,131,2,90,75,71,0,100,96,100,97,132,0,100,97,
-    131,2,90,76,71,0,100,98,100,99,132,0,100,99,131,2,
-    90,77,71,0,100,100,100,101,132,0,100,101,131,2,90,78,
-    100,116,100,102,100,103,132,1,90,79,100,104,100,105,132,0,
-    90,80,100,106,100,107,132,0,90,81,100,108,100,109,132,0,
-    90,82,100,1,83,0,41,117,97,94,1,0,0,67,111,114,
-    101,32,105,109,112,108,101,109,101,110,116,97,116,105,111,110,
-    32,111,102,32,112,97,116,104,45,98,97,115,101,100,32,105,
-    109,112,111,114,116,46,10,10,84,104,105,115,32,109,111,100,
-    117,108,101,32,105,115,32,78,79,84,32,109,101,97,110,116,
-    32,116,111,32,98,101,32,100,105,114,101,99,116,108,121,32,
-    105,109,112,111,114,116,101,100,33,32,73,116,32,104,97,115,
-    32,98,101,101,110,32,100,101,115,105,103,110,101,100,32,115,
-    117,99,104,10,116,104,97,116,32,105,116,32,99,97,110,32,
-    98,101,32,98,111,111,116,115,116,114,97,112,112,101,100,32,
-    105,110,116,111,32,80,121,116,104,111,110,32,97,115,32,116,
-    104,101,32,105,109,112,108,101,109,101,110,116,97,116,105,111,
-    110,32,111,102,32,105,109,112,111,114,116,46,32,65,115,10,
-    115,117,99,104,32,105,116,32,114,101,113,117,105,114,101,115,
-    32,116,104,101,32,105,110,106,101,99,116,105,111,110,32,111,
-    102,32,115,112,101,99,105,102,105,99,32,109,111,100,117,108,
-    101,115,32,97,110,100,32,97,116,116,114,105,98,117,116,101,
-    115,32,105,110,32,111,114,100,101,114,32,116,111,10,119,111,
-    114,107,46,32,79,110,101,32,115,104,111,117,108,100,32,117,
-    115,101,32,105,109,112,111,114,116,108,105,98,32,97,115,32,
-    116,104,101,32,112,117,98,108,105,99,45,102,97,99,105,110,
-    103,32,118,101,114,115,105,111,110,32,111,102,32,116,104,105,
-    115,32,109,111,100,117,108,101,46,10,10,78,233,0,0,0,
-    0,90,5,119,105,110,51,50,250,1,92,250,1,47,99,1,
-    0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,3,
-    0,0,0,99,0,0,0,115,26,0,0,0,124,0,93,18,
-    125,1,116,0,124,1,131,1,100,0,107,2,86,0,1,0,
-    113,2,100,1,83,0,41,2,233,1,0,0,0,78,41,1,
-    218,3,108,101,110,41,2,218,2,46,48,218,3,115,101,112,
-    169,0,114,7,0,0,0,250,38,60,102,114,111,122,101,110,
-    32,105,109,112,111,114,116,108,105,98,46,95,98,111,111,116,
-    115,116,114,97,112,95,101,120,116,101,114,110,97,108,62,218,
-    9,60,103,101,110,101,120,112,114,62,46,0,0,0,115,4,
-    0,0,0,26,0,255,128,114,9,0,0,0,218,0,99,1,
-    0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,4,
-    0,0,0,67,0,0,0,115,22,0,0,0,104,0,124,0,
-    93,14,125,1,100,0,124,1,155,0,157,2,146,2,113,4,
-    83,0,41,1,250,1,58,114,7,0,0,0,41,2,114,5,
-    0,0,0,218,1,115,114,7,0,0,0,114,7,0,0,0,
-    114,8,0,0,0,218,9,60,115,101,116,99,111,109,112,62,
-    49,0,0,0,243,4,0,0,0,22,0,255,128,114,13,0,
-    0,0,41,1,218,3,119,105,110,41,2,90,6,99,121,103,
-    119,105,110,90,6,100,97,114,119,105,110,99,0,0,0,0,
-    0,0,0,0,0,0,0,0,1,0,0,0,3,0,0,0,
-    3,0,0,0,115,62,0,0,0,116,0,106,1,160,2,116,
-    3,161,1,114,50,116,0,106,1,160,2,116,4,161,1,114,
-    30,100,1,137,0,110,4,100,2,137,0,135,0,102,1,100,
-    3,100,4,132,8,125,0,124,0,83,0,100,5,100,4,132,
-    0,125,0,124,0,83,0,41,6,78,90,12,80,89,84,72,
-    79,78,67,65,83,69,79,75,115,12,0,0,0,80,89,84,
-    72,79,78,67,65,83,69,79,75,99,0,0,0,0,0,0,
-    0,0,0,0,0,0,0,0,0,0,2,0,0,0,19,0,
-    0,0,115,20,0,0,0,116,0,106,1,106,2,12,0,111,
-    18,136,0,116,3,106,4,118,0,83,0,41,2,122,94,84,
-    114,117,101,32,105,102,32,102,105,108,101,110,97,109,101,115,
-    32,109,117,115,116,32,98,101,32,99,104,101,99,107,101,100,
-    32,99,97,115,101,45,105,110,115,101,110,115,105,116,105,118,
-    101,108,121,32,97,110,100,32,105,103,110,111,114,101,32,101,
-    110,118,105,114,111,110,109,101,110,116,32,102,108,97,103,115,
-    32,97,114,101,32,110,111,116,32,115,101,116,46,78,41,5,
-    218,3,115,121,115,218,5,102,108,97,103,115,218,18,105,103,
-    110,111,114,101,95,101,110,118,105,114,111,110,109,101,110,116,
-    218,3,95,111,115,90,7,101,110,118,105,114,111,110,114,7,
-    0,0,0,169,1,218,3,107,101,121,114,7,0,0,0,114,
-    8,0,0,0,218,11,95,114,101,108,97,120,95,99,97,115,
-    101,66,0,0,0,243,4,0,0,0,20,2,255,128,122,37,
-    95,109,97,107,101,95,114,101,108,97,120,95,99,97,115,101,
-    46,60,108,111,99,97,108,115,62,46,95,114,101,108,97,120,
-    95,99,97,115,101,99,0,0,0,0,0,0,0,0,0,0,
-    0,0,0,0,0,0,1,0,0,0,83,0,0,0,243,4,
-    0,0,0,100,1,83,0,41,3,122,53,84,114,117,101,32,
+    90,59,100,66,100,67,132,0,90,60,100,114,100,68,100,69,
+    132,1,90,61,105,0,90,62,100,70,100,71,132,0,90,63,
+    100,115,100,72,100,73,132,1,90,64,100,116,100,75,100,76,
+    132,1,90,65,100,77,100,78,132,0,90,66,101,67,131,0,
+    90,68,100,117,100,1,101,68,100,79,156,2,100,80,100,81,
+    132,3,90,69,71,0,100,82,100,83,132,0,100,83,131,2,
+    90,70,71,0,100,84,100,85,132,0,100,85,131,2,90,71,
+    71,0,100,86,100,87,132,0,100,87,101,71,131,3,90,72,
+    71,0,100,88,100,89,132,0,100,89,131,2,90,73,71,0,
+    100,90,100,91,132,0,100,91,101,73,101,72,131,4,90,74,
+    71,0,100,92,100,93,132,0,100,93,101,73,101,71,131,4,
+    90,75,71,0,100,94,100,95,132,0,100,95,101,73,101,71,
+    131,4,90,76,71,0,100,96,100,97,132,0,100,97,131,2,
+    90,77,71,0,100,98,100,99,132,0,100,99,131,2,90,78,
+    71,0,100,100,100,101,132,0,100,101,131,2,90,79,71,0,
+    100,102,100,103,132,0,100,103,131,2,90,80,100,118,100,104,
+    100,105,132,1,90,81,100,106,100,107,132,0,90,82,100,108,
+    100,109,132,0,90,83,100,110,100,111,132,0,90,84,100,1,
+    83,0,41,119,97,94,1,0,0,67,111,114,101,32,105,109,
+    112,108,101,109,101,110,116,97,116,105,111,110,32,111,102,32,
+    112,97,116,104,45,98,97,115,101,100,32,105,109,112,111,114,
+    116,46,10,10,84,104,105,115,32,109,111,100,117,108,101,32,
+    105,115,32,78,79,84,32,109,101,97,110,116,32,116,111,32,
+    98,101,32,100,105,114,101,99,116,108,121,32,105,109,112,111,
+    114,116,101,100,33,32,73,116,32,104,97,115,32,98,101,101,
+    110,32,100,101,115,105,103,110,101,100,32,115,117,99,104,10,
+    116,104,97,116,32,105,116,32,99,97,110,32,98,101,32,98,
+    111,111,116,115,116,114,97,112,112,101,100,32,105,110,116,111,
+    32,80,121,116,104,111,110,32,97,115,32,116,104,101,32,105,
+    109,112,108,101,109,101,110,116,97,116,105,111,110,32,111,102,
+    32,105,109,112,111,114,116,46,32,65,115,10,115,117,99,104,
+    32,105,116,32,114,101,113,117,105,114,101,115,32,116,104,101,
+    32,105,110,106,101,99,116,105,111,110,32,111,102,32,115,112,
+    101,99,105,102,105,99,32,109,111,100,117,108,101,115,32,97,
+    110,100,32,97,116,116,114,105,98,117,116,101,115,32,105,110,
+    32,111,114,100,101,114,32,116,111,10,119,111,114,107,46,32,
+    79,110,101,32,115,104,111,117,108,100,32,117,115,101,32,105,
+    109,112,111,114,116,108,105,98,32,97,115,32,116,104,101,32,
+    112,117,98,108,105,99,45,102,97,99,105,110,103,32,118,101,
+    114,115,105,111,110,32,111,102,32,116,104,105,115,32,109,111,
+    100,117,108,101,46,10,10,78,233,0,0,0,0,90,5,119,
+    105,110,51,50,250,1,92,250,1,47,99,1,0,0,0,0,
+    0,0,0,0,0,0,0,2,0,0,0,3,0,0,0,99,
+    0,0,0,115,26,0,0,0,124,0,93,18,125,1,116,0,
+    124,1,131,1,100,0,107,2,86,0,1,0,113,2,100,1,
+    83,0,41,2,233,1,0,0,0,78,41,1,218,3,108,101,
+    110,41,2,218,2,46,48,218,3,115,101,112,169,0,114,7,
+    0,0,0,250,38,60,102,114,111,122,101,110,32,105,109,112,
+    111,114,116,108,105,98,46,95,98,111,111,116,115,116,114,97,
+    112,95,101,120,116,101,114,110,97,108,62,218,9,60,103,101,
+    110,101,120,112,114,62,46,0,0,0,115,4,0,0,0,26,
+    0,255,128,114,9,0,0,0,218,0,99,1,0,0,0,0,
+    0,0,0,0,0,0,0,2,0,0,0,4,0,0,0,67,
+    0,0,0,115,22,0,0,0,104,0,124,0,93,14,125,1,
+    100,0,124,1,155,0,157,2,146,2,113,4,83,0,41,1,
+    250,1,58,114,7,0,0,0,41,2,114,5,0,0,0,218,
+    1,115,114,7,0,0,0,114,7,0,0,0,114,8,0,0,
+    0,218,9,60,115,101,116,99,111,109,112,62,49,0,0,0,
+    243,4,0,0,0,22,0,255,128,114,13,0,0,0,41,1,
+    218,3,119,105,110,41,2,90,6,99,121,103,119,105,110,90,
+    6,100,97,114,119,105,110,99,0,0,0,0,0,0,0,0,
+    0,0,0,0,1,0,0,0,3,0,0,0,3,0,0,0,
+    115,62,0,0,0,116,0,106,1,160,2,116,3,161,1,114,
+    50,116,0,106,1,160,2,116,4,161,1,114,30,100,1,137,
+    0,110,4,100,2,137,0,135,0,102,1,100,3,100,4,132,
+    8,125,0,124,0,83,0,100,5,100,4,132,0,125,0,124,
+    0,83,0,41,6,78,90,12,80,89,84,72,79,78,67,65,
+    83,69,79,75,115,12,0,0,0,80,89,84,72,79,78,67,
+    65,83,69,79,75,99,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,2,0,0,0,19,0,0,0,115,20,
+    0,0,0,116,0,106,1,106,2,12,0,111,18,136,0,116,
+    3,106,4,118,0,83,0,41,2,122,94,84,114,117,101,32,
     105,102,32,102,105,108,101,110,97,109,101,115,32,109,117,115,
     116,32,98,101,32,99,104,101,99,107,101,100,32,99,97,115,
-    101,45,105,110,115,101,110,115,105,116,105,118,101,108,121,46,
-    70,78,114,7,0,0,0,114,7,0,0,0,114,7,0,0,
-    0,114,7,0,0,0,114,8,0,0,0,114,22,0,0,0,
-    70,0,0,0,243,4,0,0,0,4,2,255,128,41,5,114,
-    16,0,0,0,218,8,112,108,97,116,102,111,114,109,218,10,
-    115,116,97,114,116,115,119,105,116,104,218,27,95,67,65,83,
-    69,95,73,78,83,69,78,83,73,84,73,86,69,95,80,76,
-    65,84,70,79,82,77,83,218,35,95,67,65,83,69,95,73,
-    78,83,69,78,83,73,84,73,86,69,95,80,76,65,84,70,
-    79,82,77,83,95,83,84,82,95,75,69,89,41,1,114,22,
-    0,0,0,114,7,0,0,0,114,20,0,0,0,114,8,0,
-    0,0,218,16,95,109,97,107,101,95,114,101,108,97,120,95,
-    99,97,115,101,59,0,0,0,115,18,0,0,0,12,1,12,
-    1,6,1,4,2,12,2,4,7,8,253,4,3,255,128,114,
-    30,0,0,0,99,1,0,0,0,0,0,0,0,0,0,0,
-    0,1,0,0,0,4,0,0,0,67,0,0,0,115,20,0,
-    0,0,116,0,124,0,131,1,100,1,64,0,160,1,100,2,
-    100,3,161,2,83,0,41,5,122,42,67,111,110,118,101,114,
-    116,32,97,32,51,50,45,98,105,116,32,105,110,116,101,103,
-    101,114,32,116,111,32,108,105,116,116,108,101,45,101,110,100,
-    105,97,110,46,236,3,0,0,0,255,127,255,127,3,0,233,
-    4,0,0,0,218,6,108,105,116,116,108,101,78,41,2,218,
-    3,105,110,116,218,8,116,111,95,98,121,116,101,115,41,1,
-    218,1,120,114,7,0,0,0,114,7,0,0,0,114,8,0,
-    0,0,218,12,95,112,97,99,107,95,117,105,110,116,51,50,
-    78,0,0,0,114,23,0,0,0,114,37,0,0,0,99,1,
-    0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,4,
-    0,0,0,67,0,0,0,243,28,0,0,0,116,0,124,0,
-    131,1,100,1,107,2,115,16,74,0,130,1,116,1,160,2,
-    124,0,100,2,161,2,83,0,41,4,122,47,67,111,110,118,
-    101,114,116,32,52,32,98,121,116,101,115,32,105,110,32,108,
-    105,116,116,108,101,45,101,110,100,105,97,110,32,116,111,32,
-    97,110,32,105,110,116,101,103,101,114,46,114,32,0,0,0,
-    114,33,0,0,0,78,169,3,114,4,0,0,0,114,34,0,
-    0,0,218,10,102,114,111,109,95,98,121,116,101,115,169,1,
-    218,4,100,97,116,97,114,7,0,0,0,114,7,0,0,0,
-    114,8,0,0,0,218,14,95,117,110,112,97,99,107,95,117,
-    105,110,116,51,50,83,0,0,0,243,6,0,0,0,16,2,
-    12,1,255,128,114,43,0,0,0,99,1,0,0,0,0,0,
-    0,0,0,0,0,0,1,0,0,0,4,0,0,0,67,0,
-    0,0,114,38,0,0,0,41,4,122,47,67,111,110,118,101,
-    114,116,32,50,32,98,121,116,101,115,32,105,110,32,108,105,
-    116,116,108,101,45,101,110,100,105,97,110,32,116,111,32,97,
-    110,32,105,110,116,101,103,101,114,46,233,2,0,0,0,114,
-    33,0,0,0,78,114,39,0,0,0,114,41,0,0,0,114,
-    7,0,0,0,114,7,0,0,0,114,8,0,0,0,218,14,
-    95,117,110,112,97,99,107,95,117,105,110,116,49,54,88,0,
-    0,0,114,44,0,0,0,114,46,0,0,0,99,0,0,0,
-    0,0,0,0,0,0,0,0,0,1,0,0,0,4,0,0,
-    0,71,0,0,0,115,20,0,0,0,116,0,160,1,100,1,
-    100,2,132,0,124,0,68,0,131,1,161,1,83,0,41,4,
-    122,31,82,101,112,108,97,99,101,109,101,110,116,32,102,111,
-    114,32,111,115,46,112,97,116,104,46,106,111,105,110,40,41,
-    46,99,1,0,0,0,0,0,0,0,0,0,0,0,2,0,
-    0,0,5,0,0,0,83,0,0,0,115,26,0,0,0,103,
-    0,124,0,93,18,125,1,124,1,114,4,124,1,160,0,116,
-    1,161,1,145,2,113,4,83,0,114,7,0,0,0,41,2,
-    218,6,114,115,116,114,105,112,218,15,112,97,116,104,95,115,
-    101,112,97,114,97,116,111,114,115,41,2,114,5,0,0,0,
-    218,4,112,97,114,116,114,7,0,0,0,114,7,0,0,0,
-    114,8,0,0,0,218,10,60,108,105,115,116,99,111,109,112,
-    62,96,0,0,0,115,8,0,0,0,6,0,6,1,14,255,
-    255,128,122,30,95,112,97,116,104,95,106,111,105,110,46,60,
-    108,111,99,97,108,115,62,46,60,108,105,115,116,99,111,109,
-    112,62,78,41,2,218,8,112,97,116,104,95,115,101,112,218,
-    4,106,111,105,110,41,1,218,10,112,97,116,104,95,112,97,
-    114,116,115,114,7,0,0,0,114,7,0,0,0,114,8,0,
-    0,0,218,10,95,112,97,116,104,95,106,111,105,110,94,0,
-    0,0,115,8,0,0,0,10,2,2,1,8,255,255,128,114,
-    54,0,0,0,99,1,0,0,0,0,0,0,0,0,0,0,
-    0,5,0,0,0,5,0,0,0,67,0,0,0,115,96,0,
-    0,0,116,0,116,1,131,1,100,1,107,2,114,36,124,0,
-    160,2,116,3,161,1,92,3,125,1,125,2,125,3,124,1,
-    124,3,102,2,83,0,116,4,124,0,131,1,68,0,93,42,
-    125,4,124,4,116,1,118,0,114,86,124,0,106,5,124,4,
-    100,1,100,2,141,2,92,2,125,1,125,3,124,1,124,3,
-    102,2,2,0,1,0,83,0,113,44,100,3,124,0,102,2,
-    83,0,41,5,122,32,82,101,112,108,97,99,101,109,101,110,
-    116,32,102,111,114,32,111,115,46,112,97,116,104,46,115,112,
-    108,105,116,40,41,46,114,3,0,0,0,41,1,90,8,109,
-    97,120,115,112,108,105,116,114,10,0,0,0,78,41,6,114,
-    4,0,0,0,114,48,0,0,0,218,10,114,112,97,114,116,
-    105,116,105,111,110,114,51,0,0,0,218,8,114,101,118,101,
-    114,115,101,100,218,6,114,115,112,108,105,116,41,5,218,4,
-    112,97,116,104,90,5,102,114,111,110,116,218,1,95,218,4,
-    116,97,105,108,114,36,0,0,0,114,7,0,0,0,114,7,
-    0,0,0,114,8,0,0,0,218,11,95,112,97,116,104,95,
-    115,112,108,105,116,100,0,0,0,115,20,0,0,0,12,2,
-    16,1,8,1,12,1,8,1,18,1,12,1,2,254,8,3,
-    255,128,114,61,0,0,0,99,1,0,0,0,0,0,0,0,
-    0,0,0,0,1,0,0,0,3,0,0,0,67,0,0,0,
-    115,10,0,0,0,116,0,160,1,124,0,161,1,83,0,41,
-    2,122,126,83,116,97,116,32,116,104,101,32,112,97,116,104,
-    46,10,10,32,32,32,32,77,97,100,101,32,97,32,115,101,
-    112,97,114,97,116,101,32,102,117,110,99,116,105,111,110,32,
-    116,111,32,109,97,107,101,32,105,116,32,101,97,115,105,101,
-    114,32,116,111,32,111,118,101,114,114,105,100,101,32,105,110,
-    32,101,120,112,101,114,105,109,101,110,116,115,10,32,32,32,
-    32,40,101,46,103,46,32,99,97,99,104,101,32,115,116,97,
-    116,32,114,101,115,117,108,116,115,41,46,10,10,32,32,32,
-    32,78,41,2,114,19,0,0,0,90,4,115,116,97,116,169,
-    1,114,58,0,0,0,114,7,0,0,0,114,7,0,0,0,
-    114,8,0,0,0,218,10,95,112,97,116,104,95,115,116,97,
-    116,112,0,0,0,115,4,0,0,0,10,7,255,128,114,63,
-    0,0,0,99,2,0,0,0,0,0,0,0,0,0,0,0,
-    3,0,0,0,8,0,0,0,67,0,0,0,115,48,0,0,
-    0,122,12,116,0,124,0,131,1,125,2,87,0,110,18,4,
-    0,116,1,121,46,1,0,1,0,1,0,89,0,100,1,83,
-    0,124,2,106,2,100,2,64,0,124,1,107,2,83,0,119,
-    0,41,4,122,49,84,101,115,116,32,119,104,101,116,104,101,
-    114,32,116,104,101,32,112,97,116,104,32,105,115,32,116,104,
-    101,32,115,112,101,99,105,102,105,101,100,32,109,111,100,101,
-    32,116,121,112,101,46,70,105,0,240,0,0,78,41,3,114,
-    63,0,0,0,218,7,79,83,69,114,114,111,114,218,7,115,
-    116,95,109,111,100,101,41,3,114,58,0,0,0,218,4,109,
-    111,100,101,90,9,115,116,97,116,95,105,110,102,111,114,7,
-    0,0,0,114,7,0,0,0,114,8,0,0,0,218,18,95,
-    112,97,116,104,95,105,115,95,109,111,100,101,95,116,121,112,
-    101,122,0,0,0,115,14,0,0,0,2,2,12,1,12,1,
-    6,1,14,1,2,254,255,128,114,67,0,0,0,99,1,0,
-    0,0,0,0,0,0,0,0,0,0,1,0,0,0,3,0,
-    0,0,67,0,0,0,115,10,0,0,0,116,0,124,0,100,
-    1,131,2,83,0,41,3,122,31,82,101,112,108,97,99,101,
-    109,101,110,116,32,102,111,114,32,111,115,46,112,97,116,104,
-    46,105,115,102,105,108,101,46,105,0,128,0,0,78,41,1,
-    114,67,0,0,0,114,62,0,0,0,114,7,0,0,0,114,
-    7,0,0,0,114,8,0,0,0,218,12,95,112,97,116,104,
-    95,105,115,102,105,108,101,131,0,0,0,243,4,0,0,0,
-    10,2,255,128,114,68,0,0,0,99,1,0,0,0,0,0,
-    0,0,0,0,0,0,1,0,0,0,3,0,0,0,67,0,
-    0,0,115,22,0,0,0,124,0,115,12,116,0,160,1,161,
-    0,125,0,116,2,124,0,100,1,131,2,83,0,41,3,122,
-    30,82,101,112,108,97,99,101,109,101,110,116,32,102,111,114,
-    32,111,115,46,112,97,116,104,46,105,115,100,105,114,46,105,
-    0,64,0,0,78,41,3,114,19,0,0,0,218,6,103,101,
-    116,99,119,100,114,67,0,0,0,114,62,0,0,0,114,7,
-    0,0,0,114,7,0,0,0,114,8,0,0,0,218,11,95,
-    112,97,116,104,95,105,115,100,105,114,136,0,0,0,115,8,
-    0,0,0,4,2,8,1,10,1,255,128,114,71,0,0,0,
+    101,45,105,110,115,101,110,115,105,116,105,118,101,108,121,32,
+    97,110,100,32,105,103,110,111,114,101,32,101,110,118,105,114,
+    111,110,109,101,110,116,32,102,108,97,103,115,32,97,114,101,
+    32,110,111,116,32,115,101,116,46,78,41,5,218,3,115,121,
+    115,218,5,102,108,97,103,115,218,18,105,103,110,111,114,101,
+    95,101,110,118,105,114,111,110,109,101,110,116,218,3,95,111,
+    115,90,7,101,110,118,105,114,111,110,114,7,0,0,0,169,
+    1,218,3,107,101,121,114,7,0,0,0,114,8,0,0,0,
+    218,11,95,114,101,108,97,120,95,99,97,115,101,66,0,0,
+    0,243,4,0,0,0,20,2,255,128,122,37,95,109,97,107,
+    101,95,114,101,108,97,120,95,99,97,115,101,46,60,108,111,
+    99,97,108,115,62,46,95,114,101,108,97,120,95,99,97,115,
+    101,99,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,1,0,0,0,83,0,0,0,243,4,0,0,0,100,
+    1,83,0,41,3,122,53,84,114,117,101,32,105,102,32,102,
+    105,108,101,110,97,109,101,115,32,109,117,115,116,32,98,101,
+    32,99,104,101,99,107,101,100,32,99,97,115,101,45,105,110,
+    115,101,110,115,105,116,105,118,101,108,121,46,70,78,114,7,
+    0,0,0,114,7,0,0,0,114,7,0,0,0,114,7,0,
+    0,0,114,8,0,0,0,114,22,0,0,0,70,0,0,0,
+    243,4,0,0,0,4,2,255,128,41,5,114,16,0,0,0,
+    218,8,112,108,97,116,102,111,114,109,218,10,115,116,97,114,
+    116,115,119,105,116,104,218,27,95,67,65,83,69,95,73,78,
+    83,69,78,83,73,84,73,86,69,95,80,76,65,84,70,79,
+    82,77,83,218,35,95,67,65,83,69,95,73,78,83,69,78,
+    83,73,84,73,86,69,95,80,76,65,84,70,79,82,77,83,
+    95,83,84,82,95,75,69,89,41,1,114,22,0,0,0,114,
+    7,0,0,0,114,20,0,0,0,114,8,0,0,0,218,16,
+    95,109,97,107,101,95,114,101,108,97,120,95,99,97,115,101,
+    59,0,0,0,115,18,0,0,0,12,1,12,1,6,1,4,
+    2,12,2,4,7,8,253,4,3,255,128,114,30,0,0,0,
     99,1,0,0,0,0,0,0,0,0,0,0,0,1,0,0,
-    0,3,0,0,0,67,0,0,0,115,26,0,0,0,124,0,
-    160,0,116,1,161,1,112,24,124,0,100,1,100,2,133,2,
-    25,0,116,2,118,0,83,0,41,4,122,142,82,101,112,108,
-    97,99,101,109,101,110,116,32,102,111,114,32,111,115,46,112,
-    97,116,104,46,105,115,97,98,115,46,10,10,32,32,32,32,
-    67,111,110,115,105,100,101,114,115,32,97,32,87,105,110,100,
-    111,119,115,32,100,114,105,118,101,45,114,101,108,97,116,105,
-    118,101,32,112,97,116,104,32,40,110,111,32,100,114,105,118,
-    101,44,32,98,117,116,32,115,116,97,114,116,115,32,119,105,
-    116,104,32,115,108,97,115,104,41,32,116,111,10,32,32,32,
-    32,115,116,105,108,108,32,98,101,32,34,97,98,115,111,108,
-    117,116,101,34,46,10,32,32,32,32,114,3,0,0,0,233,
-    3,0,0,0,78,41,3,114,27,0,0,0,114,48,0,0,
-    0,218,20,95,112,97,116,104,115,101,112,115,95,119,105,116,
-    104,95,99,111,108,111,110,114,62,0,0,0,114,7,0,0,
-    0,114,7,0,0,0,114,8,0,0,0,218,11,95,112,97,
-    116,104,95,105,115,97,98,115,143,0,0,0,115,4,0,0,
-    0,26,6,255,128,114,74,0,0,0,233,182,1,0,0,99,
-    3,0,0,0,0,0,0,0,0,0,0,0,6,0,0,0,
-    11,0,0,0,67,0,0,0,115,170,0,0,0,100,1,160,
-    0,124,0,116,1,124,0,131,1,161,2,125,3,116,2,160,
-    3,124,3,116,2,106,4,116,2,106,5,66,0,116,2,106,
-    6,66,0,124,2,100,2,64,0,161,3,125,4,122,72,116,
-    7,160,8,124,4,100,3,161,2,143,26,125,5,124,5,160,
-    9,124,1,161,1,1,0,87,0,100,4,4,0,4,0,131,
-    3,1,0,110,16,49,0,115,94,119,1,1,0,1,0,1,
-    0,89,0,1,0,116,2,160,10,124,3,124,0,161,2,1,
-    0,87,0,100,4,83,0,4,0,116,11,121,168,1,0,1,
-    0,1,0,122,14,116,2,160,12,124,3,161,1,1,0,87,
-    0,130,0,4,0,116,11,121,166,1,0,1,0,1,0,89,
-    0,130,0,119,0,119,0,41,5,122,162,66,101,115,116,45,
-    101,102,102,111,114,116,32,102,117,110,99,116,105,111,110,32,
-    116,111,32,119,114,105,116,101,32,100,97,116,97,32,116,111,
-    32,97,32,112,97,116,104,32,97,116,111,109,105,99,97,108,
-    108,121,46,10,32,32,32,32,66,101,32,112,114,101,112,97,
-    114,101,100,32,116,111,32,104,97,110,100,108,101,32,97,32,
-    70,105,108,101,69,120,105,115,116,115,69,114,114,111,114,32,
-    105,102,32,99,111,110,99,117,114,114,101,110,116,32,119,114,
-    105,116,105,110,103,32,111,102,32,116,104,101,10,32,32,32,
-    32,116,101,109,112,111,114,97,114,121,32,102,105,108,101,32,
-    105,115,32,97,116,116,101,109,112,116,101,100,46,250,5,123,
-    125,46,123,125,114,75,0,0,0,90,2,119,98,78,41,13,
-    218,6,102,111,114,109,97,116,218,2,105,100,114,19,0,0,
-    0,90,4,111,112,101,110,90,6,79,95,69,88,67,76,90,
-    7,79,95,67,82,69,65,84,90,8,79,95,87,82,79,78,
-    76,89,218,3,95,105,111,218,6,70,105,108,101,73,79,218,
-    5,119,114,105,116,101,218,7,114,101,112,108,97,99,101,114,
-    64,0,0,0,90,6,117,110,108,105,110,107,41,6,114,58,
-    0,0,0,114,42,0,0,0,114,66,0,0,0,90,8,112,
-    97,116,104,95,116,109,112,90,2,102,100,218,4,102,105,108,
-    101,114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,
-    218,13,95,119,114,105,116,101,95,97,116,111,109,105,99,152,
-    0,0,0,115,38,0,0,0,16,5,6,1,22,1,4,255,
-    2,2,14,3,24,1,16,128,18,1,12,1,2,1,12,1,
-    2,3,12,254,2,1,2,1,2,254,2,253,255,128,114,84,
-    0,0,0,105,105,13,0,0,114,45,0,0,0,114,33,0,
-    0,0,115,2,0,0,0,13,10,90,11,95,95,112,121,99,
-    97,99,104,101,95,95,122,4,111,112,116,45,122,3,46,112,
-    121,122,4,46,112,121,119,122,4,46,112,121,99,41,1,218,
-    12,111,112,116,105,109,105,122,97,116,105,111,110,99,2,0,
-    0,0,0,0,0,0,1,0,0,0,12,0,0,0,5,0,
-    0,0,67,0,0,0,115,88,1,0,0,124,1,100,1,117,
-    1,114,52,116,0,160,1,100,2,116,2,161,2,1,0,124,
-    2,100,1,117,1,114,40,100,3,125,3,116,3,124,3,131,
-    1,130,1,124,1,114,48,100,4,110,2,100,5,125,2,116,
-    4,160,5,124,0,161,1,125,0,116,6,124,0,131,1,92,
-    2,125,4,125,5,124,5,160,7,100,6,161,1,92,3,125,
-    6,125,7,125,8,116,8,106,9,106,10,125,9,124,9,100,
-    1,117,0,114,114,116,11,100,7,131,1,130,1,100,4,160,
-    12,124,6,114,126,124,6,110,2,124,8,124,7,124,9,103,
-    3,161,1,125,10,124,2,100,1,117,0,114,172,116,8,106,
-    13,106,14,100,8,107,2,114,164,100,4,125,2,110,8,116,
-    8,106,13,106,14,125,2,116,15,124,2,131,1,125,2,124,
-    2,100,4,107,3,114,224,124,2,160,16,161,0,115,210,116,
-    17,100,9,160,18,124,2,161,1,131,1,130,1,100,10,160,
-    18,124,10,116,19,124,2,161,3,125,10,124,10,116,20,100,
-    8,25,0,23,0,125,11,116,8,106,21,100,1,117,1,144,
-    1,114,76,116,22,124,4,131,1,144,1,115,16,116,23,116,
-    4,160,24,161,0,124,4,131,2,125,4,124,4,100,5,25,
-    0,100,11,107,2,144,1,114,56,124,4,100,8,25,0,116,
-    25,118,1,144,1,114,56,124,4,100,12,100,1,133,2,25,
-    0,125,4,116,23,116,8,106,21,124,4,160,26,116,25,161,
-    1,124,11,131,3,83,0,116,23,124,4,116,27,124,11,131,
-    3,83,0,41,13,97,254,2,0,0,71,105,118,101,110,32,
-    116,104,101,32,112,97,116,104,32,116,111,32,97,32,46,112,
-    121,32,102,105,108,101,44,32,114,101,116,117,114,110,32,116,
-    104,101,32,112,97,116,104,32,116,111,32,105,116,115,32,46,
-    112,121,99,32,102,105,108,101,46,10,10,32,32,32,32,84,
-    104,101,32,46,112,121,32,102,105,108,101,32,100,111,101,115,
-    32,110,111,116,32,110,101,101,100,32,116,111,32,101,120,105,
-    115,116,59,32,116,104,105,115,32,115,105,109,112,108,121,32,
-    114,101,116,117,114,110,115,32,116,104,101,32,112,97,116,104,
-    32,116,111,32,116,104,101,10,32,32,32,32,46,112,121,99,
-    32,102,105,108,101,32,99,97,108,99,117,108,97,116,101,100,
-    32,97,115,32,105,102,32,116,104,101,32,46,112,121,32,102,
-    105,108,101,32,119,101,114,101,32,105,109,112,111,114,116,101,
-    100,46,10,10,32,32,32,32,84,104,101,32,39,111,112,116,
-    105,109,105,122,97,116,105,111,110,39,32,112,97,114,97,109,
-    101,116,101,114,32,99,111,110,116,114,111,108,115,32,116,104,
-    101,32,112,114,101,115,117,109,101,100,32,111,112,116,105,109,
-    105,122,97,116,105,111,110,32,108,101,118,101,108,32,111,102,
-    10,32,32,32,32,116,104,101,32,98,121,116,101,99,111,100,
-    101,32,102,105,108,101,46,32,73,102,32,39,111,112,116,105,
-    109,105,122,97,116,105,111,110,39,32,105,115,32,110,111,116,
-    32,78,111,110,101,44,32,116,104,101,32,115,116,114,105,110,
-    103,32,114,101,112,114,101,115,101,110,116,97,116,105,111,110,
-    10,32,32,32,32,111,102,32,116,104,101,32,97,114,103,117,
-    109,101,110,116,32,105,115,32,116,97,107,101,110,32,97,110,
-    100,32,118,101,114,105,102,105,101,100,32,116,111,32,98,101,
-    32,97,108,112,104,97,110,117,109,101,114,105,99,32,40,101,
-    108,115,101,32,86,97,108,117,101,69,114,114,111,114,10,32,
-    32,32,32,105,115,32,114,97,105,115,101,100,41,46,10,10,
-    32,32,32,32,84,104,101,32,100,101,98,117,103,95,111,118,
-    101,114,114,105,100,101,32,112,97,114,97,109,101,116,101,114,
-    32,105,115,32,100,101,112,114,101,99,97,116,101,100,46,32,
-    73,102,32,100,101,98,117,103,95,111,118,101,114,114,105,100,
-    101,32,105,115,32,110,111,116,32,78,111,110,101,44,10,32,
-    32,32,32,97,32,84,114,117,101,32,118,97,108,117,101,32,
-    105,115,32,116,104,101,32,115,97,109,101,32,97,115,32,115,
+    0,4,0,0,0,67,0,0,0,115,20,0,0,0,116,0,
+    124,0,131,1,100,1,64,0,160,1,100,2,100,3,161,2,
+    83,0,41,5,122,42,67,111,110,118,101,114,116,32,97,32,
+    51,50,45,98,105,116,32,105,110,116,101,103,101,114,32,116,
+    111,32,108,105,116,116,108,101,45,101,110,100,105,97,110,46,
+    236,3,0,0,0,255,127,255,127,3,0,233,4,0,0,0,
+    218,6,108,105,116,116,108,101,78,41,2,218,3,105,110,116,
+    218,8,116,111,95,98,121,116,101,115,41,1,218,1,120,114,
+    7,0,0,0,114,7,0,0,0,114,8,0,0,0,218,12,
+    95,112,97,99,107,95,117,105,110,116,51,50,78,0,0,0,
+    114,23,0,0,0,114,37,0,0,0,99,1,0,0,0,0,
+    0,0,0,0,0,0,0,1,0,0,0,4,0,0,0,67,
+    0,0,0,243,28,0,0,0,116,0,124,0,131,1,100,1,
+    107,2,115,16,74,0,130,1,116,1,160,2,124,0,100,2,
+    161,2,83,0,41,4,122,47,67,111,110,118,101,114,116,32,
+    52,32,98,121,116,101,115,32,105,110,32,108,105,116,116,108,
+    101,45,101,110,100,105,97,110,32,116,111,32,97,110,32,105,
+    110,116,101,103,101,114,46,114,32,0,0,0,114,33,0,0,
+    0,78,169,3,114,4,0,0,0,114,34,0,0,0,218,10,
+    102,114,111,109,95,98,121,116,101,115,169,1,218,4,100,97,
+    116,97,114,7,0,0,0,114,7,0,0,0,114,8,0,0,
+    0,218,14,95,117,110,112,97,99,107,95,117,105,110,116,51,
+    50,83,0,0,0,243,6,0,0,0,16,2,12,1,255,128,
+    114,43,0,0,0,99,1,0,0,0,0,0,0,0,0,0,
+    0,0,1,0,0,0,4,0,0,0,67,0,0,0,114,38,
+    0,0,0,41,4,122,47,67,111,110,118,101,114,116,32,50,
+    32,98,121,116,101,115,32,105,110,32,108,105,116,116,108,101,
+    45,101,110,100,105,97,110,32,116,111,32,97,110,32,105,110,
+    116,101,103,101,114,46,233,2,0,0,0,114,33,0,0,0,
+    78,114,39,0,0,0,114,41,0,0,0,114,7,0,0,0,
+    114,7,0,0,0,114,8,0,0,0,218,14,95,117,110,112,
+    97,99,107,95,117,105,110,116,49,54,88,0,0,0,114,44,
+    0,0,0,114,46,0,0,0,99,0,0,0,0,0,0,0,
+    0,0,0,0,0,1,0,0,0,4,0,0,0,71,0,0,
+    0,115,20,0,0,0,116,0,160,1,100,1,100,2,132,0,
+    124,0,68,0,131,1,161,1,83,0,41,4,122,31,82,101,
+    112,108,97,99,101,109,101,110,116,32,102,111,114,32,111,115,
+    46,112,97,116,104,46,106,111,105,110,40,41,46,99,1,0,
+    0,0,0,0,0,0,0,0,0,0,2,0,0,0,5,0,
+    0,0,83,0,0,0,115,26,0,0,0,103,0,124,0,93,
+    18,125,1,124,1,114,4,124,1,160,0,116,1,161,1,145,
+    2,113,4,83,0,114,7,0,0,0,41,2,218,6,114,115,
+    116,114,105,112,218,15,112,97,116,104,95,115,101,112,97,114,
+    97,116,111,114,115,41,2,114,5,0,0,0,218,4,112,97,
+    114,116,114,7,0,0,0,114,7,0,0,0,114,8,0,0,
+    0,218,10,60,108,105,115,116,99,111,109,112,62,96,0,0,
+    0,115,8,0,0,0,6,0,6,1,14,255,255,128,122,30,
+    95,112,97,116,104,95,106,111,105,110,46,60,108,111,99,97,
+    108,115,62,46,60,108,105,115,116,99,111,109,112,62,78,41,
+    2,218,8,112,97,116,104,95,115,101,112,218,4,106,111,105,
+    110,41,1,218,10,112,97,116,104,95,112,97,114,116,115,114,
+    7,0,0,0,114,7,0,0,0,114,8,0,0,0,218,10,
+    95,112,97,116,104,95,106,111,105,110,94,0,0,0,115,8,
+    0,0,0,10,2,2,1,8,255,255,128,114,54,0,0,0,
+    99,1,0,0,0,0,0,0,0,0,0,0,0,5,0,0,
+    0,5,0,0,0,67,0,0,0,115,96,0,0,0,116,0,
+    116,1,131,1,100,1,107,2,114,36,124,0,160,2,116,3,
+    161,1,92,3,125,1,125,2,125,3,124,1,124,3,102,2,
+    83,0,116,4,124,0,131,1,68,0,93,42,125,4,124,4,
+    116,1,118,0,114,86,124,0,106,5,124,4,100,1,100,2,
+    141,2,92,2,125,1,125,3,124,1,124,3,102,2,2,0,
+    1,0,83,0,113,44,100,3,124,0,102,2,83,0,41,5,
+    122,32,82,101,112,108,97,99,101,109,101,110,116,32,102,111,
+    114,32,111,115,46,112,97,116,104,46,115,112,108,105,116,40,
+    41,46,114,3,0,0,0,41,1,90,8,109,97,120,115,112,
+    108,105,116,114,10,0,0,0,78,41,6,114,4,0,0,0,
+    114,48,0,0,0,218,10,114,112,97,114,116,105,116,105,111,
+    110,114,51,0,0,0,218,8,114,101,118,101,114,115,101,100,
+    218,6,114,115,112,108,105,116,41,5,218,4,112,97,116,104,
+    90,5,102,114,111,110,116,218,1,95,218,4,116,97,105,108,
+    114,36,0,0,0,114,7,0,0,0,114,7,0,0,0,114,
+    8,0,0,0,218,11,95,112,97,116,104,95,115,112,108,105,
+    116,100,0,0,0,115,20,0,0,0,12,2,16,1,8,1,
+    12,1,8,1,18,1,12,1,2,254,8,3,255,128,114,61,
+    0,0,0,99,1,0,0,0,0,0,0,0,0,0,0,0,
+    1,0,0,0,3,0,0,0,67,0,0,0,115,10,0,0,
+    0,116,0,160,1,124,0,161,1,83,0,41,2,122,126,83,
+    116,97,116,32,116,104,101,32,112,97,116,104,46,10,10,32,
+    32,32,32,77,97,100,101,32,97,32,115,101,112,97,114,97,
+    116,101,32,102,117,110,99,116,105,111,110,32,116,111,32,109,
+    97,107,101,32,105,116,32,101,97,115,105,101,114,32,116,111,
+    32,111,118,101,114,114,105,100,101,32,105,110,32,101,120,112,
+    101,114,105,109,101,110,116,115,10,32,32,32,32,40,101,46,
+    103,46,32,99,97,99,104,101,32,115,116,97,116,32,114,101,
+    115,117,108,116,115,41,46,10,10,32,32,32,32,78,41,2,
+    114,19,0,0,0,90,4,115,116,97,116,169,1,114,58,0,
+    0,0,114,7,0,0,0,114,7,0,0,0,114,8,0,0,
+    0,218,10,95,112,97,116,104,95,115,116,97,116,112,0,0,
+    0,115,4,0,0,0,10,7,255,128,114,63,0,0,0,99,
+    2,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,
+    8,0,0,0,67,0,0,0,115,48,0,0,0,122,12,116,
+    0,124,0,131,1,125,2,87,0,110,18,4,0,116,1,121,
+    46,1,0,1,0,1,0,89,0,100,1,83,0,124,2,106,
+    2,100,2,64,0,124,1,107,2,83,0,119,0,41,4,122,
+    49,84,101,115,116,32,119,104,101,116,104,101,114,32,116,104,
+    101,32,112,97,116,104,32,105,115,32,116,104,101,32,115,112,
+    101,99,105,102,105,101,100,32,109,111,100,101,32,116,121,112,
+    101,46,70,105,0,240,0,0,78,41,3,114,63,0,0,0,
+    218,7,79,83,69,114,114,111,114,218,7,115,116,95,109,111,
+    100,101,41,3,114,58,0,0,0,218,4,109,111,100,101,90,
+    9,115,116,97,116,95,105,110,102,111,114,7,0,0,0,114,
+    7,0,0,0,114,8,0,0,0,218,18,95,112,97,116,104,
+    95,105,115,95,109,111,100,101,95,116,121,112,101,122,0,0,
+    0,115,14,0,0,0,2,2,12,1,12,1,6,1,14,1,
+    2,254,255,128,114,67,0,0,0,99,1,0,0,0,0,0,
+    0,0,0,0,0,0,1,0,0,0,3,0,0,0,67,0,
+    0,0,115,10,0,0,0,116,0,124,0,100,1,131,2,83,
+    0,41,3,122,31,82,101,112,108,97,99,101,109,101,110,116,
+    32,102,111,114,32,111,115,46,112,97,116,104,46,105,115,102,
+    105,108,101,46,105,0,128,0,0,78,41,1,114,67,0,0,
+    0,114,62,0,0,0,114,7,0,0,0,114,7,0,0,0,
+    114,8,0,0,0,218,12,95,112,97,116,104,95,105,115,102,
+    105,108,101,131,0,0,0,243,4,0,0,0,10,2,255,128,
+    114,68,0,0,0,99,1,0,0,0,0,0,0,0,0,0,
+    0,0,1,0,0,0,3,0,0,0,67,0,0,0,115,22,
+    0,0,0,124,0,115,12,116,0,160,1,161,0,125,0,116,
+    2,124,0,100,1,131,2,83,0,41,3,122,30,82,101,112,
+    108,97,99,101,109,101,110,116,32,102,111,114,32,111,115,46,
+    112,97,116,104,46,105,115,100,105,114,46,105,0,64,0,0,
+    78,41,3,114,19,0,0,0,218,6,103,101,116,99,119,100,
+    114,67,0,0,0,114,62,0,0,0,114,7,0,0,0,114,
+    7,0,0,0,114,8,0,0,0,218,11,95,112,97,116,104,
+    95,105,115,100,105,114,136,0,0,0,115,8,0,0,0,4,
+    2,8,1,10,1,255,128,114,71,0,0,0,99,1,0,0,
+    0,0,0,0,0,0,0,0,0,1,0,0,0,3,0,0,
+    0,67,0,0,0,115,26,0,0,0,124,0,160,0,116,1,
+    161,1,112,24,124,0,100,1,100,2,133,2,25,0,116,2,
+    118,0,83,0,41,4,122,142,82,101,112,108,97,99,101,109,
+    101,110,116,32,102,111,114,32,111,115,46,112,97,116,104,46,
+    105,115,97,98,115,46,10,10,32,32,32,32,67,111,110,115,
+    105,100,101,114,115,32,97,32,87,105,110,100,111,119,115,32,
+    100,114,105,118,101,45,114,101,108,97,116,105,118,101,32,112,
+    97,116,104,32,40,110,111,32,100,114,105,118,101,44,32,98,
+    117,116,32,115,116,97,114,116,115,32,119,105,116,104,32,115,
+    108,97,115,104,41,32,116,111,10,32,32,32,32,115,116,105,
+    108,108,32,98,101,32,34,97,98,115,111,108,117,116,101,34,
+    46,10,32,32,32,32,114,3,0,0,0,233,3,0,0,0,
+    78,41,3,114,27,0,0,0,114,48,0,0,0,218,20,95,
+    112,97,116,104,115,101,112,115,95,119,105,116,104,95,99,111,
+    108,111,110,114,62,0,0,0,114,7,0,0,0,114,7,0,
+    0,0,114,8,0,0,0,218,11,95,112,97,116,104,95,105,
+    115,97,98,115,143,0,0,0,115,4,0,0,0,26,6,255,
+    128,114,74,0,0,0,233,182,1,0,0,99,3,0,0,0,
+    0,0,0,0,0,0,0,0,6,0,0,0,11,0,0,0,
+    67,0,0,0,115,170,0,0,0,100,1,160,0,124,0,116,
+    1,124,0,131,1,161,2,125,3,116,2,160,3,124,3,116,
+    2,106,4,116,2,106,5,66,0,116,2,106,6,66,0,124,
+    2,100,2,64,0,161,3,125,4,122,72,116,7,160,8,124,
+    4,100,3,161,2,143,26,125,5,124,5,160,9,124,1,161,
+    1,1,0,87,0,100,4,4,0,4,0,131,3,1,0,110,
+    16,49,0,115,94,119,1,1,0,1,0,1,0,89,0,1,
+    0,116,2,160,10,124,3,124,0,161,2,1,0,87,0,100,
+    4,83,0,4,0,116,11,121,168,1,0,1,0,1,0,122,
+    14,116,2,160,12,124,3,161,1,1,0,87,0,130,0,4,
+    0,116,11,121,166,1,0,1,0,1,0,89,0,130,0,119,
+    0,119,0,41,5,122,162,66,101,115,116,45,101,102,102,111,
+    114,116,32,102,117,110,99,116,105,111,110,32,116,111,32,119,
+    114,105,116,101,32,100,97,116,97,32,116,111,32,97,32,112,
+    97,116,104,32,97,116,111,109,105,99,97,108,108,121,46,10,
+    32,32,32,32,66,101,32,112,114,101,112,97,114,101,100,32,
+    116,111,32,104,97,110,100,108,101,32,97,32,70,105,108,101,
+    69,120,105,115,116,115,69,114,114,111,114,32,105,102,32,99,
+    111,110,99,117,114,114,101,110,116,32,119,114,105,116,105,110,
+    103,32,111,102,32,116,104,101,10,32,32,32,32,116,101,109,
+    112,111,114,97,114,121,32,102,105,108,101,32,105,115,32,97,
+    116,116,101,109,112,116,101,100,46,250,5,123,125,46,123,125,
+    114,75,0,0,0,90,2,119,98,78,41,13,218,6,102,111,
+    114,109,97,116,218,2,105,100,114,19,0,0,0,90,4,111,
+    112,101,110,90,6,79,95,69,88,67,76,90,7,79,95,67,
+    82,69,65,84,90,8,79,95,87,82,79,78,76,89,218,3,
+    95,105,111,218,6,70,105,108,101,73,79,218,5,119,114,105,
+    116,101,218,7,114,101,112,108,97,99,101,114,64,0,0,0,
+    90,6,117,110,108,105,110,107,41,6,114,58,0,0,0,114,
+    42,0,0,0,114,66,0,0,0,90,8,112,97,116,104,95,
+    116,109,112,90,2,102,100,218,4,102,105,108,101,114,7,0,
+    0,0,114,7,0,0,0,114,8,0,0,0,218,13,95,119,
+    114,105,116,101,95,97,116,111,109,105,99,152,0,0,0,115,
+    38,0,0,0,16,5,6,1,22,1,4,255,2,2,14,3,
+    24,1,16,128,18,1,12,1,2,1,12,1,2,3,12,254,
+    2,1,2,1,2,254,2,253,255,128,114,84,0,0,0,105,
+    105,13,0,0,114,45,0,0,0,114,33,0,0,0,115,2,
+    0,0,0,13,10,90,11,95,95,112,121,99,97,99,104,101,
+    95,95,122,4,111,112,116,45,122,3,46,112,121,122,4,46,
+    112,121,119,122,4,46,112,121,99,41,1,218,12,111,112,116,
+    105,109,105,122,97,116,105,111,110,99,2,0,0,0,0,0,
+    0,0,1,0,0,0,12,0,0,0,5,0,0,0,67,0,
+    0,0,115,88,1,0,0,124,1,100,1,117,1,114,52,116,
+    0,160,1,100,2,116,2,161,2,1,0,124,2,100,1,117,
+    1,114,40,100,3,125,3,116,3,124,3,131,1,130,1,124,
+    1,114,48,100,4,110,2,100,5,125,2,116,4,160,5,124,
+    0,161,1,125,0,116,6,124,0,131,1,92,2,125,4,125,
+    5,124,5,160,7,100,6,161,1,92,3,125,6,125,7,125,
+    8,116,8,106,9,106,10,125,9,124,9,100,1,117,0,114,
+    114,116,11,100,7,131,1,130,1,100,4,160,12,124,6,114,
+    126,124,6,110,2,124,8,124,7,124,9,103,3,161,1,125,
+    10,124,2,100,1,117,0,114,172,116,8,106,13,106,14,100,
+    8,107,2,114,164,100,4,125,2,110,8,116,8,106,13,106,
+    14,125,2,116,15,124,2,131,1,125,2,124,2,100,4,107,
+    3,114,224,124,2,160,16,161,0,115,210,116,17,100,9,160,
+    18,124,2,161,1,131,1,130,1,100,10,160,18,124,10,116,
+    19,124,2,161,3,125,10,124,10,116,20,100,8,25,0,23,
+    0,125,11,116,8,106,21,100,1,117,1,144,1,114,76,116,
+    22,124,4,131,1,144,1,115,16,116,23,116,4,160,24,161,
+    0,124,4,131,2,125,4,124,4,100,5,25,0,100,11,107,
+    2,144,1,114,56,124,4,100,8,25,0,116,25,118,1,144,
+    1,114,56,124,4,100,12,100,1,133,2,25,0,125,4,116,
+    23,116,8,106,21,124,4,160,26,116,25,161,1,124,11,131,
+    3,83,0,116,23,124,4,116,27,124,11,131,3,83,0,41,
+    13,97,254,2,0,0,71,105,118,101,110,32,116,104,101,32,
+    112,97,116,104,32,116,111,32,97,32,46,112,121,32,102,105,
+    108,101,44,32,114,101,116,117,114,110,32,116,104,101,32,112,
+    97,116,104,32,116,111,32,105,116,115,32,46,112,121,99,32,
+    102,105,108,101,46,10,10,32,32,32,32,84,104,101,32,46,
+    112,121,32,102,105,108,101,32,100,111,101,115,32,110,111,116,
+    32,110,101,101,100,32,116,111,32,101,120,105,115,116,59,32,
+    116,104,105,115,32,115,105,109,112,108,121,32,114,101,116,117,
+    114,110,115,32,116,104,101,32,112,97,116,104,32,116,111,32,
+    116,104,101,10,32,32,32,32,46,112,121,99,32,102,105,108,
+    101,32,99,97,108,99,117,108,97,116,101,100,32,97,115,32,
+    105,102,32,116,104,101,32,46,112,121,32,102,105,108,101,32,
+    119,101,114,101,32,105,109,112,111,114,116,101,100,46,10,10,
+    32,32,32,32,84,104,101,32,39,111,112,116,105,109,105,122,
+    97,116,105,111,110,39,32,112,97,114,97,109,101,116,101,114,
+    32,99,111,110,116,114,111,108,115,32,116,104,101,32,112,114,
+    101,115,117,109,101,100,32,111,112,116,105,109,105,122,97,116,
+    105,111,110,32,108,101,118,101,108,32,111,102,10,32,32,32,
+    32,116,104,101,32,98,121,116,101,99,111,100,101,32,102,105,
+    108,101,46,32,73,102,32,39,111,112,116,105,109,105,122,97,
+    116,105,111,110,39,32,105,115,32,110,111,116,32,78,111,110,
+    101,44,32,116,104,101,32,115,116,114,105,110,103,32,114,101,
+    112,114,101,115,101,110,116,97,116,105,111,110,10,32,32,32,
+    32,111,102,32,116,104,101,32,97,114,103,117,109,101,110,116,
+    32,105,115,32,116,97,107,101,110,32,97,110,100,32,118,101,
+    114,105,102,105,101,100,32,116,111,32,98,101,32,97,108,112,
+    104,97,110,117,109,101,114,105,99,32,40,101,108,115,101,32,
+    86,97,108,117,101,69,114,114,111,114,10,32,32,32,32,105,
+    115,32,114,97,105,115,101,100,41,46,10,10,32,32,32,32,
+    84,104,101,32,100,101,98,117,103,95,111,118,101,114,114,105,
+    100,101,32,112,97,114,97,109,101,116,101,114,32,105,115,32,
+    100,101,112,114,101,99,97,116,101,100,46,32,73,102,32,100,
+    101,98,117,103,95,111,118,101,114,114,105,100,101,32,105,115,
+    32,110,111,116,32,78,111,110,101,44,10,32,32,32,32,97,
+    32,84,114,117,101,32,118,97,108,117,101,32,105,115,32,116,
+    104,101,32,115,97,109,101,32,97,115,32,115,101,116,116,105,
+    110,103,32,39,111,112,116,105,109,105,122,97,116,105,111,110,
+    39,32,116,111,32,116,104,101,32,101,109,112,116,121,32,115,
+    116,114,105,110,103,10,32,32,32,32,119,104,105,108,101,32,
+    97,32,70,97,108,115,101,32,118,97,108,117,101,32,105,115,
+    32,101,113,117,105,118,97,108,101,110,116,32,116,111,32,115,
     101,116,116,105,110,103,32,39,111,112,116,105,109,105,122,97,
-    116,105,111,110,39,32,116,111,32,116,104,101,32,101,109,112,
-    116,121,32,115,116,114,105,110,103,10,32,32,32,32,119,104,
-    105,108,101,32,97,32,70,97,108,115,101,32,118,97,108,117,
-    101,32,105,115,32,101,113,117,105,118,97,108,101,110,116,32,
-    116,111,32,115,101,116,116,105,110,103,32,39,111,112,116,105,
-    109,105,122,97,116,105,111,110,39,32,116,111,32,39,49,39,
-    46,10,10,32,32,32,32,73,102,32,115,121,115,46,105,109,
-    112,108,101,109,101,110,116,97,116,105,111,110,46,99,97,99,
-    104,101,95,116,97,103,32,105,115,32,78,111,110,101,32,116,
-    104,101,110,32,78,111,116,73,109,112,108,101,109,101,110,116,
-    101,100,69,114,114,111,114,32,105,115,32,114,97,105,115,101,
-    100,46,10,10,32,32,32,32,78,122,70,116,104,101,32,100,
-    101,98,117,103,95,111,118,101,114,114,105,100,101,32,112,97,
-    114,97,109,101,116,101,114,32,105,115,32,100,101,112,114,101,
-    99,97,116,101,100,59,32,117,115,101,32,39,111,112,116,105,
-    109,105,122,97,116,105,111,110,39,32,105,110,115,116,101,97,
-    100,122,50,100,101,98,117,103,95,111,118,101,114,114,105,100,
-    101,32,111,114,32,111,112,116,105,109,105,122,97,116,105,111,
-    110,32,109,117,115,116,32,98,101,32,115,101,116,32,116,111,
-    32,78,111,110,101,114,10,0,0,0,114,3,0,0,0,218,
-    1,46,250,36,115,121,115,46,105,109,112,108,101,109,101,110,
-    116,97,116,105,111,110,46,99,97,99,104,101,95,116,97,103,
-    32,105,115,32,78,111,110,101,114,0,0,0,0,122,24,123,
-    33,114,125,32,105,115,32,110,111,116,32,97,108,112,104,97,
-    110,117,109,101,114,105,99,122,7,123,125,46,123,125,123,125,
-    114,11,0,0,0,114,45,0,0,0,41,28,218,9,95,119,
-    97,114,110,105,110,103,115,218,4,119,97,114,110,218,18,68,
-    101,112,114,101,99,97,116,105,111,110,87,97,114,110,105,110,
-    103,218,9,84,121,112,101,69,114,114,111,114,114,19,0,0,
-    0,218,6,102,115,112,97,116,104,114,61,0,0,0,114,55,
-    0,0,0,114,16,0,0,0,218,14,105,109,112,108,101,109,
-    101,110,116,97,116,105,111,110,218,9,99,97,99,104,101,95,
-    116,97,103,218,19,78,111,116,73,109,112,108,101,109,101,110,
-    116,101,100,69,114,114,111,114,114,52,0,0,0,114,17,0,
-    0,0,218,8,111,112,116,105,109,105,122,101,218,3,115,116,
-    114,218,7,105,115,97,108,110,117,109,218,10,86,97,108,117,
-    101,69,114,114,111,114,114,77,0,0,0,218,4,95,79,80,
-    84,218,17,66,89,84,69,67,79,68,69,95,83,85,70,70,
-    73,88,69,83,218,14,112,121,99,97,99,104,101,95,112,114,
-    101,102,105,120,114,74,0,0,0,114,54,0,0,0,114,70,
-    0,0,0,114,48,0,0,0,218,6,108,115,116,114,105,112,
-    218,8,95,80,89,67,65,67,72,69,41,12,114,58,0,0,
-    0,90,14,100,101,98,117,103,95,111,118,101,114,114,105,100,
-    101,114,85,0,0,0,218,7,109,101,115,115,97,103,101,218,
-    4,104,101,97,100,114,60,0,0,0,90,4,98,97,115,101,
-    114,6,0,0,0,218,4,114,101,115,116,90,3,116,97,103,
-    90,15,97,108,109,111,115,116,95,102,105,108,101,110,97,109,
-    101,218,8,102,105,108,101,110,97,109,101,114,7,0,0,0,
-    114,7,0,0,0,114,8,0,0,0,218,17,99,97,99,104,
-    101,95,102,114,111,109,95,115,111,117,114,99,101,85,1,0,
-    0,115,74,0,0,0,8,18,6,1,2,1,4,255,8,2,
-    4,1,8,1,12,1,10,1,12,1,16,1,8,1,8,1,
-    8,1,24,1,8,1,12,1,6,1,8,2,8,1,8,1,
-    8,1,14,1,14,1,12,1,12,1,10,9,14,1,28,5,
-    12,1,2,4,4,1,8,1,2,1,4,253,12,5,255,128,
-    114,109,0,0,0,99,1,0,0,0,0,0,0,0,0,0,
-    0,0,10,0,0,0,5,0,0,0,67,0,0,0,115,44,
-    1,0,0,116,0,106,1,106,2,100,1,117,0,114,20,116,
-    3,100,2,131,1,130,1,116,4,160,5,124,0,161,1,125,
-    0,116,6,124,0,131,1,92,2,125,1,125,2,100,3,125,
-    3,116,0,106,7,100,1,117,1,114,102,116,0,106,7,160,
-    8,116,9,161,1,125,4,124,1,160,10,124,4,116,11,23,
-    0,161,1,114,102,124,1,116,12,124,4,131,1,100,1,133,
-    2,25,0,125,1,100,4,125,3,124,3,115,144,116,6,124,
-    1,131,1,92,2,125,1,125,5,124,5,116,13,107,3,114,
-    144,116,14,116,13,155,0,100,5,124,0,155,2,157,3,131,
-    1,130,1,124,2,160,15,100,6,161,1,125,6,124,6,100,
-    7,118,1,114,176,116,14,100,8,124,2,155,2,157,2,131,
-    1,130,1,124,6,100,9,107,2,144,1,114,12,124,2,160,
-    16,100,6,100,10,161,2,100,11,25,0,125,7,124,7,160,
-    10,116,17,161,1,115,226,116,14,100,12,116,17,155,2,157,
-    2,131,1,130,1,124,7,116,12,116,17,131,1,100,1,133,
-    2,25,0,125,8,124,8,160,18,161,0,144,1,115,12,116,
-    14,100,13,124,7,155,2,100,14,157,3,131,1,130,1,124,
-    2,160,19,100,6,161,1,100,15,25,0,125,9,116,20,124,
-    1,124,9,116,21,100,15,25,0,23,0,131,2,83,0,41,
-    16,97,110,1,0,0,71,105,118,101,110,32,116,104,101,32,
-    112,97,116,104,32,116,111,32,97,32,46,112,121,99,46,32,
-    102,105,108,101,44,32,114,101,116,117,114,110,32,116,104,101,
-    32,112,97,116,104,32,116,111,32,105,116,115,32,46,112,121,
-    32,102,105,108,101,46,10,10,32,32,32,32,84,104,101,32,
-    46,112,121,99,32,102,105,108,101,32,100,111,101,115,32,110,
-    111,116,32,110,101,101,100,32,116,111,32,101,120,105,115,116,
-    59,32,116,104,105,115,32,115,105,109,112,108,121,32,114,101,
-    116,117,114,110,115,32,116,104,101,32,112,97,116,104,32,116,
-    111,10,32,32,32,32,116,104,101,32,46,112,121,32,102,105,
-    108,101,32,99,97,108,99,117,108,97,116,101,100,32,116,111,
-    32,99,111,114,114,101,115,112,111,110,100,32,116,111,32,116,
-    104,101,32,46,112,121,99,32,102,105,108,101,46,32,32,73,
-    102,32,112,97,116,104,32,100,111,101,115,10,32,32,32,32,
-    110,111,116,32,99,111,110,102,111,114,109,32,116,111,32,80,
-    69,80,32,51,49,52,55,47,52,56,56,32,102,111,114,109,
-    97,116,44,32,86,97,108,117,101,69,114,114,111,114,32,119,
-    105,108,108,32,98,101,32,114,97,105,115,101,100,46,32,73,
-    102,10,32,32,32,32,115,121,115,46,105,109,112,108,101,109,
+    116,105,111,110,39,32,116,111,32,39,49,39,46,10,10,32,
+    32,32,32,73,102,32,115,121,115,46,105,109,112,108,101,109,
     101,110,116,97,116,105,111,110,46,99,97,99,104,101,95,116,
     97,103,32,105,115,32,78,111,110,101,32,116,104,101,110,32,
     78,111,116,73,109,112,108,101,109,101,110,116,101,100,69,114,
     114,111,114,32,105,115,32,114,97,105,115,101,100,46,10,10,
-    32,32,32,32,78,114,87,0,0,0,70,84,122,31,32,110,
-    111,116,32,98,111,116,116,111,109,45,108,101,118,101,108,32,
-    100,105,114,101,99,116,111,114,121,32,105,110,32,114,86,0,
-    0,0,62,2,0,0,0,114,45,0,0,0,114,72,0,0,
-    0,122,29,101,120,112,101,99,116,101,100,32,111,110,108,121,
-    32,50,32,111,114,32,51,32,100,111,116,115,32,105,110,32,
-    114,72,0,0,0,114,45,0,0,0,233,254,255,255,255,122,
-    53,111,112,116,105,109,105,122,97,116,105,111,110,32,112,111,
-    114,116,105,111,110,32,111,102,32,102,105,108,101,110,97,109,
-    101,32,100,111,101,115,32,110,111,116,32,115,116,97,114,116,
-    32,119,105,116,104,32,122,19,111,112,116,105,109,105,122,97,
-    116,105,111,110,32,108,101,118,101,108,32,122,29,32,105,115,
-    32,110,111,116,32,97,110,32,97,108,112,104,97,110,117,109,
-    101,114,105,99,32,118,97,108,117,101,114,0,0,0,0,41,
-    22,114,16,0,0,0,114,93,0,0,0,114,94,0,0,0,
-    114,95,0,0,0,114,19,0,0,0,114,92,0,0,0,114,
-    61,0,0,0,114,102,0,0,0,114,47,0,0,0,114,48,
-    0,0,0,114,27,0,0,0,114,51,0,0,0,114,4,0,
-    0,0,114,104,0,0,0,114,99,0,0,0,218,5,99,111,
-    117,110,116,114,57,0,0,0,114,100,0,0,0,114,98,0,
-    0,0,218,9,112,97,114,116,105,116,105,111,110,114,54,0,
-    0,0,218,15,83,79,85,82,67,69,95,83,85,70,70,73,
-    88,69,83,41,10,114,58,0,0,0,114,106,0,0,0,90,
-    16,112,121,99,97,99,104,101,95,102,105,108,101,110,97,109,
-    101,90,23,102,111,117,110,100,95,105,110,95,112,121,99,97,
-    99,104,101,95,112,114,101,102,105,120,90,13,115,116,114,105,
-    112,112,101,100,95,112,97,116,104,90,7,112,121,99,97,99,
-    104,101,90,9,100,111,116,95,99,111,117,110,116,114,85,0,
-    0,0,90,9,111,112,116,95,108,101,118,101,108,90,13,98,
-    97,115,101,95,102,105,108,101,110,97,109,101,114,7,0,0,
-    0,114,7,0,0,0,114,8,0,0,0,218,17,115,111,117,
-    114,99,101,95,102,114,111,109,95,99,97,99,104,101,156,1,
-    0,0,115,62,0,0,0,12,9,8,1,10,1,12,1,4,
-    1,10,1,12,1,14,1,16,1,4,1,4,1,12,1,8,
-    1,8,1,2,1,8,255,10,2,8,1,14,1,10,1,16,
-    1,10,1,4,1,2,1,8,255,16,2,10,1,16,1,14,
-    2,18,1,255,128,114,114,0,0,0,99,1,0,0,0,0,
-    0,0,0,0,0,0,0,5,0,0,0,9,0,0,0,67,
-    0,0,0,115,122,0,0,0,116,0,124,0,131,1,100,1,
-    107,2,114,16,100,2,83,0,124,0,160,1,100,3,161,1,
-    92,3,125,1,125,2,125,3,124,1,114,56,124,3,160,2,
-    161,0,100,4,100,5,133,2,25,0,100,6,107,3,114,60,
-    124,0,83,0,122,12,116,3,124,0,131,1,125,4,87,0,
-    110,30,4,0,116,4,116,5,102,2,121,120,1,0,1,0,
-    1,0,124,0,100,2,100,5,133,2,25,0,125,4,89,0,
-    116,6,124,4,131,1,114,116,124,4,83,0,124,0,83,0,
-    119,0,41,7,122,188,67,111,110,118,101,114,116,32,97,32,
-    98,121,116,101,99,111,100,101,32,102,105,108,101,32,112,97,
-    116,104,32,116,111,32,97,32,115,111,117,114,99,101,32,112,
-    97,116,104,32,40,105,102,32,112,111,115,115,105,98,108,101,
-    41,46,10,10,32,32,32,32,84,104,105,115,32,102,117,110,
-    99,116,105,111,110,32,101,120,105,115,116,115,32,112,117,114,
-    101,108,121,32,102,111,114,32,98,97,99,107,119,97,114,100,
-    115,45,99,111,109,112,97,116,105,98,105,108,105,116,121,32,
-    102,111,114,10,32,32,32,32,80,121,73,109,112,111,114,116,
-    95,69,120,101,99,67,111,100,101,77,111,100,117,108,101,87,
-    105,116,104,70,105,108,101,110,97,109,101,115,40,41,32,105,
-    110,32,116,104,101,32,67,32,65,80,73,46,10,10,32,32,
-    32,32,114,0,0,0,0,78,114,86,0,0,0,233,253,255,
-    255,255,233,255,255,255,255,90,2,112,121,41,7,114,4,0,
-    0,0,114,55,0,0,0,218,5,108,111,119,101,114,114,114,
-    0,0,0,114,95,0,0,0,114,99,0,0,0,114,68,0,
-    0,0,41,5,218,13,98,121,116,101,99,111,100,101,95,112,
-    97,116,104,114,107,0,0,0,114,59,0,0,0,90,9,101,
-    120,116,101,110,115,105,111,110,218,11,115,111,117,114,99,101,
-    95,112,97,116,104,114,7,0,0,0,114,7,0,0,0,114,
-    8,0,0,0,218,15,95,103,101,116,95,115,111,117,114,99,
-    101,102,105,108,101,196,1,0,0,115,24,0,0,0,12,7,
-    4,1,16,1,24,1,4,1,2,1,12,1,16,1,14,1,
-    16,1,2,254,255,128,114,120,0,0,0,99,1,0,0,0,
-    0,0,0,0,0,0,0,0,1,0,0,0,8,0,0,0,
-    67,0,0,0,115,68,0,0,0,124,0,160,0,116,1,116,
-    2,131,1,161,1,114,44,122,10,116,3,124,0,131,1,87,
-    0,83,0,4,0,116,4,121,66,1,0,1,0,1,0,89,
-    0,100,0,83,0,124,0,160,0,116,1,116,5,131,1,161,
-    1,114,62,124,0,83,0,100,0,83,0,119,0,169,1,78,
-    41,6,218,8,101,110,100,115,119,105,116,104,218,5,116,117,
-    112,108,101,114,113,0,0,0,114,109,0,0,0,114,95,0,
-    0,0,114,101,0,0,0,41,1,114,108,0,0,0,114,7,
-    0,0,0,114,7,0,0,0,114,8,0,0,0,218,11,95,
-    103,101,116,95,99,97,99,104,101,100,215,1,0,0,115,20,
-    0,0,0,14,1,2,1,10,1,12,1,6,1,14,1,4,
-    1,4,2,2,251,255,128,114,124,0,0,0,99,1,0,0,
-    0,0,0,0,0,0,0,0,0,2,0,0,0,8,0,0,
-    0,67,0,0,0,115,48,0,0,0,122,14,116,0,124,0,
-    131,1,106,1,125,1,87,0,110,18,4,0,116,2,121,46,
-    1,0,1,0,1,0,100,1,125,1,89,0,124,1,100,2,
-    79,0,125,1,124,1,83,0,119,0,41,4,122,51,67,97,
-    108,99,117,108,97,116,101,32,116,104,101,32,109,111,100,101,
-    32,112,101,114,109,105,115,115,105,111,110,115,32,102,111,114,
-    32,97,32,98,121,116,101,99,111,100,101,32,102,105,108,101,
-    46,114,75,0,0,0,233,128,0,0,0,78,41,3,114,63,
-    0,0,0,114,65,0,0,0,114,64,0,0,0,41,2,114,
-    58,0,0,0,114,66,0,0,0,114,7,0,0,0,114,7,
-    0,0,0,114,8,0,0,0,218,10,95,99,97,108,99,95,
-    109,111,100,101,227,1,0,0,115,16,0,0,0,2,2,14,
-    1,12,1,6,1,8,3,4,1,2,251,255,128,114,126,0,
-    0,0,99,1,0,0,0,0,0,0,0,0,0,0,0,3,
-    0,0,0,4,0,0,0,3,0,0,0,115,52,0,0,0,
-    100,6,135,0,102,1,100,2,100,3,132,9,125,1,116,0,
-    100,1,117,1,114,30,116,0,106,1,125,2,110,8,100,4,
-    100,5,132,0,125,2,124,2,124,1,136,0,131,2,1,0,
-    124,1,83,0,41,7,122,252,68,101,99,111,114,97,116,111,
-    114,32,116,111,32,118,101,114,105,102,121,32,116,104,97,116,
-    32,116,104,101,32,109,111,100,117,108,101,32,98,101,105,110,
-    103,32,114,101,113,117,101,115,116,101,100,32,109,97,116,99,
-    104,101,115,32,116,104,101,32,111,110,101,32,116,104,101,10,
-    32,32,32,32,108,111,97,100,101,114,32,99,97,110,32,104,
-    97,110,100,108,101,46,10,10,32,32,32,32,84,104,101,32,
-    102,105,114,115,116,32,97,114,103,117,109,101,110,116,32,40,
-    115,101,108,102,41,32,109,117,115,116,32,100,101,102,105,110,
-    101,32,95,110,97,109,101,32,119,104,105,99,104,32,116,104,
-    101,32,115,101,99,111,110,100,32,97,114,103,117,109,101,110,
-    116,32,105,115,10,32,32,32,32,99,111,109,112,97,114,101,
-    100,32,97,103,97,105,110,115,116,46,32,73,102,32,116,104,
-    101,32,99,111,109,112,97,114,105,115,111,110,32,102,97,105,
-    108,115,32,116,104,101,110,32,73,109,112,111,114,116,69,114,
-    114,111,114,32,105,115,32,114,97,105,115,101,100,46,10,10,
-    32,32,32,32,78,99,2,0,0,0,0,0,0,0,0,0,
-    0,0,4,0,0,0,4,0,0,0,31,0,0,0,115,72,
-    0,0,0,124,1,100,0,117,0,114,16,124,0,106,0,125,
-    1,110,32,124,0,106,0,124,1,107,3,114,48,116,1,100,
-    1,124,0,106,0,124,1,102,2,22,0,124,1,100,2,141,
-    2,130,1,136,0,124,0,124,1,103,2,124,2,162,1,82,
-    0,105,0,124,3,164,1,142,1,83,0,41,3,78,122,30,
-    108,111,97,100,101,114,32,102,111,114,32,37,115,32,99,97,
-    110,110,111,116,32,104,97,110,100,108,101,32,37,115,169,1,
-    218,4,110,97,109,101,41,2,114,128,0,0,0,218,11,73,
-    109,112,111,114,116,69,114,114,111,114,41,4,218,4,115,101,
-    108,102,114,128,0,0,0,218,4,97,114,103,115,218,6,107,
-    119,97,114,103,115,169,1,218,6,109,101,116,104,111,100,114,
-    7,0,0,0,114,8,0,0,0,218,19,95,99,104,101,99,
-    107,95,110,97,109,101,95,119,114,97,112,112,101,114,247,1,
-    0,0,115,20,0,0,0,8,1,8,1,10,1,4,1,8,
-    1,2,255,2,1,6,255,24,2,255,128,122,40,95,99,104,
-    101,99,107,95,110,97,109,101,46,60,108,111,99,97,108,115,
-    62,46,95,99,104,101,99,107,95,110,97,109,101,95,119,114,
-    97,112,112,101,114,99,2,0,0,0,0,0,0,0,0,0,
-    0,0,3,0,0,0,7,0,0,0,83,0,0,0,115,56,
-    0,0,0,100,1,68,0,93,32,125,2,116,0,124,1,124,
-    2,131,2,114,36,116,1,124,0,124,2,116,2,124,1,124,
-    2,131,2,131,3,1,0,113,4,124,0,106,3,160,4,124,
-    1,106,3,161,1,1,0,100,0,83,0,41,2,78,41,4,
-    218,10,95,95,109,111,100,117,108,101,95,95,218,8,95,95,
-    110,97,109,101,95,95,218,12,95,95,113,117,97,108,110,97,
-    109,101,95,95,218,7,95,95,100,111,99,95,95,41,5,218,
-    7,104,97,115,97,116,116,114,218,7,115,101,116,97,116,116,
-    114,218,7,103,101,116,97,116,116,114,218,8,95,95,100,105,
-    99,116,95,95,218,6,117,112,100,97,116,101,41,3,90,3,
-    110,101,119,90,3,111,108,100,114,82,0,0,0,114,7,0,
-    0,0,114,7,0,0,0,114,8,0,0,0,218,5,95,119,
-    114,97,112,4,2,0,0,115,12,0,0,0,8,1,10,1,
-    18,1,2,128,18,1,255,128,122,26,95,99,104,101,99,107,
-    95,110,97,109,101,46,60,108,111,99,97,108,115,62,46,95,
-    119,114,97,112,41,1,78,41,2,218,10,95,98,111,111,116,
-    115,116,114,97,112,114,145,0,0,0,41,3,114,134,0,0,
-    0,114,135,0,0,0,114,145,0,0,0,114,7,0,0,0,
-    114,133,0,0,0,114,8,0,0,0,218,11,95,99,104,101,
-    99,107,95,110,97,109,101,239,1,0,0,115,14,0,0,0,
-    14,8,8,10,8,1,8,2,10,6,4,1,255,128,114,147,
-    0,0,0,99,2,0,0,0,0,0,0,0,0,0,0,0,
-    5,0,0,0,6,0,0,0,67,0,0,0,115,60,0,0,
-    0,124,0,160,0,124,1,161,1,92,2,125,2,125,3,124,
-    2,100,1,117,0,114,56,116,1,124,3,131,1,114,56,100,
-    2,125,4,116,2,160,3,124,4,160,4,124,3,100,3,25,
-    0,161,1,116,5,161,2,1,0,124,2,83,0,41,4,122,
-    155,84,114,121,32,116,111,32,102,105,110,100,32,97,32,108,
-    111,97,100,101,114,32,102,111,114,32,116,104,101,32,115,112,
-    101,99,105,102,105,101,100,32,109,111,100,117,108,101,32,98,
-    121,32,100,101,108,101,103,97,116,105,110,103,32,116,111,10,
-    32,32,32,32,115,101,108,102,46,102,105,110,100,95,108,111,
-    97,100,101,114,40,41,46,10,10,32,32,32,32,84,104,105,
-    115,32,109,101,116,104,111,100,32,105,115,32,100,101,112,114,
-    101,99,97,116,101,100,32,105,110,32,102,97,118,111,114,32,
-    111,102,32,102,105,110,100,101,114,46,102,105,110,100,95,115,
-    112,101,99,40,41,46,10,10,32,32,32,32,78,122,44,78,
-    111,116,32,105,109,112,111,114,116,105,110,103,32,100,105,114,
-    101,99,116,111,114,121,32,123,125,58,32,109,105,115,115,105,
-    110,103,32,95,95,105,110,105,116,95,95,114,0,0,0,0,
-    41,6,218,11,102,105,110,100,95,108,111,97,100,101,114,114,
-    4,0,0,0,114,88,0,0,0,114,89,0,0,0,114,77,
-    0,0,0,218,13,73,109,112,111,114,116,87,97,114,110,105,
-    110,103,41,5,114,130,0,0,0,218,8,102,117,108,108,110,
-    97,109,101,218,6,108,111,97,100,101,114,218,8,112,111,114,
-    116,105,111,110,115,218,3,109,115,103,114,7,0,0,0,114,
-    7,0,0,0,114,8,0,0,0,218,17,95,102,105,110,100,
-    95,109,111,100,117,108,101,95,115,104,105,109,14,2,0,0,
-    115,12,0,0,0,14,10,16,1,4,1,22,1,4,1,255,
-    128,114,154,0,0,0,99,3,0,0,0,0,0,0,0,0,
-    0,0,0,6,0,0,0,4,0,0,0,67,0,0,0,115,
-    166,0,0,0,124,0,100,1,100,2,133,2,25,0,125,3,
-    124,3,116,0,107,3,114,64,100,3,124,1,155,2,100,4,
-    124,3,155,2,157,4,125,4,116,1,160,2,100,5,124,4,
-    161,2,1,0,116,3,124,4,102,1,105,0,124,2,164,1,
-    142,1,130,1,116,4,124,0,131,1,100,6,107,0,114,106,
-    100,7,124,1,155,2,157,2,125,4,116,1,160,2,100,5,
-    124,4,161,2,1,0,116,5,124,4,131,1,130,1,116,6,
-    124,0,100,2,100,8,133,2,25,0,131,1,125,5,124,5,
-    100,9,64,0,114,162,100,10,124,5,155,2,100,11,124,1,
-    155,2,157,4,125,4,116,3,124,4,102,1,105,0,124,2,
-    164,1,142,1,130,1,124,5,83,0,41,12,97,84,2,0,
-    0,80,101,114,102,111,114,109,32,98,97,115,105,99,32,118,
-    97,108,105,100,105,116,121,32,99,104,101,99,107,105,110,103,
-    32,111,102,32,97,32,112,121,99,32,104,101,97,100,101,114,
-    32,97,110,100,32,114,101,116,117,114,110,32,116,104,101,32,
-    102,108,97,103,115,32,102,105,101,108,100,44,10,32,32,32,
-    32,119,104,105,99,104,32,100,101,116,101,114,109,105,110,101,
-    115,32,104,111,119,32,116,104,101,32,112,121,99,32,115,104,
-    111,117,108,100,32,98,101,32,102,117,114,116,104,101,114,32,
-    118,97,108,105,100,97,116,101,100,32,97,103,97,105,110,115,
-    116,32,116,104,101,32,115,111,117,114,99,101,46,10,10,32,
-    32,32,32,42,100,97,116,97,42,32,105,115,32,116,104,101,
-    32,99,111,110,116,101,110,116,115,32,111,102,32,116,104,101,
-    32,112,121,99,32,102,105,108,101,46,32,40,79,110,108,121,
-    32,116,104,101,32,102,105,114,115,116,32,49,54,32,98,121,
-    116,101,115,32,97,114,101,10,32,32,32,32,114,101,113,117,
-    105,114,101,100,44,32,116,104,111,117,103,104,46,41,10,10,
-    32,32,32,32,42,110,97,109,101,42,32,105,115,32,116,104,
-    101,32,110,97,109,101,32,111,102,32,116,104,101,32,109,111,
-    100,117,108,101,32,98,101,105,110,103,32,105,109,112,111,114,
-    116,101,100,46,32,73,116,32,105,115,32,117,115,101,100,32,
-    102,111,114,32,108,111,103,103,105,110,103,46,10,10,32,32,
-    32,32,42,101,120,99,95,100,101,116,97,105,108,115,42,32,
-    105,115,32,97,32,100,105,99,116,105,111,110,97,114,121,32,
-    112,97,115,115,101,100,32,116,111,32,73,109,112,111,114,116,
-    69,114,114,111,114,32,105,102,32,105,116,32,114,97,105,115,
-    101,100,32,102,111,114,10,32,32,32,32,105,109,112,114,111,
-    118,101,100,32,100,101,98,117,103,103,105,110,103,46,10,10,
-    32,32,32,32,73,109,112,111,114,116,69,114,114,111,114,32,
-    105,115,32,114,97,105,115,101,100,32,119,104,101,110,32,116,
-    104,101,32,109,97,103,105,99,32,110,117,109,98,101,114,32,
-    105,115,32,105,110,99,111,114,114,101,99,116,32,111,114,32,
-    119,104,101,110,32,116,104,101,32,102,108,97,103,115,10,32,
-    32,32,32,102,105,101,108,100,32,105,115,32,105,110,118,97,
-    108,105,100,46,32,69,79,70,69,114,114,111,114,32,105,115,
-    32,114,97,105,115,101,100,32,119,104,101,110,32,116,104,101,
-    32,100,97,116,97,32,105,115,32,102,111,117,110,100,32,116,
-    111,32,98,101,32,116,114,117,110,99,97,116,101,100,46,10,
-    10,32,32,32,32,78,114,32,0,0,0,122,20,98,97,100,
-    32,109,97,103,105,99,32,110,117,109,98,101,114,32,105,110,
-    32,122,2,58,32,250,2,123,125,233,16,0,0,0,122,40,
-    114,101,97,99,104,101,100,32,69,79,70,32,119,104,105,108,
-    101,32,114,101,97,100,105,110,103,32,112,121,99,32,104,101,
-    97,100,101,114,32,111,102,32,233,8,0,0,0,233,252,255,
-    255,255,122,14,105,110,118,97,108,105,100,32,102,108,97,103,
-    115,32,122,4,32,105,110,32,41,7,218,12,77,65,71,73,
-    67,95,78,85,77,66,69,82,114,146,0,0,0,218,16,95,
-    118,101,114,98,111,115,101,95,109,101,115,115,97,103,101,114,
-    129,0,0,0,114,4,0,0,0,218,8,69,79,70,69,114,
-    114,111,114,114,43,0,0,0,41,6,114,42,0,0,0,114,
-    128,0,0,0,218,11,101,120,99,95,100,101,116,97,105,108,
-    115,90,5,109,97,103,105,99,114,105,0,0,0,114,17,0,
-    0,0,114,7,0,0,0,114,7,0,0,0,114,8,0,0,
-    0,218,13,95,99,108,97,115,115,105,102,121,95,112,121,99,
-    31,2,0,0,115,30,0,0,0,12,16,8,1,16,1,12,
-    1,16,1,12,1,10,1,12,1,8,1,16,1,8,2,16,
-    1,16,1,4,1,255,128,114,163,0,0,0,99,5,0,0,
-    0,0,0,0,0,0,0,0,0,6,0,0,0,4,0,0,
-    0,67,0,0,0,115,124,0,0,0,116,0,124,0,100,1,
-    100,2,133,2,25,0,131,1,124,1,100,3,64,0,107,3,
-    114,62,100,4,124,3,155,2,157,2,125,5,116,1,160,2,
-    100,5,124,5,161,2,1,0,116,3,124,5,102,1,105,0,
-    124,4,164,1,142,1,130,1,124,2,100,6,117,1,114,120,
-    116,0,124,0,100,2,100,7,133,2,25,0,131,1,124,2,
-    100,3,64,0,107,3,114,116,116,3,100,4,124,3,155,2,
-    157,2,102,1,105,0,124,4,164,1,142,1,130,1,100,6,
-    83,0,100,6,83,0,41,8,97,7,2,0,0,86,97,108,
-    105,100,97,116,101,32,97,32,112,121,99,32,97,103,97,105,
-    110,115,116,32,116,104,101,32,115,111,117,114,99,101,32,108,
-    97,115,116,45,109,111,100,105,102,105,101,100,32,116,105,109,
-    101,46,10,10,32,32,32,32,42,100,97,116,97,42,32,105,
-    115,32,116,104,101,32,99,111,110,116,101,110,116,115,32,111,
-    102,32,116,104,101,32,112,121,99,32,102,105,108,101,46,32,
-    40,79,110,108,121,32,116,104,101,32,102,105,114,115,116,32,
-    49,54,32,98,121,116,101,115,32,97,114,101,10,32,32,32,
-    32,114,101,113,117,105,114,101,100,46,41,10,10,32,32,32,
-    32,42,115,111,117,114,99,101,95,109,116,105,109,101,42,32,
-    105,115,32,116,104,101,32,108,97,115,116,32,109,111,100,105,
-    102,105,101,100,32,116,105,109,101,115,116,97,109,112,32,111,
-    102,32,116,104,101,32,115,111,117,114,99,101,32,102,105,108,
-    101,46,10,10,32,32,32,32,42,115,111,117,114,99,101,95,
-    115,105,122,101,42,32,105,115,32,78,111,110,101,32,111,114,
-    32,116,104,101,32,115,105,122,101,32,111,102,32,116,104,101,
-    32,115,111,117,114,99,101,32,102,105,108,101,32,105,110,32,
-    98,121,116,101,115,46,10,10,32,32,32,32,42,110,97,109,
-    101,42,32,105,115,32,116,104,101,32,110,97,109,101,32,111,
-    102,32,116,104,101,32,109,111,100,117,108,101,32,98,101,105,
-    110,103,32,105,109,112,111,114,116,101,100,46,32,73,116,32,
-    105,115,32,117,115,101,100,32,102,111,114,32,108,111,103,103,
-    105,110,103,46,10,10,32,32,32,32,42,101,120,99,95,100,
-    101,116,97,105,108,115,42,32,105,115,32,97,32,100,105,99,
-    116,105,111,110,97,114,121,32,112,97,115,115,101,100,32,116,
-    111,32,73,109,112,111,114,116,69,114,114,111,114,32,105,102,
-    32,105,116,32,114,97,105,115,101,100,32,102,111,114,10,32,
-    32,32,32,105,109,112,114,111,118,101,100,32,100,101,98,117,
-    103,103,105,110,103,46,10,10,32,32,32,32,65,110,32,73,
-    109,112,111,114,116,69,114,114,111,114,32,105,115,32,114,97,
-    105,115,101,100,32,105,102,32,116,104,101,32,98,121,116,101,
-    99,111,100,101,32,105,115,32,115,116,97,108,101,46,10,10,
-    32,32,32,32,114,157,0,0,0,233,12,0,0,0,114,31,
-    0,0,0,122,22,98,121,116,101,99,111,100,101,32,105,115,
-    32,115,116,97,108,101,32,102,111,114,32,114,155,0,0,0,
-    78,114,156,0,0,0,41,4,114,43,0,0,0,114,146,0,
-    0,0,114,160,0,0,0,114,129,0,0,0,41,6,114,42,
-    0,0,0,218,12,115,111,117,114,99,101,95,109,116,105,109,
-    101,218,11,115,111,117,114,99,101,95,115,105,122,101,114,128,
-    0,0,0,114,162,0,0,0,114,105,0,0,0,114,7,0,
-    0,0,114,7,0,0,0,114,8,0,0,0,218,23,95,118,
-    97,108,105,100,97,116,101,95,116,105,109,101,115,116,97,109,
-    112,95,112,121,99,64,2,0,0,115,20,0,0,0,24,19,
-    10,1,12,1,16,1,8,1,22,1,2,255,22,2,8,254,
-    255,128,114,167,0,0,0,99,4,0,0,0,0,0,0,0,
-    0,0,0,0,4,0,0,0,4,0,0,0,67,0,0,0,
-    115,42,0,0,0,124,0,100,1,100,2,133,2,25,0,124,
-    1,107,3,114,38,116,0,100,3,124,2,155,2,157,2,102,
-    1,105,0,124,3,164,1,142,1,130,1,100,4,83,0,41,
-    5,97,243,1,0,0,86,97,108,105,100,97,116,101,32,97,
-    32,104,97,115,104,45,98,97,115,101,100,32,112,121,99,32,
-    98,121,32,99,104,101,99,107,105,110,103,32,116,104,101,32,
-    114,101,97,108,32,115,111,117,114,99,101,32,104,97,115,104,
-    32,97,103,97,105,110,115,116,32,116,104,101,32,111,110,101,
-    32,105,110,10,32,32,32,32,116,104,101,32,112,121,99,32,
-    104,101,97,100,101,114,46,10,10,32,32,32,32,42,100,97,
-    116,97,42,32,105,115,32,116,104,101,32,99,111,110,116,101,
-    110,116,115,32,111,102,32,116,104,101,32,112,121,99,32,102,
-    105,108,101,46,32,40,79,110,108,121,32,116,104,101,32,102,
-    105,114,115,116,32,49,54,32,98,121,116,101,115,32,97,114,
-    101,10,32,32,32,32,114,101,113,117,105,114,101,100,46,41,
-    10,10,32,32,32,32,42,115,111,117,114,99,101,95,104,97,
-    115,104,42,32,105,115,32,116,104,101,32,105,109,112,111,114,
-    116,108,105,98,46,117,116,105,108,46,115,111,117,114,99,101,
-    95,104,97,115,104,40,41,32,111,102,32,116,104,101,32,115,
-    111,117,114,99,101,32,102,105,108,101,46,10,10,32,32,32,
-    32,42,110,97,109,101,42,32,105,115,32,116,104,101,32,110,
-    97,109,101,32,111,102,32,116,104,101,32,109,111,100,117,108,
-    101,32,98,101,105,110,103,32,105,109,112,111,114,116,101,100,
-    46,32,73,116,32,105,115,32,117,115,101,100,32,102,111,114,
-    32,108,111,103,103,105,110,103,46,10,10,32,32,32,32,42,
-    101,120,99,95,100,101,116,97,105,108,115,42,32,105,115,32,
-    97,32,100,105,99,116,105,111,110,97,114,121,32,112,97,115,
-    115,101,100,32,116,111,32,73,109,112,111,114,116,69,114,114,
-    111,114,32,105,102,32,105,116,32,114,97,105,115,101,100,32,
-    102,111,114,10,32,32,32,32,105,109,112,114,111,118,101,100,
-    32,100,101,98,117,103,103,105,110,103,46,10,10,32,32,32,
-    32,65,110,32,73,109,112,111,114,116,69,114,114,111,114,32,
-    105,115,32,114,97,105,115,101,100,32,105,102,32,116,104,101,
-    32,98,121,116,101,99,111,100,101,32,105,115,32,115,116,97,
-    108,101,46,10,10,32,32,32,32,114,157,0,0,0,114,156,
-    0,0,0,122,46,104,97,115,104,32,105,110,32,98,121,116,
-    101,99,111,100,101,32,100,111,101,115,110,39,116,32,109,97,
-    116,99,104,32,104,97,115,104,32,111,102,32,115,111,117,114,
-    99,101,32,78,41,1,114,129,0,0,0,41,4,114,42,0,
-    0,0,218,11,115,111,117,114,99,101,95,104,97,115,104,114,
-    128,0,0,0,114,162,0,0,0,114,7,0,0,0,114,7,
-    0,0,0,114,8,0,0,0,218,18,95,118,97,108,105,100,
-    97,116,101,95,104,97,115,104,95,112,121,99,92,2,0,0,
-    115,16,0,0,0,16,17,2,1,8,1,4,255,2,2,6,
-    254,4,255,255,128,114,169,0,0,0,99,4,0,0,0,0,
-    0,0,0,0,0,0,0,5,0,0,0,5,0,0,0,67,
-    0,0,0,115,76,0,0,0,116,0,160,1,124,0,161,1,
-    125,4,116,2,124,4,116,3,131,2,114,56,116,4,160,5,
-    100,1,124,2,161,2,1,0,124,3,100,2,117,1,114,52,
-    116,6,160,7,124,4,124,3,161,2,1,0,124,4,83,0,
-    116,8,100,3,160,9,124,2,161,1,124,1,124,2,100,4,
-    141,3,130,1,41,5,122,35,67,111,109,112,105,108,101,32,
-    98,121,116,101,99,111,100,101,32,97,115,32,102,111,117,110,
-    100,32,105,110,32,97,32,112,121,99,46,122,21,99,111,100,
-    101,32,111,98,106,101,99,116,32,102,114,111,109,32,123,33,
-    114,125,78,122,23,78,111,110,45,99,111,100,101,32,111,98,
-    106,101,99,116,32,105,110,32,123,33,114,125,169,2,114,128,
-    0,0,0,114,58,0,0,0,41,10,218,7,109,97,114,115,
-    104,97,108,90,5,108,111,97,100,115,218,10,105,115,105,110,
-    115,116,97,110,99,101,218,10,95,99,111,100,101,95,116,121,
-    112,101,114,146,0,0,0,114,160,0,0,0,218,4,95,105,
-    109,112,90,16,95,102,105,120,95,99,111,95,102,105,108,101,
-    110,97,109,101,114,129,0,0,0,114,77,0,0,0,41,5,
-    114,42,0,0,0,114,128,0,0,0,114,118,0,0,0,114,
-    119,0,0,0,218,4,99,111,100,101,114,7,0,0,0,114,
-    7,0,0,0,114,8,0,0,0,218,17,95,99,111,109,112,
-    105,108,101,95,98,121,116,101,99,111,100,101,116,2,0,0,
-    115,20,0,0,0,10,2,10,1,12,1,8,1,12,1,4,
-    1,10,2,4,1,6,255,255,128,114,176,0,0,0,99,3,
+    32,32,32,32,78,122,70,116,104,101,32,100,101,98,117,103,
+    95,111,118,101,114,114,105,100,101,32,112,97,114,97,109,101,
+    116,101,114,32,105,115,32,100,101,112,114,101,99,97,116,101,
+    100,59,32,117,115,101,32,39,111,112,116,105,109,105,122,97,
+    116,105,111,110,39,32,105,110,115,116,101,97,100,122,50,100,
+    101,98,117,103,95,111,118,101,114,114,105,100,101,32,111,114,
+    32,111,112,116,105,109,105,122,97,116,105,111,110,32,109,117,
+    115,116,32,98,101,32,115,101,116,32,116,111,32,78,111,110,
+    101,114,10,0,0,0,114,3,0,0,0,218,1,46,250,36,
+    115,121,115,46,105,109,112,108,101,109,101,110,116,97,116,105,
+    111,110,46,99,97,99,104,101,95,116,97,103,32,105,115,32,
+    78,111,110,101,114,0,0,0,0,122,24,123,33,114,125,32,
+    105,115,32,110,111,116,32,97,108,112,104,97,110,117,109,101,
+    114,105,99,122,7,123,125,46,123,125,123,125,114,11,0,0,
+    0,114,45,0,0,0,41,28,218,9,95,119,97,114,110,105,
+    110,103,115,218,4,119,97,114,110,218,18,68,101,112,114,101,
+    99,97,116,105,111,110,87,97,114,110,105,110,103,218,9,84,
+    121,112,101,69,114,114,111,114,114,19,0,0,0,218,6,102,
+    115,112,97,116,104,114,61,0,0,0,114,55,0,0,0,114,
+    16,0,0,0,218,14,105,109,112,108,101,109,101,110,116,97,
+    116,105,111,110,218,9,99,97,99,104,101,95,116,97,103,218,
+    19,78,111,116,73,109,112,108,101,109,101,110,116,101,100,69,
+    114,114,111,114,114,52,0,0,0,114,17,0,0,0,218,8,
+    111,112,116,105,109,105,122,101,218,3,115,116,114,218,7,105,
+    115,97,108,110,117,109,218,10,86,97,108,117,101,69,114,114,
+    111,114,114,77,0,0,0,218,4,95,79,80,84,218,17,66,
+    89,84,69,67,79,68,69,95,83,85,70,70,73,88,69,83,
+    218,14,112,121,99,97,99,104,101,95,112,114,101,102,105,120,
+    114,74,0,0,0,114,54,0,0,0,114,70,0,0,0,114,
+    48,0,0,0,218,6,108,115,116,114,105,112,218,8,95,80,
+    89,67,65,67,72,69,41,12,114,58,0,0,0,90,14,100,
+    101,98,117,103,95,111,118,101,114,114,105,100,101,114,85,0,
+    0,0,218,7,109,101,115,115,97,103,101,218,4,104,101,97,
+    100,114,60,0,0,0,90,4,98,97,115,101,114,6,0,0,
+    0,218,4,114,101,115,116,90,3,116,97,103,90,15,97,108,
+    109,111,115,116,95,102,105,108,101,110,97,109,101,218,8,102,
+    105,108,101,110,97,109,101,114,7,0,0,0,114,7,0,0,
+    0,114,8,0,0,0,218,17,99,97,99,104,101,95,102,114,
+    111,109,95,115,111,117,114,99,101,85,1,0,0,115,74,0,
+    0,0,8,18,6,1,2,1,4,255,8,2,4,1,8,1,
+    12,1,10,1,12,1,16,1,8,1,8,1,8,1,24,1,
+    8,1,12,1,6,1,8,2,8,1,8,1,8,1,14,1,
+    14,1,12,1,12,1,10,9,14,1,28,5,12,1,2,4,
+    4,1,8,1,2,1,4,253,12,5,255,128,114,109,0,0,
+    0,99,1,0,0,0,0,0,0,0,0,0,0,0,10,0,
+    0,0,5,0,0,0,67,0,0,0,115,44,1,0,0,116,
+    0,106,1,106,2,100,1,117,0,114,20,116,3,100,2,131,
+    1,130,1,116,4,160,5,124,0,161,1,125,0,116,6,124,
+    0,131,1,92,2,125,1,125,2,100,3,125,3,116,0,106,
+    7,100,1,117,1,114,102,116,0,106,7,160,8,116,9,161,
+    1,125,4,124,1,160,10,124,4,116,11,23,0,161,1,114,
+    102,124,1,116,12,124,4,131,1,100,1,133,2,25,0,125,
+    1,100,4,125,3,124,3,115,144,116,6,124,1,131,1,92,
+    2,125,1,125,5,124,5,116,13,107,3,114,144,116,14,116,
+    13,155,0,100,5,124,0,155,2,157,3,131,1,130,1,124,
+    2,160,15,100,6,161,1,125,6,124,6,100,7,118,1,114,
+    176,116,14,100,8,124,2,155,2,157,2,131,1,130,1,124,
+    6,100,9,107,2,144,1,114,12,124,2,160,16,100,6,100,
+    10,161,2,100,11,25,0,125,7,124,7,160,10,116,17,161,
+    1,115,226,116,14,100,12,116,17,155,2,157,2,131,1,130,
+    1,124,7,116,12,116,17,131,1,100,1,133,2,25,0,125,
+    8,124,8,160,18,161,0,144,1,115,12,116,14,100,13,124,
+    7,155,2,100,14,157,3,131,1,130,1,124,2,160,19,100,
+    6,161,1,100,15,25,0,125,9,116,20,124,1,124,9,116,
+    21,100,15,25,0,23,0,131,2,83,0,41,16,97,110,1,
+    0,0,71,105,118,101,110,32,116,104,101,32,112,97,116,104,
+    32,116,111,32,97,32,46,112,121,99,46,32,102,105,108,101,
+    44,32,114,101,116,117,114,110,32,116,104,101,32,112,97,116,
+    104,32,116,111,32,105,116,115,32,46,112,121,32,102,105,108,
+    101,46,10,10,32,32,32,32,84,104,101,32,46,112,121,99,
+    32,102,105,108,101,32,100,111,101,115,32,110,111,116,32,110,
+    101,101,100,32,116,111,32,101,120,105,115,116,59,32,116,104,
+    105,115,32,115,105,109,112,108,121,32,114,101,116,117,114,110,
+    115,32,116,104,101,32,112,97,116,104,32,116,111,10,32,32,
+    32,32,116,104,101,32,46,112,121,32,102,105,108,101,32,99,
+    97,108,99,117,108,97,116,101,100,32,116,111,32,99,111,114,
+    114,101,115,112,111,110,100,32,116,111,32,116,104,101,32,46,
+    112,121,99,32,102,105,108,101,46,32,32,73,102,32,112,97,
+    116,104,32,100,111,101,115,10,32,32,32,32,110,111,116,32,
+    99,111,110,102,111,114,109,32,116,111,32,80,69,80,32,51,
+    49,52,55,47,52,56,56,32,102,111,114,109,97,116,44,32,
+    86,97,108,117,101,69,114,114,111,114,32,119,105,108,108,32,
+    98,101,32,114,97,105,115,101,100,46,32,73,102,10,32,32,
+    32,32,115,121,115,46,105,109,112,108,101,109,101,110,116,97,
+    116,105,111,110,46,99,97,99,104,101,95,116,97,103,32,105,
+    115,32,78,111,110,101,32,116,104,101,110,32,78,111,116,73,
+    109,112,108,101,109,101,110,116,101,100,69,114,114,111,114,32,
+    105,115,32,114,97,105,115,101,100,46,10,10,32,32,32,32,
+    78,114,87,0,0,0,70,84,122,31,32,110,111,116,32,98,
+    111,116,116,111,109,45,108,101,118,101,108,32,100,105,114,101,
+    99,116,111,114,121,32,105,110,32,114,86,0,0,0,62,2,
+    0,0,0,114,45,0,0,0,114,72,0,0,0,122,29,101,
+    120,112,101,99,116,101,100,32,111,110,108,121,32,50,32,111,
+    114,32,51,32,100,111,116,115,32,105,110,32,114,72,0,0,
+    0,114,45,0,0,0,233,254,255,255,255,122,53,111,112,116,
+    105,109,105,122,97,116,105,111,110,32,112,111,114,116,105,111,
+    110,32,111,102,32,102,105,108,101,110,97,109,101,32,100,111,
+    101,115,32,110,111,116,32,115,116,97,114,116,32,119,105,116,
+    104,32,122,19,111,112,116,105,109,105,122,97,116,105,111,110,
+    32,108,101,118,101,108,32,122,29,32,105,115,32,110,111,116,
+    32,97,110,32,97,108,112,104,97,110,117,109,101,114,105,99,
+    32,118,97,108,117,101,114,0,0,0,0,41,22,114,16,0,
+    0,0,114,93,0,0,0,114,94,0,0,0,114,95,0,0,
+    0,114,19,0,0,0,114,92,0,0,0,114,61,0,0,0,
+    114,102,0,0,0,114,47,0,0,0,114,48,0,0,0,114,
+    27,0,0,0,114,51,0,0,0,114,4,0,0,0,114,104,
+    0,0,0,114,99,0,0,0,218,5,99,111,117,110,116,114,
+    57,0,0,0,114,100,0,0,0,114,98,0,0,0,218,9,
+    112,97,114,116,105,116,105,111,110,114,54,0,0,0,218,15,
+    83,79,85,82,67,69,95,83,85,70,70,73,88,69,83,41,
+    10,114,58,0,0,0,114,106,0,0,0,90,16,112,121,99,
+    97,99,104,101,95,102,105,108,101,110,97,109,101,90,23,102,
+    111,117,110,100,95,105,110,95,112,121,99,97,99,104,101,95,
+    112,114,101,102,105,120,90,13,115,116,114,105,112,112,101,100,
+    95,112,97,116,104,90,7,112,121,99,97,99,104,101,90,9,
+    100,111,116,95,99,111,117,110,116,114,85,0,0,0,90,9,
+    111,112,116,95,108,101,118,101,108,90,13,98,97,115,101,95,
+    102,105,108,101,110,97,109,101,114,7,0,0,0,114,7,0,
+    0,0,114,8,0,0,0,218,17,115,111,117,114,99,101,95,
+    102,114,111,109,95,99,97,99,104,101,156,1,0,0,115,62,
+    0,0,0,12,9,8,1,10,1,12,1,4,1,10,1,12,
+    1,14,1,16,1,4,1,4,1,12,1,8,1,8,1,2,
+    1,8,255,10,2,8,1,14,1,10,1,16,1,10,1,4,
+    1,2,1,8,255,16,2,10,1,16,1,14,2,18,1,255,
+    128,114,114,0,0,0,99,1,0,0,0,0,0,0,0,0,
+    0,0,0,5,0,0,0,9,0,0,0,67,0,0,0,115,
+    122,0,0,0,116,0,124,0,131,1,100,1,107,2,114,16,
+    100,2,83,0,124,0,160,1,100,3,161,1,92,3,125,1,
+    125,2,125,3,124,1,114,56,124,3,160,2,161,0,100,4,
+    100,5,133,2,25,0,100,6,107,3,114,60,124,0,83,0,
+    122,12,116,3,124,0,131,1,125,4,87,0,110,30,4,0,
+    116,4,116,5,102,2,121,120,1,0,1,0,1,0,124,0,
+    100,2,100,5,133,2,25,0,125,4,89,0,116,6,124,4,
+    131,1,114,116,124,4,83,0,124,0,83,0,119,0,41,7,
+    122,188,67,111,110,118,101,114,116,32,97,32,98,121,116,101,
+    99,111,100,101,32,102,105,108,101,32,112,97,116,104,32,116,
+    111,32,97,32,115,111,117,114,99,101,32,112,97,116,104,32,
+    40,105,102,32,112,111,115,115,105,98,108,101,41,46,10,10,
+    32,32,32,32,84,104,105,115,32,102,117,110,99,116,105,111,
+    110,32,101,120,105,115,116,115,32,112,117,114,101,108,121,32,
+    102,111,114,32,98,97,99,107,119,97,114,100,115,45,99,111,
+    109,112,97,116,105,98,105,108,105,116,121,32,102,111,114,10,
+    32,32,32,32,80,121,73,109,112,111,114,116,95,69,120,101,
+    99,67,111,100,101,77,111,100,117,108,101,87,105,116,104,70,
+    105,108,101,110,97,109,101,115,40,41,32,105,110,32,116,104,
+    101,32,67,32,65,80,73,46,10,10,32,32,32,32,114,0,
+    0,0,0,78,114,86,0,0,0,233,253,255,255,255,233,255,
+    255,255,255,90,2,112,121,41,7,114,4,0,0,0,114,55,
+    0,0,0,218,5,108,111,119,101,114,114,114,0,0,0,114,
+    95,0,0,0,114,99,0,0,0,114,68,0,0,0,41,5,
+    218,13,98,121,116,101,99,111,100,101,95,112,97,116,104,114,
+    107,0,0,0,114,59,0,0,0,90,9,101,120,116,101,110,
+    115,105,111,110,218,11,115,111,117,114,99,101,95,112,97,116,
+    104,114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,
+    218,15,95,103,101,116,95,115,111,117,114,99,101,102,105,108,
+    101,196,1,0,0,115,24,0,0,0,12,7,4,1,16,1,
+    24,1,4,1,2,1,12,1,16,1,14,1,16,1,2,254,
+    255,128,114,120,0,0,0,99,1,0,0,0,0,0,0,0,
+    0,0,0,0,1,0,0,0,8,0,0,0,67,0,0,0,
+    115,68,0,0,0,124,0,160,0,116,1,116,2,131,1,161,
+    1,114,44,122,10,116,3,124,0,131,1,87,0,83,0,4,
+    0,116,4,121,66,1,0,1,0,1,0,89,0,100,0,83,
+    0,124,0,160,0,116,1,116,5,131,1,161,1,114,62,124,
+    0,83,0,100,0,83,0,119,0,169,1,78,41,6,218,8,
+    101,110,100,115,119,105,116,104,218,5,116,117,112,108,101,114,
+    113,0,0,0,114,109,0,0,0,114,95,0,0,0,114,101,
+    0,0,0,41,1,114,108,0,0,0,114,7,0,0,0,114,
+    7,0,0,0,114,8,0,0,0,218,11,95,103,101,116,95,
+    99,97,99,104,101,100,215,1,0,0,115,20,0,0,0,14,
+    1,2,1,10,1,12,1,6,1,14,1,4,1,4,2,2,
+    251,255,128,114,124,0,0,0,99,1,0,0,0,0,0,0,
+    0,0,0,0,0,2,0,0,0,8,0,0,0,67,0,0,
+    0,115,48,0,0,0,122,14,116,0,124,0,131,1,106,1,
+    125,1,87,0,110,18,4,0,116,2,121,46,1,0,1,0,
+    1,0,100,1,125,1,89,0,124,1,100,2,79,0,125,1,
+    124,1,83,0,119,0,41,4,122,51,67,97,108,99,117,108,
+    97,116,101,32,116,104,101,32,109,111,100,101,32,112,101,114,
+    109,105,115,115,105,111,110,115,32,102,111,114,32,97,32,98,
+    121,116,101,99,111,100,101,32,102,105,108,101,46,114,75,0,
+    0,0,233,128,0,0,0,78,41,3,114,63,0,0,0,114,
+    65,0,0,0,114,64,0,0,0,41,2,114,58,0,0,0,
+    114,66,0,0,0,114,7,0,0,0,114,7,0,0,0,114,
+    8,0,0,0,218,10,95,99,97,108,99,95,109,111,100,101,
+    227,1,0,0,115,16,0,0,0,2,2,14,1,12,1,6,
+    1,8,3,4,1,2,251,255,128,114,126,0,0,0,99,1,
+    0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,4,
+    0,0,0,3,0,0,0,115,52,0,0,0,100,6,135,0,
+    102,1,100,2,100,3,132,9,125,1,116,0,100,1,117,1,
+    114,30,116,0,106,1,125,2,110,8,100,4,100,5,132,0,
+    125,2,124,2,124,1,136,0,131,2,1,0,124,1,83,0,
+    41,7,122,252,68,101,99,111,114,97,116,111,114,32,116,111,
+    32,118,101,114,105,102,121,32,116,104,97,116,32,116,104,101,
+    32,109,111,100,117,108,101,32,98,101,105,110,103,32,114,101,
+    113,117,101,115,116,101,100,32,109,97,116,99,104,101,115,32,
+    116,104,101,32,111,110,101,32,116,104,101,10,32,32,32,32,
+    108,111,97,100,101,114,32,99,97,110,32,104,97,110,100,108,
+    101,46,10,10,32,32,32,32,84,104,101,32,102,105,114,115,
+    116,32,97,114,103,117,109,101,110,116,32,40,115,101,108,102,
+    41,32,109,117,115,116,32,100,101,102,105,110,101,32,95,110,
+    97,109,101,32,119,104,105,99,104,32,116,104,101,32,115,101,
+    99,111,110,100,32,97,114,103,117,109,101,110,116,32,105,115,
+    10,32,32,32,32,99,111,109,112,97,114,101,100,32,97,103,
+    97,105,110,115,116,46,32,73,102,32,116,104,101,32,99,111,
+    109,112,97,114,105,115,111,110,32,102,97,105,108,115,32,116,
+    104,101,110,32,73,109,112,111,114,116,69,114,114,111,114,32,
+    105,115,32,114,97,105,115,101,100,46,10,10,32,32,32,32,
+    78,99,2,0,0,0,0,0,0,0,0,0,0,0,4,0,
+    0,0,4,0,0,0,31,0,0,0,115,72,0,0,0,124,
+    1,100,0,117,0,114,16,124,0,106,0,125,1,110,32,124,
+    0,106,0,124,1,107,3,114,48,116,1,100,1,124,0,106,
+    0,124,1,102,2,22,0,124,1,100,2,141,2,130,1,136,
+    0,124,0,124,1,103,2,124,2,162,1,82,0,105,0,124,
+    3,164,1,142,1,83,0,41,3,78,122,30,108,111,97,100,
+    101,114,32,102,111,114,32,37,115,32,99,97,110,110,111,116,
+    32,104,97,110,100,108,101,32,37,115,169,1,218,4,110,97,
+    109,101,41,2,114,128,0,0,0,218,11,73,109,112,111,114,
+    116,69,114,114,111,114,41,4,218,4,115,101,108,102,114,128,
+    0,0,0,218,4,97,114,103,115,218,6,107,119,97,114,103,
+    115,169,1,218,6,109,101,116,104,111,100,114,7,0,0,0,
+    114,8,0,0,0,218,19,95,99,104,101,99,107,95,110,97,
+    109,101,95,119,114,97,112,112,101,114,247,1,0,0,115,20,
+    0,0,0,8,1,8,1,10,1,4,1,8,1,2,255,2,
+    1,6,255,24,2,255,128,122,40,95,99,104,101,99,107,95,
+    110,97,109,101,46,60,108,111,99,97,108,115,62,46,95,99,
+    104,101,99,107,95,110,97,109,101,95,119,114,97,112,112,101,
+    114,99,2,0,0,0,0,0,0,0,0,0,0,0,3,0,
+    0,0,7,0,0,0,83,0,0,0,115,56,0,0,0,100,
+    1,68,0,93,32,125,2,116,0,124,1,124,2,131,2,114,
+    36,116,1,124,0,124,2,116,2,124,1,124,2,131,2,131,
+    3,1,0,113,4,124,0,106,3,160,4,124,1,106,3,161,
+    1,1,0,100,0,83,0,41,2,78,41,4,218,10,95,95,
+    109,111,100,117,108,101,95,95,218,8,95,95,110,97,109,101,
+    95,95,218,12,95,95,113,117,97,108,110,97,109,101,95,95,
+    218,7,95,95,100,111,99,95,95,41,5,218,7,104,97,115,
+    97,116,116,114,218,7,115,101,116,97,116,116,114,218,7,103,
+    101,116,97,116,116,114,218,8,95,95,100,105,99,116,95,95,
+    218,6,117,112,100,97,116,101,41,3,90,3,110,101,119,90,
+    3,111,108,100,114,82,0,0,0,114,7,0,0,0,114,7,
+    0,0,0,114,8,0,0,0,218,5,95,119,114,97,112,4,
+    2,0,0,115,12,0,0,0,8,1,10,1,18,1,2,128,
+    18,1,255,128,122,26,95,99,104,101,99,107,95,110,97,109,
+    101,46,60,108,111,99,97,108,115,62,46,95,119,114,97,112,
+    41,1,78,41,2,218,10,95,98,111,111,116,115,116,114,97,
+    112,114,145,0,0,0,41,3,114,134,0,0,0,114,135,0,
+    0,0,114,145,0,0,0,114,7,0,0,0,114,133,0,0,
+    0,114,8,0,0,0,218,11,95,99,104,101,99,107,95,110,
+    97,109,101,239,1,0,0,115,14,0,0,0,14,8,8,10,
+    8,1,8,2,10,6,4,1,255,128,114,147,0,0,0,99,
+    2,0,0,0,0,0,0,0,0,0,0,0,5,0,0,0,
+    6,0,0,0,67,0,0,0,115,60,0,0,0,124,0,160,
+    0,124,1,161,1,92,2,125,2,125,3,124,2,100,1,117,
+    0,114,56,116,1,124,3,131,1,114,56,100,2,125,4,116,
+    2,160,3,124,4,160,4,124,3,100,3,25,0,161,1,116,
+    5,161,2,1,0,124,2,83,0,41,4,122,155,84,114,121,
+    32,116,111,32,102,105,110,100,32,97,32,108,111,97,100,101,
+    114,32,102,111,114,32,116,104,101,32,115,112,101,99,105,102,
+    105,101,100,32,109,111,100,117,108,101,32,98,121,32,100,101,
+    108,101,103,97,116,105,110,103,32,116,111,10,32,32,32,32,
+    115,101,108,102,46,102,105,110,100,95,108,111,97,100,101,114,
+    40,41,46,10,10,32,32,32,32,84,104,105,115,32,109,101,
+    116,104,111,100,32,105,115,32,100,101,112,114,101,99,97,116,
+    101,100,32,105,110,32,102,97,118,111,114,32,111,102,32,102,
+    105,110,100,101,114,46,102,105,110,100,95,115,112,101,99,40,
+    41,46,10,10,32,32,32,32,78,122,44,78,111,116,32,105,
+    109,112,111,114,116,105,110,103,32,100,105,114,101,99,116,111,
+    114,121,32,123,125,58,32,109,105,115,115,105,110,103,32,95,
+    95,105,110,105,116,95,95,114,0,0,0,0,41,6,218,11,
+    102,105,110,100,95,108,111,97,100,101,114,114,4,0,0,0,
+    114,88,0,0,0,114,89,0,0,0,114,77,0,0,0,218,
+    13,73,109,112,111,114,116,87,97,114,110,105,110,103,41,5,
+    114,130,0,0,0,218,8,102,117,108,108,110,97,109,101,218,
+    6,108,111,97,100,101,114,218,8,112,111,114,116,105,111,110,
+    115,218,3,109,115,103,114,7,0,0,0,114,7,0,0,0,
+    114,8,0,0,0,218,17,95,102,105,110,100,95,109,111,100,
+    117,108,101,95,115,104,105,109,14,2,0,0,115,12,0,0,
+    0,14,10,16,1,4,1,22,1,4,1,255,128,114,154,0,
+    0,0,99,3,0,0,0,0,0,0,0,0,0,0,0,6,
+    0,0,0,4,0,0,0,67,0,0,0,115,166,0,0,0,
+    124,0,100,1,100,2,133,2,25,0,125,3,124,3,116,0,
+    107,3,114,64,100,3,124,1,155,2,100,4,124,3,155,2,
+    157,4,125,4,116,1,160,2,100,5,124,4,161,2,1,0,
+    116,3,124,4,102,1,105,0,124,2,164,1,142,1,130,1,
+    116,4,124,0,131,1,100,6,107,0,114,106,100,7,124,1,
+    155,2,157,2,125,4,116,1,160,2,100,5,124,4,161,2,
+    1,0,116,5,124,4,131,1,130,1,116,6,124,0,100,2,
+    100,8,133,2,25,0,131,1,125,5,124,5,100,9,64,0,
+    114,162,100,10,124,5,155,2,100,11,124,1,155,2,157,4,
+    125,4,116,3,124,4,102,1,105,0,124,2,164,1,142,1,
+    130,1,124,5,83,0,41,12,97,84,2,0,0,80,101,114,
+    102,111,114,109,32,98,97,115,105,99,32,118,97,108,105,100,
+    105,116,121,32,99,104,101,99,107,105,110,103,32,111,102,32,
+    97,32,112,121,99,32,104,101,97,100,101,114,32,97,110,100,
+    32,114,101,116,117,114,110,32,116,104,101,32,102,108,97,103,
+    115,32,102,105,101,108,100,44,10,32,32,32,32,119,104,105,
+    99,104,32,100,101,116,101,114,109,105,110,101,115,32,104,111,
+    119,32,116,104,101,32,112,121,99,32,115,104,111,117,108,100,
+    32,98,101,32,102,117,114,116,104,101,114,32,118,97,108,105,
+    100,97,116,101,100,32,97,103,97,105,110,115,116,32,116,104,
+    101,32,115,111,117,114,99,101,46,10,10,32,32,32,32,42,
+    100,97,116,97,42,32,105,115,32,116,104,101,32,99,111,110,
+    116,101,110,116,115,32,111,102,32,116,104,101,32,112,121,99,
+    32,102,105,108,101,46,32,40,79,110,108,121,32,116,104,101,
+    32,102,105,114,115,116,32,49,54,32,98,121,116,101,115,32,
+    97,114,101,10,32,32,32,32,114,101,113,117,105,114,101,100,
+    44,32,116,104,111,117,103,104,46,41,10,10,32,32,32,32,
+    42,110,97,109,101,42,32,105,115,32,116,104,101,32,110,97,
+    109,101,32,111,102,32,116,104,101,32,109,111,100,117,108,101,
+    32,98,101,105,110,103,32,105,109,112,111,114,116,101,100,46,
+    32,73,116,32,105,115,32,117,115,101,100,32,102,111,114,32,
+    108,111,103,103,105,110,103,46,10,10,32,32,32,32,42,101,
+    120,99,95,100,101,116,97,105,108,115,42,32,105,115,32,97,
+    32,100,105,99,116,105,111,110,97,114,121,32,112,97,115,115,
+    101,100,32,116,111,32,73,109,112,111,114,116,69,114,114,111,
+    114,32,105,102,32,105,116,32,114,97,105,115,101,100,32,102,
+    111,114,10,32,32,32,32,105,109,112,114,111,118,101,100,32,
+    100,101,98,117,103,103,105,110,103,46,10,10,32,32,32,32,
+    73,109,112,111,114,116,69,114,114,111,114,32,105,115,32,114,
+    97,105,115,101,100,32,119,104,101,110,32,116,104,101,32,109,
+    97,103,105,99,32,110,117,109,98,101,114,32,105,115,32,105,
+    110,99,111,114,114,101,99,116,32,111,114,32,119,104,101,110,
+    32,116,104,101,32,102,108,97,103,115,10,32,32,32,32,102,
+    105,101,108,100,32,105,115,32,105,110,118,97,108,105,100,46,
+    32,69,79,70,69,114,114,111,114,32,105,115,32,114,97,105,
+    115,101,100,32,119,104,101,110,32,116,104,101,32,100,97,116,
+    97,32,105,115,32,102,111,117,110,100,32,116,111,32,98,101,
+    32,116,114,117,110,99,97,116,101,100,46,10,10,32,32,32,
+    32,78,114,32,0,0,0,122,20,98,97,100,32,109,97,103,
+    105,99,32,110,117,109,98,101,114,32,105,110,32,122,2,58,
+    32,250,2,123,125,233,16,0,0,0,122,40,114,101,97,99,
+    104,101,100,32,69,79,70,32,119,104,105,108,101,32,114,101,
+    97,100,105,110,103,32,112,121,99,32,104,101,97,100,101,114,
+    32,111,102,32,233,8,0,0,0,233,252,255,255,255,122,14,
+    105,110,118,97,108,105,100,32,102,108,97,103,115,32,122,4,
+    32,105,110,32,41,7,218,12,77,65,71,73,67,95,78,85,
+    77,66,69,82,114,146,0,0,0,218,16,95,118,101,114,98,
+    111,115,101,95,109,101,115,115,97,103,101,114,129,0,0,0,
+    114,4,0,0,0,218,8,69,79,70,69,114,114,111,114,114,
+    43,0,0,0,41,6,114,42,0,0,0,114,128,0,0,0,
+    218,11,101,120,99,95,100,101,116,97,105,108,115,90,5,109,
+    97,103,105,99,114,105,0,0,0,114,17,0,0,0,114,7,
+    0,0,0,114,7,0,0,0,114,8,0,0,0,218,13,95,
+    99,108,97,115,115,105,102,121,95,112,121,99,31,2,0,0,
+    115,30,0,0,0,12,16,8,1,16,1,12,1,16,1,12,
+    1,10,1,12,1,8,1,16,1,8,2,16,1,16,1,4,
+    1,255,128,114,163,0,0,0,99,5,0,0,0,0,0,0,
+    0,0,0,0,0,6,0,0,0,4,0,0,0,67,0,0,
+    0,115,124,0,0,0,116,0,124,0,100,1,100,2,133,2,
+    25,0,131,1,124,1,100,3,64,0,107,3,114,62,100,4,
+    124,3,155,2,157,2,125,5,116,1,160,2,100,5,124,5,
+    161,2,1,0,116,3,124,5,102,1,105,0,124,4,164,1,
+    142,1,130,1,124,2,100,6,117,1,114,120,116,0,124,0,
+    100,2,100,7,133,2,25,0,131,1,124,2,100,3,64,0,
+    107,3,114,116,116,3,100,4,124,3,155,2,157,2,102,1,
+    105,0,124,4,164,1,142,1,130,1,100,6,83,0,100,6,
+    83,0,41,8,97,7,2,0,0,86,97,108,105,100,97,116,
+    101,32,97,32,112,121,99,32,97,103,97,105,110,115,116,32,
+    116,104,101,32,115,111,117,114,99,101,32,108,97,115,116,45,
+    109,111,100,105,102,105,101,100,32,116,105,109,101,46,10,10,
+    32,32,32,32,42,100,97,116,97,42,32,105,115,32,116,104,
+    101,32,99,111,110,116,101,110,116,115,32,111,102,32,116,104,
+    101,32,112,121,99,32,102,105,108,101,46,32,40,79,110,108,
+    121,32,116,104,101,32,102,105,114,115,116,32,49,54,32,98,
+    121,116,101,115,32,97,114,101,10,32,32,32,32,114,101,113,
+    117,105,114,101,100,46,41,10,10,32,32,32,32,42,115,111,
+    117,114,99,101,95,109,116,105,109,101,42,32,105,115,32,116,
+    104,101,32,108,97,115,116,32,109,111,100,105,102,105,101,100,
+    32,116,105,109,101,115,116,97,109,112,32,111,102,32,116,104,
+    101,32,115,111,117,114,99,101,32,102,105,108,101,46,10,10,
+    32,32,32,32,42,115,111,117,114,99,101,95,115,105,122,101,
+    42,32,105,115,32,78,111,110,101,32,111,114,32,116,104,101,
+    32,115,105,122,101,32,111,102,32,116,104,101,32,115,111,117,
+    114,99,101,32,102,105,108,101,32,105,110,32,98,121,116,101,
+    115,46,10,10,32,32,32,32,42,110,97,109,101,42,32,105,
+    115,32,116,104,101,32,110,97,109,101,32,111,102,32,116,104,
+    101,32,109,111,100,117,108,101,32,98,101,105,110,103,32,105,
+    109,112,111,114,116,101,100,46,32,73,116,32,105,115,32,117,
+    115,101,100,32,102,111,114,32,108,111,103,103,105,110,103,46,
+    10,10,32,32,32,32,42,101,120,99,95,100,101,116,97,105,
+    108,115,42,32,105,115,32,97,32,100,105,99,116,105,111,110,
+    97,114,121,32,112,97,115,115,101,100,32,116,111,32,73,109,
+    112,111,114,116,69,114,114,111,114,32,105,102,32,105,116,32,
+    114,97,105,115,101,100,32,102,111,114,10,32,32,32,32,105,
+    109,112,114,111,118,101,100,32,100,101,98,117,103,103,105,110,
+    103,46,10,10,32,32,32,32,65,110,32,73,109,112,111,114,
+    116,69,114,114,111,114,32,105,115,32,114,97,105,115,101,100,
+    32,105,102,32,116,104,101,32,98,121,116,101,99,111,100,101,
+    32,105,115,32,115,116,97,108,101,46,10,10,32,32,32,32,
+    114,157,0,0,0,233,12,0,0,0,114,31,0,0,0,122,
+    22,98,121,116,101,99,111,100,101,32,105,115,32,115,116,97,
+    108,101,32,102,111,114,32,114,155,0,0,0,78,114,156,0,
+    0,0,41,4,114,43,0,0,0,114,146,0,0,0,114,160,
+    0,0,0,114,129,0,0,0,41,6,114,42,0,0,0,218,
+    12,115,111,117,114,99,101,95,109,116,105,109,101,218,11,115,
+    111,117,114,99,101,95,115,105,122,101,114,128,0,0,0,114,
+    162,0,0,0,114,105,0,0,0,114,7,0,0,0,114,7,
+    0,0,0,114,8,0,0,0,218,23,95,118,97,108,105,100,
+    97,116,101,95,116,105,109,101,115,116,97,109,112,95,112,121,
+    99,64,2,0,0,115,20,0,0,0,24,19,10,1,12,1,
+    16,1,8,1,22,1,2,255,22,2,8,254,255,128,114,167,
+    0,0,0,99,4,0,0,0,0,0,0,0,0,0,0,0,
+    4,0,0,0,4,0,0,0,67,0,0,0,115,42,0,0,
+    0,124,0,100,1,100,2,133,2,25,0,124,1,107,3,114,
+    38,116,0,100,3,124,2,155,2,157,2,102,1,105,0,124,
+    3,164,1,142,1,130,1,100,4,83,0,41,5,97,243,1,
+    0,0,86,97,108,105,100,97,116,101,32,97,32,104,97,115,
+    104,45,98,97,115,101,100,32,112,121,99,32,98,121,32,99,
+    104,101,99,107,105,110,103,32,116,104,101,32,114,101,97,108,
+    32,115,111,117,114,99,101,32,104,97,115,104,32,97,103,97,
+    105,110,115,116,32,116,104,101,32,111,110,101,32,105,110,10,
+    32,32,32,32,116,104,101,32,112,121,99,32,104,101,97,100,
+    101,114,46,10,10,32,32,32,32,42,100,97,116,97,42,32,
+    105,115,32,116,104,101,32,99,111,110,116,101,110,116,115,32,
+    111,102,32,116,104,101,32,112,121,99,32,102,105,108,101,46,
+    32,40,79,110,108,121,32,116,104,101,32,102,105,114,115,116,
+    32,49,54,32,98,121,116,101,115,32,97,114,101,10,32,32,
+    32,32,114,101,113,117,105,114,101,100,46,41,10,10,32,32,
+    32,32,42,115,111,117,114,99,101,95,104,97,115,104,42,32,
+    105,115,32,116,104,101,32,105,109,112,111,114,116,108,105,98,
+    46,117,116,105,108,46,115,111,117,114,99,101,95,104,97,115,
+    104,40,41,32,111,102,32,116,104,101,32,115,111,117,114,99,
+    101,32,102,105,108,101,46,10,10,32,32,32,32,42,110,97,
+    109,101,42,32,105,115,32,116,104,101,32,110,97,109,101,32,
+    111,102,32,116,104,101,32,109,111,100,117,108,101,32,98,101,
+    105,110,103,32,105,109,112,111,114,116,101,100,46,32,73,116,
+    32,105,115,32,117,115,101,100,32,102,111,114,32,108,111,103,
+    103,105,110,103,46,10,10,32,32,32,32,42,101,120,99,95,
+    100,101,116,97,105,108,115,42,32,105,115,32,97,32,100,105,
+    99,116,105,111,110,97,114,121,32,112,97,115,115,101,100,32,
+    116,111,32,73,109,112,111,114,116,69,114,114,111,114,32,105,
+    102,32,105,116,32,114,97,105,115,101,100,32,102,111,114,10,
+    32,32,32,32,105,109,112,114,111,118,101,100,32,100,101,98,
+    117,103,103,105,110,103,46,10,10,32,32,32,32,65,110,32,
+    73,109,112,111,114,116,69,114,114,111,114,32,105,115,32,114,
+    97,105,115,101,100,32,105,102,32,116,104,101,32,98,121,116,
+    101,99,111,100,101,32,105,115,32,115,116,97,108,101,46,10,
+    10,32,32,32,32,114,157,0,0,0,114,156,0,0,0,122,
+    46,104,97,115,104,32,105,110,32,98,121,116,101,99,111,100,
+    101,32,100,111,101,115,110,39,116,32,109,97,116,99,104,32,
+    104,97,115,104,32,111,102,32,115,111,117,114,99,101,32,78,
+    41,1,114,129,0,0,0,41,4,114,42,0,0,0,218,11,
+    115,111,117,114,99,101,95,104,97,115,104,114,128,0,0,0,
+    114,162,0,0,0,114,7,0,0,0,114,7,0,0,0,114,
+    8,0,0,0,218,18,95,118,97,108,105,100,97,116,101,95,
+    104,97,115,104,95,112,121,99,92,2,0,0,115,16,0,0,
+    0,16,17,2,1,8,1,4,255,2,2,6,254,4,255,255,
+    128,114,169,0,0,0,99,4,0,0,0,0,0,0,0,0,
+    0,0,0,5,0,0,0,5,0,0,0,67,0,0,0,115,
+    76,0,0,0,116,0,160,1,124,0,161,1,125,4,116,2,
+    124,4,116,3,131,2,114,56,116,4,160,5,100,1,124,2,
+    161,2,1,0,124,3,100,2,117,1,114,52,116,6,160,7,
+    124,4,124,3,161,2,1,0,124,4,83,0,116,8,100,3,
+    160,9,124,2,161,1,124,1,124,2,100,4,141,3,130,1,
+    41,5,122,35,67,111,109,112,105,108,101,32,98,121,116,101,
+    99,111,100,101,32,97,115,32,102,111,117,110,100,32,105,110,
+    32,97,32,112,121,99,46,122,21,99,111,100,101,32,111,98,
+    106,101,99,116,32,102,114,111,109,32,123,33,114,125,78,122,
+    23,78,111,110,45,99,111,100,101,32,111,98,106,101,99,116,
+    32,105,110,32,123,33,114,125,169,2,114,128,0,0,0,114,
+    58,0,0,0,41,10,218,7,109,97,114,115,104,97,108,90,
+    5,108,111,97,100,115,218,10,105,115,105,110,115,116,97,110,
+    99,101,218,10,95,99,111,100,101,95,116,121,112,101,114,146,
+    0,0,0,114,160,0,0,0,218,4,95,105,109,112,90,16,
+    95,102,105,120,95,99,111,95,102,105,108,101,110,97,109,101,
+    114,129,0,0,0,114,77,0,0,0,41,5,114,42,0,0,
+    0,114,128,0,0,0,114,118,0,0,0,114,119,0,0,0,
+    218,4,99,111,100,101,114,7,0,0,0,114,7,0,0,0,
+    114,8,0,0,0,218,17,95,99,111,109,112,105,108,101,95,
+    98,121,116,101,99,111,100,101,116,2,0,0,115,20,0,0,
+    0,10,2,10,1,12,1,8,1,12,1,4,1,10,2,4,
+    1,6,255,255,128,114,176,0,0,0,99,3,0,0,0,0,
+    0,0,0,0,0,0,0,9,0,0,0,11,0,0,0,67,
+    0,0,0,115,226,0,0,0,122,62,116,0,124,1,131,1,
+    125,3,116,1,160,2,124,2,161,1,143,24,125,4,124,4,
+    160,3,161,0,125,5,87,0,100,1,4,0,4,0,131,3,
+    1,0,110,16,49,0,115,50,119,1,1,0,1,0,1,0,
+    89,0,1,0,87,0,110,18,4,0,116,4,121,224,1,0,
+    1,0,1,0,89,0,100,2,83,0,124,0,124,2,100,3,
+    156,2,125,6,122,82,116,5,124,5,124,0,124,6,131,3,
+    100,4,107,3,114,116,87,0,100,2,83,0,116,6,124,3,
+    106,7,131,1,125,7,116,8,124,5,124,7,124,3,106,9,
+    124,0,124,6,131,5,1,0,116,10,116,11,124,5,131,1,
+    100,5,100,1,133,2,25,0,124,0,124,2,124,1,100,6,
+    141,4,125,8,87,0,110,26,4,0,116,12,116,13,116,14,
+    116,15,102,4,121,222,1,0,1,0,1,0,89,0,100,2,
+    83,0,124,7,124,3,106,9,124,8,102,3,116,16,124,2,
+    60,0,100,7,83,0,119,0,119,0,41,8,122,198,76,111,
+    97,100,32,97,32,116,105,109,101,115,116,97,109,112,45,98,
+    97,115,101,100,32,112,121,99,32,97,110,100,32,107,101,101,
+    112,32,105,116,115,32,99,111,100,101,32,111,98,106,101,99,
+    116,32,102,111,114,32,83,111,117,114,99,101,76,111,97,100,
+    101,114,46,10,10,32,32,32,32,82,101,116,117,114,110,32,
+    84,114,117,101,32,105,102,32,116,104,101,32,98,121,116,101,
+    99,111,100,101,32,119,97,115,32,117,112,32,116,111,32,100,
+    97,116,101,32,97,110,100,32,99,111,117,108,100,32,98,101,
+    32,108,111,97,100,101,100,46,32,32,69,114,114,111,114,115,
+    10,32,32,32,32,97,114,101,32,108,101,102,116,32,102,111,
+    114,32,116,104,101,32,105,109,112,111,114,116,32,105,116,115,
+    101,108,102,32,116,111,32,114,101,112,111,114,116,46,10,10,
+    32,32,32,32,78,70,114,170,0,0,0,114,0,0,0,0,
+    114,156,0,0,0,169,3,114,128,0,0,0,114,118,0,0,
+    0,114,119,0,0,0,84,41,17,114,63,0,0,0,114,79,
+    0,0,0,218,9,111,112,101,110,95,99,111,100,101,218,4,
+    114,101,97,100,114,64,0,0,0,114,163,0,0,0,114,34,
+    0,0,0,218,8,115,116,95,109,116,105,109,101,114,167,0,
+    0,0,218,7,115,116,95,115,105,122,101,114,176,0,0,0,
+    218,10,109,101,109,111,114,121,118,105,101,119,114,129,0,0,
+    0,114,161,0,0,0,114,99,0,0,0,114,91,0,0,0,
+    218,14,95,112,114,101,112,97,114,101,100,95,99,111,100,101,
+    41,9,114,128,0,0,0,114,119,0,0,0,114,118,0,0,
+    0,218,2,115,116,114,83,0,0,0,114,42,0,0,0,114,
+    162,0,0,0,114,165,0,0,0,114,175,0,0,0,114,7,
+    0,0,0,114,7,0,0,0,114,8,0,0,0,218,13,95,
+    112,114,101,112,97,114,101,95,99,111,100,101,134,2,0,0,
+    115,52,0,0,0,2,7,8,1,12,1,22,1,20,128,12,
+    1,6,1,10,1,2,1,16,2,6,1,10,1,12,1,2,
+    1,4,255,18,2,2,1,2,1,10,254,20,3,6,1,16,
+    1,4,1,2,253,2,243,255,128,114,185,0,0,0,99,3,
     0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,5,
     0,0,0,67,0,0,0,115,70,0,0,0,116,0,116,1,
     131,1,125,3,124,3,160,2,116,3,100,1,131,1,161,1,
@@ -877,8 +925,8 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     114,166,0,0,0,114,42,0,0,0,114,7,0,0,0,114,
     7,0,0,0,114,8,0,0,0,218,22,95,99,111,100,101,
     95,116,111,95,116,105,109,101,115,116,97,109,112,95,112,121,
-    99,129,2,0,0,115,14,0,0,0,8,2,14,1,14,1,
-    14,1,16,1,4,1,255,128,114,181,0,0,0,84,99,3,
+    99,164,2,0,0,115,14,0,0,0,8,2,14,1,14,1,
+    14,1,16,1,4,1,255,128,114,190,0,0,0,84,99,3,
     0,0,0,0,0,0,0,0,0,0,0,5,0,0,0,5,
     0,0,0,67,0,0,0,115,80,0,0,0,116,0,116,1,
     131,1,125,3,100,1,124,2,100,1,62,0,66,0,125,4,
@@ -889,15 +937,15 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     80,114,111,100,117,99,101,32,116,104,101,32,100,97,116,97,
     32,102,111,114,32,97,32,104,97,115,104,45,98,97,115,101,
     100,32,112,121,99,46,114,3,0,0,0,114,157,0,0,0,
-    78,41,7,114,177,0,0,0,114,159,0,0,0,114,178,0,
+    78,41,7,114,186,0,0,0,114,159,0,0,0,114,187,0,
     0,0,114,37,0,0,0,114,4,0,0,0,114,171,0,0,
-    0,114,179,0,0,0,41,5,114,175,0,0,0,114,168,0,
+    0,114,188,0,0,0,41,5,114,175,0,0,0,114,168,0,
     0,0,90,7,99,104,101,99,107,101,100,114,42,0,0,0,
     114,17,0,0,0,114,7,0,0,0,114,7,0,0,0,114,
     8,0,0,0,218,17,95,99,111,100,101,95,116,111,95,104,
-    97,115,104,95,112,121,99,139,2,0,0,115,16,0,0,0,
+    97,115,104,95,112,121,99,174,2,0,0,115,16,0,0,0,
     8,2,12,1,14,1,16,1,10,1,16,1,4,1,255,128,
-    114,182,0,0,0,99,1,0,0,0,0,0,0,0,0,0,
+    114,191,0,0,0,99,1,0,0,0,0,0,0,0,0,0,
     0,0,5,0,0,0,6,0,0,0,67,0,0,0,115,62,
     0,0,0,100,1,100,2,108,0,125,1,116,1,160,2,124,
     0,161,1,106,3,125,2,124,1,160,4,124,2,161,1,125,
@@ -917,14 +965,14 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     116,95,101,110,99,111,100,105,110,103,90,25,73,110,99,114,
     101,109,101,110,116,97,108,78,101,119,108,105,110,101,68,101,
     99,111,100,101,114,218,6,100,101,99,111,100,101,41,5,218,
-    12,115,111,117,114,99,101,95,98,121,116,101,115,114,183,0,
+    12,115,111,117,114,99,101,95,98,121,116,101,115,114,192,0,
     0,0,90,21,115,111,117,114,99,101,95,98,121,116,101,115,
     95,114,101,97,100,108,105,110,101,218,8,101,110,99,111,100,
     105,110,103,90,15,110,101,119,108,105,110,101,95,100,101,99,
     111,100,101,114,114,7,0,0,0,114,7,0,0,0,114,8,
     0,0,0,218,13,100,101,99,111,100,101,95,115,111,117,114,
-    99,101,150,2,0,0,115,12,0,0,0,8,5,12,1,10,
-    1,12,1,20,1,255,128,114,187,0,0,0,169,2,114,151,
+    99,101,185,2,0,0,115,12,0,0,0,8,5,12,1,10,
+    1,12,1,20,1,255,128,114,196,0,0,0,169,2,114,151,
     0,0,0,218,26,115,117,98,109,111,100,117,108,101,95,115,
     101,97,114,99,104,95,108,111,99,97,116,105,111,110,115,99,
     2,0,0,0,0,0,0,0,2,0,0,0,9,0,0,0,
@@ -969,28 +1017,28 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     32,78,122,9,60,117,110,107,110,111,119,110,62,218,12,103,
     101,116,95,102,105,108,101,110,97,109,101,169,1,218,6,111,
     114,105,103,105,110,84,218,10,105,115,95,112,97,99,107,97,
-    103,101,114,0,0,0,0,41,17,114,140,0,0,0,114,190,
+    103,101,114,0,0,0,0,41,17,114,140,0,0,0,114,199,
     0,0,0,114,129,0,0,0,114,19,0,0,0,114,92,0,
     0,0,114,146,0,0,0,218,10,77,111,100,117,108,101,83,
     112,101,99,90,13,95,115,101,116,95,102,105,108,101,97,116,
     116,114,218,27,95,103,101,116,95,115,117,112,112,111,114,116,
     101,100,95,102,105,108,101,95,108,111,97,100,101,114,115,114,
     122,0,0,0,114,123,0,0,0,114,151,0,0,0,218,9,
-    95,80,79,80,85,76,65,84,69,114,193,0,0,0,114,189,
+    95,80,79,80,85,76,65,84,69,114,202,0,0,0,114,198,
     0,0,0,114,61,0,0,0,218,6,97,112,112,101,110,100,
     41,9,114,128,0,0,0,90,8,108,111,99,97,116,105,111,
-    110,114,151,0,0,0,114,189,0,0,0,218,4,115,112,101,
+    110,114,151,0,0,0,114,198,0,0,0,218,4,115,112,101,
     99,218,12,108,111,97,100,101,114,95,99,108,97,115,115,218,
-    8,115,117,102,102,105,120,101,115,114,193,0,0,0,90,7,
+    8,115,117,102,102,105,120,101,115,114,202,0,0,0,90,7,
     100,105,114,110,97,109,101,114,7,0,0,0,114,7,0,0,
     0,114,8,0,0,0,218,23,115,112,101,99,95,102,114,111,
-    109,95,102,105,108,101,95,108,111,99,97,116,105,111,110,167,
+    109,95,102,105,108,101,95,108,111,99,97,116,105,111,110,202,
     2,0,0,115,74,0,0,0,8,12,4,4,10,1,2,2,
     14,1,14,1,4,1,2,251,10,7,16,8,6,1,8,3,
     14,1,14,1,10,1,6,1,4,1,2,253,4,5,8,3,
     10,2,2,1,14,1,14,1,4,1,4,2,6,1,2,128,
     6,2,12,1,6,1,12,1,12,1,4,2,2,244,2,226,
-    255,128,114,201,0,0,0,99,0,0,0,0,0,0,0,0,
+    255,128,114,210,0,0,0,99,0,0,0,0,0,0,0,0,
     0,0,0,0,0,0,0,0,4,0,0,0,64,0,0,0,
     115,88,0,0,0,101,0,90,1,100,0,90,2,100,1,90,
     3,100,2,90,4,100,3,90,5,101,6,111,30,100,4,101,
@@ -1023,7 +1071,7 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     72,75,69,89,95,76,79,67,65,76,95,77,65,67,72,73,
     78,69,114,20,0,0,0,114,7,0,0,0,114,7,0,0,
     0,114,8,0,0,0,218,14,95,111,112,101,110,95,114,101,
-    103,105,115,116,114,121,247,2,0,0,115,12,0,0,0,2,
+    103,105,115,116,114,121,26,3,0,0,115,12,0,0,0,2,
     2,16,1,12,1,18,1,2,255,255,128,122,36,87,105,110,
     100,111,119,115,82,101,103,105,115,116,114,121,70,105,110,100,
     101,114,46,95,111,112,101,110,95,114,101,103,105,115,116,114,
@@ -1044,13 +1092,13 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     82,89,95,75,69,89,95,68,69,66,85,71,218,12,82,69,
     71,73,83,84,82,89,95,75,69,89,114,77,0,0,0,114,
     16,0,0,0,218,12,118,101,114,115,105,111,110,95,105,110,
-    102,111,114,204,0,0,0,114,203,0,0,0,90,10,81,117,
+    102,111,114,213,0,0,0,114,212,0,0,0,90,10,81,117,
     101,114,121,86,97,108,117,101,114,64,0,0,0,41,6,218,
     3,99,108,115,114,150,0,0,0,90,12,114,101,103,105,115,
     116,114,121,95,107,101,121,114,21,0,0,0,90,4,104,107,
     101,121,218,8,102,105,108,101,112,97,116,104,114,7,0,0,
     0,114,7,0,0,0,114,8,0,0,0,218,16,95,115,101,
-    97,114,99,104,95,114,101,103,105,115,116,114,121,254,2,0,
+    97,114,99,104,95,114,101,103,105,115,116,114,121,33,3,0,
     0,115,30,0,0,0,6,2,8,1,6,2,6,1,16,1,
     6,255,2,2,12,1,26,1,18,128,4,3,12,254,6,1,
     2,255,255,128,122,38,87,105,110,100,111,119,115,82,101,103,
@@ -1065,15 +1113,15 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     4,160,4,116,5,124,6,131,1,161,1,114,112,116,6,106,
     7,124,1,124,5,124,1,124,4,131,2,124,4,100,1,141,
     3,125,7,124,7,2,0,1,0,83,0,113,60,100,0,83,
-    0,119,0,41,2,78,114,191,0,0,0,41,8,114,211,0,
-    0,0,114,63,0,0,0,114,64,0,0,0,114,195,0,0,
+    0,119,0,41,2,78,114,200,0,0,0,41,8,114,220,0,
+    0,0,114,63,0,0,0,114,64,0,0,0,114,204,0,0,
     0,114,122,0,0,0,114,123,0,0,0,114,146,0,0,0,
     218,16,115,112,101,99,95,102,114,111,109,95,108,111,97,100,
-    101,114,41,8,114,209,0,0,0,114,150,0,0,0,114,58,
-    0,0,0,218,6,116,97,114,103,101,116,114,210,0,0,0,
-    114,151,0,0,0,114,200,0,0,0,114,198,0,0,0,114,
+    101,114,41,8,114,218,0,0,0,114,150,0,0,0,114,58,
+    0,0,0,218,6,116,97,114,103,101,116,114,219,0,0,0,
+    114,151,0,0,0,114,209,0,0,0,114,207,0,0,0,114,
     7,0,0,0,114,7,0,0,0,114,8,0,0,0,218,9,
-    102,105,110,100,95,115,112,101,99,13,3,0,0,115,36,0,
+    102,105,110,100,95,115,112,101,99,48,3,0,0,115,36,0,
     0,0,10,2,8,1,4,1,2,1,12,1,12,1,6,1,
     14,1,14,1,6,1,8,1,2,1,6,254,8,3,2,252,
     4,255,2,254,255,128,122,31,87,105,110,100,111,119,115,82,
@@ -1089,26 +1137,26 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     115,32,100,101,112,114,101,99,97,116,101,100,46,32,32,85,
     115,101,32,101,120,101,99,95,109,111,100,117,108,101,40,41,
     32,105,110,115,116,101,97,100,46,10,10,32,32,32,32,32,
-    32,32,32,78,169,2,114,214,0,0,0,114,151,0,0,0,
-    169,4,114,209,0,0,0,114,150,0,0,0,114,58,0,0,
-    0,114,198,0,0,0,114,7,0,0,0,114,7,0,0,0,
+    32,32,32,78,169,2,114,223,0,0,0,114,151,0,0,0,
+    169,4,114,218,0,0,0,114,150,0,0,0,114,58,0,0,
+    0,114,207,0,0,0,114,7,0,0,0,114,7,0,0,0,
     114,8,0,0,0,218,11,102,105,110,100,95,109,111,100,117,
-    108,101,29,3,0,0,115,10,0,0,0,12,7,8,1,6,
+    108,101,64,3,0,0,115,10,0,0,0,12,7,8,1,6,
     1,4,2,255,128,122,33,87,105,110,100,111,119,115,82,101,
     103,105,115,116,114,121,70,105,110,100,101,114,46,102,105,110,
     100,95,109,111,100,117,108,101,41,2,78,78,41,1,78,41,
     15,114,137,0,0,0,114,136,0,0,0,114,138,0,0,0,
-    114,139,0,0,0,114,207,0,0,0,114,206,0,0,0,218,
+    114,139,0,0,0,114,216,0,0,0,114,215,0,0,0,218,
     11,95,77,83,95,87,73,78,68,79,87,83,218,18,69,88,
     84,69,78,83,73,79,78,95,83,85,70,70,73,88,69,83,
-    114,205,0,0,0,218,12,115,116,97,116,105,99,109,101,116,
-    104,111,100,114,204,0,0,0,218,11,99,108,97,115,115,109,
-    101,116,104,111,100,114,211,0,0,0,114,214,0,0,0,114,
-    217,0,0,0,114,7,0,0,0,114,7,0,0,0,114,7,
-    0,0,0,114,8,0,0,0,114,202,0,0,0,235,2,0,
+    114,214,0,0,0,218,12,115,116,97,116,105,99,109,101,116,
+    104,111,100,114,213,0,0,0,218,11,99,108,97,115,115,109,
+    101,116,104,111,100,114,220,0,0,0,114,223,0,0,0,114,
+    226,0,0,0,114,7,0,0,0,114,7,0,0,0,114,7,
+    0,0,0,114,8,0,0,0,114,211,0,0,0,14,3,0,
     0,115,32,0,0,0,8,0,4,2,2,3,2,255,2,4,
     2,255,12,3,2,2,10,1,2,6,10,1,2,14,12,1,
-    2,15,16,1,255,128,114,202,0,0,0,99,0,0,0,0,
+    2,15,16,1,255,128,114,211,0,0,0,99,0,0,0,0,
     0,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,
     64,0,0,0,115,48,0,0,0,101,0,90,1,100,0,90,
     2,100,1,90,3,100,2,100,3,132,0,90,4,100,4,100,
@@ -1137,12 +1185,12 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     39,95,95,105,110,105,116,95,95,46,112,121,39,46,114,3,
     0,0,0,114,86,0,0,0,114,0,0,0,0,114,45,0,
     0,0,218,8,95,95,105,110,105,116,95,95,78,41,4,114,
-    61,0,0,0,114,190,0,0,0,114,57,0,0,0,114,55,
+    61,0,0,0,114,199,0,0,0,114,57,0,0,0,114,55,
     0,0,0,41,5,114,130,0,0,0,114,150,0,0,0,114,
     108,0,0,0,90,13,102,105,108,101,110,97,109,101,95,98,
     97,115,101,90,9,116,97,105,108,95,110,97,109,101,114,7,
-    0,0,0,114,7,0,0,0,114,8,0,0,0,114,193,0,
-    0,0,48,3,0,0,115,10,0,0,0,18,3,16,1,14,
+    0,0,0,114,7,0,0,0,114,8,0,0,0,114,202,0,
+    0,0,83,3,0,0,115,10,0,0,0,18,3,16,1,14,
     1,16,1,255,128,122,24,95,76,111,97,100,101,114,66,97,
     115,105,99,115,46,105,115,95,112,97,99,107,97,103,101,99,
     2,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,
@@ -1150,9 +1198,9 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     42,85,115,101,32,100,101,102,97,117,108,116,32,115,101,109,
     97,110,116,105,99,115,32,102,111,114,32,109,111,100,117,108,
     101,32,99,114,101,97,116,105,111,110,46,78,114,7,0,0,
-    0,169,2,114,130,0,0,0,114,198,0,0,0,114,7,0,
+    0,169,2,114,130,0,0,0,114,207,0,0,0,114,7,0,
     0,0,114,7,0,0,0,114,8,0,0,0,218,13,99,114,
-    101,97,116,101,95,109,111,100,117,108,101,56,3,0,0,243,
+    101,97,116,101,95,109,111,100,117,108,101,91,3,0,0,243,
     4,0,0,0,4,0,255,128,122,27,95,76,111,97,100,101,
     114,66,97,115,105,99,115,46,99,114,101,97,116,101,95,109,
     111,100,117,108,101,99,2,0,0,0,0,0,0,0,0,0,
@@ -1172,7 +1220,7 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     111,118,101,100,218,4,101,120,101,99,114,143,0,0,0,41,
     3,114,130,0,0,0,218,6,109,111,100,117,108,101,114,175,
     0,0,0,114,7,0,0,0,114,7,0,0,0,114,8,0,
-    0,0,218,11,101,120,101,99,95,109,111,100,117,108,101,59,
+    0,0,218,11,101,120,101,99,95,109,111,100,117,108,101,94,
     3,0,0,115,14,0,0,0,12,2,8,1,6,1,4,1,
     6,255,20,2,255,128,122,25,95,76,111,97,100,101,114,66,
     97,115,105,99,115,46,101,120,101,99,95,109,111,100,117,108,
@@ -1184,16 +1232,16 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     0,218,17,95,108,111,97,100,95,109,111,100,117,108,101,95,
     115,104,105,109,169,2,114,130,0,0,0,114,150,0,0,0,
     114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,218,
-    11,108,111,97,100,95,109,111,100,117,108,101,67,3,0,0,
+    11,108,111,97,100,95,109,111,100,117,108,101,102,3,0,0,
     115,4,0,0,0,12,3,255,128,122,25,95,76,111,97,100,
     101,114,66,97,115,105,99,115,46,108,111,97,100,95,109,111,
     100,117,108,101,78,41,8,114,137,0,0,0,114,136,0,0,
-    0,114,138,0,0,0,114,139,0,0,0,114,193,0,0,0,
-    114,226,0,0,0,114,232,0,0,0,114,235,0,0,0,114,
+    0,114,138,0,0,0,114,139,0,0,0,114,202,0,0,0,
+    114,235,0,0,0,114,241,0,0,0,114,244,0,0,0,114,
     7,0,0,0,114,7,0,0,0,114,7,0,0,0,114,8,
-    0,0,0,114,222,0,0,0,43,3,0,0,115,14,0,0,
+    0,0,0,114,231,0,0,0,78,3,0,0,115,14,0,0,
     0,8,0,4,2,8,3,8,8,8,3,12,8,255,128,114,
-    222,0,0,0,99,0,0,0,0,0,0,0,0,0,0,0,
+    231,0,0,0,99,0,0,0,0,0,0,0,0,0,0,0,
     0,0,0,0,0,3,0,0,0,64,0,0,0,115,74,0,
     0,0,101,0,90,1,100,0,90,2,100,1,100,2,132,0,
     90,3,100,3,100,4,132,0,90,4,100,5,100,6,132,0,
@@ -1216,7 +1264,7 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     32,32,32,32,32,32,32,78,41,1,114,64,0,0,0,169,
     2,114,130,0,0,0,114,58,0,0,0,114,7,0,0,0,
     114,7,0,0,0,114,8,0,0,0,218,10,112,97,116,104,
-    95,109,116,105,109,101,75,3,0,0,115,4,0,0,0,4,
+    95,109,116,105,109,101,110,3,0,0,115,4,0,0,0,4,
     6,255,128,122,23,83,111,117,114,99,101,76,111,97,100,101,
     114,46,112,97,116,104,95,109,116,105,109,101,99,2,0,0,
     0,0,0,0,0,0,0,0,0,2,0,0,0,4,0,0,
@@ -1247,10 +1295,10 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     32,32,32,32,32,82,97,105,115,101,115,32,79,83,69,114,
     114,111,114,32,119,104,101,110,32,116,104,101,32,112,97,116,
     104,32,99,97,110,110,111,116,32,98,101,32,104,97,110,100,
-    108,101,100,46,10,32,32,32,32,32,32,32,32,114,180,0,
-    0,0,78,41,1,114,238,0,0,0,114,237,0,0,0,114,
+    108,101,100,46,10,32,32,32,32,32,32,32,32,114,189,0,
+    0,0,78,41,1,114,247,0,0,0,114,246,0,0,0,114,
     7,0,0,0,114,7,0,0,0,114,8,0,0,0,218,10,
-    112,97,116,104,95,115,116,97,116,115,83,3,0,0,115,4,
+    112,97,116,104,95,115,116,97,116,115,118,3,0,0,115,4,
     0,0,0,14,12,255,128,122,23,83,111,117,114,99,101,76,
     111,97,100,101,114,46,112,97,116,104,95,115,116,97,116,115,
     99,4,0,0,0,0,0,0,0,0,0,0,0,4,0,0,
@@ -1274,7 +1322,7 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     4,114,130,0,0,0,114,119,0,0,0,90,10,99,97,99,
     104,101,95,112,97,116,104,114,42,0,0,0,114,7,0,0,
     0,114,7,0,0,0,114,8,0,0,0,218,15,95,99,97,
-    99,104,101,95,98,121,116,101,99,111,100,101,97,3,0,0,
+    99,104,101,95,98,121,116,101,99,111,100,101,132,3,0,0,
     115,4,0,0,0,12,8,255,128,122,28,83,111,117,114,99,
     101,76,111,97,100,101,114,46,95,99,97,99,104,101,95,98,
     121,116,101,99,111,100,101,99,3,0,0,0,0,0,0,0,
@@ -1291,7 +1339,7 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     102,105,108,101,115,46,10,32,32,32,32,32,32,32,32,78,
     114,7,0,0,0,41,3,114,130,0,0,0,114,58,0,0,
     0,114,42,0,0,0,114,7,0,0,0,114,7,0,0,0,
-    114,8,0,0,0,114,240,0,0,0,107,3,0,0,114,227,
+    114,8,0,0,0,114,249,0,0,0,142,3,0,0,114,236,
     0,0,0,122,21,83,111,117,114,99,101,76,111,97,100,101,
     114,46,115,101,116,95,100,97,116,97,99,2,0,0,0,0,
     0,0,0,0,0,0,0,5,0,0,0,10,0,0,0,67,
@@ -1306,12 +1354,12 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     111,117,114,99,101,46,122,39,115,111,117,114,99,101,32,110,
     111,116,32,97,118,97,105,108,97,98,108,101,32,116,104,114,
     111,117,103,104,32,103,101,116,95,100,97,116,97,40,41,114,
-    127,0,0,0,78,41,5,114,190,0,0,0,218,8,103,101,
+    127,0,0,0,78,41,5,114,199,0,0,0,218,8,103,101,
     116,95,100,97,116,97,114,64,0,0,0,114,129,0,0,0,
-    114,187,0,0,0,41,5,114,130,0,0,0,114,150,0,0,
-    0,114,58,0,0,0,114,185,0,0,0,218,3,101,120,99,
+    114,196,0,0,0,41,5,114,130,0,0,0,114,150,0,0,
+    0,114,58,0,0,0,114,194,0,0,0,218,3,101,120,99,
     114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,218,
-    10,103,101,116,95,115,111,117,114,99,101,114,3,0,0,115,
+    10,103,101,116,95,115,111,117,114,99,101,149,3,0,0,115,
     26,0,0,0,10,2,2,1,12,1,8,4,14,253,4,1,
     2,1,4,255,2,1,2,255,8,128,2,255,255,128,122,23,
     83,111,117,114,99,101,76,111,97,100,101,114,46,103,101,116,
@@ -1328,1332 +1376,1339 @@ const unsigned char _Py_M__importlib_bootstrap_external[] = {
     101,32,97,110,121,32,111,98,106,101,99,116,32,116,121,112,
     101,32,116,104,97,116,32,99,111,109,112,105,108,101,40,41,
     32,115,117,112,112,111,114,116,115,46,10,32,32,32,32,32,
-    32,32,32,114,230,0,0,0,84,41,2,218,12,100,111,110,
+    32,32,32,114,239,0,0,0,84,41,2,218,12,100,111,110,
     116,95,105,110,104,101,114,105,116,114,96,0,0,0,78,41,
-    3,114,146,0,0,0,114,229,0,0,0,218,7,99,111,109,
+    3,114,146,0,0,0,114,238,0,0,0,218,7,99,111,109,
     112,105,108,101,41,4,114,130,0,0,0,114,42,0,0,0,
-    114,58,0,0,0,114,245,0,0,0,114,7,0,0,0,114,
+    114,58,0,0,0,114,254,0,0,0,114,7,0,0,0,114,
     7,0,0,0,114,8,0,0,0,218,14,115,111,117,114,99,
-    101,95,116,111,95,99,111,100,101,124,3,0,0,115,8,0,
+    101,95,116,111,95,99,111,100,101,159,3,0,0,115,8,0,
     0,0,12,5,4,1,6,255,255,128,122,27,83,111,117,114,
     99,101,76,111,97,100,101,114,46,115,111,117,114,99,101,95,
     116,111,95,99,111,100,101,99,2,0,0,0,0,0,0,0,
-    0,0,0,0,15,0,0,0,9,0,0,0,67,0,0,0,
-    115,34,2,0,0,124,0,160,0,124,1,161,1,125,2,100,
+    0,0,0,0,16,0,0,0,9,0,0,0,67,0,0,0,
+    115,104,2,0,0,124,0,160,0,124,1,161,1,125,2,100,
     1,125,3,100,1,125,4,100,1,125,5,100,2,125,6,100,
     3,125,7,122,12,116,1,124,2,131,1,125,8,87,0,110,
-    24,4,0,116,2,144,2,121,32,1,0,1,0,1,0,100,
-    1,125,8,89,0,144,1,110,38,122,14,124,0,160,3,124,
+    24,4,0,116,2,144,2,121,102,1,0,1,0,1,0,100,
+    1,125,8,89,0,144,1,110,108,122,14,124,0,160,3,124,
     2,161,1,125,9,87,0,110,20,4,0,116,4,144,2,121,
-    30,1,0,1,0,1,0,89,0,144,1,110,2,116,5,124,
-    9,100,4,25,0,131,1,125,3,122,14,124,0,160,6,124,
-    8,161,1,125,10,87,0,110,18,4,0,116,4,144,2,121,
-    28,1,0,1,0,1,0,89,0,110,212,124,1,124,8,100,
-    5,156,2,125,11,122,148,116,7,124,10,124,1,124,11,131,
-    3,125,12,116,8,124,10,131,1,100,6,100,1,133,2,25,
-    0,125,13,124,12,100,7,64,0,100,8,107,3,125,6,124,
-    6,144,1,114,30,124,12,100,9,64,0,100,8,107,3,125,
-    7,116,9,106,10,100,10,107,3,144,1,114,28,124,7,115,
-    248,116,9,106,10,100,11,107,2,144,1,114,28,124,0,160,
-    6,124,2,161,1,125,4,116,9,160,11,116,12,124,4,161,
-    2,125,5,116,13,124,10,124,5,124,1,124,11,131,4,1,
-    0,110,20,116,14,124,10,124,3,124,9,100,12,25,0,124,
-    1,124,11,131,5,1,0,87,0,110,22,4,0,116,15,116,
-    16,102,2,144,2,121,26,1,0,1,0,1,0,89,0,110,
-    30,116,17,160,18,100,13,124,8,124,2,161,3,1,0,116,
-    19,124,13,124,1,124,8,124,2,100,14,141,4,83,0,124,
-    4,100,1,117,0,144,1,114,126,124,0,160,6,124,2,161,
-    1,125,4,124,0,160,20,124,4,124,2,161,2,125,14,116,
-    17,160,18,100,15,124,2,161,2,1,0,116,21,106,22,144,
-    2,115,20,124,8,100,1,117,1,144,2,114,20,124,3,100,
-    1,117,1,144,2,114,20,124,6,144,1,114,218,124,5,100,
-    1,117,0,144,1,114,204,116,9,160,11,124,4,161,1,125,
-    5,116,23,124,14,124,5,124,7,131,3,125,10,110,16,116,
-    24,124,14,124,3,116,25,124,4,131,1,131,3,125,10,122,
-    20,124,0,160,26,124,2,124,8,124,10,161,3,1,0,87,
-    0,124,14,83,0,4,0,116,2,144,2,121,24,1,0,1,
-    0,1,0,89,0,124,14,83,0,124,14,83,0,119,0,119,
-    0,119,0,119,0,119,0,41,16,122,190,67,111,110,99,114,
-    101,116,101,32,105,109,112,108,101,109,101,110,116,97,116,105,
-    111,110,32,111,102,32,73,110,115,112,101,99,116,76,111,97,
-    100,101,114,46,103,101,116,95,99,111,100,101,46,10,10,32,
-    32,32,32,32,32,32,32,82,101,97,100,105,110,103,32,111,
-    102,32,98,121,116,101,99,111,100,101,32,114,101,113,117,105,
-    114,101,115,32,112,97,116,104,95,115,116,97,116,115,32,116,
-    111,32,98,101,32,105,109,112,108,101,109,101,110,116,101,100,
-    46,32,84,111,32,119,114,105,116,101,10,32,32,32,32,32,
-    32,32,32,98,121,116,101,99,111,100,101,44,32,115,101,116,
-    95,100,97,116,97,32,109,117,115,116,32,97,108,115,111,32,
-    98,101,32,105,109,112,108,101,109,101,110,116,101,100,46,10,
-    10,32,32,32,32,32,32,32,32,78,70,84,114,180,0,0,
-    0,114,170,0,0,0,114,156,0,0,0,114,3,0,0,0,
-    114,0,0,0,0,114,45,0,0,0,90,5,110,101,118,101,
-    114,90,6,97,108,119,97,121,115,218,4,115,105,122,101,122,
-    13,123,125,32,109,97,116,99,104,101,115,32,123,125,41,3,
-    114,128,0,0,0,114,118,0,0,0,114,119,0,0,0,122,
-    19,99,111,100,101,32,111,98,106,101,99,116,32,102,114,111,
-    109,32,123,125,41,27,114,190,0,0,0,114,109,0,0,0,
-    114,95,0,0,0,114,239,0,0,0,114,64,0,0,0,114,
-    34,0,0,0,114,242,0,0,0,114,163,0,0,0,218,10,
-    109,101,109,111,114,121,118,105,101,119,114,174,0,0,0,90,
-    21,99,104,101,99,107,95,104,97,115,104,95,98,97,115,101,
-    100,95,112,121,99,115,114,168,0,0,0,218,17,95,82,65,
-    87,95,77,65,71,73,67,95,78,85,77,66,69,82,114,169,
-    0,0,0,114,167,0,0,0,114,129,0,0,0,114,161,0,
-    0,0,114,146,0,0,0,114,160,0,0,0,114,176,0,0,
-    0,114,248,0,0,0,114,16,0,0,0,218,19,100,111,110,
-    116,95,119,114,105,116,101,95,98,121,116,101,99,111,100,101,
-    114,182,0,0,0,114,181,0,0,0,114,4,0,0,0,114,
-    241,0,0,0,41,15,114,130,0,0,0,114,150,0,0,0,
-    114,119,0,0,0,114,165,0,0,0,114,185,0,0,0,114,
-    168,0,0,0,90,10,104,97,115,104,95,98,97,115,101,100,
-    90,12,99,104,101,99,107,95,115,111,117,114,99,101,114,118,
-    0,0,0,218,2,115,116,114,42,0,0,0,114,162,0,0,
-    0,114,17,0,0,0,90,10,98,121,116,101,115,95,100,97,
-    116,97,90,11,99,111,100,101,95,111,98,106,101,99,116,114,
-    7,0,0,0,114,7,0,0,0,114,8,0,0,0,114,228,
-    0,0,0,132,3,0,0,115,170,0,0,0,10,7,4,1,
-    4,1,4,1,4,1,4,1,2,1,12,1,14,1,10,1,
-    2,2,14,1,14,1,6,1,12,2,2,1,14,1,14,1,
-    4,1,2,3,2,1,6,254,2,4,12,1,16,1,12,1,
-    6,1,12,1,12,1,2,1,2,255,8,2,4,254,10,3,
-    4,1,2,1,2,1,4,254,8,4,2,1,4,255,2,128,
-    2,3,2,1,2,1,6,1,2,1,2,1,4,251,4,128,
-    18,7,4,1,8,2,2,1,4,255,6,2,2,1,2,1,
-    6,254,10,3,10,1,12,1,12,1,18,1,6,1,4,255,
-    6,2,10,1,10,1,14,1,6,2,6,1,4,255,2,2,
-    16,1,4,3,14,254,2,1,8,1,2,254,2,233,2,225,
-    2,250,2,251,255,128,122,21,83,111,117,114,99,101,76,111,
-    97,100,101,114,46,103,101,116,95,99,111,100,101,78,41,10,
-    114,137,0,0,0,114,136,0,0,0,114,138,0,0,0,114,
-    238,0,0,0,114,239,0,0,0,114,241,0,0,0,114,240,
-    0,0,0,114,244,0,0,0,114,248,0,0,0,114,228,0,
-    0,0,114,7,0,0,0,114,7,0,0,0,114,7,0,0,
-    0,114,8,0,0,0,114,236,0,0,0,73,3,0,0,115,
-    18,0,0,0,8,0,8,2,8,8,8,14,8,10,8,7,
-    14,10,12,8,255,128,114,236,0,0,0,99,0,0,0,0,
-    0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,0,
-    0,0,0,0,115,92,0,0,0,101,0,90,1,100,0,90,
-    2,100,1,90,3,100,2,100,3,132,0,90,4,100,4,100,
-    5,132,0,90,5,100,6,100,7,132,0,90,6,101,7,135,
-    0,102,1,100,8,100,9,132,8,131,1,90,8,101,7,100,
-    10,100,11,132,0,131,1,90,9,100,12,100,13,132,0,90,
-    10,101,7,100,14,100,15,132,0,131,1,90,11,135,0,4,
-    0,90,12,83,0,41,16,218,10,70,105,108,101,76,111,97,
-    100,101,114,122,103,66,97,115,101,32,102,105,108,101,32,108,
-    111,97,100,101,114,32,99,108,97,115,115,32,119,104,105,99,
-    104,32,105,109,112,108,101,109,101,110,116,115,32,116,104,101,
-    32,108,111,97,100,101,114,32,112,114,111,116,111,99,111,108,
-    32,109,101,116,104,111,100,115,32,116,104,97,116,10,32,32,
-    32,32,114,101,113,117,105,114,101,32,102,105,108,101,32,115,
-    121,115,116,101,109,32,117,115,97,103,101,46,99,3,0,0,
-    0,0,0,0,0,0,0,0,0,3,0,0,0,2,0,0,
-    0,67,0,0,0,115,16,0,0,0,124,1,124,0,95,0,
-    124,2,124,0,95,1,100,1,83,0,41,2,122,75,67,97,
-    99,104,101,32,116,104,101,32,109,111,100,117,108,101,32,110,
-    97,109,101,32,97,110,100,32,116,104,101,32,112,97,116,104,
-    32,116,111,32,116,104,101,32,102,105,108,101,32,102,111,117,
-    110,100,32,98,121,32,116,104,101,10,32,32,32,32,32,32,
-    32,32,102,105,110,100,101,114,46,78,114,170,0,0,0,41,
-    3,114,130,0,0,0,114,150,0,0,0,114,58,0,0,0,
-    114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,114,
-    223,0,0,0,222,3,0,0,115,6,0,0,0,6,3,10,
-    1,255,128,122,19,70,105,108,101,76,111,97,100,101,114,46,
-    95,95,105,110,105,116,95,95,99,2,0,0,0,0,0,0,
-    0,0,0,0,0,2,0,0,0,2,0,0,0,67,0,0,
-    0,243,24,0,0,0,124,0,106,0,124,1,106,0,107,2,
-    111,22,124,0,106,1,124,1,106,1,107,2,83,0,114,121,
-    0,0,0,169,2,218,9,95,95,99,108,97,115,115,95,95,
-    114,143,0,0,0,169,2,114,130,0,0,0,90,5,111,116,
-    104,101,114,114,7,0,0,0,114,7,0,0,0,114,8,0,
-    0,0,218,6,95,95,101,113,95,95,228,3,0,0,243,8,
-    0,0,0,12,1,10,1,2,255,255,128,122,17,70,105,108,
-    101,76,111,97,100,101,114,46,95,95,101,113,95,95,99,1,
-    0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,3,
-    0,0,0,67,0,0,0,243,20,0,0,0,116,0,124,0,
-    106,1,131,1,116,0,124,0,106,2,131,1,65,0,83,0,
-    114,121,0,0,0,169,3,218,4,104,97,115,104,114,128,0,
-    0,0,114,58,0,0,0,169,1,114,130,0,0,0,114,7,
-    0,0,0,114,7,0,0,0,114,8,0,0,0,218,8,95,
-    95,104,97,115,104,95,95,232,3,0,0,243,4,0,0,0,
-    20,1,255,128,122,19,70,105,108,101,76,111,97,100,101,114,
-    46,95,95,104,97,115,104,95,95,99,2,0,0,0,0,0,
-    0,0,0,0,0,0,2,0,0,0,3,0,0,0,3,0,
-    0,0,115,16,0,0,0,116,0,116,1,124,0,131,2,160,
-    2,124,1,161,1,83,0,41,2,122,100,76,111,97,100,32,
-    97,32,109,111,100,117,108,101,32,102,114,111,109,32,97,32,
-    102,105,108,101,46,10,10,32,32,32,32,32,32,32,32,84,
-    104,105,115,32,109,101,116,104,111,100,32,105,115,32,100,101,
-    112,114,101,99,97,116,101,100,46,32,32,85,115,101,32,101,
-    120,101,99,95,109,111,100,117,108,101,40,41,32,105,110,115,
-    116,101,97,100,46,10,10,32,32,32,32,32,32,32,32,78,
-    41,3,218,5,115,117,112,101,114,114,254,0,0,0,114,235,
-    0,0,0,114,234,0,0,0,169,1,114,1,1,0,0,114,
-    7,0,0,0,114,8,0,0,0,114,235,0,0,0,235,3,
-    0,0,115,4,0,0,0,16,10,255,128,122,22,70,105,108,
-    101,76,111,97,100,101,114,46,108,111,97,100,95,109,111,100,
-    117,108,101,99,2,0,0,0,0,0,0,0,0,0,0,0,
-    2,0,0,0,1,0,0,0,67,0,0,0,243,6,0,0,
-    0,124,0,106,0,83,0,169,2,122,58,82,101,116,117,114,
-    110,32,116,104,101,32,112,97,116,104,32,116,111,32,116,104,
-    101,32,115,111,117,114,99,101,32,102,105,108,101,32,97,115,
-    32,102,111,117,110,100,32,98,121,32,116,104,101,32,102,105,
-    110,100,101,114,46,78,114,62,0,0,0,114,234,0,0,0,
-    114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,114,
-    190,0,0,0,247,3,0,0,243,4,0,0,0,6,3,255,
-    128,122,23,70,105,108,101,76,111,97,100,101,114,46,103,101,
-    116,95,102,105,108,101,110,97,109,101,99,2,0,0,0,0,
-    0,0,0,0,0,0,0,3,0,0,0,8,0,0,0,67,
-    0,0,0,115,128,0,0,0,116,0,124,0,116,1,116,2,
-    102,2,131,2,114,72,116,3,160,4,116,5,124,1,131,1,
-    161,1,143,24,125,2,124,2,160,6,161,0,87,0,2,0,
-    100,1,4,0,4,0,131,3,1,0,83,0,49,0,115,58,
-    119,1,1,0,1,0,1,0,89,0,1,0,100,1,83,0,
-    116,3,160,7,124,1,100,2,161,2,143,24,125,2,124,2,
-    160,6,161,0,87,0,2,0,100,1,4,0,4,0,131,3,
-    1,0,83,0,49,0,115,114,119,1,1,0,1,0,1,0,
-    89,0,1,0,100,1,83,0,41,3,122,39,82,101,116,117,
-    114,110,32,116,104,101,32,100,97,116,97,32,102,114,111,109,
-    32,112,97,116,104,32,97,115,32,114,97,119,32,98,121,116,
-    101,115,46,78,218,1,114,41,8,114,172,0,0,0,114,236,
-    0,0,0,218,19,69,120,116,101,110,115,105,111,110,70,105,
-    108,101,76,111,97,100,101,114,114,79,0,0,0,90,9,111,
-    112,101,110,95,99,111,100,101,114,97,0,0,0,90,4,114,
-    101,97,100,114,80,0,0,0,41,3,114,130,0,0,0,114,
-    58,0,0,0,114,83,0,0,0,114,7,0,0,0,114,7,
-    0,0,0,114,8,0,0,0,114,242,0,0,0,252,3,0,
-    0,115,16,0,0,0,14,2,16,1,22,1,20,128,14,2,
-    22,1,20,128,255,128,122,19,70,105,108,101,76,111,97,100,
-    101,114,46,103,101,116,95,100,97,116,97,99,2,0,0,0,
-    0,0,0,0,0,0,0,0,3,0,0,0,2,0,0,0,
-    67,0,0,0,115,20,0,0,0,100,1,100,2,108,0,109,
-    1,125,2,1,0,124,2,124,0,131,1,83,0,41,3,78,
-    114,0,0,0,0,41,1,218,10,70,105,108,101,82,101,97,
-    100,101,114,41,2,90,17,105,109,112,111,114,116,108,105,98,
-    46,114,101,97,100,101,114,115,114,18,1,0,0,41,3,114,
-    130,0,0,0,114,231,0,0,0,114,18,1,0,0,114,7,
-    0,0,0,114,7,0,0,0,114,8,0,0,0,218,19,103,
-    101,116,95,114,101,115,111,117,114,99,101,95,114,101,97,100,
-    101,114,5,4,0,0,115,6,0,0,0,12,2,8,1,255,
-    128,122,30,70,105,108,101,76,111,97,100,101,114,46,103,101,
-    116,95,114,101,115,111,117,114,99,101,95,114,101,97,100,101,
-    114,41,13,114,137,0,0,0,114,136,0,0,0,114,138,0,
-    0,0,114,139,0,0,0,114,223,0,0,0,114,3,1,0,
-    0,114,9,1,0,0,114,147,0,0,0,114,235,0,0,0,
-    114,190,0,0,0,114,242,0,0,0,114,19,1,0,0,90,
-    13,95,95,99,108,97,115,115,99,101,108,108,95,95,114,7,
-    0,0,0,114,7,0,0,0,114,12,1,0,0,114,8,0,
-    0,0,114,254,0,0,0,217,3,0,0,115,26,0,0,0,
-    8,0,4,2,8,3,8,6,8,4,2,3,14,1,2,11,
-    10,1,8,4,2,9,18,1,255,128,114,254,0,0,0,99,
-    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-    3,0,0,0,64,0,0,0,115,46,0,0,0,101,0,90,
-    1,100,0,90,2,100,1,90,3,100,2,100,3,132,0,90,
-    4,100,4,100,5,132,0,90,5,100,6,100,7,156,1,100,
-    8,100,9,132,2,90,6,100,10,83,0,41,11,218,16,83,
-    111,117,114,99,101,70,105,108,101,76,111,97,100,101,114,122,
-    62,67,111,110,99,114,101,116,101,32,105,109,112,108,101,109,
-    101,110,116,97,116,105,111,110,32,111,102,32,83,111,117,114,
-    99,101,76,111,97,100,101,114,32,117,115,105,110,103,32,116,
-    104,101,32,102,105,108,101,32,115,121,115,116,101,109,46,99,
-    2,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,
-    3,0,0,0,67,0,0,0,115,22,0,0,0,116,0,124,
-    1,131,1,125,2,124,2,106,1,124,2,106,2,100,1,156,
-    2,83,0,41,3,122,33,82,101,116,117,114,110,32,116,104,
-    101,32,109,101,116,97,100,97,116,97,32,102,111,114,32,116,
-    104,101,32,112,97,116,104,46,41,2,114,180,0,0,0,114,
-    249,0,0,0,78,41,3,114,63,0,0,0,218,8,115,116,
-    95,109,116,105,109,101,90,7,115,116,95,115,105,122,101,41,
-    3,114,130,0,0,0,114,58,0,0,0,114,253,0,0,0,
-    114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,114,
-    239,0,0,0,15,4,0,0,115,6,0,0,0,8,2,14,
-    1,255,128,122,27,83,111,117,114,99,101,70,105,108,101,76,
-    111,97,100,101,114,46,112,97,116,104,95,115,116,97,116,115,
-    99,4,0,0,0,0,0,0,0,0,0,0,0,5,0,0,
-    0,5,0,0,0,67,0,0,0,115,24,0,0,0,116,0,
-    124,1,131,1,125,4,124,0,106,1,124,2,124,3,124,4,
-    100,1,141,3,83,0,41,2,78,169,1,218,5,95,109,111,
-    100,101,41,2,114,126,0,0,0,114,240,0,0,0,41,5,
-    114,130,0,0,0,114,119,0,0,0,114,118,0,0,0,114,
-    42,0,0,0,114,66,0,0,0,114,7,0,0,0,114,7,
-    0,0,0,114,8,0,0,0,114,241,0,0,0,20,4,0,
-    0,115,6,0,0,0,8,2,16,1,255,128,122,32,83,111,
-    117,114,99,101,70,105,108,101,76,111,97,100,101,114,46,95,
-    99,97,99,104,101,95,98,121,116,101,99,111,100,101,114,75,
-    0,0,0,114,22,1,0,0,99,3,0,0,0,0,0,0,
-    0,1,0,0,0,9,0,0,0,11,0,0,0,67,0,0,
-    0,115,254,0,0,0,116,0,124,1,131,1,92,2,125,4,
-    125,5,103,0,125,6,124,4,114,62,116,1,124,4,131,1,
-    115,62,116,0,124,4,131,1,92,2,125,4,125,7,124,6,
-    160,2,124,7,161,1,1,0,124,4,114,62,116,1,124,4,
-    131,1,114,28,116,3,124,6,131,1,68,0,93,96,125,7,
-    116,4,124,4,124,7,131,2,125,4,122,14,116,5,160,6,
-    124,4,161,1,1,0,87,0,113,70,4,0,116,7,121,116,
-    1,0,1,0,1,0,89,0,113,70,4,0,116,8,121,252,
-    1,0,125,8,1,0,122,30,116,9,160,10,100,1,124,4,
-    124,8,161,3,1,0,87,0,89,0,100,2,125,8,126,8,
-    1,0,100,2,83,0,100,2,125,8,126,8,119,1,122,30,
-    116,11,124,1,124,2,124,3,131,3,1,0,116,9,160,10,
-    100,3,124,1,161,2,1,0,87,0,100,2,83,0,4,0,
-    116,8,121,250,1,0,125,8,1,0,122,28,116,9,160,10,
-    100,1,124,1,124,8,161,3,1,0,87,0,89,0,100,2,
-    125,8,126,8,100,2,83,0,100,2,125,8,126,8,119,1,
-    119,0,119,0,41,4,122,27,87,114,105,116,101,32,98,121,
-    116,101,115,32,100,97,116,97,32,116,111,32,97,32,102,105,
-    108,101,46,122,27,99,111,117,108,100,32,110,111,116,32,99,
-    114,101,97,116,101,32,123,33,114,125,58,32,123,33,114,125,
-    78,122,12,99,114,101,97,116,101,100,32,123,33,114,125,41,
-    12,114,61,0,0,0,114,71,0,0,0,114,197,0,0,0,
-    114,56,0,0,0,114,54,0,0,0,114,19,0,0,0,90,
-    5,109,107,100,105,114,218,15,70,105,108,101,69,120,105,115,
-    116,115,69,114,114,111,114,114,64,0,0,0,114,146,0,0,
-    0,114,160,0,0,0,114,84,0,0,0,41,9,114,130,0,
-    0,0,114,58,0,0,0,114,42,0,0,0,114,23,1,0,
-    0,218,6,112,97,114,101,110,116,114,108,0,0,0,114,53,
-    0,0,0,114,49,0,0,0,114,243,0,0,0,114,7,0,
-    0,0,114,7,0,0,0,114,8,0,0,0,114,240,0,0,
-    0,25,4,0,0,115,58,0,0,0,12,2,4,1,12,2,
-    12,1,10,1,12,254,12,4,10,1,2,1,14,1,12,1,
-    4,2,14,1,6,3,4,1,4,255,16,2,8,128,2,1,
-    12,1,18,1,14,1,8,2,2,1,18,255,8,128,2,254,
-    2,247,255,128,122,25,83,111,117,114,99,101,70,105,108,101,
-    76,111,97,100,101,114,46,115,101,116,95,100,97,116,97,78,
-    41,7,114,137,0,0,0,114,136,0,0,0,114,138,0,0,
-    0,114,139,0,0,0,114,239,0,0,0,114,241,0,0,0,
-    114,240,0,0,0,114,7,0,0,0,114,7,0,0,0,114,
-    7,0,0,0,114,8,0,0,0,114,20,1,0,0,11,4,
-    0,0,115,12,0,0,0,8,0,4,2,8,2,8,5,18,
-    5,255,128,114,20,1,0,0,99,0,0,0,0,0,0,0,
-    0,0,0,0,0,0,0,0,0,2,0,0,0,64,0,0,
-    0,115,32,0,0,0,101,0,90,1,100,0,90,2,100,1,
+    100,1,0,1,0,1,0,89,0,144,1,110,72,116,5,124,
+    9,100,4,25,0,131,1,125,3,116,6,160,7,124,8,100,
+    1,161,2,125,10,124,10,100,1,117,1,114,184,124,10,100,
+    1,100,5,133,2,25,0,124,3,124,9,160,8,100,6,161,
+    1,102,2,107,2,114,184,116,9,160,10,100,7,124,8,124,
+    2,161,3,1,0,124,10,100,5,25,0,83,0,122,14,124,
+    0,160,11,124,8,161,1,125,11,87,0,110,18,4,0,116,
+    4,144,2,121,98,1,0,1,0,1,0,89,0,110,214,124,
+    1,124,8,100,8,156,2,125,12,122,150,116,12,124,11,124,
+    1,124,12,131,3,125,13,116,13,124,11,131,1,100,9,100,
+    1,133,2,25,0,125,14,124,13,100,10,64,0,100,11,107,
+    3,125,6,124,6,144,1,114,100,124,13,100,5,64,0,100,
+    11,107,3,125,7,116,14,106,15,100,12,107,3,144,1,114,
+    98,124,7,144,1,115,62,116,14,106,15,100,13,107,2,144,
+    1,114,98,124,0,160,11,124,2,161,1,125,4,116,14,160,
+    16,116,17,124,4,161,2,125,5,116,18,124,11,124,5,124,
+    1,124,12,131,4,1,0,110,20,116,19,124,11,124,3,124,
+    9,100,6,25,0,124,1,124,12,131,5,1,0,87,0,110,
+    22,4,0,116,20,116,21,102,2,144,2,121,96,1,0,1,
+    0,1,0,89,0,110,30,116,9,160,10,100,7,124,8,124,
+    2,161,3,1,0,116,22,124,14,124,1,124,8,124,2,100,
+    14,141,4,83,0,124,4,100,1,117,0,144,1,114,196,124,
+    0,160,11,124,2,161,1,125,4,124,0,160,23,124,4,124,
+    2,161,2,125,15,116,9,160,10,100,15,124,2,161,2,1,
+    0,116,24,106,25,144,2,115,90,124,8,100,1,117,1,144,
+    2,114,90,124,3,100,1,117,1,144,2,114,90,124,6,144,
+    2,114,32,124,5,100,1,117,0,144,2,114,18,116,14,160,
+    16,124,4,161,1,125,5,116,26,124,15,124,5,124,7,131,
+    3,125,11,110,16,116,27,124,15,124,3,116,28,124,4,131,
+    1,131,3,125,11,122,20,124,0,160,29,124,2,124,8,124,
+    11,161,3,1,0,87,0,124,15,83,0,4,0,116,2,144,
+    2,121,94,1,0,1,0,1,0,89,0,124,15,83,0,124,
+    15,83,0,119,0,119,0,119,0,119,0,119,0,41,16,122,
+    190,67,111,110,99,114,101,116,101,32,105,109,112,108,101,109,
+    101,110,116,97,116,105,111,110,32,111,102,32,73,110,115,112,
+    101,99,116,76,111,97,100,101,114,46,103,101,116,95,99,111,
+    100,101,46,10,10,32,32,32,32,32,32,32,32,82,101,97,
+    100,105,110,103,32,111,102,32,98,121,116,101,99,111,100,101,
+    32,114,101,113,117,105,114,101,115,32,112,97,116,104,95,115,
+    116,97,116,115,32,116,111,32,98,101,32,105,109,112,108,101,
+    109,101,110,116,101,100,46,32,84,111,32,119,114,105,116,101,
+    10,32,32,32,32,32,32,32,32,98,121,116,101,99,111,100,
+    101,44,32,115,101,116,95,100,97,116,97,32,109,117,115,116,
+    32,97,108,115,111,32,98,101,32,105,109,112,108,101,109,101,
+    110,116,101,100,46,10,10,32,32,32,32,32,32,32,32,78,
+    70,84,114,189,0,0,0,114,45,0,0,0,218,4,115,105,
+    122,101,122,13,123,125,32,109,97,116,99,104,101,115,32,123,
+    125,114,170,0,0,0,114,156,0,0,0,114,3,0,0,0,
+    114,0,0,0,0,90,5,110,101,118,101,114,90,6,97,108,
+    119,97,121,115,114,177,0,0,0,122,19,99,111,100,101,32,
+    111,98,106,101,99,116,32,102,114,111,109,32,123,125,41,30,
+    114,199,0,0,0,114,109,0,0,0,114,95,0,0,0,114,
+    248,0,0,0,114,64,0,0,0,114,34,0,0,0,114,183,
+    0,0,0,218,3,112,111,112,218,3,103,101,116,114,146,0,
+    0,0,114,160,0,0,0,114,251,0,0,0,114,163,0,0,
+    0,114,182,0,0,0,114,174,0,0,0,90,21,99,104,101,
+    99,107,95,104,97,115,104,95,98,97,115,101,100,95,112,121,
+    99,115,114,168,0,0,0,218,17,95,82,65,87,95,77,65,
+    71,73,67,95,78,85,77,66,69,82,114,169,0,0,0,114,
+    167,0,0,0,114,129,0,0,0,114,161,0,0,0,114,176,
+    0,0,0,114,1,1,0,0,114,16,0,0,0,218,19,100,
+    111,110,116,95,119,114,105,116,101,95,98,121,116,101,99,111,
+    100,101,114,191,0,0,0,114,190,0,0,0,114,4,0,0,
+    0,114,250,0,0,0,41,16,114,130,0,0,0,114,150,0,
+    0,0,114,119,0,0,0,114,165,0,0,0,114,194,0,0,
+    0,114,168,0,0,0,90,10,104,97,115,104,95,98,97,115,
+    101,100,90,12,99,104,101,99,107,95,115,111,117,114,99,101,
+    114,118,0,0,0,114,184,0,0,0,90,8,112,114,101,112,
+    97,114,101,100,114,42,0,0,0,114,162,0,0,0,114,17,
+    0,0,0,90,10,98,121,116,101,115,95,100,97,116,97,90,
+    11,99,111,100,101,95,111,98,106,101,99,116,114,7,0,0,
+    0,114,7,0,0,0,114,8,0,0,0,114,237,0,0,0,
+    167,3,0,0,115,186,0,0,0,10,7,4,1,4,1,4,
+    1,4,1,4,1,2,1,12,1,14,1,10,1,2,2,14,
+    1,14,1,6,1,12,2,12,1,8,1,24,1,2,255,8,
+    2,2,1,4,255,8,2,2,1,14,1,14,1,4,1,2,
+    3,2,1,6,254,2,4,12,1,16,1,12,1,6,1,12,
+    1,12,1,2,1,4,255,8,2,4,254,10,3,4,1,2,
+    1,2,1,4,254,8,4,2,1,4,255,2,128,2,3,2,
+    1,2,1,6,1,2,1,2,1,4,251,4,128,18,7,4,
+    1,8,2,2,1,4,255,6,2,2,1,2,1,6,254,10,
+    3,10,1,12,1,12,1,18,1,6,1,4,255,6,2,10,
+    1,10,1,14,1,6,2,6,1,4,255,2,2,16,1,4,
+    3,14,254,2,1,8,1,2,254,2,233,2,225,2,244,2,
+    251,255,128,122,21,83,111,117,114,99,101,76,111,97,100,101,
+    114,46,103,101,116,95,99,111,100,101,78,41,10,114,137,0,
+    0,0,114,136,0,0,0,114,138,0,0,0,114,247,0,0,
+    0,114,248,0,0,0,114,250,0,0,0,114,249,0,0,0,
+    114,253,0,0,0,114,1,1,0,0,114,237,0,0,0,114,
+    7,0,0,0,114,7,0,0,0,114,7,0,0,0,114,8,
+    0,0,0,114,245,0,0,0,108,3,0,0,115,18,0,0,
+    0,8,0,8,2,8,8,8,14,8,10,8,7,14,10,12,
+    8,255,128,114,245,0,0,0,99,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,4,0,0,0,0,0,0,
+    0,115,92,0,0,0,101,0,90,1,100,0,90,2,100,1,
     90,3,100,2,100,3,132,0,90,4,100,4,100,5,132,0,
-    90,5,100,6,83,0,41,7,218,20,83,111,117,114,99,101,
-    108,101,115,115,70,105,108,101,76,111,97,100,101,114,122,45,
-    76,111,97,100,101,114,32,119,104,105,99,104,32,104,97,110,
-    100,108,101,115,32,115,111,117,114,99,101,108,101,115,115,32,
-    102,105,108,101,32,105,109,112,111,114,116,115,46,99,2,0,
-    0,0,0,0,0,0,0,0,0,0,5,0,0,0,5,0,
-    0,0,67,0,0,0,115,68,0,0,0,124,0,160,0,124,
-    1,161,1,125,2,124,0,160,1,124,2,161,1,125,3,124,
-    1,124,2,100,1,156,2,125,4,116,2,124,3,124,1,124,
-    4,131,3,1,0,116,3,116,4,124,3,131,1,100,2,100,
-    0,133,2,25,0,124,1,124,2,100,3,141,3,83,0,41,
-    4,78,114,170,0,0,0,114,156,0,0,0,41,2,114,128,
-    0,0,0,114,118,0,0,0,41,5,114,190,0,0,0,114,
-    242,0,0,0,114,163,0,0,0,114,176,0,0,0,114,250,
-    0,0,0,41,5,114,130,0,0,0,114,150,0,0,0,114,
-    58,0,0,0,114,42,0,0,0,114,162,0,0,0,114,7,
-    0,0,0,114,7,0,0,0,114,8,0,0,0,114,228,0,
-    0,0,60,4,0,0,115,24,0,0,0,10,1,10,1,2,
-    4,2,1,6,254,12,4,2,1,14,1,2,1,2,1,6,
-    253,255,128,122,29,83,111,117,114,99,101,108,101,115,115,70,
-    105,108,101,76,111,97,100,101,114,46,103,101,116,95,99,111,
-    100,101,99,2,0,0,0,0,0,0,0,0,0,0,0,2,
-    0,0,0,1,0,0,0,67,0,0,0,114,24,0,0,0,
-    41,2,122,39,82,101,116,117,114,110,32,78,111,110,101,32,
-    97,115,32,116,104,101,114,101,32,105,115,32,110,111,32,115,
-    111,117,114,99,101,32,99,111,100,101,46,78,114,7,0,0,
-    0,114,234,0,0,0,114,7,0,0,0,114,7,0,0,0,
-    114,8,0,0,0,114,244,0,0,0,76,4,0,0,114,25,
-    0,0,0,122,31,83,111,117,114,99,101,108,101,115,115,70,
-    105,108,101,76,111,97,100,101,114,46,103,101,116,95,115,111,
-    117,114,99,101,78,41,6,114,137,0,0,0,114,136,0,0,
-    0,114,138,0,0,0,114,139,0,0,0,114,228,0,0,0,
-    114,244,0,0,0,114,7,0,0,0,114,7,0,0,0,114,
-    7,0,0,0,114,8,0,0,0,114,26,1,0,0,56,4,
-    0,0,115,10,0,0,0,8,0,4,2,8,2,12,16,255,
-    128,114,26,1,0,0,99,0,0,0,0,0,0,0,0,0,
-    0,0,0,0,0,0,0,3,0,0,0,64,0,0,0,115,
-    92,0,0,0,101,0,90,1,100,0,90,2,100,1,90,3,
-    100,2,100,3,132,0,90,4,100,4,100,5,132,0,90,5,
-    100,6,100,7,132,0,90,6,100,8,100,9,132,0,90,7,
-    100,10,100,11,132,0,90,8,100,12,100,13,132,0,90,9,
-    100,14,100,15,132,0,90,10,100,16,100,17,132,0,90,11,
-    101,12,100,18,100,19,132,0,131,1,90,13,100,20,83,0,
-    41,21,114,17,1,0,0,122,93,76,111,97,100,101,114,32,
-    102,111,114,32,101,120,116,101,110,115,105,111,110,32,109,111,
-    100,117,108,101,115,46,10,10,32,32,32,32,84,104,101,32,
-    99,111,110,115,116,114,117,99,116,111,114,32,105,115,32,100,
-    101,115,105,103,110,101,100,32,116,111,32,119,111,114,107,32,
-    119,105,116,104,32,70,105,108,101,70,105,110,100,101,114,46,
-    10,10,32,32,32,32,99,3,0,0,0,0,0,0,0,0,
-    0,0,0,3,0,0,0,2,0,0,0,67,0,0,0,115,
-    16,0,0,0,124,1,124,0,95,0,124,2,124,0,95,1,
-    100,0,83,0,114,121,0,0,0,114,170,0,0,0,41,3,
-    114,130,0,0,0,114,128,0,0,0,114,58,0,0,0,114,
-    7,0,0,0,114,7,0,0,0,114,8,0,0,0,114,223,
-    0,0,0,89,4,0,0,115,6,0,0,0,6,1,10,1,
-    255,128,122,28,69,120,116,101,110,115,105,111,110,70,105,108,
-    101,76,111,97,100,101,114,46,95,95,105,110,105,116,95,95,
-    99,2,0,0,0,0,0,0,0,0,0,0,0,2,0,0,
-    0,2,0,0,0,67,0,0,0,114,255,0,0,0,114,121,
-    0,0,0,114,0,1,0,0,114,2,1,0,0,114,7,0,
-    0,0,114,7,0,0,0,114,8,0,0,0,114,3,1,0,
-    0,93,4,0,0,114,4,1,0,0,122,26,69,120,116,101,
-    110,115,105,111,110,70,105,108,101,76,111,97,100,101,114,46,
-    95,95,101,113,95,95,99,1,0,0,0,0,0,0,0,0,
-    0,0,0,1,0,0,0,3,0,0,0,67,0,0,0,114,
-    5,1,0,0,114,121,0,0,0,114,6,1,0,0,114,8,
-    1,0,0,114,7,0,0,0,114,7,0,0,0,114,8,0,
-    0,0,114,9,1,0,0,97,4,0,0,114,10,1,0,0,
-    122,28,69,120,116,101,110,115,105,111,110,70,105,108,101,76,
-    111,97,100,101,114,46,95,95,104,97,115,104,95,95,99,2,
-    0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,5,
-    0,0,0,67,0,0,0,115,36,0,0,0,116,0,160,1,
-    116,2,106,3,124,1,161,2,125,2,116,0,160,4,100,1,
-    124,1,106,5,124,0,106,6,161,3,1,0,124,2,83,0,
-    41,3,122,38,67,114,101,97,116,101,32,97,110,32,117,110,
-    105,116,105,97,108,105,122,101,100,32,101,120,116,101,110,115,
-    105,111,110,32,109,111,100,117,108,101,122,38,101,120,116,101,
-    110,115,105,111,110,32,109,111,100,117,108,101,32,123,33,114,
-    125,32,108,111,97,100,101,100,32,102,114,111,109,32,123,33,
-    114,125,78,41,7,114,146,0,0,0,114,229,0,0,0,114,
-    174,0,0,0,90,14,99,114,101,97,116,101,95,100,121,110,
-    97,109,105,99,114,160,0,0,0,114,128,0,0,0,114,58,
-    0,0,0,41,3,114,130,0,0,0,114,198,0,0,0,114,
-    231,0,0,0,114,7,0,0,0,114,7,0,0,0,114,8,
-    0,0,0,114,226,0,0,0,100,4,0,0,115,16,0,0,
-    0,4,2,6,1,4,255,6,2,8,1,4,255,4,2,255,
-    128,122,33,69,120,116,101,110,115,105,111,110,70,105,108,101,
-    76,111,97,100,101,114,46,99,114,101,97,116,101,95,109,111,
-    100,117,108,101,99,2,0,0,0,0,0,0,0,0,0,0,
-    0,2,0,0,0,5,0,0,0,67,0,0,0,115,36,0,
-    0,0,116,0,160,1,116,2,106,3,124,1,161,2,1,0,
-    116,0,160,4,100,1,124,0,106,5,124,0,106,6,161,3,
-    1,0,100,2,83,0,41,3,122,30,73,110,105,116,105,97,
-    108,105,122,101,32,97,110,32,101,120,116,101,110,115,105,111,
-    110,32,109,111,100,117,108,101,122,40,101,120,116,101,110,115,
-    105,111,110,32,109,111,100,117,108,101,32,123,33,114,125,32,
-    101,120,101,99,117,116,101,100,32,102,114,111,109,32,123,33,
-    114,125,78,41,7,114,146,0,0,0,114,229,0,0,0,114,
-    174,0,0,0,90,12,101,120,101,99,95,100,121,110,97,109,
-    105,99,114,160,0,0,0,114,128,0,0,0,114,58,0,0,
-    0,169,2,114,130,0,0,0,114,231,0,0,0,114,7,0,
+    90,5,100,6,100,7,132,0,90,6,101,7,135,0,102,1,
+    100,8,100,9,132,8,131,1,90,8,101,7,100,10,100,11,
+    132,0,131,1,90,9,100,12,100,13,132,0,90,10,101,7,
+    100,14,100,15,132,0,131,1,90,11,135,0,4,0,90,12,
+    83,0,41,16,218,10,70,105,108,101,76,111,97,100,101,114,
+    122,103,66,97,115,101,32,102,105,108,101,32,108,111,97,100,
+    101,114,32,99,108,97,115,115,32,119,104,105,99,104,32,105,
+    109,112,108,101,109,101,110,116,115,32,116,104,101,32,108,111,
+    97,100,101,114,32,112,114,111,116,111,99,111,108,32,109,101,
+    116,104,111,100,115,32,116,104,97,116,10,32,32,32,32,114,
+    101,113,117,105,114,101,32,102,105,108,101,32,115,121,115,116,
+    101,109,32,117,115,97,103,101,46,99,3,0,0,0,0,0,
+    0,0,0,0,0,0,3,0,0,0,2,0,0,0,67,0,
+    0,0,115,16,0,0,0,124,1,124,0,95,0,124,2,124,
+    0,95,1,100,1,83,0,41,2,122,75,67,97,99,104,101,
+    32,116,104,101,32,109,111,100,117,108,101,32,110,97,109,101,
+    32,97,110,100,32,116,104,101,32,112,97,116,104,32,116,111,
+    32,116,104,101,32,102,105,108,101,32,102,111,117,110,100,32,
+    98,121,32,116,104,101,10,32,32,32,32,32,32,32,32,102,
+    105,110,100,101,114,46,78,114,170,0,0,0,41,3,114,130,
+    0,0,0,114,150,0,0,0,114,58,0,0,0,114,7,0,
     0,0,114,7,0,0,0,114,8,0,0,0,114,232,0,0,
-    0,108,4,0,0,115,10,0,0,0,14,2,6,1,8,1,
-    8,255,255,128,122,31,69,120,116,101,110,115,105,111,110,70,
-    105,108,101,76,111,97,100,101,114,46,101,120,101,99,95,109,
-    111,100,117,108,101,99,2,0,0,0,0,0,0,0,0,0,
-    0,0,2,0,0,0,4,0,0,0,3,0,0,0,115,36,
-    0,0,0,116,0,124,0,106,1,131,1,100,1,25,0,137,
-    0,116,2,135,0,102,1,100,2,100,3,132,8,116,3,68,
-    0,131,1,131,1,83,0,41,5,122,49,82,101,116,117,114,
-    110,32,84,114,117,101,32,105,102,32,116,104,101,32,101,120,
-    116,101,110,115,105,111,110,32,109,111,100,117,108,101,32,105,
-    115,32,97,32,112,97,99,107,97,103,101,46,114,3,0,0,
-    0,99,1,0,0,0,0,0,0,0,0,0,0,0,2,0,
-    0,0,4,0,0,0,51,0,0,0,115,26,0,0,0,124,
-    0,93,18,125,1,136,0,100,0,124,1,23,0,107,2,86,
-    0,1,0,113,2,100,1,83,0,41,2,114,223,0,0,0,
-    78,114,7,0,0,0,169,2,114,5,0,0,0,218,6,115,
-    117,102,102,105,120,169,1,90,9,102,105,108,101,95,110,97,
-    109,101,114,7,0,0,0,114,8,0,0,0,114,9,0,0,
-    0,117,4,0,0,115,8,0,0,0,4,0,2,1,20,255,
-    255,128,122,49,69,120,116,101,110,115,105,111,110,70,105,108,
-    101,76,111,97,100,101,114,46,105,115,95,112,97,99,107,97,
-    103,101,46,60,108,111,99,97,108,115,62,46,60,103,101,110,
-    101,120,112,114,62,78,41,4,114,61,0,0,0,114,58,0,
-    0,0,218,3,97,110,121,114,219,0,0,0,114,234,0,0,
-    0,114,7,0,0,0,114,30,1,0,0,114,8,0,0,0,
-    114,193,0,0,0,114,4,0,0,115,10,0,0,0,14,2,
-    12,1,2,1,8,255,255,128,122,30,69,120,116,101,110,115,
-    105,111,110,70,105,108,101,76,111,97,100,101,114,46,105,115,
-    95,112,97,99,107,97,103,101,99,2,0,0,0,0,0,0,
-    0,0,0,0,0,2,0,0,0,1,0,0,0,67,0,0,
-    0,114,24,0,0,0,41,2,122,63,82,101,116,117,114,110,
-    32,78,111,110,101,32,97,115,32,97,110,32,101,120,116,101,
-    110,115,105,111,110,32,109,111,100,117,108,101,32,99,97,110,
-    110,111,116,32,99,114,101,97,116,101,32,97,32,99,111,100,
-    101,32,111,98,106,101,99,116,46,78,114,7,0,0,0,114,
-    234,0,0,0,114,7,0,0,0,114,7,0,0,0,114,8,
-    0,0,0,114,228,0,0,0,120,4,0,0,114,25,0,0,
-    0,122,28,69,120,116,101,110,115,105,111,110,70,105,108,101,
+    0,7,4,0,0,115,6,0,0,0,6,3,10,1,255,128,
+    122,19,70,105,108,101,76,111,97,100,101,114,46,95,95,105,
+    110,105,116,95,95,99,2,0,0,0,0,0,0,0,0,0,
+    0,0,2,0,0,0,2,0,0,0,67,0,0,0,243,24,
+    0,0,0,124,0,106,0,124,1,106,0,107,2,111,22,124,
+    0,106,1,124,1,106,1,107,2,83,0,114,121,0,0,0,
+    169,2,218,9,95,95,99,108,97,115,115,95,95,114,143,0,
+    0,0,169,2,114,130,0,0,0,90,5,111,116,104,101,114,
+    114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,218,
+    6,95,95,101,113,95,95,13,4,0,0,243,8,0,0,0,
+    12,1,10,1,2,255,255,128,122,17,70,105,108,101,76,111,
+    97,100,101,114,46,95,95,101,113,95,95,99,1,0,0,0,
+    0,0,0,0,0,0,0,0,1,0,0,0,3,0,0,0,
+    67,0,0,0,243,20,0,0,0,116,0,124,0,106,1,131,
+    1,116,0,124,0,106,2,131,1,65,0,83,0,114,121,0,
+    0,0,169,3,218,4,104,97,115,104,114,128,0,0,0,114,
+    58,0,0,0,169,1,114,130,0,0,0,114,7,0,0,0,
+    114,7,0,0,0,114,8,0,0,0,218,8,95,95,104,97,
+    115,104,95,95,17,4,0,0,243,4,0,0,0,20,1,255,
+    128,122,19,70,105,108,101,76,111,97,100,101,114,46,95,95,
+    104,97,115,104,95,95,99,2,0,0,0,0,0,0,0,0,
+    0,0,0,2,0,0,0,3,0,0,0,3,0,0,0,115,
+    16,0,0,0,116,0,116,1,124,0,131,2,160,2,124,1,
+    161,1,83,0,41,2,122,100,76,111,97,100,32,97,32,109,
+    111,100,117,108,101,32,102,114,111,109,32,97,32,102,105,108,
+    101,46,10,10,32,32,32,32,32,32,32,32,84,104,105,115,
+    32,109,101,116,104,111,100,32,105,115,32,100,101,112,114,101,
+    99,97,116,101,100,46,32,32,85,115,101,32,101,120,101,99,
+    95,109,111,100,117,108,101,40,41,32,105,110,115,116,101,97,
+    100,46,10,10,32,32,32,32,32,32,32,32,78,41,3,218,
+    5,115,117,112,101,114,114,7,1,0,0,114,244,0,0,0,
+    114,243,0,0,0,169,1,114,10,1,0,0,114,7,0,0,
+    0,114,8,0,0,0,114,244,0,0,0,20,4,0,0,115,
+    4,0,0,0,16,10,255,128,122,22,70,105,108,101,76,111,
+    97,100,101,114,46,108,111,97,100,95,109,111,100,117,108,101,
+    99,2,0,0,0,0,0,0,0,0,0,0,0,2,0,0,
+    0,1,0,0,0,67,0,0,0,243,6,0,0,0,124,0,
+    106,0,83,0,169,2,122,58,82,101,116,117,114,110,32,116,
+    104,101,32,112,97,116,104,32,116,111,32,116,104,101,32,115,
+    111,117,114,99,101,32,102,105,108,101,32,97,115,32,102,111,
+    117,110,100,32,98,121,32,116,104,101,32,102,105,110,100,101,
+    114,46,78,114,62,0,0,0,114,243,0,0,0,114,7,0,
+    0,0,114,7,0,0,0,114,8,0,0,0,114,199,0,0,
+    0,32,4,0,0,243,4,0,0,0,6,3,255,128,122,23,
+    70,105,108,101,76,111,97,100,101,114,46,103,101,116,95,102,
+    105,108,101,110,97,109,101,99,2,0,0,0,0,0,0,0,
+    0,0,0,0,3,0,0,0,8,0,0,0,67,0,0,0,
+    115,128,0,0,0,116,0,124,0,116,1,116,2,102,2,131,
+    2,114,72,116,3,160,4,116,5,124,1,131,1,161,1,143,
+    24,125,2,124,2,160,6,161,0,87,0,2,0,100,1,4,
+    0,4,0,131,3,1,0,83,0,49,0,115,58,119,1,1,
+    0,1,0,1,0,89,0,1,0,100,1,83,0,116,3,160,
+    7,124,1,100,2,161,2,143,24,125,2,124,2,160,6,161,
+    0,87,0,2,0,100,1,4,0,4,0,131,3,1,0,83,
+    0,49,0,115,114,119,1,1,0,1,0,1,0,89,0,1,
+    0,100,1,83,0,41,3,122,39,82,101,116,117,114,110,32,
+    116,104,101,32,100,97,116,97,32,102,114,111,109,32,112,97,
+    116,104,32,97,115,32,114,97,119,32,98,121,116,101,115,46,
+    78,218,1,114,41,8,114,172,0,0,0,114,245,0,0,0,
+    218,19,69,120,116,101,110,115,105,111,110,70,105,108,101,76,
+    111,97,100,101,114,114,79,0,0,0,114,178,0,0,0,114,
+    97,0,0,0,114,179,0,0,0,114,80,0,0,0,41,3,
+    114,130,0,0,0,114,58,0,0,0,114,83,0,0,0,114,
+    7,0,0,0,114,7,0,0,0,114,8,0,0,0,114,251,
+    0,0,0,37,4,0,0,115,16,0,0,0,14,2,16,1,
+    22,1,20,128,14,2,22,1,20,128,255,128,122,19,70,105,
+    108,101,76,111,97,100,101,114,46,103,101,116,95,100,97,116,
+    97,99,2,0,0,0,0,0,0,0,0,0,0,0,3,0,
+    0,0,2,0,0,0,67,0,0,0,115,20,0,0,0,100,
+    1,100,2,108,0,109,1,125,2,1,0,124,2,124,0,131,
+    1,83,0,41,3,78,114,0,0,0,0,41,1,218,10,70,
+    105,108,101,82,101,97,100,101,114,41,2,90,17,105,109,112,
+    111,114,116,108,105,98,46,114,101,97,100,101,114,115,114,27,
+    1,0,0,41,3,114,130,0,0,0,114,240,0,0,0,114,
+    27,1,0,0,114,7,0,0,0,114,7,0,0,0,114,8,
+    0,0,0,218,19,103,101,116,95,114,101,115,111,117,114,99,
+    101,95,114,101,97,100,101,114,46,4,0,0,115,6,0,0,
+    0,12,2,8,1,255,128,122,30,70,105,108,101,76,111,97,
+    100,101,114,46,103,101,116,95,114,101,115,111,117,114,99,101,
+    95,114,101,97,100,101,114,41,13,114,137,0,0,0,114,136,
+    0,0,0,114,138,0,0,0,114,139,0,0,0,114,232,0,
+    0,0,114,12,1,0,0,114,18,1,0,0,114,147,0,0,
+    0,114,244,0,0,0,114,199,0,0,0,114,251,0,0,0,
+    114,28,1,0,0,90,13,95,95,99,108,97,115,115,99,101,
+    108,108,95,95,114,7,0,0,0,114,7,0,0,0,114,21,
+    1,0,0,114,8,0,0,0,114,7,1,0,0,2,4,0,
+    0,115,26,0,0,0,8,0,4,2,8,3,8,6,8,4,
+    2,3,14,1,2,11,10,1,8,4,2,9,18,1,255,128,
+    114,7,1,0,0,99,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,3,0,0,0,64,0,0,0,115,46,
+    0,0,0,101,0,90,1,100,0,90,2,100,1,90,3,100,
+    2,100,3,132,0,90,4,100,4,100,5,132,0,90,5,100,
+    6,100,7,156,1,100,8,100,9,132,2,90,6,100,10,83,
+    0,41,11,218,16,83,111,117,114,99,101,70,105,108,101,76,
+    111,97,100,101,114,122,62,67,111,110,99,114,101,116,101,32,
+    105,109,112,108,101,109,101,110,116,97,116,105,111,110,32,111,
+    102,32,83,111,117,114,99,101,76,111,97,100,101,114,32,117,
+    115,105,110,103,32,116,104,101,32,102,105,108,101,32,115,121,
+    115,116,101,109,46,99,2,0,0,0,0,0,0,0,0,0,
+    0,0,3,0,0,0,3,0,0,0,67,0,0,0,115,22,
+    0,0,0,116,0,124,1,131,1,125,2,124,2,106,1,124,
+    2,106,2,100,1,156,2,83,0,41,3,122,33,82,101,116,
+    117,114,110,32,116,104,101,32,109,101,116,97,100,97,116,97,
+    32,102,111,114,32,116,104,101,32,112,97,116,104,46,41,2,
+    114,189,0,0,0,114,2,1,0,0,78,41,3,114,63,0,
+    0,0,114,180,0,0,0,114,181,0,0,0,41,3,114,130,
+    0,0,0,114,58,0,0,0,114,184,0,0,0,114,7,0,
+    0,0,114,7,0,0,0,114,8,0,0,0,114,248,0,0,
+    0,56,4,0,0,115,6,0,0,0,8,2,14,1,255,128,
+    122,27,83,111,117,114,99,101,70,105,108,101,76,111,97,100,
+    101,114,46,112,97,116,104,95,115,116,97,116,115,99,4,0,
+    0,0,0,0,0,0,0,0,0,0,5,0,0,0,5,0,
+    0,0,67,0,0,0,115,24,0,0,0,116,0,124,1,131,
+    1,125,4,124,0,106,1,124,2,124,3,124,4,100,1,141,
+    3,83,0,41,2,78,169,1,218,5,95,109,111,100,101,41,
+    2,114,126,0,0,0,114,249,0,0,0,41,5,114,130,0,
+    0,0,114,119,0,0,0,114,118,0,0,0,114,42,0,0,
+    0,114,66,0,0,0,114,7,0,0,0,114,7,0,0,0,
+    114,8,0,0,0,114,250,0,0,0,61,4,0,0,115,6,
+    0,0,0,8,2,16,1,255,128,122,32,83,111,117,114,99,
+    101,70,105,108,101,76,111,97,100,101,114,46,95,99,97,99,
+    104,101,95,98,121,116,101,99,111,100,101,114,75,0,0,0,
+    114,30,1,0,0,99,3,0,0,0,0,0,0,0,1,0,
+    0,0,9,0,0,0,11,0,0,0,67,0,0,0,115,254,
+    0,0,0,116,0,124,1,131,1,92,2,125,4,125,5,103,
+    0,125,6,124,4,114,62,116,1,124,4,131,1,115,62,116,
+    0,124,4,131,1,92,2,125,4,125,7,124,6,160,2,124,
+    7,161,1,1,0,124,4,114,62,116,1,124,4,131,1,114,
+    28,116,3,124,6,131,1,68,0,93,96,125,7,116,4,124,
+    4,124,7,131,2,125,4,122,14,116,5,160,6,124,4,161,
+    1,1,0,87,0,113,70,4,0,116,7,121,116,1,0,1,
+    0,1,0,89,0,113,70,4,0,116,8,121,252,1,0,125,
+    8,1,0,122,30,116,9,160,10,100,1,124,4,124,8,161,
+    3,1,0,87,0,89,0,100,2,125,8,126,8,1,0,100,
+    2,83,0,100,2,125,8,126,8,119,1,122,30,116,11,124,
+    1,124,2,124,3,131,3,1,0,116,9,160,10,100,3,124,
+    1,161,2,1,0,87,0,100,2,83,0,4,0,116,8,121,
+    250,1,0,125,8,1,0,122,28,116,9,160,10,100,1,124,
+    1,124,8,161,3,1,0,87,0,89,0,100,2,125,8,126,
+    8,100,2,83,0,100,2,125,8,126,8,119,1,119,0,119,
+    0,41,4,122,27,87,114,105,116,101,32,98,121,116,101,115,
+    32,100,97,116,97,32,116,111,32,97,32,102,105,108,101,46,
+    122,27,99,111,117,108,100,32,110,111,116,32,99,114,101,97,
+    116,101,32,123,33,114,125,58,32,123,33,114,125,78,122,12,
+    99,114,101,97,116,101,100,32,123,33,114,125,41,12,114,61,
+    0,0,0,114,71,0,0,0,114,206,0,0,0,114,56,0,
+    0,0,114,54,0,0,0,114,19,0,0,0,90,5,109,107,
+    100,105,114,218,15,70,105,108,101,69,120,105,115,116,115,69,
+    114,114,111,114,114,64,0,0,0,114,146,0,0,0,114,160,
+    0,0,0,114,84,0,0,0,41,9,114,130,0,0,0,114,
+    58,0,0,0,114,42,0,0,0,114,31,1,0,0,218,6,
+    112,97,114,101,110,116,114,108,0,0,0,114,53,0,0,0,
+    114,49,0,0,0,114,252,0,0,0,114,7,0,0,0,114,
+    7,0,0,0,114,8,0,0,0,114,249,0,0,0,66,4,
+    0,0,115,58,0,0,0,12,2,4,1,12,2,12,1,10,
+    1,12,254,12,4,10,1,2,1,14,1,12,1,4,2,14,
+    1,6,3,4,1,4,255,16,2,8,128,2,1,12,1,18,
+    1,14,1,8,2,2,1,18,255,8,128,2,254,2,247,255,
+    128,122,25,83,111,117,114,99,101,70,105,108,101,76,111,97,
+    100,101,114,46,115,101,116,95,100,97,116,97,78,41,7,114,
+    137,0,0,0,114,136,0,0,0,114,138,0,0,0,114,139,
+    0,0,0,114,248,0,0,0,114,250,0,0,0,114,249,0,
+    0,0,114,7,0,0,0,114,7,0,0,0,114,7,0,0,
+    0,114,8,0,0,0,114,29,1,0,0,52,4,0,0,115,
+    12,0,0,0,8,0,4,2,8,2,8,5,18,5,255,128,
+    114,29,1,0,0,99,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,2,0,0,0,64,0,0,0,115,32,
+    0,0,0,101,0,90,1,100,0,90,2,100,1,90,3,100,
+    2,100,3,132,0,90,4,100,4,100,5,132,0,90,5,100,
+    6,83,0,41,7,218,20,83,111,117,114,99,101,108,101,115,
+    115,70,105,108,101,76,111,97,100,101,114,122,45,76,111,97,
+    100,101,114,32,119,104,105,99,104,32,104,97,110,100,108,101,
+    115,32,115,111,117,114,99,101,108,101,115,115,32,102,105,108,
+    101,32,105,109,112,111,114,116,115,46,99,2,0,0,0,0,
+    0,0,0,0,0,0,0,5,0,0,0,5,0,0,0,67,
+    0,0,0,115,68,0,0,0,124,0,160,0,124,1,161,1,
+    125,2,124,0,160,1,124,2,161,1,125,3,124,1,124,2,
+    100,1,156,2,125,4,116,2,124,3,124,1,124,4,131,3,
+    1,0,116,3,116,4,124,3,131,1,100,2,100,0,133,2,
+    25,0,124,1,124,2,100,3,141,3,83,0,41,4,78,114,
+    170,0,0,0,114,156,0,0,0,41,2,114,128,0,0,0,
+    114,118,0,0,0,41,5,114,199,0,0,0,114,251,0,0,
+    0,114,163,0,0,0,114,176,0,0,0,114,182,0,0,0,
+    41,5,114,130,0,0,0,114,150,0,0,0,114,58,0,0,
+    0,114,42,0,0,0,114,162,0,0,0,114,7,0,0,0,
+    114,7,0,0,0,114,8,0,0,0,114,237,0,0,0,101,
+    4,0,0,115,24,0,0,0,10,1,10,1,2,4,2,1,
+    6,254,12,4,2,1,14,1,2,1,2,1,6,253,255,128,
+    122,29,83,111,117,114,99,101,108,101,115,115,70,105,108,101,
     76,111,97,100,101,114,46,103,101,116,95,99,111,100,101,99,
     2,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,
     1,0,0,0,67,0,0,0,114,24,0,0,0,41,2,122,
-    53,82,101,116,117,114,110,32,78,111,110,101,32,97,115,32,
-    101,120,116,101,110,115,105,111,110,32,109,111,100,117,108,101,
-    115,32,104,97,118,101,32,110,111,32,115,111,117,114,99,101,
-    32,99,111,100,101,46,78,114,7,0,0,0,114,234,0,0,
+    39,82,101,116,117,114,110,32,78,111,110,101,32,97,115,32,
+    116,104,101,114,101,32,105,115,32,110,111,32,115,111,117,114,
+    99,101,32,99,111,100,101,46,78,114,7,0,0,0,114,243,
+    0,0,0,114,7,0,0,0,114,7,0,0,0,114,8,0,
+    0,0,114,253,0,0,0,117,4,0,0,114,25,0,0,0,
+    122,31,83,111,117,114,99,101,108,101,115,115,70,105,108,101,
+    76,111,97,100,101,114,46,103,101,116,95,115,111,117,114,99,
+    101,78,41,6,114,137,0,0,0,114,136,0,0,0,114,138,
+    0,0,0,114,139,0,0,0,114,237,0,0,0,114,253,0,
+    0,0,114,7,0,0,0,114,7,0,0,0,114,7,0,0,
+    0,114,8,0,0,0,114,34,1,0,0,97,4,0,0,115,
+    10,0,0,0,8,0,4,2,8,2,12,16,255,128,114,34,
+    1,0,0,99,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,3,0,0,0,64,0,0,0,115,92,0,0,
+    0,101,0,90,1,100,0,90,2,100,1,90,3,100,2,100,
+    3,132,0,90,4,100,4,100,5,132,0,90,5,100,6,100,
+    7,132,0,90,6,100,8,100,9,132,0,90,7,100,10,100,
+    11,132,0,90,8,100,12,100,13,132,0,90,9,100,14,100,
+    15,132,0,90,10,100,16,100,17,132,0,90,11,101,12,100,
+    18,100,19,132,0,131,1,90,13,100,20,83,0,41,21,114,
+    26,1,0,0,122,93,76,111,97,100,101,114,32,102,111,114,
+    32,101,120,116,101,110,115,105,111,110,32,109,111,100,117,108,
+    101,115,46,10,10,32,32,32,32,84,104,101,32,99,111,110,
+    115,116,114,117,99,116,111,114,32,105,115,32,100,101,115,105,
+    103,110,101,100,32,116,111,32,119,111,114,107,32,119,105,116,
+    104,32,70,105,108,101,70,105,110,100,101,114,46,10,10,32,
+    32,32,32,99,3,0,0,0,0,0,0,0,0,0,0,0,
+    3,0,0,0,2,0,0,0,67,0,0,0,115,16,0,0,
+    0,124,1,124,0,95,0,124,2,124,0,95,1,100,0,83,
+    0,114,121,0,0,0,114,170,0,0,0,41,3,114,130,0,
+    0,0,114,128,0,0,0,114,58,0,0,0,114,7,0,0,
+    0,114,7,0,0,0,114,8,0,0,0,114,232,0,0,0,
+    130,4,0,0,115,6,0,0,0,6,1,10,1,255,128,122,
+    28,69,120,116,101,110,115,105,111,110,70,105,108,101,76,111,
+    97,100,101,114,46,95,95,105,110,105,116,95,95,99,2,0,
+    0,0,0,0,0,0,0,0,0,0,2,0,0,0,2,0,
+    0,0,67,0,0,0,114,8,1,0,0,114,121,0,0,0,
+    114,9,1,0,0,114,11,1,0,0,114,7,0,0,0,114,
+    7,0,0,0,114,8,0,0,0,114,12,1,0,0,134,4,
+    0,0,114,13,1,0,0,122,26,69,120,116,101,110,115,105,
+    111,110,70,105,108,101,76,111,97,100,101,114,46,95,95,101,
+    113,95,95,99,1,0,0,0,0,0,0,0,0,0,0,0,
+    1,0,0,0,3,0,0,0,67,0,0,0,114,14,1,0,
+    0,114,121,0,0,0,114,15,1,0,0,114,17,1,0,0,
+    114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,114,
+    18,1,0,0,138,4,0,0,114,19,1,0,0,122,28,69,
+    120,116,101,110,115,105,111,110,70,105,108,101,76,111,97,100,
+    101,114,46,95,95,104,97,115,104,95,95,99,2,0,0,0,
+    0,0,0,0,0,0,0,0,3,0,0,0,5,0,0,0,
+    67,0,0,0,115,36,0,0,0,116,0,160,1,116,2,106,
+    3,124,1,161,2,125,2,116,0,160,4,100,1,124,1,106,
+    5,124,0,106,6,161,3,1,0,124,2,83,0,41,3,122,
+    38,67,114,101,97,116,101,32,97,110,32,117,110,105,116,105,
+    97,108,105,122,101,100,32,101,120,116,101,110,115,105,111,110,
+    32,109,111,100,117,108,101,122,38,101,120,116,101,110,115,105,
+    111,110,32,109,111,100,117,108,101,32,123,33,114,125,32,108,
+    111,97,100,101,100,32,102,114,111,109,32,123,33,114,125,78,
+    41,7,114,146,0,0,0,114,238,0,0,0,114,174,0,0,
+    0,90,14,99,114,101,97,116,101,95,100,121,110,97,109,105,
+    99,114,160,0,0,0,114,128,0,0,0,114,58,0,0,0,
+    41,3,114,130,0,0,0,114,207,0,0,0,114,240,0,0,
     0,114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,
-    114,244,0,0,0,124,4,0,0,114,25,0,0,0,122,30,
+    114,235,0,0,0,141,4,0,0,115,16,0,0,0,4,2,
+    6,1,4,255,6,2,8,1,4,255,4,2,255,128,122,33,
     69,120,116,101,110,115,105,111,110,70,105,108,101,76,111,97,
-    100,101,114,46,103,101,116,95,115,111,117,114,99,101,99,2,
-    0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,1,
-    0,0,0,67,0,0,0,114,13,1,0,0,114,14,1,0,
-    0,114,62,0,0,0,114,234,0,0,0,114,7,0,0,0,
-    114,7,0,0,0,114,8,0,0,0,114,190,0,0,0,128,
-    4,0,0,114,15,1,0,0,122,32,69,120,116,101,110,115,
-    105,111,110,70,105,108,101,76,111,97,100,101,114,46,103,101,
-    116,95,102,105,108,101,110,97,109,101,78,41,14,114,137,0,
-    0,0,114,136,0,0,0,114,138,0,0,0,114,139,0,0,
-    0,114,223,0,0,0,114,3,1,0,0,114,9,1,0,0,
-    114,226,0,0,0,114,232,0,0,0,114,193,0,0,0,114,
-    228,0,0,0,114,244,0,0,0,114,147,0,0,0,114,190,
-    0,0,0,114,7,0,0,0,114,7,0,0,0,114,7,0,
-    0,0,114,8,0,0,0,114,17,1,0,0,81,4,0,0,
-    115,26,0,0,0,8,0,4,2,8,6,8,4,8,4,8,
-    3,8,8,8,6,8,6,8,4,2,4,14,1,255,128,114,
-    17,1,0,0,99,0,0,0,0,0,0,0,0,0,0,0,
-    0,0,0,0,0,2,0,0,0,64,0,0,0,115,104,0,
-    0,0,101,0,90,1,100,0,90,2,100,1,90,3,100,2,
-    100,3,132,0,90,4,100,4,100,5,132,0,90,5,100,6,
-    100,7,132,0,90,6,100,8,100,9,132,0,90,7,100,10,
-    100,11,132,0,90,8,100,12,100,13,132,0,90,9,100,14,
-    100,15,132,0,90,10,100,16,100,17,132,0,90,11,100,18,
-    100,19,132,0,90,12,100,20,100,21,132,0,90,13,100,22,
-    100,23,132,0,90,14,100,24,83,0,41,25,218,14,95,78,
-    97,109,101,115,112,97,99,101,80,97,116,104,97,38,1,0,
-    0,82,101,112,114,101,115,101,110,116,115,32,97,32,110,97,
-    109,101,115,112,97,99,101,32,112,97,99,107,97,103,101,39,
-    115,32,112,97,116,104,46,32,32,73,116,32,117,115,101,115,
-    32,116,104,101,32,109,111,100,117,108,101,32,110,97,109,101,
-    10,32,32,32,32,116,111,32,102,105,110,100,32,105,116,115,
-    32,112,97,114,101,110,116,32,109,111,100,117,108,101,44,32,
-    97,110,100,32,102,114,111,109,32,116,104,101,114,101,32,105,
-    116,32,108,111,111,107,115,32,117,112,32,116,104,101,32,112,
-    97,114,101,110,116,39,115,10,32,32,32,32,95,95,112,97,
-    116,104,95,95,46,32,32,87,104,101,110,32,116,104,105,115,
-    32,99,104,97,110,103,101,115,44,32,116,104,101,32,109,111,
-    100,117,108,101,39,115,32,111,119,110,32,112,97,116,104,32,
-    105,115,32,114,101,99,111,109,112,117,116,101,100,44,10,32,
-    32,32,32,117,115,105,110,103,32,112,97,116,104,95,102,105,
-    110,100,101,114,46,32,32,70,111,114,32,116,111,112,45,108,
-    101,118,101,108,32,109,111,100,117,108,101,115,44,32,116,104,
-    101,32,112,97,114,101,110,116,32,109,111,100,117,108,101,39,
-    115,32,112,97,116,104,10,32,32,32,32,105,115,32,115,121,
-    115,46,112,97,116,104,46,99,4,0,0,0,0,0,0,0,
-    0,0,0,0,4,0,0,0,3,0,0,0,67,0,0,0,
-    115,36,0,0,0,124,1,124,0,95,0,124,2,124,0,95,
-    1,116,2,124,0,160,3,161,0,131,1,124,0,95,4,124,
-    3,124,0,95,5,100,0,83,0,114,121,0,0,0,41,6,
-    218,5,95,110,97,109,101,218,5,95,112,97,116,104,114,123,
-    0,0,0,218,16,95,103,101,116,95,112,97,114,101,110,116,
-    95,112,97,116,104,218,17,95,108,97,115,116,95,112,97,114,
-    101,110,116,95,112,97,116,104,218,12,95,112,97,116,104,95,
-    102,105,110,100,101,114,169,4,114,130,0,0,0,114,128,0,
-    0,0,114,58,0,0,0,90,11,112,97,116,104,95,102,105,
-    110,100,101,114,114,7,0,0,0,114,7,0,0,0,114,8,
-    0,0,0,114,223,0,0,0,141,4,0,0,115,10,0,0,
-    0,6,1,6,1,14,1,10,1,255,128,122,23,95,78,97,
-    109,101,115,112,97,99,101,80,97,116,104,46,95,95,105,110,
-    105,116,95,95,99,1,0,0,0,0,0,0,0,0,0,0,
-    0,4,0,0,0,3,0,0,0,67,0,0,0,115,38,0,
-    0,0,124,0,106,0,160,1,100,1,161,1,92,3,125,1,
-    125,2,125,3,124,2,100,2,107,2,114,30,100,3,83,0,
-    124,1,100,4,102,2,83,0,41,6,122,62,82,101,116,117,
-    114,110,115,32,97,32,116,117,112,108,101,32,111,102,32,40,
-    112,97,114,101,110,116,45,109,111,100,117,108,101,45,110,97,
-    109,101,44,32,112,97,114,101,110,116,45,112,97,116,104,45,
-    97,116,116,114,45,110,97,109,101,41,114,86,0,0,0,114,
-    10,0,0,0,41,2,114,16,0,0,0,114,58,0,0,0,
-    90,8,95,95,112,97,116,104,95,95,78,41,2,114,33,1,
-    0,0,114,55,0,0,0,41,4,114,130,0,0,0,114,25,
-    1,0,0,218,3,100,111,116,90,2,109,101,114,7,0,0,
-    0,114,7,0,0,0,114,8,0,0,0,218,23,95,102,105,
-    110,100,95,112,97,114,101,110,116,95,112,97,116,104,95,110,
-    97,109,101,115,147,4,0,0,115,10,0,0,0,18,2,8,
-    1,4,2,8,3,255,128,122,38,95,78,97,109,101,115,112,
-    97,99,101,80,97,116,104,46,95,102,105,110,100,95,112,97,
-    114,101,110,116,95,112,97,116,104,95,110,97,109,101,115,99,
-    1,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,
-    3,0,0,0,67,0,0,0,115,28,0,0,0,124,0,160,
-    0,161,0,92,2,125,1,125,2,116,1,116,2,106,3,124,
-    1,25,0,124,2,131,2,83,0,114,121,0,0,0,41,4,
-    114,40,1,0,0,114,142,0,0,0,114,16,0,0,0,218,
-    7,109,111,100,117,108,101,115,41,3,114,130,0,0,0,90,
-    18,112,97,114,101,110,116,95,109,111,100,117,108,101,95,110,
-    97,109,101,90,14,112,97,116,104,95,97,116,116,114,95,110,
-    97,109,101,114,7,0,0,0,114,7,0,0,0,114,8,0,
-    0,0,114,35,1,0,0,157,4,0,0,115,6,0,0,0,
-    12,1,16,1,255,128,122,31,95,78,97,109,101,115,112,97,
-    99,101,80,97,116,104,46,95,103,101,116,95,112,97,114,101,
-    110,116,95,112,97,116,104,99,1,0,0,0,0,0,0,0,
-    0,0,0,0,3,0,0,0,4,0,0,0,67,0,0,0,
-    115,80,0,0,0,116,0,124,0,160,1,161,0,131,1,125,
-    1,124,1,124,0,106,2,107,3,114,74,124,0,160,3,124,
-    0,106,4,124,1,161,2,125,2,124,2,100,0,117,1,114,
-    68,124,2,106,5,100,0,117,0,114,68,124,2,106,6,114,
-    68,124,2,106,6,124,0,95,7,124,1,124,0,95,2,124,
-    0,106,7,83,0,114,121,0,0,0,41,8,114,123,0,0,
-    0,114,35,1,0,0,114,36,1,0,0,114,37,1,0,0,
-    114,33,1,0,0,114,151,0,0,0,114,189,0,0,0,114,
-    34,1,0,0,41,3,114,130,0,0,0,90,11,112,97,114,
-    101,110,116,95,112,97,116,104,114,198,0,0,0,114,7,0,
-    0,0,114,7,0,0,0,114,8,0,0,0,218,12,95,114,
-    101,99,97,108,99,117,108,97,116,101,161,4,0,0,115,18,
-    0,0,0,12,2,10,1,14,1,18,3,6,1,8,1,6,
-    1,6,1,255,128,122,27,95,78,97,109,101,115,112,97,99,
-    101,80,97,116,104,46,95,114,101,99,97,108,99,117,108,97,
-    116,101,99,1,0,0,0,0,0,0,0,0,0,0,0,1,
-    0,0,0,3,0,0,0,67,0,0,0,243,12,0,0,0,
-    116,0,124,0,160,1,161,0,131,1,83,0,114,121,0,0,
-    0,41,2,218,4,105,116,101,114,114,42,1,0,0,114,8,
-    1,0,0,114,7,0,0,0,114,7,0,0,0,114,8,0,
-    0,0,218,8,95,95,105,116,101,114,95,95,174,4,0,0,
-    243,4,0,0,0,12,1,255,128,122,23,95,78,97,109,101,
-    115,112,97,99,101,80,97,116,104,46,95,95,105,116,101,114,
-    95,95,99,2,0,0,0,0,0,0,0,0,0,0,0,2,
-    0,0,0,2,0,0,0,67,0,0,0,115,12,0,0,0,
-    124,0,160,0,161,0,124,1,25,0,83,0,114,121,0,0,
-    0,169,1,114,42,1,0,0,41,2,114,130,0,0,0,218,
-    5,105,110,100,101,120,114,7,0,0,0,114,7,0,0,0,
-    114,8,0,0,0,218,11,95,95,103,101,116,105,116,101,109,
-    95,95,177,4,0,0,114,46,1,0,0,122,26,95,78,97,
-    109,101,115,112,97,99,101,80,97,116,104,46,95,95,103,101,
-    116,105,116,101,109,95,95,99,3,0,0,0,0,0,0,0,
-    0,0,0,0,3,0,0,0,3,0,0,0,67,0,0,0,
-    115,14,0,0,0,124,2,124,0,106,0,124,1,60,0,100,
-    0,83,0,114,121,0,0,0,41,1,114,34,1,0,0,41,
-    3,114,130,0,0,0,114,48,1,0,0,114,58,0,0,0,
+    100,101,114,46,99,114,101,97,116,101,95,109,111,100,117,108,
+    101,99,2,0,0,0,0,0,0,0,0,0,0,0,2,0,
+    0,0,5,0,0,0,67,0,0,0,115,36,0,0,0,116,
+    0,160,1,116,2,106,3,124,1,161,2,1,0,116,0,160,
+    4,100,1,124,0,106,5,124,0,106,6,161,3,1,0,100,
+    2,83,0,41,3,122,30,73,110,105,116,105,97,108,105,122,
+    101,32,97,110,32,101,120,116,101,110,115,105,111,110,32,109,
+    111,100,117,108,101,122,40,101,120,116,101,110,115,105,111,110,
+    32,109,111,100,117,108,101,32,123,33,114,125,32,101,120,101,
+    99,117,116,101,100,32,102,114,111,109,32,123,33,114,125,78,
+    41,7,114,146,0,0,0,114,238,0,0,0,114,174,0,0,
+    0,90,12,101,120,101,99,95,100,121,110,97,109,105,99,114,
+    160,0,0,0,114,128,0,0,0,114,58,0,0,0,169,2,
+    114,130,0,0,0,114,240,0,0,0,114,7,0,0,0,114,
+    7,0,0,0,114,8,0,0,0,114,241,0,0,0,149,4,
+    0,0,115,10,0,0,0,14,2,6,1,8,1,8,255,255,
+    128,122,31,69,120,116,101,110,115,105,111,110,70,105,108,101,
+    76,111,97,100,101,114,46,101,120,101,99,95,109,111,100,117,
+    108,101,99,2,0,0,0,0,0,0,0,0,0,0,0,2,
+    0,0,0,4,0,0,0,3,0,0,0,115,36,0,0,0,
+    116,0,124,0,106,1,131,1,100,1,25,0,137,0,116,2,
+    135,0,102,1,100,2,100,3,132,8,116,3,68,0,131,1,
+    131,1,83,0,41,5,122,49,82,101,116,117,114,110,32,84,
+    114,117,101,32,105,102,32,116,104,101,32,101,120,116,101,110,
+    115,105,111,110,32,109,111,100,117,108,101,32,105,115,32,97,
+    32,112,97,99,107,97,103,101,46,114,3,0,0,0,99,1,
+    0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,4,
+    0,0,0,51,0,0,0,115,26,0,0,0,124,0,93,18,
+    125,1,136,0,100,0,124,1,23,0,107,2,86,0,1,0,
+    113,2,100,1,83,0,41,2,114,232,0,0,0,78,114,7,
+    0,0,0,169,2,114,5,0,0,0,218,6,115,117,102,102,
+    105,120,169,1,90,9,102,105,108,101,95,110,97,109,101,114,
+    7,0,0,0,114,8,0,0,0,114,9,0,0,0,158,4,
+    0,0,115,8,0,0,0,4,0,2,1,20,255,255,128,122,
+    49,69,120,116,101,110,115,105,111,110,70,105,108,101,76,111,
+    97,100,101,114,46,105,115,95,112,97,99,107,97,103,101,46,
+    60,108,111,99,97,108,115,62,46,60,103,101,110,101,120,112,
+    114,62,78,41,4,114,61,0,0,0,114,58,0,0,0,218,
+    3,97,110,121,114,228,0,0,0,114,243,0,0,0,114,7,
+    0,0,0,114,38,1,0,0,114,8,0,0,0,114,202,0,
+    0,0,155,4,0,0,115,10,0,0,0,14,2,12,1,2,
+    1,8,255,255,128,122,30,69,120,116,101,110,115,105,111,110,
+    70,105,108,101,76,111,97,100,101,114,46,105,115,95,112,97,
+    99,107,97,103,101,99,2,0,0,0,0,0,0,0,0,0,
+    0,0,2,0,0,0,1,0,0,0,67,0,0,0,114,24,
+    0,0,0,41,2,122,63,82,101,116,117,114,110,32,78,111,
+    110,101,32,97,115,32,97,110,32,101,120,116,101,110,115,105,
+    111,110,32,109,111,100,117,108,101,32,99,97,110,110,111,116,
+    32,99,114,101,97,116,101,32,97,32,99,111,100,101,32,111,
+    98,106,101,99,116,46,78,114,7,0,0,0,114,243,0,0,
+    0,114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,
+    114,237,0,0,0,161,4,0,0,114,25,0,0,0,122,28,
+    69,120,116,101,110,115,105,111,110,70,105,108,101,76,111,97,
+    100,101,114,46,103,101,116,95,99,111,100,101,99,2,0,0,
+    0,0,0,0,0,0,0,0,0,2,0,0,0,1,0,0,
+    0,67,0,0,0,114,24,0,0,0,41,2,122,53,82,101,
+    116,117,114,110,32,78,111,110,101,32,97,115,32,101,120,116,
+    101,110,115,105,111,110,32,109,111,100,117,108,101,115,32,104,
+    97,118,101,32,110,111,32,115,111,117,114,99,101,32,99,111,
+    100,101,46,78,114,7,0,0,0,114,243,0,0,0,114,7,
+    0,0,0,114,7,0,0,0,114,8,0,0,0,114,253,0,
+    0,0,165,4,0,0,114,25,0,0,0,122,30,69,120,116,
+    101,110,115,105,111,110,70,105,108,101,76,111,97,100,101,114,
+    46,103,101,116,95,115,111,117,114,99,101,99,2,0,0,0,
+    0,0,0,0,0,0,0,0,2,0,0,0,1,0,0,0,
+    67,0,0,0,114,22,1,0,0,114,23,1,0,0,114,62,
+    0,0,0,114,243,0,0,0,114,7,0,0,0,114,7,0,
+    0,0,114,8,0,0,0,114,199,0,0,0,169,4,0,0,
+    114,24,1,0,0,122,32,69,120,116,101,110,115,105,111,110,
+    70,105,108,101,76,111,97,100,101,114,46,103,101,116,95,102,
+    105,108,101,110,97,109,101,78,41,14,114,137,0,0,0,114,
+    136,0,0,0,114,138,0,0,0,114,139,0,0,0,114,232,
+    0,0,0,114,12,1,0,0,114,18,1,0,0,114,235,0,
+    0,0,114,241,0,0,0,114,202,0,0,0,114,237,0,0,
+    0,114,253,0,0,0,114,147,0,0,0,114,199,0,0,0,
+    114,7,0,0,0,114,7,0,0,0,114,7,0,0,0,114,
+    8,0,0,0,114,26,1,0,0,122,4,0,0,115,26,0,
+    0,0,8,0,4,2,8,6,8,4,8,4,8,3,8,8,
+    8,6,8,6,8,4,2,4,14,1,255,128,114,26,1,0,
+    0,99,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,2,0,0,0,64,0,0,0,115,104,0,0,0,101,
+    0,90,1,100,0,90,2,100,1,90,3,100,2,100,3,132,
+    0,90,4,100,4,100,5,132,0,90,5,100,6,100,7,132,
+    0,90,6,100,8,100,9,132,0,90,7,100,10,100,11,132,
+    0,90,8,100,12,100,13,132,0,90,9,100,14,100,15,132,
+    0,90,10,100,16,100,17,132,0,90,11,100,18,100,19,132,
+    0,90,12,100,20,100,21,132,0,90,13,100,22,100,23,132,
+    0,90,14,100,24,83,0,41,25,218,14,95,78,97,109,101,
+    115,112,97,99,101,80,97,116,104,97,38,1,0,0,82,101,
+    112,114,101,115,101,110,116,115,32,97,32,110,97,109,101,115,
+    112,97,99,101,32,112,97,99,107,97,103,101,39,115,32,112,
+    97,116,104,46,32,32,73,116,32,117,115,101,115,32,116,104,
+    101,32,109,111,100,117,108,101,32,110,97,109,101,10,32,32,
+    32,32,116,111,32,102,105,110,100,32,105,116,115,32,112,97,
+    114,101,110,116,32,109,111,100,117,108,101,44,32,97,110,100,
+    32,102,114,111,109,32,116,104,101,114,101,32,105,116,32,108,
+    111,111,107,115,32,117,112,32,116,104,101,32,112,97,114,101,
+    110,116,39,115,10,32,32,32,32,95,95,112,97,116,104,95,
+    95,46,32,32,87,104,101,110,32,116,104,105,115,32,99,104,
+    97,110,103,101,115,44,32,116,104,101,32,109,111,100,117,108,
+    101,39,115,32,111,119,110,32,112,97,116,104,32,105,115,32,
+    114,101,99,111,109,112,117,116,101,100,44,10,32,32,32,32,
+    117,115,105,110,103,32,112,97,116,104,95,102,105,110,100,101,
+    114,46,32,32,70,111,114,32,116,111,112,45,108,101,118,101,
+    108,32,109,111,100,117,108,101,115,44,32,116,104,101,32,112,
+    97,114,101,110,116,32,109,111,100,117,108,101,39,115,32,112,
+    97,116,104,10,32,32,32,32,105,115,32,115,121,115,46,112,
+    97,116,104,46,99,4,0,0,0,0,0,0,0,0,0,0,
+    0,4,0,0,0,3,0,0,0,67,0,0,0,115,36,0,
+    0,0,124,1,124,0,95,0,124,2,124,0,95,1,116,2,
+    124,0,160,3,161,0,131,1,124,0,95,4,124,3,124,0,
+    95,5,100,0,83,0,114,121,0,0,0,41,6,218,5,95,
+    110,97,109,101,218,5,95,112,97,116,104,114,123,0,0,0,
+    218,16,95,103,101,116,95,112,97,114,101,110,116,95,112,97,
+    116,104,218,17,95,108,97,115,116,95,112,97,114,101,110,116,
+    95,112,97,116,104,218,12,95,112,97,116,104,95,102,105,110,
+    100,101,114,169,4,114,130,0,0,0,114,128,0,0,0,114,
+    58,0,0,0,90,11,112,97,116,104,95,102,105,110,100,101,
+    114,114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,
+    114,232,0,0,0,182,4,0,0,115,10,0,0,0,6,1,
+    6,1,14,1,10,1,255,128,122,23,95,78,97,109,101,115,
+    112,97,99,101,80,97,116,104,46,95,95,105,110,105,116,95,
+    95,99,1,0,0,0,0,0,0,0,0,0,0,0,4,0,
+    0,0,3,0,0,0,67,0,0,0,115,38,0,0,0,124,
+    0,106,0,160,1,100,1,161,1,92,3,125,1,125,2,125,
+    3,124,2,100,2,107,2,114,30,100,3,83,0,124,1,100,
+    4,102,2,83,0,41,6,122,62,82,101,116,117,114,110,115,
+    32,97,32,116,117,112,108,101,32,111,102,32,40,112,97,114,
+    101,110,116,45,109,111,100,117,108,101,45,110,97,109,101,44,
+    32,112,97,114,101,110,116,45,112,97,116,104,45,97,116,116,
+    114,45,110,97,109,101,41,114,86,0,0,0,114,10,0,0,
+    0,41,2,114,16,0,0,0,114,58,0,0,0,90,8,95,
+    95,112,97,116,104,95,95,78,41,2,114,41,1,0,0,114,
+    55,0,0,0,41,4,114,130,0,0,0,114,33,1,0,0,
+    218,3,100,111,116,90,2,109,101,114,7,0,0,0,114,7,
+    0,0,0,114,8,0,0,0,218,23,95,102,105,110,100,95,
+    112,97,114,101,110,116,95,112,97,116,104,95,110,97,109,101,
+    115,188,4,0,0,115,10,0,0,0,18,2,8,1,4,2,
+    8,3,255,128,122,38,95,78,97,109,101,115,112,97,99,101,
+    80,97,116,104,46,95,102,105,110,100,95,112,97,114,101,110,
+    116,95,112,97,116,104,95,110,97,109,101,115,99,1,0,0,
+    0,0,0,0,0,0,0,0,0,3,0,0,0,3,0,0,
+    0,67,0,0,0,115,28,0,0,0,124,0,160,0,161,0,
+    92,2,125,1,125,2,116,1,116,2,106,3,124,1,25,0,
+    124,2,131,2,83,0,114,121,0,0,0,41,4,114,48,1,
+    0,0,114,142,0,0,0,114,16,0,0,0,218,7,109,111,
+    100,117,108,101,115,41,3,114,130,0,0,0,90,18,112,97,
+    114,101,110,116,95,109,111,100,117,108,101,95,110,97,109,101,
+    90,14,112,97,116,104,95,97,116,116,114,95,110,97,109,101,
+    114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,114,
+    43,1,0,0,198,4,0,0,115,6,0,0,0,12,1,16,
+    1,255,128,122,31,95,78,97,109,101,115,112,97,99,101,80,
+    97,116,104,46,95,103,101,116,95,112,97,114,101,110,116,95,
+    112,97,116,104,99,1,0,0,0,0,0,0,0,0,0,0,
+    0,3,0,0,0,4,0,0,0,67,0,0,0,115,80,0,
+    0,0,116,0,124,0,160,1,161,0,131,1,125,1,124,1,
+    124,0,106,2,107,3,114,74,124,0,160,3,124,0,106,4,
+    124,1,161,2,125,2,124,2,100,0,117,1,114,68,124,2,
+    106,5,100,0,117,0,114,68,124,2,106,6,114,68,124,2,
+    106,6,124,0,95,7,124,1,124,0,95,2,124,0,106,7,
+    83,0,114,121,0,0,0,41,8,114,123,0,0,0,114,43,
+    1,0,0,114,44,1,0,0,114,45,1,0,0,114,41,1,
+    0,0,114,151,0,0,0,114,198,0,0,0,114,42,1,0,
+    0,41,3,114,130,0,0,0,90,11,112,97,114,101,110,116,
+    95,112,97,116,104,114,207,0,0,0,114,7,0,0,0,114,
+    7,0,0,0,114,8,0,0,0,218,12,95,114,101,99,97,
+    108,99,117,108,97,116,101,202,4,0,0,115,18,0,0,0,
+    12,2,10,1,14,1,18,3,6,1,8,1,6,1,6,1,
+    255,128,122,27,95,78,97,109,101,115,112,97,99,101,80,97,
+    116,104,46,95,114,101,99,97,108,99,117,108,97,116,101,99,
+    1,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,
+    3,0,0,0,67,0,0,0,243,12,0,0,0,116,0,124,
+    0,160,1,161,0,131,1,83,0,114,121,0,0,0,41,2,
+    218,4,105,116,101,114,114,50,1,0,0,114,17,1,0,0,
     114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,218,
-    11,95,95,115,101,116,105,116,101,109,95,95,180,4,0,0,
-    115,4,0,0,0,14,1,255,128,122,26,95,78,97,109,101,
-    115,112,97,99,101,80,97,116,104,46,95,95,115,101,116,105,
-    116,101,109,95,95,99,1,0,0,0,0,0,0,0,0,0,
-    0,0,1,0,0,0,3,0,0,0,67,0,0,0,114,43,
-    1,0,0,114,121,0,0,0,41,2,114,4,0,0,0,114,
-    42,1,0,0,114,8,1,0,0,114,7,0,0,0,114,7,
-    0,0,0,114,8,0,0,0,218,7,95,95,108,101,110,95,
-    95,183,4,0,0,114,46,1,0,0,122,22,95,78,97,109,
-    101,115,112,97,99,101,80,97,116,104,46,95,95,108,101,110,
+    8,95,95,105,116,101,114,95,95,215,4,0,0,243,4,0,
+    0,0,12,1,255,128,122,23,95,78,97,109,101,115,112,97,
+    99,101,80,97,116,104,46,95,95,105,116,101,114,95,95,99,
+    2,0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,
+    2,0,0,0,67,0,0,0,115,12,0,0,0,124,0,160,
+    0,161,0,124,1,25,0,83,0,114,121,0,0,0,169,1,
+    114,50,1,0,0,41,2,114,130,0,0,0,218,5,105,110,
+    100,101,120,114,7,0,0,0,114,7,0,0,0,114,8,0,
+    0,0,218,11,95,95,103,101,116,105,116,101,109,95,95,218,
+    4,0,0,114,54,1,0,0,122,26,95,78,97,109,101,115,
+    112,97,99,101,80,97,116,104,46,95,95,103,101,116,105,116,
+    101,109,95,95,99,3,0,0,0,0,0,0,0,0,0,0,
+    0,3,0,0,0,3,0,0,0,67,0,0,0,115,14,0,
+    0,0,124,2,124,0,106,0,124,1,60,0,100,0,83,0,
+    114,121,0,0,0,41,1,114,42,1,0,0,41,3,114,130,
+    0,0,0,114,56,1,0,0,114,58,0,0,0,114,7,0,
+    0,0,114,7,0,0,0,114,8,0,0,0,218,11,95,95,
+    115,101,116,105,116,101,109,95,95,221,4,0,0,115,4,0,
+    0,0,14,1,255,128,122,26,95,78,97,109,101,115,112,97,
+    99,101,80,97,116,104,46,95,95,115,101,116,105,116,101,109,
     95,95,99,1,0,0,0,0,0,0,0,0,0,0,0,1,
-    0,0,0,3,0,0,0,67,0,0,0,243,12,0,0,0,
-    100,1,160,0,124,0,106,1,161,1,83,0,41,2,78,122,
-    20,95,78,97,109,101,115,112,97,99,101,80,97,116,104,40,
-    123,33,114,125,41,41,2,114,77,0,0,0,114,34,1,0,
-    0,114,8,1,0,0,114,7,0,0,0,114,7,0,0,0,
-    114,8,0,0,0,218,8,95,95,114,101,112,114,95,95,186,
-    4,0,0,114,46,1,0,0,122,23,95,78,97,109,101,115,
-    112,97,99,101,80,97,116,104,46,95,95,114,101,112,114,95,
-    95,99,2,0,0,0,0,0,0,0,0,0,0,0,2,0,
-    0,0,3,0,0,0,67,0,0,0,115,12,0,0,0,124,
-    1,124,0,160,0,161,0,118,0,83,0,114,121,0,0,0,
-    114,47,1,0,0,169,2,114,130,0,0,0,218,4,105,116,
-    101,109,114,7,0,0,0,114,7,0,0,0,114,8,0,0,
-    0,218,12,95,95,99,111,110,116,97,105,110,115,95,95,189,
-    4,0,0,114,46,1,0,0,122,27,95,78,97,109,101,115,
-    112,97,99,101,80,97,116,104,46,95,95,99,111,110,116,97,
-    105,110,115,95,95,99,2,0,0,0,0,0,0,0,0,0,
-    0,0,2,0,0,0,3,0,0,0,67,0,0,0,115,16,
-    0,0,0,124,0,106,0,160,1,124,1,161,1,1,0,100,
-    0,83,0,114,121,0,0,0,41,2,114,34,1,0,0,114,
-    197,0,0,0,114,54,1,0,0,114,7,0,0,0,114,7,
-    0,0,0,114,8,0,0,0,114,197,0,0,0,192,4,0,
-    0,243,4,0,0,0,16,1,255,128,122,21,95,78,97,109,
-    101,115,112,97,99,101,80,97,116,104,46,97,112,112,101,110,
-    100,78,41,15,114,137,0,0,0,114,136,0,0,0,114,138,
-    0,0,0,114,139,0,0,0,114,223,0,0,0,114,40,1,
-    0,0,114,35,1,0,0,114,42,1,0,0,114,45,1,0,
-    0,114,49,1,0,0,114,50,1,0,0,114,51,1,0,0,
-    114,53,1,0,0,114,56,1,0,0,114,197,0,0,0,114,
-    7,0,0,0,114,7,0,0,0,114,7,0,0,0,114,8,
-    0,0,0,114,32,1,0,0,134,4,0,0,115,28,0,0,
-    0,8,0,4,1,8,6,8,6,8,10,8,4,8,13,8,
-    3,8,3,8,3,8,3,8,3,12,3,255,128,114,32,1,
-    0,0,99,0,0,0,0,0,0,0,0,0,0,0,0,0,
-    0,0,0,3,0,0,0,64,0,0,0,115,80,0,0,0,
-    101,0,90,1,100,0,90,2,100,1,100,2,132,0,90,3,
-    101,4,100,3,100,4,132,0,131,1,90,5,100,5,100,6,
-    132,0,90,6,100,7,100,8,132,0,90,7,100,9,100,10,
-    132,0,90,8,100,11,100,12,132,0,90,9,100,13,100,14,
-    132,0,90,10,100,15,100,16,132,0,90,11,100,17,83,0,
-    41,18,218,16,95,78,97,109,101,115,112,97,99,101,76,111,
-    97,100,101,114,99,4,0,0,0,0,0,0,0,0,0,0,
-    0,4,0,0,0,4,0,0,0,67,0,0,0,115,18,0,
-    0,0,116,0,124,1,124,2,124,3,131,3,124,0,95,1,
-    100,0,83,0,114,121,0,0,0,41,2,114,32,1,0,0,
-    114,34,1,0,0,114,38,1,0,0,114,7,0,0,0,114,
-    7,0,0,0,114,8,0,0,0,114,223,0,0,0,198,4,
-    0,0,115,4,0,0,0,18,1,255,128,122,25,95,78,97,
-    109,101,115,112,97,99,101,76,111,97,100,101,114,46,95,95,
-    105,110,105,116,95,95,99,1,0,0,0,0,0,0,0,0,
-    0,0,0,1,0,0,0,3,0,0,0,67,0,0,0,114,
-    52,1,0,0,41,3,122,115,82,101,116,117,114,110,32,114,
-    101,112,114,32,102,111,114,32,116,104,101,32,109,111,100,117,
-    108,101,46,10,10,32,32,32,32,32,32,32,32,84,104,101,
-    32,109,101,116,104,111,100,32,105,115,32,100,101,112,114,101,
-    99,97,116,101,100,46,32,32,84,104,101,32,105,109,112,111,
-    114,116,32,109,97,99,104,105,110,101,114,121,32,100,111,101,
-    115,32,116,104,101,32,106,111,98,32,105,116,115,101,108,102,
-    46,10,10,32,32,32,32,32,32,32,32,122,25,60,109,111,
-    100,117,108,101,32,123,33,114,125,32,40,110,97,109,101,115,
-    112,97,99,101,41,62,78,41,2,114,77,0,0,0,114,137,
-    0,0,0,41,1,114,231,0,0,0,114,7,0,0,0,114,
-    7,0,0,0,114,8,0,0,0,218,11,109,111,100,117,108,
-    101,95,114,101,112,114,201,4,0,0,115,4,0,0,0,12,
-    7,255,128,122,28,95,78,97,109,101,115,112,97,99,101,76,
-    111,97,100,101,114,46,109,111,100,117,108,101,95,114,101,112,
-    114,99,2,0,0,0,0,0,0,0,0,0,0,0,2,0,
-    0,0,1,0,0,0,67,0,0,0,114,24,0,0,0,41,
-    2,78,84,114,7,0,0,0,114,234,0,0,0,114,7,0,
-    0,0,114,7,0,0,0,114,8,0,0,0,114,193,0,0,
-    0,210,4,0,0,243,4,0,0,0,4,1,255,128,122,27,
-    95,78,97,109,101,115,112,97,99,101,76,111,97,100,101,114,
-    46,105,115,95,112,97,99,107,97,103,101,99,2,0,0,0,
-    0,0,0,0,0,0,0,0,2,0,0,0,1,0,0,0,
-    67,0,0,0,114,24,0,0,0,41,2,78,114,10,0,0,
-    0,114,7,0,0,0,114,234,0,0,0,114,7,0,0,0,
-    114,7,0,0,0,114,8,0,0,0,114,244,0,0,0,213,
-    4,0,0,114,60,1,0,0,122,27,95,78,97,109,101,115,
-    112,97,99,101,76,111,97,100,101,114,46,103,101,116,95,115,
-    111,117,114,99,101,99,2,0,0,0,0,0,0,0,0,0,
-    0,0,2,0,0,0,6,0,0,0,67,0,0,0,115,16,
-    0,0,0,116,0,100,1,100,2,100,3,100,4,100,5,141,
-    4,83,0,41,6,78,114,10,0,0,0,122,8,60,115,116,
-    114,105,110,103,62,114,230,0,0,0,84,41,1,114,246,0,
-    0,0,41,1,114,247,0,0,0,114,234,0,0,0,114,7,
-    0,0,0,114,7,0,0,0,114,8,0,0,0,114,228,0,
-    0,0,216,4,0,0,114,57,1,0,0,122,25,95,78,97,
-    109,101,115,112,97,99,101,76,111,97,100,101,114,46,103,101,
-    116,95,99,111,100,101,99,2,0,0,0,0,0,0,0,0,
-    0,0,0,2,0,0,0,1,0,0,0,67,0,0,0,114,
-    24,0,0,0,114,224,0,0,0,114,7,0,0,0,114,225,
-    0,0,0,114,7,0,0,0,114,7,0,0,0,114,8,0,
-    0,0,114,226,0,0,0,219,4,0,0,114,227,0,0,0,
-    122,30,95,78,97,109,101,115,112,97,99,101,76,111,97,100,
-    101,114,46,99,114,101,97,116,101,95,109,111,100,117,108,101,
-    99,2,0,0,0,0,0,0,0,0,0,0,0,2,0,0,
-    0,1,0,0,0,67,0,0,0,115,4,0,0,0,100,0,
-    83,0,114,121,0,0,0,114,7,0,0,0,114,27,1,0,
+    0,0,0,3,0,0,0,67,0,0,0,114,51,1,0,0,
+    114,121,0,0,0,41,2,114,4,0,0,0,114,50,1,0,
+    0,114,17,1,0,0,114,7,0,0,0,114,7,0,0,0,
+    114,8,0,0,0,218,7,95,95,108,101,110,95,95,224,4,
+    0,0,114,54,1,0,0,122,22,95,78,97,109,101,115,112,
+    97,99,101,80,97,116,104,46,95,95,108,101,110,95,95,99,
+    1,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,
+    3,0,0,0,67,0,0,0,243,12,0,0,0,100,1,160,
+    0,124,0,106,1,161,1,83,0,41,2,78,122,20,95,78,
+    97,109,101,115,112,97,99,101,80,97,116,104,40,123,33,114,
+    125,41,41,2,114,77,0,0,0,114,42,1,0,0,114,17,
+    1,0,0,114,7,0,0,0,114,7,0,0,0,114,8,0,
+    0,0,218,8,95,95,114,101,112,114,95,95,227,4,0,0,
+    114,54,1,0,0,122,23,95,78,97,109,101,115,112,97,99,
+    101,80,97,116,104,46,95,95,114,101,112,114,95,95,99,2,
+    0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,3,
+    0,0,0,67,0,0,0,115,12,0,0,0,124,1,124,0,
+    160,0,161,0,118,0,83,0,114,121,0,0,0,114,55,1,
+    0,0,169,2,114,130,0,0,0,218,4,105,116,101,109,114,
+    7,0,0,0,114,7,0,0,0,114,8,0,0,0,218,12,
+    95,95,99,111,110,116,97,105,110,115,95,95,230,4,0,0,
+    114,54,1,0,0,122,27,95,78,97,109,101,115,112,97,99,
+    101,80,97,116,104,46,95,95,99,111,110,116,97,105,110,115,
+    95,95,99,2,0,0,0,0,0,0,0,0,0,0,0,2,
+    0,0,0,3,0,0,0,67,0,0,0,115,16,0,0,0,
+    124,0,106,0,160,1,124,1,161,1,1,0,100,0,83,0,
+    114,121,0,0,0,41,2,114,42,1,0,0,114,206,0,0,
+    0,114,62,1,0,0,114,7,0,0,0,114,7,0,0,0,
+    114,8,0,0,0,114,206,0,0,0,233,4,0,0,243,4,
+    0,0,0,16,1,255,128,122,21,95,78,97,109,101,115,112,
+    97,99,101,80,97,116,104,46,97,112,112,101,110,100,78,41,
+    15,114,137,0,0,0,114,136,0,0,0,114,138,0,0,0,
+    114,139,0,0,0,114,232,0,0,0,114,48,1,0,0,114,
+    43,1,0,0,114,50,1,0,0,114,53,1,0,0,114,57,
+    1,0,0,114,58,1,0,0,114,59,1,0,0,114,61,1,
+    0,0,114,64,1,0,0,114,206,0,0,0,114,7,0,0,
     0,114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,
-    114,232,0,0,0,222,4,0,0,114,60,1,0,0,122,28,
-    95,78,97,109,101,115,112,97,99,101,76,111,97,100,101,114,
-    46,101,120,101,99,95,109,111,100,117,108,101,99,2,0,0,
-    0,0,0,0,0,0,0,0,0,2,0,0,0,4,0,0,
-    0,67,0,0,0,115,26,0,0,0,116,0,160,1,100,1,
-    124,0,106,2,161,2,1,0,116,0,160,3,124,0,124,1,
-    161,2,83,0,41,3,122,98,76,111,97,100,32,97,32,110,
-    97,109,101,115,112,97,99,101,32,109,111,100,117,108,101,46,
-    10,10,32,32,32,32,32,32,32,32,84,104,105,115,32,109,
-    101,116,104,111,100,32,105,115,32,100,101,112,114,101,99,97,
-    116,101,100,46,32,32,85,115,101,32,101,120,101,99,95,109,
-    111,100,117,108,101,40,41,32,105,110,115,116,101,97,100,46,
-    10,10,32,32,32,32,32,32,32,32,122,38,110,97,109,101,
-    115,112,97,99,101,32,109,111,100,117,108,101,32,108,111,97,
-    100,101,100,32,119,105,116,104,32,112,97,116,104,32,123,33,
-    114,125,78,41,4,114,146,0,0,0,114,160,0,0,0,114,
-    34,1,0,0,114,233,0,0,0,114,234,0,0,0,114,7,
-    0,0,0,114,7,0,0,0,114,8,0,0,0,114,235,0,
-    0,0,225,4,0,0,115,10,0,0,0,6,7,4,1,4,
-    255,12,3,255,128,122,28,95,78,97,109,101,115,112,97,99,
-    101,76,111,97,100,101,114,46,108,111,97,100,95,109,111,100,
-    117,108,101,78,41,12,114,137,0,0,0,114,136,0,0,0,
-    114,138,0,0,0,114,223,0,0,0,114,220,0,0,0,114,
-    59,1,0,0,114,193,0,0,0,114,244,0,0,0,114,228,
-    0,0,0,114,226,0,0,0,114,232,0,0,0,114,235,0,
-    0,0,114,7,0,0,0,114,7,0,0,0,114,7,0,0,
-    0,114,8,0,0,0,114,58,1,0,0,197,4,0,0,115,
-    22,0,0,0,8,0,8,1,2,3,10,1,8,8,8,3,
-    8,3,8,3,8,3,12,3,255,128,114,58,1,0,0,99,
+    114,40,1,0,0,175,4,0,0,115,28,0,0,0,8,0,
+    4,1,8,6,8,6,8,10,8,4,8,13,8,3,8,3,
+    8,3,8,3,8,3,12,3,255,128,114,40,1,0,0,99,
     0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
-    4,0,0,0,64,0,0,0,115,118,0,0,0,101,0,90,
-    1,100,0,90,2,100,1,90,3,101,4,100,2,100,3,132,
-    0,131,1,90,5,101,4,100,4,100,5,132,0,131,1,90,
-    6,101,7,100,6,100,7,132,0,131,1,90,8,101,7,100,
-    8,100,9,132,0,131,1,90,9,101,7,100,19,100,11,100,
-    12,132,1,131,1,90,10,101,7,100,20,100,13,100,14,132,
-    1,131,1,90,11,101,7,100,21,100,15,100,16,132,1,131,
-    1,90,12,101,4,100,17,100,18,132,0,131,1,90,13,100,
-    10,83,0,41,22,218,10,80,97,116,104,70,105,110,100,101,
-    114,122,62,77,101,116,97,32,112,97,116,104,32,102,105,110,
-    100,101,114,32,102,111,114,32,115,121,115,46,112,97,116,104,
-    32,97,110,100,32,112,97,99,107,97,103,101,32,95,95,112,
-    97,116,104,95,95,32,97,116,116,114,105,98,117,116,101,115,
-    46,99,0,0,0,0,0,0,0,0,0,0,0,0,2,0,
-    0,0,4,0,0,0,67,0,0,0,115,64,0,0,0,116,
-    0,116,1,106,2,160,3,161,0,131,1,68,0,93,44,92,
-    2,125,0,125,1,124,1,100,1,117,0,114,40,116,1,106,
-    2,124,0,61,0,113,14,116,4,124,1,100,2,131,2,114,
-    58,124,1,160,5,161,0,1,0,113,14,100,1,83,0,41,
-    3,122,125,67,97,108,108,32,116,104,101,32,105,110,118,97,
-    108,105,100,97,116,101,95,99,97,99,104,101,115,40,41,32,
-    109,101,116,104,111,100,32,111,110,32,97,108,108,32,112,97,
-    116,104,32,101,110,116,114,121,32,102,105,110,100,101,114,115,
-    10,32,32,32,32,32,32,32,32,115,116,111,114,101,100,32,
-    105,110,32,115,121,115,46,112,97,116,104,95,105,109,112,111,
-    114,116,101,114,95,99,97,99,104,101,115,32,40,119,104,101,
-    114,101,32,105,109,112,108,101,109,101,110,116,101,100,41,46,
-    78,218,17,105,110,118,97,108,105,100,97,116,101,95,99,97,
-    99,104,101,115,41,6,218,4,108,105,115,116,114,16,0,0,
-    0,218,19,112,97,116,104,95,105,109,112,111,114,116,101,114,
-    95,99,97,99,104,101,218,5,105,116,101,109,115,114,140,0,
-    0,0,114,62,1,0,0,41,2,114,128,0,0,0,218,6,
-    102,105,110,100,101,114,114,7,0,0,0,114,7,0,0,0,
-    114,8,0,0,0,114,62,1,0,0,244,4,0,0,115,16,
-    0,0,0,22,4,8,1,10,1,10,1,8,1,2,128,4,
-    252,255,128,122,28,80,97,116,104,70,105,110,100,101,114,46,
+    3,0,0,0,64,0,0,0,115,80,0,0,0,101,0,90,
+    1,100,0,90,2,100,1,100,2,132,0,90,3,101,4,100,
+    3,100,4,132,0,131,1,90,5,100,5,100,6,132,0,90,
+    6,100,7,100,8,132,0,90,7,100,9,100,10,132,0,90,
+    8,100,11,100,12,132,0,90,9,100,13,100,14,132,0,90,
+    10,100,15,100,16,132,0,90,11,100,17,83,0,41,18,218,
+    16,95,78,97,109,101,115,112,97,99,101,76,111,97,100,101,
+    114,99,4,0,0,0,0,0,0,0,0,0,0,0,4,0,
+    0,0,4,0,0,0,67,0,0,0,115,18,0,0,0,116,
+    0,124,1,124,2,124,3,131,3,124,0,95,1,100,0,83,
+    0,114,121,0,0,0,41,2,114,40,1,0,0,114,42,1,
+    0,0,114,46,1,0,0,114,7,0,0,0,114,7,0,0,
+    0,114,8,0,0,0,114,232,0,0,0,239,4,0,0,115,
+    4,0,0,0,18,1,255,128,122,25,95,78,97,109,101,115,
+    112,97,99,101,76,111,97,100,101,114,46,95,95,105,110,105,
+    116,95,95,99,1,0,0,0,0,0,0,0,0,0,0,0,
+    1,0,0,0,3,0,0,0,67,0,0,0,114,60,1,0,
+    0,41,3,122,115,82,101,116,117,114,110,32,114,101,112,114,
+    32,102,111,114,32,116,104,101,32,109,111,100,117,108,101,46,
+    10,10,32,32,32,32,32,32,32,32,84,104,101,32,109,101,
+    116,104,111,100,32,105,115,32,100,101,112,114,101,99,97,116,
+    101,100,46,32,32,84,104,101,32,105,109,112,111,114,116,32,
+    109,97,99,104,105,110,101,114,121,32,100,111,101,115,32,116,
+    104,101,32,106,111,98,32,105,116,115,101,108,102,46,10,10,
+    32,32,32,32,32,32,32,32,122,25,60,109,111,100,117,108,
+    101,32,123,33,114,125,32,40,110,97,109,101,115,112,97,99,
+    101,41,62,78,41,2,114,77,0,0,0,114,137,0,0,0,
+    41,1,114,240,0,0,0,114,7,0,0,0,114,7,0,0,
+    0,114,8,0,0,0,218,11,109,111,100,117,108,101,95,114,
+    101,112,114,242,4,0,0,115,4,0,0,0,12,7,255,128,
+    122,28,95,78,97,109,101,115,112,97,99,101,76,111,97,100,
+    101,114,46,109,111,100,117,108,101,95,114,101,112,114,99,2,
+    0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,1,
+    0,0,0,67,0,0,0,114,24,0,0,0,41,2,78,84,
+    114,7,0,0,0,114,243,0,0,0,114,7,0,0,0,114,
+    7,0,0,0,114,8,0,0,0,114,202,0,0,0,251,4,
+    0,0,243,4,0,0,0,4,1,255,128,122,27,95,78,97,
+    109,101,115,112,97,99,101,76,111,97,100,101,114,46,105,115,
+    95,112,97,99,107,97,103,101,99,2,0,0,0,0,0,0,
+    0,0,0,0,0,2,0,0,0,1,0,0,0,67,0,0,
+    0,114,24,0,0,0,41,2,78,114,10,0,0,0,114,7,
+    0,0,0,114,243,0,0,0,114,7,0,0,0,114,7,0,
+    0,0,114,8,0,0,0,114,253,0,0,0,254,4,0,0,
+    114,68,1,0,0,122,27,95,78,97,109,101,115,112,97,99,
+    101,76,111,97,100,101,114,46,103,101,116,95,115,111,117,114,
+    99,101,99,2,0,0,0,0,0,0,0,0,0,0,0,2,
+    0,0,0,6,0,0,0,67,0,0,0,115,16,0,0,0,
+    116,0,100,1,100,2,100,3,100,4,100,5,141,4,83,0,
+    41,6,78,114,10,0,0,0,122,8,60,115,116,114,105,110,
+    103,62,114,239,0,0,0,84,41,1,114,255,0,0,0,41,
+    1,114,0,1,0,0,114,243,0,0,0,114,7,0,0,0,
+    114,7,0,0,0,114,8,0,0,0,114,237,0,0,0,1,
+    5,0,0,114,65,1,0,0,122,25,95,78,97,109,101,115,
+    112,97,99,101,76,111,97,100,101,114,46,103,101,116,95,99,
+    111,100,101,99,2,0,0,0,0,0,0,0,0,0,0,0,
+    2,0,0,0,1,0,0,0,67,0,0,0,114,24,0,0,
+    0,114,233,0,0,0,114,7,0,0,0,114,234,0,0,0,
+    114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,114,
+    235,0,0,0,4,5,0,0,114,236,0,0,0,122,30,95,
+    78,97,109,101,115,112,97,99,101,76,111,97,100,101,114,46,
+    99,114,101,97,116,101,95,109,111,100,117,108,101,99,2,0,
+    0,0,0,0,0,0,0,0,0,0,2,0,0,0,1,0,
+    0,0,67,0,0,0,115,4,0,0,0,100,0,83,0,114,
+    121,0,0,0,114,7,0,0,0,114,35,1,0,0,114,7,
+    0,0,0,114,7,0,0,0,114,8,0,0,0,114,241,0,
+    0,0,7,5,0,0,114,68,1,0,0,122,28,95,78,97,
+    109,101,115,112,97,99,101,76,111,97,100,101,114,46,101,120,
+    101,99,95,109,111,100,117,108,101,99,2,0,0,0,0,0,
+    0,0,0,0,0,0,2,0,0,0,4,0,0,0,67,0,
+    0,0,115,26,0,0,0,116,0,160,1,100,1,124,0,106,
+    2,161,2,1,0,116,0,160,3,124,0,124,1,161,2,83,
+    0,41,3,122,98,76,111,97,100,32,97,32,110,97,109,101,
+    115,112,97,99,101,32,109,111,100,117,108,101,46,10,10,32,
+    32,32,32,32,32,32,32,84,104,105,115,32,109,101,116,104,
+    111,100,32,105,115,32,100,101,112,114,101,99,97,116,101,100,
+    46,32,32,85,115,101,32,101,120,101,99,95,109,111,100,117,
+    108,101,40,41,32,105,110,115,116,101,97,100,46,10,10,32,
+    32,32,32,32,32,32,32,122,38,110,97,109,101,115,112,97,
+    99,101,32,109,111,100,117,108,101,32,108,111,97,100,101,100,
+    32,119,105,116,104,32,112,97,116,104,32,123,33,114,125,78,
+    41,4,114,146,0,0,0,114,160,0,0,0,114,42,1,0,
+    0,114,242,0,0,0,114,243,0,0,0,114,7,0,0,0,
+    114,7,0,0,0,114,8,0,0,0,114,244,0,0,0,10,
+    5,0,0,115,10,0,0,0,6,7,4,1,4,255,12,3,
+    255,128,122,28,95,78,97,109,101,115,112,97,99,101,76,111,
+    97,100,101,114,46,108,111,97,100,95,109,111,100,117,108,101,
+    78,41,12,114,137,0,0,0,114,136,0,0,0,114,138,0,
+    0,0,114,232,0,0,0,114,229,0,0,0,114,67,1,0,
+    0,114,202,0,0,0,114,253,0,0,0,114,237,0,0,0,
+    114,235,0,0,0,114,241,0,0,0,114,244,0,0,0,114,
+    7,0,0,0,114,7,0,0,0,114,7,0,0,0,114,8,
+    0,0,0,114,66,1,0,0,238,4,0,0,115,22,0,0,
+    0,8,0,8,1,2,3,10,1,8,8,8,3,8,3,8,
+    3,8,3,12,3,255,128,114,66,1,0,0,99,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,4,0,0,
+    0,64,0,0,0,115,118,0,0,0,101,0,90,1,100,0,
+    90,2,100,1,90,3,101,4,100,2,100,3,132,0,131,1,
+    90,5,101,4,100,4,100,5,132,0,131,1,90,6,101,7,
+    100,6,100,7,132,0,131,1,90,8,101,7,100,8,100,9,
+    132,0,131,1,90,9,101,7,100,19,100,11,100,12,132,1,
+    131,1,90,10,101,7,100,20,100,13,100,14,132,1,131,1,
+    90,11,101,7,100,21,100,15,100,16,132,1,131,1,90,12,
+    101,4,100,17,100,18,132,0,131,1,90,13,100,10,83,0,
+    41,22,218,10,80,97,116,104,70,105,110,100,101,114,122,62,
+    77,101,116,97,32,112,97,116,104,32,102,105,110,100,101,114,
+    32,102,111,114,32,115,121,115,46,112,97,116,104,32,97,110,
+    100,32,112,97,99,107,97,103,101,32,95,95,112,97,116,104,
+    95,95,32,97,116,116,114,105,98,117,116,101,115,46,99,0,
+    0,0,0,0,0,0,0,0,0,0,0,2,0,0,0,4,
+    0,0,0,67,0,0,0,115,72,0,0,0,116,0,160,1,
+    161,0,1,0,116,2,116,3,106,4,160,5,161,0,131,1,
+    68,0,93,44,92,2,125,0,125,1,124,1,100,1,117,0,
+    114,48,116,3,106,4,124,0,61,0,113,22,116,6,124,1,
+    100,2,131,2,114,66,124,1,160,7,161,0,1,0,113,22,
+    100,1,83,0,41,3,122,125,67,97,108,108,32,116,104,101,
+    32,105,110,118,97,108,105,100,97,116,101,95,99,97,99,104,
+    101,115,40,41,32,109,101,116,104,111,100,32,111,110,32,97,
+    108,108,32,112,97,116,104,32,101,110,116,114,121,32,102,105,
+    110,100,101,114,115,10,32,32,32,32,32,32,32,32,115,116,
+    111,114,101,100,32,105,110,32,115,121,115,46,112,97,116,104,
+    95,105,109,112,111,114,116,101,114,95,99,97,99,104,101,115,
+    32,40,119,104,101,114,101,32,105,109,112,108,101,109,101,110,
+    116,101,100,41,46,78,218,17,105,110,118,97,108,105,100,97,
+    116,101,95,99,97,99,104,101,115,41,8,114,183,0,0,0,
+    218,5,99,108,101,97,114,218,4,108,105,115,116,114,16,0,
+    0,0,218,19,112,97,116,104,95,105,109,112,111,114,116,101,
+    114,95,99,97,99,104,101,218,5,105,116,101,109,115,114,140,
+    0,0,0,114,70,1,0,0,41,2,114,128,0,0,0,218,
+    6,102,105,110,100,101,114,114,7,0,0,0,114,7,0,0,
+    0,114,8,0,0,0,114,70,1,0,0,29,5,0,0,115,
+    18,0,0,0,8,4,22,1,8,1,10,1,10,1,8,1,
+    2,128,4,252,255,128,122,28,80,97,116,104,70,105,110,100,
+    101,114,46,105,110,118,97,108,105,100,97,116,101,95,99,97,
+    99,104,101,115,99,1,0,0,0,0,0,0,0,0,0,0,
+    0,2,0,0,0,9,0,0,0,67,0,0,0,115,76,0,
+    0,0,116,0,106,1,100,1,117,1,114,28,116,0,106,1,
+    115,28,116,2,160,3,100,2,116,4,161,2,1,0,116,0,
+    106,1,68,0,93,34,125,1,122,14,124,1,124,0,131,1,
+    87,0,2,0,1,0,83,0,4,0,116,5,121,74,1,0,
+    1,0,1,0,89,0,113,34,100,1,83,0,119,0,41,3,
+    122,46,83,101,97,114,99,104,32,115,121,115,46,112,97,116,
+    104,95,104,111,111,107,115,32,102,111,114,32,97,32,102,105,
+    110,100,101,114,32,102,111,114,32,39,112,97,116,104,39,46,
+    78,122,23,115,121,115,46,112,97,116,104,95,104,111,111,107,
+    115,32,105,115,32,101,109,112,116,121,41,6,114,16,0,0,
+    0,218,10,112,97,116,104,95,104,111,111,107,115,114,88,0,
+    0,0,114,89,0,0,0,114,149,0,0,0,114,129,0,0,
+    0,41,2,114,58,0,0,0,90,4,104,111,111,107,114,7,
+    0,0,0,114,7,0,0,0,114,8,0,0,0,218,11,95,
+    112,97,116,104,95,104,111,111,107,115,40,5,0,0,115,20,
+    0,0,0,16,3,12,1,10,1,2,1,14,1,12,1,4,
+    1,4,2,2,253,255,128,122,22,80,97,116,104,70,105,110,
+    100,101,114,46,95,112,97,116,104,95,104,111,111,107,115,99,
+    2,0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,
+    8,0,0,0,67,0,0,0,115,100,0,0,0,124,1,100,
+    1,107,2,114,40,122,12,116,0,160,1,161,0,125,1,87,
+    0,110,18,4,0,116,2,121,98,1,0,1,0,1,0,89,
+    0,100,2,83,0,122,16,116,3,106,4,124,1,25,0,125,
+    2,87,0,124,2,83,0,4,0,116,5,121,96,1,0,1,
+    0,1,0,124,0,160,6,124,1,161,1,125,2,124,2,116,
+    3,106,4,124,1,60,0,89,0,124,2,83,0,119,0,119,
+    0,41,3,122,210,71,101,116,32,116,104,101,32,102,105,110,
+    100,101,114,32,102,111,114,32,116,104,101,32,112,97,116,104,
+    32,101,110,116,114,121,32,102,114,111,109,32,115,121,115,46,
+    112,97,116,104,95,105,109,112,111,114,116,101,114,95,99,97,
+    99,104,101,46,10,10,32,32,32,32,32,32,32,32,73,102,
+    32,116,104,101,32,112,97,116,104,32,101,110,116,114,121,32,
+    105,115,32,110,111,116,32,105,110,32,116,104,101,32,99,97,
+    99,104,101,44,32,102,105,110,100,32,116,104,101,32,97,112,
+    112,114,111,112,114,105,97,116,101,32,102,105,110,100,101,114,
+    10,32,32,32,32,32,32,32,32,97,110,100,32,99,97,99,
+    104,101,32,105,116,46,32,73,102,32,110,111,32,102,105,110,
+    100,101,114,32,105,115,32,97,118,97,105,108,97,98,108,101,
+    44,32,115,116,111,114,101,32,78,111,110,101,46,10,10,32,
+    32,32,32,32,32,32,32,114,10,0,0,0,78,41,7,114,
+    19,0,0,0,114,70,0,0,0,218,17,70,105,108,101,78,
+    111,116,70,111,117,110,100,69,114,114,111,114,114,16,0,0,
+    0,114,73,1,0,0,218,8,75,101,121,69,114,114,111,114,
+    114,77,1,0,0,41,3,114,218,0,0,0,114,58,0,0,
+    0,114,75,1,0,0,114,7,0,0,0,114,7,0,0,0,
+    114,8,0,0,0,218,20,95,112,97,116,104,95,105,109,112,
+    111,114,116,101,114,95,99,97,99,104,101,53,5,0,0,115,
+    30,0,0,0,8,8,2,1,12,1,12,1,6,3,2,1,
+    12,1,4,4,12,253,10,1,12,1,4,1,2,253,2,250,
+    255,128,122,31,80,97,116,104,70,105,110,100,101,114,46,95,
+    112,97,116,104,95,105,109,112,111,114,116,101,114,95,99,97,
+    99,104,101,99,3,0,0,0,0,0,0,0,0,0,0,0,
+    6,0,0,0,4,0,0,0,67,0,0,0,115,82,0,0,
+    0,116,0,124,2,100,1,131,2,114,26,124,2,160,1,124,
+    1,161,1,92,2,125,3,125,4,110,14,124,2,160,2,124,
+    1,161,1,125,3,103,0,125,4,124,3,100,0,117,1,114,
+    60,116,3,160,4,124,1,124,3,161,2,83,0,116,3,160,
+    5,124,1,100,0,161,2,125,5,124,4,124,5,95,6,124,
+    5,83,0,41,2,78,114,148,0,0,0,41,7,114,140,0,
+    0,0,114,148,0,0,0,114,226,0,0,0,114,146,0,0,
+    0,114,221,0,0,0,114,203,0,0,0,114,198,0,0,0,
+    41,6,114,218,0,0,0,114,150,0,0,0,114,75,1,0,
+    0,114,151,0,0,0,114,152,0,0,0,114,207,0,0,0,
+    114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,218,
+    16,95,108,101,103,97,99,121,95,103,101,116,95,115,112,101,
+    99,75,5,0,0,115,20,0,0,0,10,4,16,1,10,2,
+    4,1,8,1,12,1,12,1,6,1,4,1,255,128,122,27,
+    80,97,116,104,70,105,110,100,101,114,46,95,108,101,103,97,
+    99,121,95,103,101,116,95,115,112,101,99,78,99,4,0,0,
+    0,0,0,0,0,0,0,0,0,9,0,0,0,5,0,0,
+    0,67,0,0,0,115,166,0,0,0,103,0,125,4,124,2,
+    68,0,93,134,125,5,116,0,124,5,116,1,116,2,102,2,
+    131,2,115,28,113,8,124,0,160,3,124,5,161,1,125,6,
+    124,6,100,1,117,1,114,142,116,4,124,6,100,2,131,2,
+    114,70,124,6,160,5,124,1,124,3,161,2,125,7,110,12,
+    124,0,160,6,124,1,124,6,161,2,125,7,124,7,100,1,
+    117,0,114,92,113,8,124,7,106,7,100,1,117,1,114,110,
+    124,7,2,0,1,0,83,0,124,7,106,8,125,8,124,8,
+    100,1,117,0,114,132,116,9,100,3,131,1,130,1,124,4,
+    160,10,124,8,161,1,1,0,113,8,116,11,160,12,124,1,
+    100,1,161,2,125,7,124,4,124,7,95,8,124,7,83,0,
+    41,4,122,63,70,105,110,100,32,116,104,101,32,108,111,97,
+    100,101,114,32,111,114,32,110,97,109,101,115,112,97,99,101,
+    95,112,97,116,104,32,102,111,114,32,116,104,105,115,32,109,
+    111,100,117,108,101,47,112,97,99,107,97,103,101,32,110,97,
+    109,101,46,78,114,223,0,0,0,122,19,115,112,101,99,32,
+    109,105,115,115,105,110,103,32,108,111,97,100,101,114,41,13,
+    114,172,0,0,0,114,97,0,0,0,218,5,98,121,116,101,
+    115,114,80,1,0,0,114,140,0,0,0,114,223,0,0,0,
+    114,81,1,0,0,114,151,0,0,0,114,198,0,0,0,114,
+    129,0,0,0,114,187,0,0,0,114,146,0,0,0,114,203,
+    0,0,0,41,9,114,218,0,0,0,114,150,0,0,0,114,
+    58,0,0,0,114,222,0,0,0,218,14,110,97,109,101,115,
+    112,97,99,101,95,112,97,116,104,90,5,101,110,116,114,121,
+    114,75,1,0,0,114,207,0,0,0,114,152,0,0,0,114,
+    7,0,0,0,114,7,0,0,0,114,8,0,0,0,218,9,
+    95,103,101,116,95,115,112,101,99,90,5,0,0,115,44,0,
+    0,0,4,5,8,1,14,1,2,1,10,1,8,1,10,1,
+    14,1,12,2,8,1,2,1,10,1,8,1,6,1,8,1,
+    8,1,10,5,2,128,12,2,6,1,4,1,255,128,122,20,
+    80,97,116,104,70,105,110,100,101,114,46,95,103,101,116,95,
+    115,112,101,99,99,4,0,0,0,0,0,0,0,0,0,0,
+    0,6,0,0,0,5,0,0,0,67,0,0,0,115,94,0,
+    0,0,124,2,100,1,117,0,114,14,116,0,106,1,125,2,
+    124,0,160,2,124,1,124,2,124,3,161,3,125,4,124,4,
+    100,1,117,0,114,40,100,1,83,0,124,4,106,3,100,1,
+    117,0,114,90,124,4,106,4,125,5,124,5,114,86,100,1,
+    124,4,95,5,116,6,124,1,124,5,124,0,106,2,131,3,
+    124,4,95,4,124,4,83,0,100,1,83,0,124,4,83,0,
+    41,2,122,141,84,114,121,32,116,111,32,102,105,110,100,32,
+    97,32,115,112,101,99,32,102,111,114,32,39,102,117,108,108,
+    110,97,109,101,39,32,111,110,32,115,121,115,46,112,97,116,
+    104,32,111,114,32,39,112,97,116,104,39,46,10,10,32,32,
+    32,32,32,32,32,32,84,104,101,32,115,101,97,114,99,104,
+    32,105,115,32,98,97,115,101,100,32,111,110,32,115,121,115,
+    46,112,97,116,104,95,104,111,111,107,115,32,97,110,100,32,
+    115,121,115,46,112,97,116,104,95,105,109,112,111,114,116,101,
+    114,95,99,97,99,104,101,46,10,32,32,32,32,32,32,32,
+    32,78,41,7,114,16,0,0,0,114,58,0,0,0,114,84,
+    1,0,0,114,151,0,0,0,114,198,0,0,0,114,201,0,
+    0,0,114,40,1,0,0,41,6,114,218,0,0,0,114,150,
+    0,0,0,114,58,0,0,0,114,222,0,0,0,114,207,0,
+    0,0,114,83,1,0,0,114,7,0,0,0,114,7,0,0,
+    0,114,8,0,0,0,114,223,0,0,0,122,5,0,0,115,
+    28,0,0,0,8,6,6,1,14,1,8,1,4,1,10,1,
+    6,1,4,1,6,3,16,1,4,1,4,2,4,2,255,128,
+    122,20,80,97,116,104,70,105,110,100,101,114,46,102,105,110,
+    100,95,115,112,101,99,99,3,0,0,0,0,0,0,0,0,
+    0,0,0,4,0,0,0,4,0,0,0,67,0,0,0,115,
+    30,0,0,0,124,0,160,0,124,1,124,2,161,2,125,3,
+    124,3,100,1,117,0,114,24,100,1,83,0,124,3,106,1,
+    83,0,41,2,122,170,102,105,110,100,32,116,104,101,32,109,
+    111,100,117,108,101,32,111,110,32,115,121,115,46,112,97,116,
+    104,32,111,114,32,39,112,97,116,104,39,32,98,97,115,101,
+    100,32,111,110,32,115,121,115,46,112,97,116,104,95,104,111,
+    111,107,115,32,97,110,100,10,32,32,32,32,32,32,32,32,
+    115,121,115,46,112,97,116,104,95,105,109,112,111,114,116,101,
+    114,95,99,97,99,104,101,46,10,10,32,32,32,32,32,32,
+    32,32,84,104,105,115,32,109,101,116,104,111,100,32,105,115,
+    32,100,101,112,114,101,99,97,116,101,100,46,32,32,85,115,
+    101,32,102,105,110,100,95,115,112,101,99,40,41,32,105,110,
+    115,116,101,97,100,46,10,10,32,32,32,32,32,32,32,32,
+    78,114,224,0,0,0,114,225,0,0,0,114,7,0,0,0,
+    114,7,0,0,0,114,8,0,0,0,114,226,0,0,0,146,
+    5,0,0,115,10,0,0,0,12,8,8,1,4,1,6,1,
+    255,128,122,22,80,97,116,104,70,105,110,100,101,114,46,102,
+    105,110,100,95,109,111,100,117,108,101,99,0,0,0,0,0,
+    0,0,0,0,0,0,0,3,0,0,0,4,0,0,0,79,
+    0,0,0,115,28,0,0,0,100,1,100,2,108,0,109,1,
+    125,2,1,0,124,2,106,2,124,0,105,0,124,1,164,1,
+    142,1,83,0,41,4,97,32,1,0,0,10,32,32,32,32,
+    32,32,32,32,70,105,110,100,32,100,105,115,116,114,105,98,
+    117,116,105,111,110,115,46,10,10,32,32,32,32,32,32,32,
+    32,82,101,116,117,114,110,32,97,110,32,105,116,101,114,97,
+    98,108,101,32,111,102,32,97,108,108,32,68,105,115,116,114,
+    105,98,117,116,105,111,110,32,105,110,115,116,97,110,99,101,
+    115,32,99,97,112,97,98,108,101,32,111,102,10,32,32,32,
+    32,32,32,32,32,108,111,97,100,105,110,103,32,116,104,101,
+    32,109,101,116,97,100,97,116,97,32,102,111,114,32,112,97,
+    99,107,97,103,101,115,32,109,97,116,99,104,105,110,103,32,
+    96,96,99,111,110,116,101,120,116,46,110,97,109,101,96,96,
+    10,32,32,32,32,32,32,32,32,40,111,114,32,97,108,108,
+    32,110,97,109,101,115,32,105,102,32,96,96,78,111,110,101,
+    96,96,32,105,110,100,105,99,97,116,101,100,41,32,97,108,
+    111,110,103,32,116,104,101,32,112,97,116,104,115,32,105,110,
+    32,116,104,101,32,108,105,115,116,10,32,32,32,32,32,32,
+    32,32,111,102,32,100,105,114,101,99,116,111,114,105,101,115,
+    32,96,96,99,111,110,116,101,120,116,46,112,97,116,104,96,
+    96,46,10,32,32,32,32,32,32,32,32,114,0,0,0,0,
+    41,1,218,18,77,101,116,97,100,97,116,97,80,97,116,104,
+    70,105,110,100,101,114,78,41,3,90,18,105,109,112,111,114,
+    116,108,105,98,46,109,101,116,97,100,97,116,97,114,85,1,
+    0,0,218,18,102,105,110,100,95,100,105,115,116,114,105,98,
+    117,116,105,111,110,115,41,3,114,131,0,0,0,114,132,0,
+    0,0,114,85,1,0,0,114,7,0,0,0,114,7,0,0,
+    0,114,8,0,0,0,114,86,1,0,0,159,5,0,0,115,
+    6,0,0,0,12,10,16,1,255,128,122,29,80,97,116,104,
+    70,105,110,100,101,114,46,102,105,110,100,95,100,105,115,116,
+    114,105,98,117,116,105,111,110,115,41,1,78,41,2,78,78,
+    41,1,78,41,14,114,137,0,0,0,114,136,0,0,0,114,
+    138,0,0,0,114,139,0,0,0,114,229,0,0,0,114,70,
+    1,0,0,114,77,1,0,0,114,230,0,0,0,114,80,1,
+    0,0,114,81,1,0,0,114,84,1,0,0,114,223,0,0,
+    0,114,226,0,0,0,114,86,1,0,0,114,7,0,0,0,
+    114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,114,
+    69,1,0,0,25,5,0,0,115,38,0,0,0,8,0,4,
+    2,2,2,10,1,2,10,10,1,2,12,10,1,2,21,10,
+    1,2,14,12,1,2,31,12,1,2,23,12,1,2,12,14,
+    1,255,128,114,69,1,0,0,99,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,3,0,0,0,64,0,0,
+    0,115,90,0,0,0,101,0,90,1,100,0,90,2,100,1,
+    90,3,100,2,100,3,132,0,90,4,100,4,100,5,132,0,
+    90,5,101,6,90,7,100,6,100,7,132,0,90,8,100,8,
+    100,9,132,0,90,9,100,19,100,11,100,12,132,1,90,10,
+    100,13,100,14,132,0,90,11,101,12,100,15,100,16,132,0,
+    131,1,90,13,100,17,100,18,132,0,90,14,100,10,83,0,
+    41,20,218,10,70,105,108,101,70,105,110,100,101,114,122,172,
+    70,105,108,101,45,98,97,115,101,100,32,102,105,110,100,101,
+    114,46,10,10,32,32,32,32,73,110,116,101,114,97,99,116,
+    105,111,110,115,32,119,105,116,104,32,116,104,101,32,102,105,
+    108,101,32,115,121,115,116,101,109,32,97,114,101,32,99,97,
+    99,104,101,100,32,102,111,114,32,112,101,114,102,111,114,109,
+    97,110,99,101,44,32,98,101,105,110,103,10,32,32,32,32,
+    114,101,102,114,101,115,104,101,100,32,119,104,101,110,32,116,
+    104,101,32,100,105,114,101,99,116,111,114,121,32,116,104,101,
+    32,102,105,110,100,101,114,32,105,115,32,104,97,110,100,108,
+    105,110,103,32,104,97,115,32,98,101,101,110,32,109,111,100,
+    105,102,105,101,100,46,10,10,32,32,32,32,99,2,0,0,
+    0,0,0,0,0,0,0,0,0,5,0,0,0,6,0,0,
+    0,7,0,0,0,115,84,0,0,0,103,0,125,3,124,2,
+    68,0,93,32,92,2,137,0,125,4,124,3,160,0,135,0,
+    102,1,100,1,100,2,132,8,124,4,68,0,131,1,161,1,
+    1,0,113,8,124,3,124,0,95,1,124,1,112,54,100,3,
+    124,0,95,2,100,4,124,0,95,3,116,4,131,0,124,0,
+    95,5,116,4,131,0,124,0,95,6,100,5,83,0,41,6,
+    122,154,73,110,105,116,105,97,108,105,122,101,32,119,105,116,
+    104,32,116,104,101,32,112,97,116,104,32,116,111,32,115,101,
+    97,114,99,104,32,111,110,32,97,110,100,32,97,32,118,97,
+    114,105,97,98,108,101,32,110,117,109,98,101,114,32,111,102,
+    10,32,32,32,32,32,32,32,32,50,45,116,117,112,108,101,
+    115,32,99,111,110,116,97,105,110,105,110,103,32,116,104,101,
+    32,108,111,97,100,101,114,32,97,110,100,32,116,104,101,32,
+    102,105,108,101,32,115,117,102,102,105,120,101,115,32,116,104,
+    101,32,108,111,97,100,101,114,10,32,32,32,32,32,32,32,
+    32,114,101,99,111,103,110,105,122,101,115,46,99,1,0,0,
+    0,0,0,0,0,0,0,0,0,2,0,0,0,3,0,0,
+    0,51,0,0,0,115,22,0,0,0,124,0,93,14,125,1,
+    124,1,136,0,102,2,86,0,1,0,113,2,100,0,83,0,
+    114,121,0,0,0,114,7,0,0,0,114,36,1,0,0,169,
+    1,114,151,0,0,0,114,7,0,0,0,114,8,0,0,0,
+    114,9,0,0,0,188,5,0,0,114,14,0,0,0,122,38,
+    70,105,108,101,70,105,110,100,101,114,46,95,95,105,110,105,
+    116,95,95,46,60,108,111,99,97,108,115,62,46,60,103,101,
+    110,101,120,112,114,62,114,86,0,0,0,114,116,0,0,0,
+    78,41,7,114,187,0,0,0,218,8,95,108,111,97,100,101,
+    114,115,114,58,0,0,0,218,11,95,112,97,116,104,95,109,
+    116,105,109,101,218,3,115,101,116,218,11,95,112,97,116,104,
+    95,99,97,99,104,101,218,19,95,114,101,108,97,120,101,100,
+    95,112,97,116,104,95,99,97,99,104,101,41,5,114,130,0,
+    0,0,114,58,0,0,0,218,14,108,111,97,100,101,114,95,
+    100,101,116,97,105,108,115,90,7,108,111,97,100,101,114,115,
+    114,209,0,0,0,114,7,0,0,0,114,88,1,0,0,114,
+    8,0,0,0,114,232,0,0,0,182,5,0,0,115,18,0,
+    0,0,4,4,12,1,26,1,6,1,10,2,6,1,8,1,
+    12,1,255,128,122,19,70,105,108,101,70,105,110,100,101,114,
+    46,95,95,105,110,105,116,95,95,99,1,0,0,0,0,0,
+    0,0,0,0,0,0,1,0,0,0,2,0,0,0,67,0,
+    0,0,115,10,0,0,0,100,1,124,0,95,0,100,2,83,
+    0,41,3,122,31,73,110,118,97,108,105,100,97,116,101,32,
+    116,104,101,32,100,105,114,101,99,116,111,114,121,32,109,116,
+    105,109,101,46,114,116,0,0,0,78,41,1,114,90,1,0,
+    0,114,17,1,0,0,114,7,0,0,0,114,7,0,0,0,
+    114,8,0,0,0,114,70,1,0,0,196,5,0,0,114,69,
+    0,0,0,122,28,70,105,108,101,70,105,110,100,101,114,46,
     105,110,118,97,108,105,100,97,116,101,95,99,97,99,104,101,
-    115,99,1,0,0,0,0,0,0,0,0,0,0,0,2,0,
-    0,0,9,0,0,0,67,0,0,0,115,76,0,0,0,116,
-    0,106,1,100,1,117,1,114,28,116,0,106,1,115,28,116,
-    2,160,3,100,2,116,4,161,2,1,0,116,0,106,1,68,
-    0,93,34,125,1,122,14,124,1,124,0,131,1,87,0,2,
-    0,1,0,83,0,4,0,116,5,121,74,1,0,1,0,1,
-    0,89,0,113,34,100,1,83,0,119,0,41,3,122,46,83,
-    101,97,114,99,104,32,115,121,115,46,112,97,116,104,95,104,
-    111,111,107,115,32,102,111,114,32,97,32,102,105,110,100,101,
-    114,32,102,111,114,32,39,112,97,116,104,39,46,78,122,23,
-    115,121,115,46,112,97,116,104,95,104,111,111,107,115,32,105,
-    115,32,101,109,112,116,121,41,6,114,16,0,0,0,218,10,
-    112,97,116,104,95,104,111,111,107,115,114,88,0,0,0,114,
-    89,0,0,0,114,149,0,0,0,114,129,0,0,0,41,2,
-    114,58,0,0,0,90,4,104,111,111,107,114,7,0,0,0,
-    114,7,0,0,0,114,8,0,0,0,218,11,95,112,97,116,
-    104,95,104,111,111,107,115,254,4,0,0,115,20,0,0,0,
-    16,3,12,1,10,1,2,1,14,1,12,1,4,1,4,2,
-    2,253,255,128,122,22,80,97,116,104,70,105,110,100,101,114,
-    46,95,112,97,116,104,95,104,111,111,107,115,99,2,0,0,
-    0,0,0,0,0,0,0,0,0,3,0,0,0,8,0,0,
-    0,67,0,0,0,115,100,0,0,0,124,1,100,1,107,2,
-    114,40,122,12,116,0,160,1,161,0,125,1,87,0,110,18,
-    4,0,116,2,121,98,1,0,1,0,1,0,89,0,100,2,
-    83,0,122,16,116,3,106,4,124,1,25,0,125,2,87,0,
-    124,2,83,0,4,0,116,5,121,96,1,0,1,0,1,0,
-    124,0,160,6,124,1,161,1,125,2,124,2,116,3,106,4,
-    124,1,60,0,89,0,124,2,83,0,119,0,119,0,41,3,
-    122,210,71,101,116,32,116,104,101,32,102,105,110,100,101,114,
-    32,102,111,114,32,116,104,101,32,112,97,116,104,32,101,110,
-    116,114,121,32,102,114,111,109,32,115,121,115,46,112,97,116,
-    104,95,105,109,112,111,114,116,101,114,95,99,97,99,104,101,
+    115,99,2,0,0,0,0,0,0,0,0,0,0,0,3,0,
+    0,0,3,0,0,0,67,0,0,0,115,42,0,0,0,124,
+    0,160,0,124,1,161,1,125,2,124,2,100,1,117,0,114,
+    26,100,1,103,0,102,2,83,0,124,2,106,1,124,2,106,
+    2,112,38,103,0,102,2,83,0,41,2,122,197,84,114,121,
+    32,116,111,32,102,105,110,100,32,97,32,108,111,97,100,101,
+    114,32,102,111,114,32,116,104,101,32,115,112,101,99,105,102,
+    105,101,100,32,109,111,100,117,108,101,44,32,111,114,32,116,
+    104,101,32,110,97,109,101,115,112,97,99,101,10,32,32,32,
+    32,32,32,32,32,112,97,99,107,97,103,101,32,112,111,114,
+    116,105,111,110,115,46,32,82,101,116,117,114,110,115,32,40,
+    108,111,97,100,101,114,44,32,108,105,115,116,45,111,102,45,
+    112,111,114,116,105,111,110,115,41,46,10,10,32,32,32,32,
+    32,32,32,32,84,104,105,115,32,109,101,116,104,111,100,32,
+    105,115,32,100,101,112,114,101,99,97,116,101,100,46,32,32,
+    85,115,101,32,102,105,110,100,95,115,112,101,99,40,41,32,
+    105,110,115,116,101,97,100,46,10,10,32,32,32,32,32,32,
+    32,32,78,41,3,114,223,0,0,0,114,151,0,0,0,114,
+    198,0,0,0,41,3,114,130,0,0,0,114,150,0,0,0,
+    114,207,0,0,0,114,7,0,0,0,114,7,0,0,0,114,
+    8,0,0,0,114,148,0,0,0,202,5,0,0,115,10,0,
+    0,0,10,7,8,1,8,1,16,1,255,128,122,22,70,105,
+    108,101,70,105,110,100,101,114,46,102,105,110,100,95,108,111,
+    97,100,101,114,99,6,0,0,0,0,0,0,0,0,0,0,
+    0,7,0,0,0,6,0,0,0,67,0,0,0,115,26,0,
+    0,0,124,1,124,2,124,3,131,2,125,6,116,0,124,2,
+    124,3,124,6,124,4,100,1,141,4,83,0,41,2,78,114,
+    197,0,0,0,41,1,114,210,0,0,0,41,7,114,130,0,
+    0,0,114,208,0,0,0,114,150,0,0,0,114,58,0,0,
+    0,90,4,115,109,115,108,114,222,0,0,0,114,151,0,0,
+    0,114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,
+    114,84,1,0,0,214,5,0,0,115,10,0,0,0,10,1,
+    8,1,2,1,6,255,255,128,122,20,70,105,108,101,70,105,
+    110,100,101,114,46,95,103,101,116,95,115,112,101,99,78,99,
+    3,0,0,0,0,0,0,0,0,0,0,0,14,0,0,0,
+    8,0,0,0,67,0,0,0,115,100,1,0,0,100,1,125,
+    3,124,1,160,0,100,2,161,1,100,3,25,0,125,4,122,
+    24,116,1,124,0,106,2,112,34,116,3,160,4,161,0,131,
+    1,106,5,125,5,87,0,110,20,4,0,116,6,144,1,121,
+    98,1,0,1,0,1,0,100,4,125,5,89,0,124,5,124,
+    0,106,7,107,3,114,88,124,0,160,8,161,0,1,0,124,
+    5,124,0,95,7,116,9,131,0,114,110,124,0,106,10,125,
+    6,124,4,160,11,161,0,125,7,110,10,124,0,106,12,125,
+    6,124,4,125,7,124,7,124,6,118,0,114,214,116,13,124,
+    0,106,2,124,4,131,2,125,8,124,0,106,14,68,0,93,
+    58,92,2,125,9,125,10,100,5,124,9,23,0,125,11,116,
+    13,124,8,124,11,131,2,125,12,116,15,124,12,131,1,114,
+    204,124,0,160,16,124,10,124,1,124,12,124,8,103,1,124,
+    2,161,5,2,0,1,0,83,0,113,146,116,17,124,8,131,
+    1,125,3,124,0,106,14,68,0,93,86,92,2,125,9,125,
+    10,116,13,124,0,106,2,124,4,124,9,23,0,131,2,125,
+    12,116,18,106,19,100,6,124,12,100,3,100,7,141,3,1,
+    0,124,7,124,9,23,0,124,6,118,0,144,1,114,50,116,
+    15,124,12,131,1,144,1,114,50,124,0,160,16,124,10,124,
+    1,124,12,100,8,124,2,161,5,2,0,1,0,83,0,113,
+    220,124,3,144,1,114,94,116,18,160,19,100,9,124,8,161,
+    2,1,0,116,18,160,20,124,1,100,8,161,2,125,13,124,
+    8,103,1,124,13,95,21,124,13,83,0,100,8,83,0,119,
+    0,41,10,122,111,84,114,121,32,116,111,32,102,105,110,100,
+    32,97,32,115,112,101,99,32,102,111,114,32,116,104,101,32,
+    115,112,101,99,105,102,105,101,100,32,109,111,100,117,108,101,
+    46,10,10,32,32,32,32,32,32,32,32,82,101,116,117,114,
+    110,115,32,116,104,101,32,109,97,116,99,104,105,110,103,32,
+    115,112,101,99,44,32,111,114,32,78,111,110,101,32,105,102,
+    32,110,111,116,32,102,111,117,110,100,46,10,32,32,32,32,
+    32,32,32,32,70,114,86,0,0,0,114,45,0,0,0,114,
+    116,0,0,0,114,232,0,0,0,122,9,116,114,121,105,110,
+    103,32,123,125,41,1,90,9,118,101,114,98,111,115,105,116,
+    121,78,122,25,112,111,115,115,105,98,108,101,32,110,97,109,
+    101,115,112,97,99,101,32,102,111,114,32,123,125,41,22,114,
+    55,0,0,0,114,63,0,0,0,114,58,0,0,0,114,19,
+    0,0,0,114,70,0,0,0,114,180,0,0,0,114,64,0,
+    0,0,114,90,1,0,0,218,11,95,102,105,108,108,95,99,
+    97,99,104,101,114,22,0,0,0,114,93,1,0,0,114,117,
+    0,0,0,114,92,1,0,0,114,54,0,0,0,114,89,1,
+    0,0,114,68,0,0,0,114,84,1,0,0,114,71,0,0,
+    0,114,146,0,0,0,114,160,0,0,0,114,203,0,0,0,
+    114,198,0,0,0,41,14,114,130,0,0,0,114,150,0,0,
+    0,114,222,0,0,0,90,12,105,115,95,110,97,109,101,115,
+    112,97,99,101,90,11,116,97,105,108,95,109,111,100,117,108,
+    101,114,189,0,0,0,90,5,99,97,99,104,101,90,12,99,
+    97,99,104,101,95,109,111,100,117,108,101,90,9,98,97,115,
+    101,95,112,97,116,104,114,37,1,0,0,114,208,0,0,0,
+    90,13,105,110,105,116,95,102,105,108,101,110,97,109,101,90,
+    9,102,117,108,108,95,112,97,116,104,114,207,0,0,0,114,
+    7,0,0,0,114,7,0,0,0,114,8,0,0,0,114,223,
+    0,0,0,219,5,0,0,115,80,0,0,0,4,5,14,1,
+    2,1,24,1,14,1,6,1,10,1,8,1,6,1,6,2,
+    6,1,10,1,6,2,4,1,8,2,12,1,14,1,8,1,
+    10,1,8,1,24,1,2,255,8,5,14,2,16,1,16,1,
+    14,1,10,1,10,1,4,1,8,255,2,128,6,2,12,1,
+    12,1,8,1,4,1,4,1,2,219,255,128,122,20,70,105,
+    108,101,70,105,110,100,101,114,46,102,105,110,100,95,115,112,
+    101,99,99,1,0,0,0,0,0,0,0,0,0,0,0,9,
+    0,0,0,10,0,0,0,67,0,0,0,115,190,0,0,0,
+    124,0,106,0,125,1,122,22,116,1,160,2,124,1,112,22,
+    116,1,160,3,161,0,161,1,125,2,87,0,110,24,4,0,
+    116,4,116,5,116,6,102,3,121,188,1,0,1,0,1,0,
+    103,0,125,2,89,0,116,7,106,8,160,9,100,1,161,1,
+    115,78,116,10,124,2,131,1,124,0,95,11,110,74,116,10,
+    131,0,125,3,124,2,68,0,93,56,125,4,124,4,160,12,
+    100,2,161,1,92,3,125,5,125,6,125,7,124,6,114,130,
+    100,3,160,13,124,5,124,7,160,14,161,0,161,2,125,8,
+    110,4,124,5,125,8,124,3,160,15,124,8,161,1,1,0,
+    113,88,124,3,124,0,95,11,116,7,106,8,160,9,116,16,
+    161,1,114,184,100,4,100,5,132,0,124,2,68,0,131,1,
+    124,0,95,17,100,6,83,0,100,6,83,0,119,0,41,7,
+    122,68,70,105,108,108,32,116,104,101,32,99,97,99,104,101,
+    32,111,102,32,112,111,116,101,110,116,105,97,108,32,109,111,
+    100,117,108,101,115,32,97,110,100,32,112,97,99,107,97,103,
+    101,115,32,102,111,114,32,116,104,105,115,32,100,105,114,101,
+    99,116,111,114,121,46,114,15,0,0,0,114,86,0,0,0,
+    114,76,0,0,0,99,1,0,0,0,0,0,0,0,0,0,
+    0,0,2,0,0,0,4,0,0,0,83,0,0,0,115,20,
+    0,0,0,104,0,124,0,93,12,125,1,124,1,160,0,161,
+    0,146,2,113,4,83,0,114,7,0,0,0,41,1,114,117,
+    0,0,0,41,2,114,5,0,0,0,90,2,102,110,114,7,
+    0,0,0,114,7,0,0,0,114,8,0,0,0,114,13,0,
+    0,0,40,6,0,0,115,4,0,0,0,20,0,255,128,122,
+    41,70,105,108,101,70,105,110,100,101,114,46,95,102,105,108,
+    108,95,99,97,99,104,101,46,60,108,111,99,97,108,115,62,
+    46,60,115,101,116,99,111,109,112,62,78,41,18,114,58,0,
+    0,0,114,19,0,0,0,90,7,108,105,115,116,100,105,114,
+    114,70,0,0,0,114,78,1,0,0,218,15,80,101,114,109,
+    105,115,115,105,111,110,69,114,114,111,114,218,18,78,111,116,
+    65,68,105,114,101,99,116,111,114,121,69,114,114,111,114,114,
+    16,0,0,0,114,26,0,0,0,114,27,0,0,0,114,91,
+    1,0,0,114,92,1,0,0,114,112,0,0,0,114,77,0,
+    0,0,114,117,0,0,0,218,3,97,100,100,114,28,0,0,
+    0,114,93,1,0,0,41,9,114,130,0,0,0,114,58,0,
+    0,0,90,8,99,111,110,116,101,110,116,115,90,21,108,111,
+    119,101,114,95,115,117,102,102,105,120,95,99,111,110,116,101,
+    110,116,115,114,63,1,0,0,114,128,0,0,0,114,47,1,
+    0,0,114,37,1,0,0,90,8,110,101,119,95,110,97,109,
+    101,114,7,0,0,0,114,7,0,0,0,114,8,0,0,0,
+    114,95,1,0,0,11,6,0,0,115,40,0,0,0,6,2,
+    2,1,22,1,18,1,6,3,12,3,12,1,6,7,8,1,
+    16,1,4,1,18,1,4,2,12,1,6,1,12,1,20,1,
+    4,255,2,233,255,128,122,22,70,105,108,101,70,105,110,100,
+    101,114,46,95,102,105,108,108,95,99,97,99,104,101,99,1,
+    0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,3,
+    0,0,0,7,0,0,0,115,18,0,0,0,135,0,135,1,
+    102,2,100,1,100,2,132,8,125,2,124,2,83,0,41,4,
+    97,20,1,0,0,65,32,99,108,97,115,115,32,109,101,116,
+    104,111,100,32,119,104,105,99,104,32,114,101,116,117,114,110,
+    115,32,97,32,99,108,111,115,117,114,101,32,116,111,32,117,
+    115,101,32,111,110,32,115,121,115,46,112,97,116,104,95,104,
+    111,111,107,10,32,32,32,32,32,32,32,32,119,104,105,99,
+    104,32,119,105,108,108,32,114,101,116,117,114,110,32,97,110,
+    32,105,110,115,116,97,110,99,101,32,117,115,105,110,103,32,
+    116,104,101,32,115,112,101,99,105,102,105,101,100,32,108,111,
+    97,100,101,114,115,32,97,110,100,32,116,104,101,32,112,97,
+    116,104,10,32,32,32,32,32,32,32,32,99,97,108,108,101,
+    100,32,111,110,32,116,104,101,32,99,108,111,115,117,114,101,
     46,10,10,32,32,32,32,32,32,32,32,73,102,32,116,104,
-    101,32,112,97,116,104,32,101,110,116,114,121,32,105,115,32,
-    110,111,116,32,105,110,32,116,104,101,32,99,97,99,104,101,
-    44,32,102,105,110,100,32,116,104,101,32,97,112,112,114,111,
-    112,114,105,97,116,101,32,102,105,110,100,101,114,10,32,32,
-    32,32,32,32,32,32,97,110,100,32,99,97,99,104,101,32,
-    105,116,46,32,73,102,32,110,111,32,102,105,110,100,101,114,
-    32,105,115,32,97,118,97,105,108,97,98,108,101,44,32,115,
-    116,111,114,101,32,78,111,110,101,46,10,10,32,32,32,32,
-    32,32,32,32,114,10,0,0,0,78,41,7,114,19,0,0,
-    0,114,70,0,0,0,218,17,70,105,108,101,78,111,116,70,
-    111,117,110,100,69,114,114,111,114,114,16,0,0,0,114,64,
-    1,0,0,218,8,75,101,121,69,114,114,111,114,114,68,1,
-    0,0,41,3,114,209,0,0,0,114,58,0,0,0,114,66,
-    1,0,0,114,7,0,0,0,114,7,0,0,0,114,8,0,
-    0,0,218,20,95,112,97,116,104,95,105,109,112,111,114,116,
-    101,114,95,99,97,99,104,101,11,5,0,0,115,30,0,0,
-    0,8,8,2,1,12,1,12,1,6,3,2,1,12,1,4,
-    4,12,253,10,1,12,1,4,1,2,253,2,250,255,128,122,
-    31,80,97,116,104,70,105,110,100,101,114,46,95,112,97,116,
-    104,95,105,109,112,111,114,116,101,114,95,99,97,99,104,101,
-    99,3,0,0,0,0,0,0,0,0,0,0,0,6,0,0,
-    0,4,0,0,0,67,0,0,0,115,82,0,0,0,116,0,
-    124,2,100,1,131,2,114,26,124,2,160,1,124,1,161,1,
-    92,2,125,3,125,4,110,14,124,2,160,2,124,1,161,1,
-    125,3,103,0,125,4,124,3,100,0,117,1,114,60,116,3,
-    160,4,124,1,124,3,161,2,83,0,116,3,160,5,124,1,
-    100,0,161,2,125,5,124,4,124,5,95,6,124,5,83,0,
-    41,2,78,114,148,0,0,0,41,7,114,140,0,0,0,114,
-    148,0,0,0,114,217,0,0,0,114,146,0,0,0,114,212,
-    0,0,0,114,194,0,0,0,114,189,0,0,0,41,6,114,
-    209,0,0,0,114,150,0,0,0,114,66,1,0,0,114,151,
-    0,0,0,114,152,0,0,0,114,198,0,0,0,114,7,0,
-    0,0,114,7,0,0,0,114,8,0,0,0,218,16,95,108,
-    101,103,97,99,121,95,103,101,116,95,115,112,101,99,33,5,
-    0,0,115,20,0,0,0,10,4,16,1,10,2,4,1,8,
-    1,12,1,12,1,6,1,4,1,255,128,122,27,80,97,116,
-    104,70,105,110,100,101,114,46,95,108,101,103,97,99,121,95,
-    103,101,116,95,115,112,101,99,78,99,4,0,0,0,0,0,
-    0,0,0,0,0,0,9,0,0,0,5,0,0,0,67,0,
-    0,0,115,166,0,0,0,103,0,125,4,124,2,68,0,93,
-    134,125,5,116,0,124,5,116,1,116,2,102,2,131,2,115,
-    28,113,8,124,0,160,3,124,5,161,1,125,6,124,6,100,
-    1,117,1,114,142,116,4,124,6,100,2,131,2,114,70,124,
-    6,160,5,124,1,124,3,161,2,125,7,110,12,124,0,160,
-    6,124,1,124,6,161,2,125,7,124,7,100,1,117,0,114,
-    92,113,8,124,7,106,7,100,1,117,1,114,110,124,7,2,
-    0,1,0,83,0,124,7,106,8,125,8,124,8,100,1,117,
-    0,114,132,116,9,100,3,131,1,130,1,124,4,160,10,124,
-    8,161,1,1,0,113,8,116,11,160,12,124,1,100,1,161,
-    2,125,7,124,4,124,7,95,8,124,7,83,0,41,4,122,
-    63,70,105,110,100,32,116,104,101,32,108,111,97,100,101,114,
-    32,111,114,32,110,97,109,101,115,112,97,99,101,95,112,97,
-    116,104,32,102,111,114,32,116,104,105,115,32,109,111,100,117,
-    108,101,47,112,97,99,107,97,103,101,32,110,97,109,101,46,
-    78,114,214,0,0,0,122,19,115,112,101,99,32,109,105,115,
-    115,105,110,103,32,108,111,97,100,101,114,41,13,114,172,0,
-    0,0,114,97,0,0,0,218,5,98,121,116,101,115,114,71,
-    1,0,0,114,140,0,0,0,114,214,0,0,0,114,72,1,
-    0,0,114,151,0,0,0,114,189,0,0,0,114,129,0,0,
-    0,114,178,0,0,0,114,146,0,0,0,114,194,0,0,0,
-    41,9,114,209,0,0,0,114,150,0,0,0,114,58,0,0,
-    0,114,213,0,0,0,218,14,110,97,109,101,115,112,97,99,
-    101,95,112,97,116,104,90,5,101,110,116,114,121,114,66,1,
-    0,0,114,198,0,0,0,114,152,0,0,0,114,7,0,0,
-    0,114,7,0,0,0,114,8,0,0,0,218,9,95,103,101,
-    116,95,115,112,101,99,48,5,0,0,115,44,0,0,0,4,
-    5,8,1,14,1,2,1,10,1,8,1,10,1,14,1,12,
-    2,8,1,2,1,10,1,8,1,6,1,8,1,8,1,10,
-    5,2,128,12,2,6,1,4,1,255,128,122,20,80,97,116,
-    104,70,105,110,100,101,114,46,95,103,101,116,95,115,112,101,
-    99,99,4,0,0,0,0,0,0,0,0,0,0,0,6,0,
-    0,0,5,0,0,0,67,0,0,0,115,94,0,0,0,124,
-    2,100,1,117,0,114,14,116,0,106,1,125,2,124,0,160,
-    2,124,1,124,2,124,3,161,3,125,4,124,4,100,1,117,
-    0,114,40,100,1,83,0,124,4,106,3,100,1,117,0,114,
-    90,124,4,106,4,125,5,124,5,114,86,100,1,124,4,95,
-    5,116,6,124,1,124,5,124,0,106,2,131,3,124,4,95,
-    4,124,4,83,0,100,1,83,0,124,4,83,0,41,2,122,
-    141,84,114,121,32,116,111,32,102,105,110,100,32,97,32,115,
-    112,101,99,32,102,111,114,32,39,102,117,108,108,110,97,109,
-    101,39,32,111,110,32,115,121,115,46,112,97,116,104,32,111,
-    114,32,39,112,97,116,104,39,46,10,10,32,32,32,32,32,
-    32,32,32,84,104,101,32,115,101,97,114,99,104,32,105,115,
-    32,98,97,115,101,100,32,111,110,32,115,121,115,46,112,97,
-    116,104,95,104,111,111,107,115,32,97,110,100,32,115,121,115,
-    46,112,97,116,104,95,105,109,112,111,114,116,101,114,95,99,
-    97,99,104,101,46,10,32,32,32,32,32,32,32,32,78,41,
-    7,114,16,0,0,0,114,58,0,0,0,114,75,1,0,0,
-    114,151,0,0,0,114,189,0,0,0,114,192,0,0,0,114,
-    32,1,0,0,41,6,114,209,0,0,0,114,150,0,0,0,
-    114,58,0,0,0,114,213,0,0,0,114,198,0,0,0,114,
-    74,1,0,0,114,7,0,0,0,114,7,0,0,0,114,8,
-    0,0,0,114,214,0,0,0,80,5,0,0,115,28,0,0,
-    0,8,6,6,1,14,1,8,1,4,1,10,1,6,1,4,
-    1,6,3,16,1,4,1,4,2,4,2,255,128,122,20,80,
-    97,116,104,70,105,110,100,101,114,46,102,105,110,100,95,115,
-    112,101,99,99,3,0,0,0,0,0,0,0,0,0,0,0,
-    4,0,0,0,4,0,0,0,67,0,0,0,115,30,0,0,
-    0,124,0,160,0,124,1,124,2,161,2,125,3,124,3,100,
-    1,117,0,114,24,100,1,83,0,124,3,106,1,83,0,41,
-    2,122,170,102,105,110,100,32,116,104,101,32,109,111,100,117,
-    108,101,32,111,110,32,115,121,115,46,112,97,116,104,32,111,
-    114,32,39,112,97,116,104,39,32,98,97,115,101,100,32,111,
-    110,32,115,121,115,46,112,97,116,104,95,104,111,111,107,115,
-    32,97,110,100,10,32,32,32,32,32,32,32,32,115,121,115,
-    46,112,97,116,104,95,105,109,112,111,114,116,101,114,95,99,
-    97,99,104,101,46,10,10,32,32,32,32,32,32,32,32,84,
-    104,105,115,32,109,101,116,104,111,100,32,105,115,32,100,101,
-    112,114,101,99,97,116,101,100,46,32,32,85,115,101,32,102,
-    105,110,100,95,115,112,101,99,40,41,32,105,110,115,116,101,
-    97,100,46,10,10,32,32,32,32,32,32,32,32,78,114,215,
-    0,0,0,114,216,0,0,0,114,7,0,0,0,114,7,0,
-    0,0,114,8,0,0,0,114,217,0,0,0,104,5,0,0,
-    115,10,0,0,0,12,8,8,1,4,1,6,1,255,128,122,
-    22,80,97,116,104,70,105,110,100,101,114,46,102,105,110,100,
-    95,109,111,100,117,108,101,99,0,0,0,0,0,0,0,0,
-    0,0,0,0,3,0,0,0,4,0,0,0,79,0,0,0,
-    115,28,0,0,0,100,1,100,2,108,0,109,1,125,2,1,
-    0,124,2,106,2,124,0,105,0,124,1,164,1,142,1,83,
-    0,41,4,97,32,1,0,0,10,32,32,32,32,32,32,32,
-    32,70,105,110,100,32,100,105,115,116,114,105,98,117,116,105,
-    111,110,115,46,10,10,32,32,32,32,32,32,32,32,82,101,
-    116,117,114,110,32,97,110,32,105,116,101,114,97,98,108,101,
-    32,111,102,32,97,108,108,32,68,105,115,116,114,105,98,117,
-    116,105,111,110,32,105,110,115,116,97,110,99,101,115,32,99,
-    97,112,97,98,108,101,32,111,102,10,32,32,32,32,32,32,
-    32,32,108,111,97,100,105,110,103,32,116,104,101,32,109,101,
-    116,97,100,97,116,97,32,102,111,114,32,112,97,99,107,97,
-    103,101,115,32,109,97,116,99,104,105,110,103,32,96,96,99,
-    111,110,116,101,120,116,46,110,97,109,101,96,96,10,32,32,
-    32,32,32,32,32,32,40,111,114,32,97,108,108,32,110,97,
-    109,101,115,32,105,102,32,96,96,78,111,110,101,96,96,32,
-    105,110,100,105,99,97,116,101,100,41,32,97,108,111,110,103,
-    32,116,104,101,32,112,97,116,104,115,32,105,110,32,116,104,
-    101,32,108,105,115,116,10,32,32,32,32,32,32,32,32,111,
-    102,32,100,105,114,101,99,116,111,114,105,101,115,32,96,96,
-    99,111,110,116,101,120,116,46,112,97,116,104,96,96,46,10,
-    32,32,32,32,32,32,32,32,114,0,0,0,0,41,1,218,
-    18,77,101,116,97,100,97,116,97,80,97,116,104,70,105,110,
-    100,101,114,78,41,3,90,18,105,109,112,111,114,116,108,105,
-    98,46,109,101,116,97,100,97,116,97,114,76,1,0,0,218,
-    18,102,105,110,100,95,100,105,115,116,114,105,98,117,116,105,
-    111,110,115,41,3,114,131,0,0,0,114,132,0,0,0,114,
-    76,1,0,0,114,7,0,0,0,114,7,0,0,0,114,8,
-    0,0,0,114,77,1,0,0,117,5,0,0,115,6,0,0,
-    0,12,10,16,1,255,128,122,29,80,97,116,104,70,105,110,
-    100,101,114,46,102,105,110,100,95,100,105,115,116,114,105,98,
-    117,116,105,111,110,115,41,1,78,41,2,78,78,41,1,78,
-    41,14,114,137,0,0,0,114,136,0,0,0,114,138,0,0,
-    0,114,139,0,0,0,114,220,0,0,0,114,62,1,0,0,
-    114,68,1,0,0,114,221,0,0,0,114,71,1,0,0,114,
-    72,1,0,0,114,75,1,0,0,114,214,0,0,0,114,217,
-    0,0,0,114,77,1,0,0,114,7,0,0,0,114,7,0,
-    0,0,114,7,0,0,0,114,8,0,0,0,114,61,1,0,
-    0,240,4,0,0,115,38,0,0,0,8,0,4,2,2,2,
-    10,1,2,9,10,1,2,12,10,1,2,21,10,1,2,14,
-    12,1,2,31,12,1,2,23,12,1,2,12,14,1,255,128,
-    114,61,1,0,0,99,0,0,0,0,0,0,0,0,0,0,
-    0,0,0,0,0,0,3,0,0,0,64,0,0,0,115,90,
-    0,0,0,101,0,90,1,100,0,90,2,100,1,90,3,100,
-    2,100,3,132,0,90,4,100,4,100,5,132,0,90,5,101,
-    6,90,7,100,6,100,7,132,0,90,8,100,8,100,9,132,
-    0,90,9,100,19,100,11,100,12,132,1,90,10,100,13,100,
-    14,132,0,90,11,101,12,100,15,100,16,132,0,131,1,90,
-    13,100,17,100,18,132,0,90,14,100,10,83,0,41,20,218,
-    10,70,105,108,101,70,105,110,100,101,114,122,172,70,105,108,
-    101,45,98,97,115,101,100,32,102,105,110,100,101,114,46,10,
-    10,32,32,32,32,73,110,116,101,114,97,99,116,105,111,110,
-    115,32,119,105,116,104,32,116,104,101,32,102,105,108,101,32,
-    115,121,115,116,101,109,32,97,114,101,32,99,97,99,104,101,
-    100,32,102,111,114,32,112,101,114,102,111,114,109,97,110,99,
-    101,44,32,98,101,105,110,103,10,32,32,32,32,114,101,102,
-    114,101,115,104,101,100,32,119,104,101,110,32,116,104,101,32,
-    100,105,114,101,99,116,111,114,121,32,116,104,101,32,102,105,
-    110,100,101,114,32,105,115,32,104,97,110,100,108,105,110,103,
-    32,104,97,115,32,98,101,101,110,32,109,111,100,105,102,105,
-    101,100,46,10,10,32,32,32,32,99,2,0,0,0,0,0,
-    0,0,0,0,0,0,5,0,0,0,6,0,0,0,7,0,
-    0,0,115,84,0,0,0,103,0,125,3,124,2,68,0,93,
-    32,92,2,137,0,125,4,124,3,160,0,135,0,102,1,100,
-    1,100,2,132,8,124,4,68,0,131,1,161,1,1,0,113,
-    8,124,3,124,0,95,1,124,1,112,54,100,3,124,0,95,
-    2,100,4,124,0,95,3,116,4,131,0,124,0,95,5,116,
-    4,131,0,124,0,95,6,100,5,83,0,41,6,122,154,73,
-    110,105,116,105,97,108,105,122,101,32,119,105,116,104,32,116,
-    104,101,32,112,97,116,104,32,116,111,32,115,101,97,114,99,
-    104,32,111,110,32,97,110,100,32,97,32,118,97,114,105,97,
-    98,108,101,32,110,117,109,98,101,114,32,111,102,10,32,32,
-    32,32,32,32,32,32,50,45,116,117,112,108,101,115,32,99,
-    111,110,116,97,105,110,105,110,103,32,116,104,101,32,108,111,
-    97,100,101,114,32,97,110,100,32,116,104,101,32,102,105,108,
-    101,32,115,117,102,102,105,120,101,115,32,116,104,101,32,108,
-    111,97,100,101,114,10,32,32,32,32,32,32,32,32,114,101,
-    99,111,103,110,105,122,101,115,46,99,1,0,0,0,0,0,
-    0,0,0,0,0,0,2,0,0,0,3,0,0,0,51,0,
-    0,0,115,22,0,0,0,124,0,93,14,125,1,124,1,136,
-    0,102,2,86,0,1,0,113,2,100,0,83,0,114,121,0,
-    0,0,114,7,0,0,0,114,28,1,0,0,169,1,114,151,
-    0,0,0,114,7,0,0,0,114,8,0,0,0,114,9,0,
-    0,0,146,5,0,0,114,14,0,0,0,122,38,70,105,108,
-    101,70,105,110,100,101,114,46,95,95,105,110,105,116,95,95,
-    46,60,108,111,99,97,108,115,62,46,60,103,101,110,101,120,
-    112,114,62,114,86,0,0,0,114,116,0,0,0,78,41,7,
-    114,178,0,0,0,218,8,95,108,111,97,100,101,114,115,114,
-    58,0,0,0,218,11,95,112,97,116,104,95,109,116,105,109,
-    101,218,3,115,101,116,218,11,95,112,97,116,104,95,99,97,
-    99,104,101,218,19,95,114,101,108,97,120,101,100,95,112,97,
-    116,104,95,99,97,99,104,101,41,5,114,130,0,0,0,114,
-    58,0,0,0,218,14,108,111,97,100,101,114,95,100,101,116,
-    97,105,108,115,90,7,108,111,97,100,101,114,115,114,200,0,
-    0,0,114,7,0,0,0,114,79,1,0,0,114,8,0,0,
-    0,114,223,0,0,0,140,5,0,0,115,18,0,0,0,4,
-    4,12,1,26,1,6,1,10,2,6,1,8,1,12,1,255,
-    128,122,19,70,105,108,101,70,105,110,100,101,114,46,95,95,
-    105,110,105,116,95,95,99,1,0,0,0,0,0,0,0,0,
-    0,0,0,1,0,0,0,2,0,0,0,67,0,0,0,115,
-    10,0,0,0,100,1,124,0,95,0,100,2,83,0,41,3,
-    122,31,73,110,118,97,108,105,100,97,116,101,32,116,104,101,
-    32,100,105,114,101,99,116,111,114,121,32,109,116,105,109,101,
-    46,114,116,0,0,0,78,41,1,114,81,1,0,0,114,8,
-    1,0,0,114,7,0,0,0,114,7,0,0,0,114,8,0,
-    0,0,114,62,1,0,0,154,5,0,0,114,69,0,0,0,
-    122,28,70,105,108,101,70,105,110,100,101,114,46,105,110,118,
-    97,108,105,100,97,116,101,95,99,97,99,104,101,115,99,2,
+    101,32,112,97,116,104,32,99,97,108,108,101,100,32,111,110,
+    32,116,104,101,32,99,108,111,115,117,114,101,32,105,115,32,
+    110,111,116,32,97,32,100,105,114,101,99,116,111,114,121,44,
+    32,73,109,112,111,114,116,69,114,114,111,114,32,105,115,10,
+    32,32,32,32,32,32,32,32,114,97,105,115,101,100,46,10,
+    10,32,32,32,32,32,32,32,32,99,1,0,0,0,0,0,
+    0,0,0,0,0,0,1,0,0,0,4,0,0,0,19,0,
+    0,0,115,36,0,0,0,116,0,124,0,131,1,115,20,116,
+    1,100,1,124,0,100,2,141,2,130,1,136,0,124,0,103,
+    1,136,1,162,1,82,0,142,0,83,0,41,4,122,45,80,
+    97,116,104,32,104,111,111,107,32,102,111,114,32,105,109,112,
+    111,114,116,108,105,98,46,109,97,99,104,105,110,101,114,121,
+    46,70,105,108,101,70,105,110,100,101,114,46,122,30,111,110,
+    108,121,32,100,105,114,101,99,116,111,114,105,101,115,32,97,
+    114,101,32,115,117,112,112,111,114,116,101,100,114,62,0,0,
+    0,78,41,2,114,71,0,0,0,114,129,0,0,0,114,62,
+    0,0,0,169,2,114,218,0,0,0,114,94,1,0,0,114,
+    7,0,0,0,114,8,0,0,0,218,24,112,97,116,104,95,
+    104,111,111,107,95,102,111,114,95,70,105,108,101,70,105,110,
+    100,101,114,52,6,0,0,115,8,0,0,0,8,2,12,1,
+    16,1,255,128,122,54,70,105,108,101,70,105,110,100,101,114,
+    46,112,97,116,104,95,104,111,111,107,46,60,108,111,99,97,
+    108,115,62,46,112,97,116,104,95,104,111,111,107,95,102,111,
+    114,95,70,105,108,101,70,105,110,100,101,114,78,114,7,0,
+    0,0,41,3,114,218,0,0,0,114,94,1,0,0,114,100,
+    1,0,0,114,7,0,0,0,114,99,1,0,0,114,8,0,
+    0,0,218,9,112,97,116,104,95,104,111,111,107,42,6,0,
+    0,115,6,0,0,0,14,10,4,6,255,128,122,20,70,105,
+    108,101,70,105,110,100,101,114,46,112,97,116,104,95,104,111,
+    111,107,99,1,0,0,0,0,0,0,0,0,0,0,0,1,
+    0,0,0,3,0,0,0,67,0,0,0,114,60,1,0,0,
+    41,2,78,122,16,70,105,108,101,70,105,110,100,101,114,40,
+    123,33,114,125,41,41,2,114,77,0,0,0,114,58,0,0,
+    0,114,17,1,0,0,114,7,0,0,0,114,7,0,0,0,
+    114,8,0,0,0,114,61,1,0,0,60,6,0,0,114,54,
+    1,0,0,122,19,70,105,108,101,70,105,110,100,101,114,46,
+    95,95,114,101,112,114,95,95,41,1,78,41,15,114,137,0,
+    0,0,114,136,0,0,0,114,138,0,0,0,114,139,0,0,
+    0,114,232,0,0,0,114,70,1,0,0,114,154,0,0,0,
+    114,226,0,0,0,114,148,0,0,0,114,84,1,0,0,114,
+    223,0,0,0,114,95,1,0,0,114,230,0,0,0,114,101,
+    1,0,0,114,61,1,0,0,114,7,0,0,0,114,7,0,
+    0,0,114,7,0,0,0,114,8,0,0,0,114,87,1,0,
+    0,173,5,0,0,115,26,0,0,0,8,0,4,2,8,7,
+    8,14,4,4,8,2,8,12,10,5,8,48,2,31,10,1,
+    12,17,255,128,114,87,1,0,0,99,4,0,0,0,0,0,
+    0,0,0,0,0,0,6,0,0,0,8,0,0,0,67,0,
+    0,0,115,144,0,0,0,124,0,160,0,100,1,161,1,125,
+    4,124,0,160,0,100,2,161,1,125,5,124,4,115,66,124,
+    5,114,36,124,5,106,1,125,4,110,30,124,2,124,3,107,
+    2,114,56,116,2,124,1,124,2,131,2,125,4,110,10,116,
+    3,124,1,124,2,131,2,125,4,124,5,115,84,116,4,124,
+    1,124,2,124,4,100,3,141,3,125,5,122,38,124,5,124,
+    0,100,2,60,0,124,4,124,0,100,1,60,0,124,2,124,
+    0,100,4,60,0,124,3,124,0,100,5,60,0,87,0,100,
+    0,83,0,4,0,116,5,121,142,1,0,1,0,1,0,89,
+    0,100,0,83,0,119,0,41,6,78,218,10,95,95,108,111,
+    97,100,101,114,95,95,218,8,95,95,115,112,101,99,95,95,
+    114,88,1,0,0,90,8,95,95,102,105,108,101,95,95,90,
+    10,95,95,99,97,99,104,101,100,95,95,41,6,114,4,1,
+    0,0,114,151,0,0,0,114,34,1,0,0,114,29,1,0,
+    0,114,210,0,0,0,218,9,69,120,99,101,112,116,105,111,
+    110,41,6,90,2,110,115,114,128,0,0,0,90,8,112,97,
+    116,104,110,97,109,101,90,9,99,112,97,116,104,110,97,109,
+    101,114,151,0,0,0,114,207,0,0,0,114,7,0,0,0,
+    114,7,0,0,0,114,8,0,0,0,218,14,95,102,105,120,
+    95,117,112,95,109,111,100,117,108,101,66,6,0,0,115,38,
+    0,0,0,10,2,10,1,4,1,4,1,8,1,8,1,12,
+    1,10,2,4,1,14,1,2,1,8,1,8,1,8,1,14,
+    1,12,1,6,2,2,254,255,128,114,105,1,0,0,99,0,
     0,0,0,0,0,0,0,0,0,0,0,3,0,0,0,3,
-    0,0,0,67,0,0,0,115,42,0,0,0,124,0,160,0,
-    124,1,161,1,125,2,124,2,100,1,117,0,114,26,100,1,
-    103,0,102,2,83,0,124,2,106,1,124,2,106,2,112,38,
-    103,0,102,2,83,0,41,2,122,197,84,114,121,32,116,111,
-    32,102,105,110,100,32,97,32,108,111,97,100,101,114,32,102,
-    111,114,32,116,104,101,32,115,112,101,99,105,102,105,101,100,
-    32,109,111,100,117,108,101,44,32,111,114,32,116,104,101,32,
-    110,97,109,101,115,112,97,99,101,10,32,32,32,32,32,32,
-    32,32,112,97,99,107,97,103,101,32,112,111,114,116,105,111,
-    110,115,46,32,82,101,116,117,114,110,115,32,40,108,111,97,
-    100,101,114,44,32,108,105,115,116,45,111,102,45,112,111,114,
-    116,105,111,110,115,41,46,10,10,32,32,32,32,32,32,32,
-    32,84,104,105,115,32,109,101,116,104,111,100,32,105,115,32,
-    100,101,112,114,101,99,97,116,101,100,46,32,32,85,115,101,
-    32,102,105,110,100,95,115,112,101,99,40,41,32,105,110,115,
-    116,101,97,100,46,10,10,32,32,32,32,32,32,32,32,78,
-    41,3,114,214,0,0,0,114,151,0,0,0,114,189,0,0,
-    0,41,3,114,130,0,0,0,114,150,0,0,0,114,198,0,
-    0,0,114,7,0,0,0,114,7,0,0,0,114,8,0,0,
-    0,114,148,0,0,0,160,5,0,0,115,10,0,0,0,10,
-    7,8,1,8,1,16,1,255,128,122,22,70,105,108,101,70,
-    105,110,100,101,114,46,102,105,110,100,95,108,111,97,100,101,
-    114,99,6,0,0,0,0,0,0,0,0,0,0,0,7,0,
-    0,0,6,0,0,0,67,0,0,0,115,26,0,0,0,124,
-    1,124,2,124,3,131,2,125,6,116,0,124,2,124,3,124,
-    6,124,4,100,1,141,4,83,0,41,2,78,114,188,0,0,
-    0,41,1,114,201,0,0,0,41,7,114,130,0,0,0,114,
-    199,0,0,0,114,150,0,0,0,114,58,0,0,0,90,4,
-    115,109,115,108,114,213,0,0,0,114,151,0,0,0,114,7,
-    0,0,0,114,7,0,0,0,114,8,0,0,0,114,75,1,
-    0,0,172,5,0,0,115,10,0,0,0,10,1,8,1,2,
-    1,6,255,255,128,122,20,70,105,108,101,70,105,110,100,101,
-    114,46,95,103,101,116,95,115,112,101,99,78,99,3,0,0,
-    0,0,0,0,0,0,0,0,0,14,0,0,0,8,0,0,
-    0,67,0,0,0,115,100,1,0,0,100,1,125,3,124,1,
-    160,0,100,2,161,1,100,3,25,0,125,4,122,24,116,1,
-    124,0,106,2,112,34,116,3,160,4,161,0,131,1,106,5,
-    125,5,87,0,110,20,4,0,116,6,144,1,121,98,1,0,
-    1,0,1,0,100,4,125,5,89,0,124,5,124,0,106,7,
-    107,3,114,88,124,0,160,8,161,0,1,0,124,5,124,0,
-    95,7,116,9,131,0,114,110,124,0,106,10,125,6,124,4,
-    160,11,161,0,125,7,110,10,124,0,106,12,125,6,124,4,
-    125,7,124,7,124,6,118,0,114,214,116,13,124,0,106,2,
-    124,4,131,2,125,8,124,0,106,14,68,0,93,58,92,2,
-    125,9,125,10,100,5,124,9,23,0,125,11,116,13,124,8,
-    124,11,131,2,125,12,116,15,124,12,131,1,114,204,124,0,
-    160,16,124,10,124,1,124,12,124,8,103,1,124,2,161,5,
-    2,0,1,0,83,0,113,146,116,17,124,8,131,1,125,3,
-    124,0,106,14,68,0,93,86,92,2,125,9,125,10,116,13,
-    124,0,106,2,124,4,124,9,23,0,131,2,125,12,116,18,
-    106,19,100,6,124,12,100,3,100,7,141,3,1,0,124,7,
-    124,9,23,0,124,6,118,0,144,1,114,50,116,15,124,12,
-    131,1,144,1,114,50,124,0,160,16,124,10,124,1,124,12,
-    100,8,124,2,161,5,2,0,1,0,83,0,113,220,124,3,
-    144,1,114,94,116,18,160,19,100,9,124,8,161,2,1,0,
-    116,18,160,20,124,1,100,8,161,2,125,13,124,8,103,1,
-    124,13,95,21,124,13,83,0,100,8,83,0,119,0,41,10,
-    122,111,84,114,121,32,116,111,32,102,105,110,100,32,97,32,
-    115,112,101,99,32,102,111,114,32,116,104,101,32,115,112,101,
-    99,105,102,105,101,100,32,109,111,100,117,108,101,46,10,10,
-    32,32,32,32,32,32,32,32,82,101,116,117,114,110,115,32,
-    116,104,101,32,109,97,116,99,104,105,110,103,32,115,112,101,
-    99,44,32,111,114,32,78,111,110,101,32,105,102,32,110,111,
-    116,32,102,111,117,110,100,46,10,32,32,32,32,32,32,32,
-    32,70,114,86,0,0,0,114,45,0,0,0,114,116,0,0,
-    0,114,223,0,0,0,122,9,116,114,121,105,110,103,32,123,
-    125,41,1,90,9,118,101,114,98,111,115,105,116,121,78,122,
-    25,112,111,115,115,105,98,108,101,32,110,97,109,101,115,112,
-    97,99,101,32,102,111,114,32,123,125,41,22,114,55,0,0,
-    0,114,63,0,0,0,114,58,0,0,0,114,19,0,0,0,
-    114,70,0,0,0,114,21,1,0,0,114,64,0,0,0,114,
-    81,1,0,0,218,11,95,102,105,108,108,95,99,97,99,104,
-    101,114,22,0,0,0,114,84,1,0,0,114,117,0,0,0,
-    114,83,1,0,0,114,54,0,0,0,114,80,1,0,0,114,
-    68,0,0,0,114,75,1,0,0,114,71,0,0,0,114,146,
-    0,0,0,114,160,0,0,0,114,194,0,0,0,114,189,0,
-    0,0,41,14,114,130,0,0,0,114,150,0,0,0,114,213,
-    0,0,0,90,12,105,115,95,110,97,109,101,115,112,97,99,
-    101,90,11,116,97,105,108,95,109,111,100,117,108,101,114,180,
-    0,0,0,90,5,99,97,99,104,101,90,12,99,97,99,104,
-    101,95,109,111,100,117,108,101,90,9,98,97,115,101,95,112,
-    97,116,104,114,29,1,0,0,114,199,0,0,0,90,13,105,
-    110,105,116,95,102,105,108,101,110,97,109,101,90,9,102,117,
-    108,108,95,112,97,116,104,114,198,0,0,0,114,7,0,0,
-    0,114,7,0,0,0,114,8,0,0,0,114,214,0,0,0,
-    177,5,0,0,115,80,0,0,0,4,5,14,1,2,1,24,
-    1,14,1,6,1,10,1,8,1,6,1,6,2,6,1,10,
-    1,6,2,4,1,8,2,12,1,14,1,8,1,10,1,8,
-    1,24,1,2,255,8,5,14,2,16,1,16,1,14,1,10,
-    1,10,1,4,1,8,255,2,128,6,2,12,1,12,1,8,
-    1,4,1,4,1,2,219,255,128,122,20,70,105,108,101,70,
-    105,110,100,101,114,46,102,105,110,100,95,115,112,101,99,99,
-    1,0,0,0,0,0,0,0,0,0,0,0,9,0,0,0,
-    10,0,0,0,67,0,0,0,115,190,0,0,0,124,0,106,
-    0,125,1,122,22,116,1,160,2,124,1,112,22,116,1,160,
-    3,161,0,161,1,125,2,87,0,110,24,4,0,116,4,116,
-    5,116,6,102,3,121,188,1,0,1,0,1,0,103,0,125,
-    2,89,0,116,7,106,8,160,9,100,1,161,1,115,78,116,
-    10,124,2,131,1,124,0,95,11,110,74,116,10,131,0,125,
-    3,124,2,68,0,93,56,125,4,124,4,160,12,100,2,161,
-    1,92,3,125,5,125,6,125,7,124,6,114,130,100,3,160,
-    13,124,5,124,7,160,14,161,0,161,2,125,8,110,4,124,
-    5,125,8,124,3,160,15,124,8,161,1,1,0,113,88,124,
-    3,124,0,95,11,116,7,106,8,160,9,116,16,161,1,114,
-    184,100,4,100,5,132,0,124,2,68,0,131,1,124,0,95,
-    17,100,6,83,0,100,6,83,0,119,0,41,7,122,68,70,
-    105,108,108,32,116,104,101,32,99,97,99,104,101,32,111,102,
-    32,112,111,116,101,110,116,105,97,108,32,109,111,100,117,108,
-    101,115,32,97,110,100,32,112,97,99,107,97,103,101,115,32,
-    102,111,114,32,116,104,105,115,32,100,105,114,101,99,116,111,
-    114,121,46,114,15,0,0,0,114,86,0,0,0,114,76,0,
-    0,0,99,1,0,0,0,0,0,0,0,0,0,0,0,2,
-    0,0,0,4,0,0,0,83,0,0,0,115,20,0,0,0,
-    104,0,124,0,93,12,125,1,124,1,160,0,161,0,146,2,
-    113,4,83,0,114,7,0,0,0,41,1,114,117,0,0,0,
-    41,2,114,5,0,0,0,90,2,102,110,114,7,0,0,0,
-    114,7,0,0,0,114,8,0,0,0,114,13,0,0,0,254,
-    5,0,0,115,4,0,0,0,20,0,255,128,122,41,70,105,
-    108,101,70,105,110,100,101,114,46,95,102,105,108,108,95,99,
-    97,99,104,101,46,60,108,111,99,97,108,115,62,46,60,115,
-    101,116,99,111,109,112,62,78,41,18,114,58,0,0,0,114,
-    19,0,0,0,90,7,108,105,115,116,100,105,114,114,70,0,
-    0,0,114,69,1,0,0,218,15,80,101,114,109,105,115,115,
-    105,111,110,69,114,114,111,114,218,18,78,111,116,65,68,105,
-    114,101,99,116,111,114,121,69,114,114,111,114,114,16,0,0,
-    0,114,26,0,0,0,114,27,0,0,0,114,82,1,0,0,
-    114,83,1,0,0,114,112,0,0,0,114,77,0,0,0,114,
-    117,0,0,0,218,3,97,100,100,114,28,0,0,0,114,84,
-    1,0,0,41,9,114,130,0,0,0,114,58,0,0,0,90,
-    8,99,111,110,116,101,110,116,115,90,21,108,111,119,101,114,
-    95,115,117,102,102,105,120,95,99,111,110,116,101,110,116,115,
-    114,55,1,0,0,114,128,0,0,0,114,39,1,0,0,114,
-    29,1,0,0,90,8,110,101,119,95,110,97,109,101,114,7,
-    0,0,0,114,7,0,0,0,114,8,0,0,0,114,86,1,
-    0,0,225,5,0,0,115,40,0,0,0,6,2,2,1,22,
-    1,18,1,6,3,12,3,12,1,6,7,8,1,16,1,4,
-    1,18,1,4,2,12,1,6,1,12,1,20,1,4,255,2,
-    233,255,128,122,22,70,105,108,101,70,105,110,100,101,114,46,
-    95,102,105,108,108,95,99,97,99,104,101,99,1,0,0,0,
-    0,0,0,0,0,0,0,0,3,0,0,0,3,0,0,0,
-    7,0,0,0,115,18,0,0,0,135,0,135,1,102,2,100,
-    1,100,2,132,8,125,2,124,2,83,0,41,4,97,20,1,
-    0,0,65,32,99,108,97,115,115,32,109,101,116,104,111,100,
-    32,119,104,105,99,104,32,114,101,116,117,114,110,115,32,97,
-    32,99,108,111,115,117,114,101,32,116,111,32,117,115,101,32,
-    111,110,32,115,121,115,46,112,97,116,104,95,104,111,111,107,
-    10,32,32,32,32,32,32,32,32,119,104,105,99,104,32,119,
-    105,108,108,32,114,101,116,117,114,110,32,97,110,32,105,110,
-    115,116,97,110,99,101,32,117,115,105,110,103,32,116,104,101,
-    32,115,112,101,99,105,102,105,101,100,32,108,111,97,100,101,
-    114,115,32,97,110,100,32,116,104,101,32,112,97,116,104,10,
-    32,32,32,32,32,32,32,32,99,97,108,108,101,100,32,111,
-    110,32,116,104,101,32,99,108,111,115,117,114,101,46,10,10,
-    32,32,32,32,32,32,32,32,73,102,32,116,104,101,32,112,
-    97,116,104,32,99,97,108,108,101,100,32,111,110,32,116,104,
-    101,32,99,108,111,115,117,114,101,32,105,115,32,110,111,116,
-    32,97,32,100,105,114,101,99,116,111,114,121,44,32,73,109,
-    112,111,114,116,69,114,114,111,114,32,105,115,10,32,32,32,
-    32,32,32,32,32,114,97,105,115,101,100,46,10,10,32,32,
-    32,32,32,32,32,32,99,1,0,0,0,0,0,0,0,0,
-    0,0,0,1,0,0,0,4,0,0,0,19,0,0,0,115,
-    36,0,0,0,116,0,124,0,131,1,115,20,116,1,100,1,
-    124,0,100,2,141,2,130,1,136,0,124,0,103,1,136,1,
-    162,1,82,0,142,0,83,0,41,4,122,45,80,97,116,104,
-    32,104,111,111,107,32,102,111,114,32,105,109,112,111,114,116,
-    108,105,98,46,109,97,99,104,105,110,101,114,121,46,70,105,
-    108,101,70,105,110,100,101,114,46,122,30,111,110,108,121,32,
-    100,105,114,101,99,116,111,114,105,101,115,32,97,114,101,32,
-    115,117,112,112,111,114,116,101,100,114,62,0,0,0,78,41,
-    2,114,71,0,0,0,114,129,0,0,0,114,62,0,0,0,
-    169,2,114,209,0,0,0,114,85,1,0,0,114,7,0,0,
-    0,114,8,0,0,0,218,24,112,97,116,104,95,104,111,111,
-    107,95,102,111,114,95,70,105,108,101,70,105,110,100,101,114,
-    10,6,0,0,115,8,0,0,0,8,2,12,1,16,1,255,
-    128,122,54,70,105,108,101,70,105,110,100,101,114,46,112,97,
-    116,104,95,104,111,111,107,46,60,108,111,99,97,108,115,62,
-    46,112,97,116,104,95,104,111,111,107,95,102,111,114,95,70,
-    105,108,101,70,105,110,100,101,114,78,114,7,0,0,0,41,
-    3,114,209,0,0,0,114,85,1,0,0,114,91,1,0,0,
-    114,7,0,0,0,114,90,1,0,0,114,8,0,0,0,218,
-    9,112,97,116,104,95,104,111,111,107,0,6,0,0,115,6,
-    0,0,0,14,10,4,6,255,128,122,20,70,105,108,101,70,
-    105,110,100,101,114,46,112,97,116,104,95,104,111,111,107,99,
-    1,0,0,0,0,0,0,0,0,0,0,0,1,0,0,0,
-    3,0,0,0,67,0,0,0,114,52,1,0,0,41,2,78,
-    122,16,70,105,108,101,70,105,110,100,101,114,40,123,33,114,
-    125,41,41,2,114,77,0,0,0,114,58,0,0,0,114,8,
-    1,0,0,114,7,0,0,0,114,7,0,0,0,114,8,0,
-    0,0,114,53,1,0,0,18,6,0,0,114,46,1,0,0,
-    122,19,70,105,108,101,70,105,110,100,101,114,46,95,95,114,
-    101,112,114,95,95,41,1,78,41,15,114,137,0,0,0,114,
-    136,0,0,0,114,138,0,0,0,114,139,0,0,0,114,223,
-    0,0,0,114,62,1,0,0,114,154,0,0,0,114,217,0,
-    0,0,114,148,0,0,0,114,75,1,0,0,114,214,0,0,
-    0,114,86,1,0,0,114,221,0,0,0,114,92,1,0,0,
-    114,53,1,0,0,114,7,0,0,0,114,7,0,0,0,114,
-    7,0,0,0,114,8,0,0,0,114,78,1,0,0,131,5,
-    0,0,115,26,0,0,0,8,0,4,2,8,7,8,14,4,
-    4,8,2,8,12,10,5,8,48,2,31,10,1,12,17,255,
-    128,114,78,1,0,0,99,4,0,0,0,0,0,0,0,0,
-    0,0,0,6,0,0,0,8,0,0,0,67,0,0,0,115,
-    144,0,0,0,124,0,160,0,100,1,161,1,125,4,124,0,
-    160,0,100,2,161,1,125,5,124,4,115,66,124,5,114,36,
-    124,5,106,1,125,4,110,30,124,2,124,3,107,2,114,56,
-    116,2,124,1,124,2,131,2,125,4,110,10,116,3,124,1,
-    124,2,131,2,125,4,124,5,115,84,116,4,124,1,124,2,
-    124,4,100,3,141,3,125,5,122,38,124,5,124,0,100,2,
-    60,0,124,4,124,0,100,1,60,0,124,2,124,0,100,4,
-    60,0,124,3,124,0,100,5,60,0,87,0,100,0,83,0,
-    4,0,116,5,121,142,1,0,1,0,1,0,89,0,100,0,
-    83,0,119,0,41,6,78,218,10,95,95,108,111,97,100,101,
-    114,95,95,218,8,95,95,115,112,101,99,95,95,114,79,1,
-    0,0,90,8,95,95,102,105,108,101,95,95,90,10,95,95,
-    99,97,99,104,101,100,95,95,41,6,218,3,103,101,116,114,
-    151,0,0,0,114,26,1,0,0,114,20,1,0,0,114,201,
-    0,0,0,218,9,69,120,99,101,112,116,105,111,110,41,6,
-    90,2,110,115,114,128,0,0,0,90,8,112,97,116,104,110,
-    97,109,101,90,9,99,112,97,116,104,110,97,109,101,114,151,
-    0,0,0,114,198,0,0,0,114,7,0,0,0,114,7,0,
-    0,0,114,8,0,0,0,218,14,95,102,105,120,95,117,112,
-    95,109,111,100,117,108,101,24,6,0,0,115,38,0,0,0,
-    10,2,10,1,4,1,4,1,8,1,8,1,12,1,10,2,
-    4,1,14,1,2,1,8,1,8,1,8,1,14,1,12,1,
-    6,2,2,254,255,128,114,97,1,0,0,99,0,0,0,0,
-    0,0,0,0,0,0,0,0,3,0,0,0,3,0,0,0,
-    67,0,0,0,115,38,0,0,0,116,0,116,1,160,2,161,
-    0,102,2,125,0,116,3,116,4,102,2,125,1,116,5,116,
-    6,102,2,125,2,124,0,124,1,124,2,103,3,83,0,41,
-    2,122,95,82,101,116,117,114,110,115,32,97,32,108,105,115,
-    116,32,111,102,32,102,105,108,101,45,98,97,115,101,100,32,
-    109,111,100,117,108,101,32,108,111,97,100,101,114,115,46,10,
-    10,32,32,32,32,69,97,99,104,32,105,116,101,109,32,105,
-    115,32,97,32,116,117,112,108,101,32,40,108,111,97,100,101,
-    114,44,32,115,117,102,102,105,120,101,115,41,46,10,32,32,
-    32,32,78,41,7,114,17,1,0,0,114,174,0,0,0,218,
-    18,101,120,116,101,110,115,105,111,110,95,115,117,102,102,105,
-    120,101,115,114,20,1,0,0,114,113,0,0,0,114,26,1,
-    0,0,114,101,0,0,0,41,3,90,10,101,120,116,101,110,
-    115,105,111,110,115,90,6,115,111,117,114,99,101,90,8,98,
-    121,116,101,99,111,100,101,114,7,0,0,0,114,7,0,0,
-    0,114,8,0,0,0,114,195,0,0,0,47,6,0,0,115,
-    10,0,0,0,12,5,8,1,8,1,10,1,255,128,114,195,
-    0,0,0,99,1,0,0,0,0,0,0,0,0,0,0,0,
-    1,0,0,0,1,0,0,0,67,0,0,0,115,8,0,0,
-    0,124,0,97,0,100,0,83,0,114,121,0,0,0,41,1,
-    114,146,0,0,0,41,1,218,17,95,98,111,111,116,115,116,
-    114,97,112,95,109,111,100,117,108,101,114,7,0,0,0,114,
-    7,0,0,0,114,8,0,0,0,218,21,95,115,101,116,95,
-    98,111,111,116,115,116,114,97,112,95,109,111,100,117,108,101,
-    58,6,0,0,115,4,0,0,0,8,2,255,128,114,100,1,
-    0,0,99,1,0,0,0,0,0,0,0,0,0,0,0,2,
-    0,0,0,4,0,0,0,67,0,0,0,115,50,0,0,0,
-    116,0,124,0,131,1,1,0,116,1,131,0,125,1,116,2,
-    106,3,160,4,116,5,106,6,124,1,142,0,103,1,161,1,
-    1,0,116,2,106,7,160,8,116,9,161,1,1,0,100,1,
-    83,0,41,2,122,41,73,110,115,116,97,108,108,32,116,104,
-    101,32,112,97,116,104,45,98,97,115,101,100,32,105,109,112,
-    111,114,116,32,99,111,109,112,111,110,101,110,116,115,46,78,
-    41,10,114,100,1,0,0,114,195,0,0,0,114,16,0,0,
-    0,114,67,1,0,0,114,178,0,0,0,114,78,1,0,0,
-    114,92,1,0,0,218,9,109,101,116,97,95,112,97,116,104,
-    114,197,0,0,0,114,61,1,0,0,41,2,114,99,1,0,
-    0,90,17,115,117,112,112,111,114,116,101,100,95,108,111,97,
-    100,101,114,115,114,7,0,0,0,114,7,0,0,0,114,8,
-    0,0,0,218,8,95,105,110,115,116,97,108,108,63,6,0,
-    0,115,10,0,0,0,8,2,6,1,20,1,16,1,255,128,
-    114,102,1,0,0,41,1,114,75,0,0,0,41,1,78,41,
-    3,78,78,78,41,2,114,0,0,0,0,114,0,0,0,0,
-    41,1,84,41,1,78,41,1,78,41,83,114,139,0,0,0,
-    114,146,0,0,0,114,174,0,0,0,114,79,0,0,0,114,
-    16,0,0,0,114,88,0,0,0,114,171,0,0,0,114,26,
-    0,0,0,114,218,0,0,0,90,2,110,116,114,19,0,0,
-    0,114,203,0,0,0,90,5,112,111,115,105,120,114,48,0,
-    0,0,218,3,97,108,108,114,51,0,0,0,114,52,0,0,
-    0,114,73,0,0,0,114,29,0,0,0,90,37,95,67,65,
-    83,69,95,73,78,83,69,78,83,73,84,73,86,69,95,80,
-    76,65,84,70,79,82,77,83,95,66,89,84,69,83,95,75,
-    69,89,114,28,0,0,0,114,30,0,0,0,114,22,0,0,
-    0,114,37,0,0,0,114,43,0,0,0,114,46,0,0,0,
-    114,54,0,0,0,114,61,0,0,0,114,63,0,0,0,114,
-    67,0,0,0,114,68,0,0,0,114,71,0,0,0,114,74,
-    0,0,0,114,84,0,0,0,218,4,116,121,112,101,218,8,
-    95,95,99,111,100,101,95,95,114,173,0,0,0,114,35,0,
-    0,0,114,159,0,0,0,114,34,0,0,0,114,40,0,0,
-    0,114,251,0,0,0,114,104,0,0,0,114,100,0,0,0,
-    114,113,0,0,0,114,197,0,0,0,114,98,1,0,0,114,
-    219,0,0,0,114,101,0,0,0,90,23,68,69,66,85,71,
+    0,0,0,67,0,0,0,115,38,0,0,0,116,0,116,1,
+    160,2,161,0,102,2,125,0,116,3,116,4,102,2,125,1,
+    116,5,116,6,102,2,125,2,124,0,124,1,124,2,103,3,
+    83,0,41,2,122,95,82,101,116,117,114,110,115,32,97,32,
+    108,105,115,116,32,111,102,32,102,105,108,101,45,98,97,115,
+    101,100,32,109,111,100,117,108,101,32,108,111,97,100,101,114,
+    115,46,10,10,32,32,32,32,69,97,99,104,32,105,116,101,
+    109,32,105,115,32,97,32,116,117,112,108,101,32,40,108,111,
+    97,100,101,114,44,32,115,117,102,102,105,120,101,115,41,46,
+    10,32,32,32,32,78,41,7,114,26,1,0,0,114,174,0,
+    0,0,218,18,101,120,116,101,110,115,105,111,110,95,115,117,
+    102,102,105,120,101,115,114,29,1,0,0,114,113,0,0,0,
+    114,34,1,0,0,114,101,0,0,0,41,3,90,10,101,120,
+    116,101,110,115,105,111,110,115,90,6,115,111,117,114,99,101,
+    90,8,98,121,116,101,99,111,100,101,114,7,0,0,0,114,
+    7,0,0,0,114,8,0,0,0,114,204,0,0,0,89,6,
+    0,0,115,10,0,0,0,12,5,8,1,8,1,10,1,255,
+    128,114,204,0,0,0,99,1,0,0,0,0,0,0,0,0,
+    0,0,0,1,0,0,0,1,0,0,0,67,0,0,0,115,
+    8,0,0,0,124,0,97,0,100,0,83,0,114,121,0,0,
+    0,41,1,114,146,0,0,0,41,1,218,17,95,98,111,111,
+    116,115,116,114,97,112,95,109,111,100,117,108,101,114,7,0,
+    0,0,114,7,0,0,0,114,8,0,0,0,218,21,95,115,
+    101,116,95,98,111,111,116,115,116,114,97,112,95,109,111,100,
+    117,108,101,100,6,0,0,115,4,0,0,0,8,2,255,128,
+    114,108,1,0,0,99,1,0,0,0,0,0,0,0,0,0,
+    0,0,2,0,0,0,4,0,0,0,67,0,0,0,115,50,
+    0,0,0,116,0,124,0,131,1,1,0,116,1,131,0,125,
+    1,116,2,106,3,160,4,116,5,106,6,124,1,142,0,103,
+    1,161,1,1,0,116,2,106,7,160,8,116,9,161,1,1,
+    0,100,1,83,0,41,2,122,41,73,110,115,116,97,108,108,
+    32,116,104,101,32,112,97,116,104,45,98,97,115,101,100,32,
+    105,109,112,111,114,116,32,99,111,109,112,111,110,101,110,116,
+    115,46,78,41,10,114,108,1,0,0,114,204,0,0,0,114,
+    16,0,0,0,114,76,1,0,0,114,187,0,0,0,114,87,
+    1,0,0,114,101,1,0,0,218,9,109,101,116,97,95,112,
+    97,116,104,114,206,0,0,0,114,69,1,0,0,41,2,114,
+    107,1,0,0,90,17,115,117,112,112,111,114,116,101,100,95,
+    108,111,97,100,101,114,115,114,7,0,0,0,114,7,0,0,
+    0,114,8,0,0,0,218,8,95,105,110,115,116,97,108,108,
+    105,6,0,0,115,10,0,0,0,8,2,6,1,20,1,16,
+    1,255,128,114,110,1,0,0,41,1,114,75,0,0,0,41,
+    1,78,41,3,78,78,78,41,2,114,0,0,0,0,114,0,
+    0,0,0,41,1,84,41,1,78,41,1,78,41,85,114,139,
+    0,0,0,114,146,0,0,0,114,174,0,0,0,114,79,0,
+    0,0,114,16,0,0,0,114,88,0,0,0,114,171,0,0,
+    0,114,26,0,0,0,114,227,0,0,0,90,2,110,116,114,
+    19,0,0,0,114,212,0,0,0,90,5,112,111,115,105,120,
+    114,48,0,0,0,218,3,97,108,108,114,51,0,0,0,114,
+    52,0,0,0,114,73,0,0,0,114,29,0,0,0,90,37,
+    95,67,65,83,69,95,73,78,83,69,78,83,73,84,73,86,
+    69,95,80,76,65,84,70,79,82,77,83,95,66,89,84,69,
+    83,95,75,69,89,114,28,0,0,0,114,30,0,0,0,114,
+    22,0,0,0,114,37,0,0,0,114,43,0,0,0,114,46,
+    0,0,0,114,54,0,0,0,114,61,0,0,0,114,63,0,
+    0,0,114,67,0,0,0,114,68,0,0,0,114,71,0,0,
+    0,114,74,0,0,0,114,84,0,0,0,218,4,116,121,112,
+    101,218,8,95,95,99,111,100,101,95,95,114,173,0,0,0,
+    114,35,0,0,0,114,159,0,0,0,114,34,0,0,0,114,
+    40,0,0,0,114,5,1,0,0,114,104,0,0,0,114,100,
+    0,0,0,114,113,0,0,0,114,206,0,0,0,114,106,1,
+    0,0,114,228,0,0,0,114,101,0,0,0,90,23,68,69,
+    66,85,71,95,66,89,84,69,67,79,68,69,95,83,85,70,
+    70,73,88,69,83,90,27,79,80,84,73,77,73,90,69,68,
     95,66,89,84,69,67,79,68,69,95,83,85,70,70,73,88,
-    69,83,90,27,79,80,84,73,77,73,90,69,68,95,66,89,
-    84,69,67,79,68,69,95,83,85,70,70,73,88,69,83,114,
-    109,0,0,0,114,114,0,0,0,114,120,0,0,0,114,124,
-    0,0,0,114,126,0,0,0,114,147,0,0,0,114,154,0,
-    0,0,114,163,0,0,0,114,167,0,0,0,114,169,0,0,
-    0,114,176,0,0,0,114,181,0,0,0,114,182,0,0,0,
-    114,187,0,0,0,218,6,111,98,106,101,99,116,114,196,0,
-    0,0,114,201,0,0,0,114,202,0,0,0,114,222,0,0,
-    0,114,236,0,0,0,114,254,0,0,0,114,20,1,0,0,
-    114,26,1,0,0,114,17,1,0,0,114,32,1,0,0,114,
-    58,1,0,0,114,61,1,0,0,114,78,1,0,0,114,97,
-    1,0,0,114,195,0,0,0,114,100,1,0,0,114,102,1,
-    0,0,114,7,0,0,0,114,7,0,0,0,114,7,0,0,
-    0,114,8,0,0,0,218,8,60,109,111,100,117,108,101,62,
-    1,0,0,0,115,172,0,0,0,4,0,4,22,8,3,8,
-    1,8,1,8,1,8,1,10,3,4,1,8,1,10,1,8,
-    2,4,3,10,1,6,2,22,2,8,1,10,1,14,1,4,
-    4,4,1,2,1,2,1,4,255,8,4,6,16,8,3,8,
-    5,8,5,8,6,8,6,8,12,8,10,8,9,8,5,8,
-    7,10,9,10,22,0,127,16,24,12,1,4,2,4,1,6,
-    2,6,1,10,1,8,2,6,2,8,2,16,2,8,71,8,
-    40,8,19,8,12,8,12,8,31,8,17,8,33,8,28,10,
-    24,10,13,10,10,8,11,6,14,4,3,2,1,12,255,14,
-    68,14,64,16,30,0,127,14,17,18,50,18,45,18,25,14,
-    53,14,63,14,43,0,127,14,20,0,127,10,22,8,23,8,
-    11,12,5,255,128,
+    69,83,114,109,0,0,0,114,114,0,0,0,114,120,0,0,
+    0,114,124,0,0,0,114,126,0,0,0,114,147,0,0,0,
+    114,154,0,0,0,114,163,0,0,0,114,167,0,0,0,114,
+    169,0,0,0,114,176,0,0,0,114,183,0,0,0,114,185,
+    0,0,0,114,190,0,0,0,114,191,0,0,0,114,196,0,
+    0,0,218,6,111,98,106,101,99,116,114,205,0,0,0,114,
+    210,0,0,0,114,211,0,0,0,114,231,0,0,0,114,245,
+    0,0,0,114,7,1,0,0,114,29,1,0,0,114,34,1,
+    0,0,114,26,1,0,0,114,40,1,0,0,114,66,1,0,
+    0,114,69,1,0,0,114,87,1,0,0,114,105,1,0,0,
+    114,204,0,0,0,114,108,1,0,0,114,110,1,0,0,114,
+    7,0,0,0,114,7,0,0,0,114,7,0,0,0,114,8,
+    0,0,0,218,8,60,109,111,100,117,108,101,62,1,0,0,
+    0,115,176,0,0,0,4,0,4,22,8,3,8,1,8,1,
+    8,1,8,1,10,3,4,1,8,1,10,1,8,2,4,3,
+    10,1,6,2,22,2,8,1,10,1,14,1,4,4,4,1,
+    2,1,2,1,4,255,8,4,6,16,8,3,8,5,8,5,
+    8,6,8,6,8,12,8,10,8,9,8,5,8,7,10,9,
+    10,22,0,127,16,24,12,1,4,2,4,1,6,2,6,1,
+    10,1,8,2,6,2,8,2,16,2,8,71,8,40,8,19,
+    8,12,8,12,8,31,8,17,8,33,8,28,10,24,4,15,
+    8,3,10,30,10,10,8,11,6,14,4,3,2,1,12,255,
+    14,68,14,64,16,30,0,127,14,23,18,50,18,45,18,25,
+    14,53,14,63,14,43,0,127,14,21,0,127,10,22,8,23,
+    8,11,12,5,255,128,
 };
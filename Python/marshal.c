@@ -13,6 +13,7 @@
 #include "code.h"
 #include "marshal.h"
 #include "pycore_hashtable.h"
+#include "pycore_unicodeobject.h" // _PyUnicode_InternFromUCS1()
 
 /*[clinic input]
 module marshal
@@ -1105,11 +1106,13 @@ r_object(RFILE *p)
             ptr = r_string(n, p);
             if (ptr == NULL)
                 break;
-            v = PyUnicode_FromKindAndData(PyUnicode_1BYTE_KIND, ptr, n);
+            /* Names are mostly interned already by other modules. */
+            if (is_interned)
+                v = _PyUnicode_InternFromUCS1((const Py_UCS1 *)ptr, n);
+            else
+                v = PyUnicode_FromKindAndData(PyUnicode_1BYTE_KIND, ptr, n);
             if (v == NULL)
                 break;
-            if (is_interned)
-                PyUnicode_InternInPlace(&v);
             retval = v;
             R_REF(retval);
             break;
@@ -289,6 +289,7 @@ _PyPreConfig_InitCompatConfig(PyPreConfig *config)
     config->coerce_c_locale_warn = 0;
 
     config->dev_mode = -1;
+    config->use_hugepages = -1;
 #ifdef EXPERIMENTAL_ISOLATED_SUBINTERPRETERS
     /* bpo-40512: pymalloc is not compatible with subinterpreters,
        force usage of libc malloc() which is thread-safe. */
@@ -338,6 +339,7 @@ PyPreConfig_InitIsolatedConfig(PyPreConfig *config)
     config->use_environment = 0;
     config->utf8_mode = 0;
     config->dev_mode = 0;
+    config->use_hugepages = 0;
 #ifdef MS_WINDOWS
     config->legacy_windows_fs_encoding = 0;
 #endif
@@ -389,6 +391,7 @@ preconfig_copy(PyPreConfig *config, const PyPreConfig *config2)
     COPY_ATTR(coerce_c_locale_warn);
     COPY_ATTR(utf8_mode);
     COPY_ATTR(allocator);
+    COPY_ATTR(use_hugepages);
 #ifdef MS_WINDOWS
     COPY_ATTR(legacy_windows_fs_encoding);
 #endif
@@ -433,6 +436,7 @@ _PyPreConfig_AsDict(const PyPreConfig *config)
 #endif
     SET_ITEM_INT(dev_mode);
     SET_ITEM_INT(allocator);
+    SET_ITEM_INT(use_hugepages);
     return dict;
 
 fail:
@@ -766,6 +770,13 @@ preconfig_read(PyPreConfig *config, _PyPreCmdline *cmdline)
         return status;
     }
 
+    /* use_hugepages */
+    if (config->use_hugepages < 0) {
+        config->use_hugepages =
+            (_Py_get_xoption(&cmdline->xoptions, L"hugepages") != NULL
+             || _Py_GetEnv(config->use_environment, "PYTHONHUGEPAGES") != NULL);
+    }
+
     assert(config->coerce_c_locale >= 0);
     assert(config->coerce_c_locale_warn >= 0);
 #ifdef MS_WINDOWS
@@ -775,6 +786,7 @@ preconfig_read(PyPreConfig *config, _PyPreCmdline *cmdline)
     assert(config->isolated >= 0);
     assert(config->use_environment >= 0);
     assert(config->dev_mode >= 0);
+    assert(config->use_hugepages >= 0);
 
     return _PyStatus_OK();
 }
@@ -957,6 +969,10 @@ _PyPreConfig_Write(const PyPreConfig *src_config)
         }
     }
 
+    if (config.use_hugepages > 0) {
+        _PyObject_EnableHugeArenas();
+    }
+
     preconfig_set_global_vars(&config);
 
     if (config.configure_locale) {
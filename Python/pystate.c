@@ -657,6 +657,10 @@ new_threadstate(PyInterpreterState *interp, int init)
     tstate->context = NULL;
     tstate->context_ver = 1;
 
+    tstate->obmalloc_cache = NULL;
+
+    memset(&tstate->gil, 0, sizeof(tstate->gil));
+
     if (init) {
         _PyThreadState_Init(tstate);
     }
@@ -870,6 +874,8 @@ PyThreadState_Clear(PyThreadState *tstate)
     if (tstate->on_delete != NULL) {
         tstate->on_delete(tstate->on_delete_data);
     }
+
+    _PyObject_ClearThreadCache(tstate);
 }
 
 
@@ -1239,6 +1245,60 @@ _PyThread_CurrentFrames(void)
     return result;
 }
 
+static PyObject *
+gil_stats_as_dict(PyThreadState *t)
+{
+    return Py_BuildValue("{sksksksdsdsd}",
+        "acquisitions", t->gil.acquisitions,
+        "contended", t->gil.contended,
+        "forced_switches", t->gil.forced_switches,
+        "wait_time", _PyTime_AsSecondsDouble(t->gil.wait_time),
+        "max_wait_time", _PyTime_AsSecondsDouble(t->gil.max_wait_time),
+        "hold_time", _PyTime_AsSecondsDouble(t->gil.hold_time));
+}
+
+PyObject *
+_PyThread_GILStats(void)
+{
+    PyThreadState *tstate = _PyThreadState_GET();
+    PyObject *result = PyDict_New();
+    if (result == NULL) {
+        return NULL;
+    }
+
+    _PyRuntimeState *runtime = tstate->interp->runtime;
+    HEAD_LOCK(runtime);
+    PyInterpreterState *i;
+    for (i = runtime->interpreters.head; i != NULL; i = i->next) {
+        PyThreadState *t;
+        for (t = i->tstate_head; t != NULL; t = t->next) {
+            PyObject *id = PyLong_FromUnsignedLong(t->thread_id);
+            if (id == NULL) {
+                goto fail;
+            }
+            PyObject *stats = gil_stats_as_dict(t);
+            if (stats == NULL) {
+                Py_DECREF(id);
+                goto fail;
+            }
+            int stat = PyDict_SetItem(result, id, stats);
+            Py_DECREF(id);
+            Py_DECREF(stats);
+            if (stat < 0) {
+                goto fail;
+            }
+        }
+    }
+    goto done;
+
+fail:
+    Py_CLEAR(result);
+
+done:
+    HEAD_UNLOCK(runtime);
+    return result;
+}
+
 PyObject *
 _PyThread_CurrentExceptions(void)
 {
@@ -16,6 +16,7 @@ Data members:
 
 #include "Python.h"
 #include "pycore_ceval.h"         // _Py_RecursionLimitLowerWaterMark()
+#include "pycore_code.h"          // _PyOpcache_GetStats()
 #include "pycore_initconfig.h"    // _PyStatus_EXCEPTION()
 #include "pycore_object.h"        // _PyObject_IS_GC()
 #include "pycore_pathconfig.h"    // _PyPathConfig_ComputeSysPath0()
@@ -1161,6 +1162,54 @@ sys_getswitchinterval_impl(PyObject *module)
     return 1e-6 * _PyEval_GetSwitchInterval();
 }
 
+/*[clinic input]
+sys.setswitchpolicy
+
+    policy: str
+    /
+
+Set the policy deciding when a thread waiting for the GIL gets it.
+
+With "interval" (the default), a waiting thread asks the running thread
+to release the GIL after the switch interval.  With "io_priority", a
+thread returning from a blocking call asks for it immediately.
+[clinic start generated code]*/
+
+static PyObject *
+sys_setswitchpolicy_impl(PyObject *module, const char *policy)
+/*[clinic end generated code: output=447246d5440070c1 input=951f91a5c84d57d5]*/
+{
+    if (strcmp(policy, "interval") == 0) {
+        _PyEval_SetSwitchPolicy(_PyEval_SWITCH_INTERVAL);
+    }
+    else if (strcmp(policy, "io_priority") == 0) {
+        _PyEval_SetSwitchPolicy(_PyEval_SWITCH_IO_PRIORITY);
+    }
+    else {
+        PyErr_Format(PyExc_ValueError,
+                     "unknown switch policy: %s", policy);
+        return NULL;
+    }
+    Py_RETURN_NONE;
+}
+
+
+/*[clinic input]
+sys.getswitchpolicy
+
+Return the current thread switch policy; see sys.setswitchpolicy().
+[clinic start generated code]*/
+
+static PyObject *
+sys_getswitchpolicy_impl(PyObject *module)
+/*[clinic end generated code: output=48f2b03374afab5a input=564a2c10b672c65a]*/
+{
+    if (_PyEval_GetSwitchPolicy() == _PyEval_SWITCH_IO_PRIORITY) {
+        return PyUnicode_FromString("io_priority");
+    }
+    return PyUnicode_FromString("interval");
+}
+
 /*[clinic input]
 sys.setrecursionlimit
 
@@ -1836,6 +1885,26 @@ sys__current_frames_impl(PyObject *module)
     return _PyThread_CurrentFrames();
 }
 
+/*[clinic input]
+sys._getgilstats
+
+Return a dict mapping each thread's identifier to its GIL statistics.
+
+The statistics count the acquisitions of the GIL, the ones which had to
+wait for another thread to release it, the releases requested by other
+threads, and the total and maximum time spent waiting for the GIL and
+the total time spent holding it, in seconds.
+
+This function should be used for specialized purposes only.
+[clinic start generated code]*/
+
+static PyObject *
+sys__getgilstats_impl(PyObject *module)
+/*[clinic end generated code: output=6cfe4e3b51e0e160 input=884c2e9e7e37371a]*/
+{
+    return _PyThread_GILStats();
+}
+
 /*[clinic input]
 sys._current_exceptions
 
@@ -1900,6 +1969,35 @@ sys__debugmallocstats_impl(PyObject *module)
     Py_RETURN_NONE;
 }
 
+/*[clinic input]
+sys._getopcachestats
+
+    code: object = None
+    /
+
+Return statistics about the per opcode cache as a dict.
+
+Without argument, report the hits, misses, optimizations,
+deoptimizations and memory use of each kind of cache since startup.
+If a code object is given, report the state of its own cache entries.
+[clinic start generated code]*/
+
+static PyObject *
+sys__getopcachestats_impl(PyObject *module, PyObject *code)
+/*[clinic end generated code: output=e7c1e358d43a816c input=836a797a72d5fe74]*/
+{
+    if (code == Py_None) {
+        return _PyOpcache_GetStats();
+    }
+    if (!PyCode_Check(code)) {
+        PyErr_Format(PyExc_TypeError,
+                     "_getopcachestats() argument must be a code object, "
+                     "not %.200s", Py_TYPE(code)->tp_name);
+        return NULL;
+    }
+    return _PyCode_GetOpcacheStats((PyCodeObject *)code);
+}
+
 #ifdef Py_TRACE_REFS
 /* Defined in objects.c because it uses static globals in that file */
 extern PyObject *_Py_GetObjects(PyObject *, PyObject *);
@@ -1968,6 +2066,7 @@ static PyMethodDef sys_methods[] = {
     SYS__CLEAR_TYPE_CACHE_METHODDEF
     SYS__CURRENT_FRAMES_METHODDEF
     SYS__CURRENT_EXCEPTIONS_METHODDEF
+    SYS__GETGILSTATS_METHODDEF
     SYS_DISPLAYHOOK_METHODDEF
     SYS_EXC_INFO_METHODDEF
     SYS_EXCEPTHOOK_METHODDEF
@@ -1996,6 +2095,8 @@ static PyMethodDef sys_methods[] = {
     SYS_MDEBUG_METHODDEF
     SYS_SETSWITCHINTERVAL_METHODDEF
     SYS_GETSWITCHINTERVAL_METHODDEF
+    SYS_SETSWITCHPOLICY_METHODDEF
+    SYS_GETSWITCHPOLICY_METHODDEF
     SYS_SETDLOPENFLAGS_METHODDEF
     {"setprofile",      sys_setprofile, METH_O, setprofile_doc},
     SYS_GETPROFILE_METHODDEF
@@ -2004,6 +2105,7 @@ static PyMethodDef sys_methods[] = {
     SYS_GETTRACE_METHODDEF
     SYS_CALL_TRACING_METHODDEF
     SYS__DEBUGMALLOCSTATS_METHODDEF
+    SYS__GETOPCACHESTATS_METHODDEF
     SYS_SET_COROUTINE_ORIGIN_TRACKING_DEPTH_METHODDEF
     SYS_GET_COROUTINE_ORIGIN_TRACKING_DEPTH_METHODDEF
     {"set_asyncgen_hooks", (PyCFunction)(void(*)(void))sys_set_asyncgen_hooks,
@@ -261,6 +261,18 @@ def run_throughput_tests(max_threads):
 
 LAT_END = "END"
 
+def _gil_stats():
+    # GIL statistics of the current thread (CPython 3.10 and newer)
+    try:
+        return sys._getgilstats()[threading.get_ident()]
+    except (AttributeError, KeyError):
+        return None
+
+def _gil_stats_delta(before, after):
+    if before is None or after is None:
+        return None
+    return dict((k, after[k] - before[k]) for k in after)
+
 def _sendto(sock, s, addr):
     sock.sendto(s.encode('ascii'), addr)
 
@@ -347,12 +359,14 @@ def run():
         start_time = _time()
         started = True
         start_cond.notify(nthreads)
+    gil_before = _gil_stats()
 
     while LAT_END not in s:
         s = _recv(sock, 4096)
         t = _time()
         chunks.append((t, s))
 
+    gil_stats = _gil_stats_delta(gil_before, _gil_stats())
     # Tell the background threads to stop.
     end_event.append(None)
     for t in threads:
@@ -370,7 +384,7 @@ def run():
                 assert isinstance(send_time, float)
                 results.append((send_time, recv_time))
 
-    return results
+    return results, gil_stats
 
 def run_latency_tests(max_threads):
     for task in latency_tasks:
@@ -379,15 +393,21 @@ def run_latency_tests(max_threads):
         func, args = task()
         nthreads = 0
         while nthreads <= max_threads:
-            results = run_latency_test(func, args, nthreads)
+            results, gil_stats = run_latency_test(func, args, nthreads)
             n = len(results)
             # We print out milliseconds
             lats = [1000 * (t2 - t1) for (t1, t2) in results]
             #print(list(map(int, lats)))
             avg = sum(lats) / n
             dev = (sum((x - avg) ** 2 for x in lats) / n) ** 0.5
-            print("CPU threads=%d: %d ms. (std dev: %d ms.)" % (nthreads, avg, dev), end="")
+            print("CPU threads=%d: %d ms. (std dev: %d ms., max: %d ms.)"
+                  % (nthreads, avg, dev, max(lats)), end="")
             print()
+            if gil_stats is not None and gil_stats['contended']:
+                # Time spent by the receiving thread waiting for the GIL
+                print("    GIL waits: %d, avg: %.2f ms."
+                      % (gil_stats['contended'],
+                         1000 * gil_stats['wait_time'] / gil_stats['contended']))
             #print("    [... from %d samples]" % n)
             nthreads += 1
         print()
@@ -540,6 +560,11 @@ def main():
                       action="store", type="float", dest="switch_interval", default=None,
                       help="sys.setswitchinterval() value "
                            "(Python 3.2 and newer)")
+    parser.add_option("-P", "--switch-policy",
+                      action="store", type="choice", dest="switch_policy",
+                      choices=["interval", "io_priority"], default=None,
+                      help="sys.setswitchpolicy() value "
+                           "(Python 3.10 and newer)")
     parser.add_option("-n", "--num-threads",
                       action="store", type="int", dest="nthreads", default=4,
                       help="max number of threads in tests")
@@ -572,6 +597,8 @@ def main():
         sys.setcheckinterval(options.check_interval)
     if options.switch_interval:
         sys.setswitchinterval(options.switch_interval)
+    if options.switch_policy:
+        sys.setswitchpolicy(options.switch_policy)
 
     print("== %s %s (%s) ==" % (
         platform.python_implementation(),
@@ -9,19 +9,23 @@
 import imp
 import importlib
 import importlib.machinery
+import importlib.util
 import json
 import os
 import py_compile
 import sys
 import tabnanny
+import tempfile
 import timeit
 
 
-def bench(name, cleanup=lambda: None, *, seconds=1, repeat=3):
+def bench(name, cleanup=lambda: None, *, seconds=1, repeat=3, snapshot=None):
     """Bench the given statement as many times as necessary until total
     executions take one second."""
     stmt = "__import__({!r})".format(name)
-    timer = timeit.Timer(stmt)
+    if snapshot is not None:
+        stmt = "importlib.util.read_snapshot({!r}); {}".format(snapshot, stmt)
+    timer = timeit.Timer(stmt, "import importlib.util")
     for x in range(repeat):
         total_time = 0
         count = 0
@@ -162,6 +166,24 @@ def using_bytecode_benchmark(seconds, repeat):
 decimal_using_bytecode = _using_bytecode(decimal)
 
 
+def _using_snapshot(module):
+    name = module.__name__
+    def using_snapshot_benchmark(seconds, repeat):
+        """Source w/ snapshot: {}"""
+        with tempfile.TemporaryDirectory() as tmpdir:
+            snapshot = os.path.join(tmpdir, 'snapshot')
+            importlib.util.write_snapshot(snapshot, [name])
+            yield from bench(name, lambda: sys.modules.pop(name),
+                             repeat=repeat, seconds=seconds, snapshot=snapshot)
+
+    using_snapshot_benchmark.__doc__ = (
+                                using_snapshot_benchmark.__doc__.format(name))
+    return using_snapshot_benchmark
+
+tabnanny_using_snapshot = _using_snapshot(tabnanny)
+decimal_using_snapshot = _using_snapshot(decimal)
+
+
 def main(import_, options):
     if options.source_file:
         with options.source_file:
@@ -176,6 +198,7 @@ def main(import_, options):
                   tabnanny_wo_bytecode, tabnanny_using_bytecode,
                   decimal_writing_bytecode,
                   decimal_wo_bytecode, decimal_using_bytecode,
+                  tabnanny_using_snapshot, decimal_using_snapshot,
                 )
     if options.benchmark:
         for b in benchmarks:
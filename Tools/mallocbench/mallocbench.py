@@ -0,0 +1,111 @@
+"""Benchmark pymalloc with and without huge page arenas (-X hugepages).
+
+Each workload runs in a fresh interpreter, so that all arenas are allocated
+with the configuration under test.
+"""
+import argparse
+import subprocess
+import sys
+import tempfile
+
+
+WORKLOADS = {
+    'build': """
+data = [(i, str(i), [i]) for i in range(N)]
+""",
+    'traverse': """
+import random
+data = [(i, str(i), [i]) for i in range(N)]
+order = list(range(N))
+random.Random(0).shuffle(order)
+total = 0
+for _ in range(3):
+    for i in order:
+        total += data[i][2][0]
+""",
+    'churn': """
+import random
+rand = random.Random(0)
+data = [{'key': i} for i in range(N)]
+for _ in range(N * 2):
+    i = rand.randrange(N)
+    data[i] = {'key': i, 'value': str(i)}
+""",
+}
+
+TIMER = """
+import time
+N = {size}
+t0 = time.perf_counter()
+exec({code!r})
+print(time.perf_counter() - t0)
+"""
+
+PERF_EVENTS = 'dTLB-load-misses,dTLB-store-misses'
+
+
+def run(python, hugepages, workload, size, perf):
+    args = [python]
+    if hugepages:
+        args += ['-X', 'hugepages']
+    args += ['-c', TIMER.format(size=size, code=WORKLOADS[workload])]
+    if not perf:
+        out = subprocess.run(args, check=True, capture_output=True, text=True)
+        return float(out.stdout), None
+
+    with tempfile.NamedTemporaryFile('r') as stats:
+        args = ['perf', 'stat', '-x,', '-e', PERF_EVENTS,
+                '-o', stats.name, '--'] + args
+        out = subprocess.run(args, check=True, capture_output=True, text=True)
+        misses = 0
+        for line in stats:
+            fields = line.split(',')
+            if len(fields) > 2 and fields[2].startswith('dTLB'):
+                try:
+                    misses += int(fields[0])
+                except ValueError:
+                    # "<not supported>" or "<not counted>"
+                    return float(out.stdout), None
+    return float(out.stdout), misses
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('-p', '--python', default=sys.executable,
+                        help='interpreter to benchmark (default: %(default)s)')
+    parser.add_argument('-n', '--size', type=int, default=2_000_000,
+                        help='number of objects per workload '
+                             '(default: %(default)s)')
+    parser.add_argument('-r', '--repeat', type=int, default=3,
+                        help='number of runs per configuration '
+                             '(default: %(default)s)')
+    parser.add_argument('--perf', action='store_true',
+                        help='count data TLB misses with "perf stat"')
+    parser.add_argument('workloads', nargs='*', metavar='workload',
+                        help='workloads to run: %s (default: all)'
+                             % ', '.join(WORKLOADS))
+    options = parser.parse_args()
+
+    workloads = options.workloads or list(WORKLOADS)
+    for workload in workloads:
+        if workload not in WORKLOADS:
+            parser.error(f'unknown workload: {workload}')
+    print(f"{'workload':10} {'arenas':8} {'best time':>10} {'dTLB misses':>14}")
+    for workload in workloads:
+        results = {}
+        for hugepages in (False, True):
+            runs = [run(options.python, hugepages, workload, options.size,
+                        options.perf)
+                    for _ in range(options.repeat)]
+            best = min(runs)
+            results[hugepages] = best
+            misses = '-' if best[1] is None else f'{best[1]:,}'
+            print(f"{workload:10} {'huge' if hugepages else 'regular':8} "
+                  f"{best[0]:9.3f}s {misses:>14}")
+            sys.stdout.flush()
+        speedup = results[False][0] / results[True][0]
+        print(f"{workload:10} huge pages are {speedup:.2f}x as fast")
+
+
+if __name__ == '__main__':
+    main()
@@ -218,6 +218,24 @@ def find_test_slow_match_100_characters_bis(STR):
     for x in _RANGE_100:
         s1_find(s2)
 
+@bench('("A"*10000).find("A"*500+"B"+"A"*500)',
+       "no match, periodic 1001 characters", 10)
+def find_test_no_match_periodic_1001_characters(STR):
+    s1 = STR("A" * 10000)
+    s2 = STR("A" * 500 + "B" + "A" * 500)
+    s1_find = s1.find
+    for x in _RANGE_10:
+        s1_find(s2)
+
+@bench('("AB"*5000).find("AB"*150+"BA")',
+       "no match, periodic 302 characters", 10)
+def find_test_no_match_periodic_302_characters(STR):
+    s1 = STR("AB" * 5000)
+    s2 = STR("AB" * 150 + "BA")
+    s1_find = s1.find
+    for x in _RANGE_10:
+        s1_find(s2)
+
 
 #### Same tests for 'rfind'
 
@@ -1081,6 +1099,41 @@ def count_aact(STR):
     for x in _RANGE_10:
         seq_count(needle)
 
+@bench('dna.find(dna[-300:])', "late match, 300 characters in DNA example", 10)
+def find_dna_tail(STR):
+    seq = _get_dna(STR)
+    seq_find = seq.find
+    needle = seq[-300:]
+    for x in _RANGE_10:
+        seq_find(needle)
+
+@bench('dna.count("GAT")', "count GAT substrings in DNA example", 10)
+def count_gat(STR):
+    seq = _get_dna(STR)
+    seq_count = seq.count
+    needle = STR("GAT")
+    for x in _RANGE_10:
+        seq_count(needle)
+
+@bench('...text.with.2000.lines.count("ERROR")',
+       "count a missing word in text", 10)
+def count_word_in_lines(STR):
+    s = _get_2000_lines(STR)
+    s_count = s.count
+    needle = STR("ERROR")
+    for x in _RANGE_10:
+        s_count(needle)
+
+@bench('...text.with.2000.lines.replace("DEBUG", "debug")',
+       "replace a missing word in text", 10)
+def replace_word_in_lines(STR):
+    s = _get_2000_lines(STR)
+    s_replace = s.replace
+    from_str = STR("DEBUG")
+    to_str = STR("debug")
+    for x in _RANGE_10:
+        s_replace(from_str, to_str)
+
 ##### startswith and endswith
 
 @bench('"Andrew".startswith("A")', 'startswith single character', 1000)
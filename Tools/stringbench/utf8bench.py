@@ -0,0 +1,67 @@
+"""Microbenchmarks of UTF-8 decoding and encoding over text corpora."""
+
+import argparse
+import random
+import sys
+import timeit
+
+
+# Each corpus is built from a repeated sample or from random choices in an
+# alphabet, so that the proportion of 1-, 2-, 3- and 4-byte sequences is
+# close to real text in that script.
+def _sample(text):
+    return lambda size: (text * (size // len(text.encode('utf-8')) + 1))
+
+def _random(alphabet):
+    def build(size):
+        rng = random.Random(size)
+        width = len(alphabet.encode('utf-8')) / len(alphabet)
+        return ''.join(rng.choice(alphabet) for _ in range(int(size / width)))
+    return build
+
+CORPORA = [
+    ('ascii', _sample(
+        "The quick brown fox jumps over the lazy dog. 0123456789\n")),
+    ('french', _sample(
+        "Le cœur a ses raisons que la raison ne connaît point. "
+        "Élève à l'école, déjà très fâché, où êtes-vous ?\n")),
+    ('latin-1 dense', _random('éàüöñçø abc')),
+    ('russian', _sample(
+        "В чащах юга жил бы цитрус? Да, но фальшивый экземпляр!\n")),
+    ('greek', _random('αβγδεζηθικλμ ')),
+    ('japanese', _random('日本語の文章を書いています。')),
+    ('chinese + ascii', _random('中文字符 abc def 123 ')),
+    ('emoji', _random('😀😃👍 abc 日 é')),
+]
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument('-s', '--size', type=int, default=100_000,
+                        help='size of each corpus in bytes '
+                             '(default: %(default)s)')
+    parser.add_argument('-r', '--repeat', type=int, default=5,
+                        help='number of timing runs (default: %(default)s)')
+    parser.add_argument('names', nargs='*',
+                        help='only run the corpora containing one of '
+                             'these names')
+    options = parser.parse_args()
+
+    print(sys.version)
+    print('%-20s %10s %10s' % ('corpus', 'decode', 'encode'))
+    print('%-20s %10s %10s' % ('', '(MB/s)', '(MB/s)'))
+    for name, build in CORPORA:
+        if options.names and not any(n in name for n in options.names):
+            continue
+        data = build(options.size).encode('utf-8')[:options.size]
+        data = data.decode('utf-8', 'ignore').encode('utf-8')
+        text = data.decode('utf-8')
+        number = max(1, 10_000_000 // len(data))
+        results = []
+        for stmt in (data.decode, text.encode):
+            best = min(timeit.repeat(stmt, number=number,
+                                     repeat=options.repeat))
+            results.append(len(data) * number / best / 1e6)
+        print('%-20s %10.0f %10.0f' % (name, *results))
+
+if __name__ == '__main__':
+    main()